@@ -95,6 +95,21 @@
             2016.11.04 apriori miner object and interface introduced
             2017.05.30 optional output compression with zlib added
             2017.08.01 bug in calls to apriori_data() fixed (arg. order)
+            2026.10.16 item order w.r.t. co-occurrence added (-q3/-q-3)
+            2026.10.16 transaction source/streaming added (options -l, -B)
+            2026.10.16 bit-parallel counting for <= 64 items (option -D)
+            2026.10.16 binary output format added (option -O)
+            2026.10.16 function apriori_store() added (in-memory)
+            2026.10.16 output writer thread added (option -A)
+            2026.10.16 heavy hitter items and pairs (options -H, -K)
+            2026.10.16 parallel rule generation (option -X#)
+            2026.10.17 transaction id lists of item sets (option -L#)
+            2026.10.17 in-memory result store usable with option -M
+            2026.10.17 number of heavy hitter counters checked (-K)
+            2026.10.17 bit-parallel counting only on request (-D)
+            2026.10.17 error message for streaming from standard input
+            2026.10.17 pattern spectrum of surrogate data (options -Y, -J)
+            2026.10.17 option -L rejected with streaming (-l)
 ------------------------------------------------------------------------
   Reference for the Apriori algorithm:
     R. Agrawal and R. Srikant.
@@ -119,6 +134,9 @@
 #ifndef PSP_REPORT
 #define PSP_REPORT
 #endif
+#ifndef HH_REPORT
+#define HH_REPORT
+#endif
 #ifndef TA_READ
 #define TA_READ
 #endif
@@ -126,6 +144,9 @@
 #ifndef TATREEFN
 #define TATREEFN
 #endif
+#ifndef TA_SURR
+#define TA_SURR
+#endif
 #ifdef APR_ABORT
 #include "sigint.h"
 #endif
@@ -145,8 +166,8 @@
 ----------------------------------------------------------------------*/
 #define PRGNAME     "apriori"
 #define DESCRIPTION "find frequent item sets with the apriori algorithm"
-#define VERSION     "version 6.27 (2017.08.01)        " \
-                    "(c) 1996-2017   Christian Borgelt"
+#define VERSION     "version 6.28 (2026.10.17)        " \
+                    "(c) 1996-2026   Christian Borgelt"
 
 /* --- error codes --- */
 /* error codes   0 to  -4 defined in tract.h */
@@ -162,7 +183,13 @@
 #define E_AGGMODE   (-14)       /* invalid aggregation mode */
 #define E_STAT      (-16)       /* invalid test statistic */
 #define E_SIGLVL    (-17)       /* invalid significance level */
-/* error codes -15 to -25 defined in tract.h */
+/* error codes -15 to -26 defined in tract.h */
+#define E_HHSIZE    (-27)       /* invalid number of h.h. counters */
+#define E_STREAM    (-28)       /* streaming from standard input */
+#define E_STROPT    (-29)       /* option not possible with streaming */
+#define E_SURR      (-30)       /* invalid surrogate method */
+#define E_SRCNT     (-31)       /* invalid number of surrogates */
+#define E_NOTAB     (-32)       /* no table-derived data */
 
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
@@ -176,6 +203,11 @@
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
+#define CL_SAMPLE   4096        /* sample size for co-occurrences */
+#define DENSITY     0.15        /* minimum density for bit-parallel */
+                                /* counting (fraction of set bits) */
+#define SURRBATCH   16          /* number of surrogates per batch */
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
@@ -194,10 +226,13 @@ struct _apriori {               /* --- apriori miner --- */
   int      algo;                /* variant of apriori algorithm */
   int      mode;                /* search mode (e.g. pruning) */
   TABAG    *tabag;              /* transaction bag/multiset */
+  TASRC    *tasrc;              /* transaction source (streaming) */
   ISREPORT *report;             /* item set reporter */
   TATREE   *tatree;             /* transaction tree */
   ISTREE   *istree;             /* item set tree (for counting) */
   ITEM     *map;                /* identifier map for filtering */
+  int      thcnt;               /* number of threads for rules */
+  TABAG    *copy;               /* unreduced copy of the trans. bag */
 };                              /* (apriori miner) */
 
 /*----------------------------------------------------------------------
@@ -224,7 +259,25 @@ static const char *errmsgs[] = {
   /* E_NOITEMS -15 */  "no (frequent) items found",
   /* E_STAT    -16 */  "invalid test statistic '%c'",
   /* E_SIGLVL  -17 */  "invalid significance level/p-value %g",
-  /*           -18 */  "unknown error"
+  /*    -18 to -22 */  NULL, NULL, NULL, NULL, NULL,
+  /*    -23 to -26 */  NULL, NULL, NULL, NULL,
+  /* E_HHSIZE  -27 */  "invalid number of heavy hitter counters %ld",
+  /* E_STREAM  -28 */  "streaming (option -l) needs a named input file",
+  /* E_STROPT  -29 */  "option -%c is not possible with streaming (-l)",
+  /* E_SURR    -30 */  "invalid surrogate generation method %d",
+  /* E_SRCNT   -31 */  "invalid number of surrogate data sets %ld",
+  /* E_NOTAB   -32 */  "column shuffling needs table-derived data",
+  /*           -33 */  "unknown error"
+};
+#endif
+
+#if defined APR_MAIN && !defined APRIACC
+/* --- surrogate data generation --- */
+static TBGSURRFN *surrfn[] = {  /* surrogate generation functions */
+  /* 0 */  tbg_ident,           /* identity (original data) */
+  /* 1 */  tbg_random,          /* random item permutation */
+  /* 2 */  tbg_swap,            /* swap randomization */
+  /* 3 */  tbg_shuffle,         /* column shuffling (table data) */
 };
 #endif
 
@@ -238,6 +291,10 @@ static CCHAR    *prgname;       /* program name for error messages */
 static TABREAD  *tread  = NULL; /* table/transaction reader */
 static ITEMBASE *ibase  = NULL; /* item base */
 static TABAG    *tabag  = NULL; /* transaction bag/multiset */
+#ifndef APRIACC
+static TASRC    *tasrc  = NULL; /* transaction source (streaming) */
+static ISSTORE  *store  = NULL; /* in-memory item set/rule store */
+#endif
 static ISREPORT *report = NULL; /* item set reporter */
 static TABWRITE *twrite = NULL; /* table writer for pattern spectrum */
 static double   *border = NULL; /* support border for filtering */
@@ -281,10 +338,13 @@ APRIORI* apriori_create (int target, double smin, double smax,
   apriori->algo   = algo;
   apriori->mode   = mode;
   apriori->tabag  = NULL;
+  apriori->tasrc  = NULL;
   apriori->report = NULL;
   apriori->tatree = NULL;
   apriori->istree = NULL;
   apriori->map    = NULL;
+  apriori->thcnt  = 1;          /* default: single thread */
+  apriori->copy   = NULL;       /* no copy of the trans. bag yet */
   return apriori;               /* return the created apriori miner */
 }  /* apriori_create() */
 
@@ -296,6 +356,8 @@ static int cleanup (APRIORI *apriori)
     return E_NOMEM;             /* if not to clean up memory, abort */
   if (apriori->map) {           /* free identifier map for filtering */
     free(apriori->map);             apriori->map    = NULL; }
+  if (apriori->tasrc)           /* remove the item filter */
+    tsrc_filter(apriori->tasrc, 0, NULL);
   if (apriori->istree) {        /* free item set tree (for counting) */
     ist_delete(apriori->istree);    apriori->istree = NULL; }
   if (apriori->tatree) {        /* free the transaction tree */
@@ -311,7 +373,10 @@ void apriori_delete (APRIORI *apriori, int deldar)
   if (deldar) {                 /* if to delete data and reporter */
     if (apriori->report) isr_delete(apriori->report, 0);
     if (apriori->tabag)  tbg_delete(apriori->tabag,  1);
+    if (apriori->tasrc)  tsrc_delete(apriori->tasrc, 1);
   }                             /* delete if existing */
+  if (apriori->copy)            /* delete the copy of the bag */
+    tbg_delete(apriori->copy, 0);    /* (trans. ids, surrogates) */
   free(apriori);                /* delete the base structure */
 }  /* apriori_delete() */
 
@@ -344,13 +409,24 @@ int apriori_data (APRIORI *apriori, TABAG *tabag, int mode, int sort)
   if (!(mode & APR_NORECODE)) { /* if to sort and recode the items */
     CLOCK(t);                   /* start timer, print log message */
     XMSG(stderr, "filtering, sorting and recoding items ... ");
-    m = tbg_recode(tabag, apriori->supp, -1, -1, sort);
+    if ((sort >= 3) || (sort <= -3))  /* if to cluster co-occurring */
+      m = tbg_reclus(tabag, apriori->supp, -1, -1,   /* items */
+                     (sort > 0) ? +1 : -1, CL_SAMPLE);
+    else m = tbg_recode(tabag, apriori->supp, -1, -1, sort);
     if (m < 0) return E_NOMEM;  /* recode items and transactions */
     if (m < 1) return E_NOITEMS;/* and check the number of items */
     XMSG(stderr, "[%"ITEM_FMT" item(s)]", m);
     XMSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
   }                             /* print a log message */
 
+  /* --- copy transactions for id lists/surrogates --- */
+  if ((apriori->mode & (APR_TIDS|APR_SURR))
+  &&  !(apriori->target & ISR_RULES)) {
+    if (apriori->copy) tbg_delete(apriori->copy, 0);
+    apriori->copy = tbg_clone(tabag);
+    if (!apriori->copy) return E_NOMEM;
+  }                             /* keep the transactions in order */
+
   /* --- sort and reduce transactions --- */
   CLOCK(t);                     /* start timer, print log message */
   XMSG(stderr, "sorting and reducing transactions ... ");
@@ -377,12 +453,61 @@ int apriori_data (APRIORI *apriori, TABAG *tabag, int mode, int sort)
 
 /*--------------------------------------------------------------------*/
 
+int apriori_source (APRIORI *apriori, TASRC *src, int mode, int sort)
+{                               /* --- prepare source for Apriori */
+  ITEM    m;                    /* number of items */
+  double  smin;                 /* absolute minimum support */
+  SUPP    w;                    /* total transaction weight */
+  int     e;                    /* evaluation without flags */
+  #ifndef QUIET                 /* if to print messages */
+  clock_t t;                    /* timer for measurements */
+  #endif                        /* (only needed for messages) */
+
+  assert(apriori && src);       /* check the function arguments */
+  apriori->tasrc = src;         /* note the transaction source */
+  if (tsrc_scan(src) < 0)       /* execute the first pass */
+    return tsrc_error(src);     /* (determine item frequencies) */
+
+  /* --- compute data-specific parameters --- */
+  w = tsrc_wgt(src);            /* compute absolute minimum support */
+  smin = ceilsupp((apriori->smin < 0) ? -apriori->smin
+                : (apriori->smin/100.0) *(double)w *(1-DBL_EPSILON));
+  apriori->body = (SUPP)smin;   /* compute body and body&head support */
+  if ((apriori->target & ISR_RULES) && !(apriori->mode & APR_ORIGSUPP))
+    smin *= apriori->conf *(1-DBL_EPSILON);
+  apriori->supp = (SUPP)ceilsupp(smin);
+
+  /* --- sort and recode items --- */
+  if (!(mode & APR_NORECODE)) { /* if to sort and recode the items */
+    CLOCK(t);                   /* start timer, print log message */
+    XMSG(stderr, "filtering, sorting and recoding items ... ");
+    if      (sort >=  3) sort = +1;  /* co-occurrence order needs */
+    else if (sort <= -3) sort = -1;  /* the transactions in memory */
+    m = tsrc_recode(src, apriori->supp, -1, -1, sort);
+    if (m < 0) return tsrc_error(src);
+    if (m < 1) return E_NOITEMS;/* recode items and check their number */
+    XMSG(stderr, "[%"ITEM_FMT" item(s)]", m);
+    XMSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  }                             /* print a log message */
+
+  /* --- set the transaction filter --- */
+  e = apriori->eval & ~APR_INVBXS;
+  if (!(mode & APR_NOFILTER)    /* filter transactions if possible */
+  &&  !(apriori->target & ISR_RULES)
+  &&  ((e <= RE_NONE) || (e >= RE_FNCNT)))
+    tsrc_filter(src, apriori->zmin, NULL);
+  return 0;                     /* return 'ok' */
+}  /* apriori_source() */
+
+/*--------------------------------------------------------------------*/
+
 int apriori_report (APRIORI *apriori, ISREPORT *report)
 {                               /* --- prepare reporter for Apriori */
-  TID    n;                     /* number of transactions */
-  SUPP   w;                     /* total transaction weight */
-  double smax;                  /* absolute maximum support */
-  int    mrep;                  /* mode for item set reporter */
+  TID      n;                   /* number of transactions */
+  SUPP     w;                   /* total transaction weight */
+  double   smax;                /* absolute maximum support */
+  int      mrep;                /* mode for item set reporter */
+  ITEMBASE *base;               /* underlying item base */
 
   assert(apriori && report);    /* check the function arguments */
   apriori->report = report;     /* note the item set reporter */
@@ -393,9 +518,21 @@ int apriori_report (APRIORI *apriori, ISREPORT *report)
   if (apriori->mode & APR_ZLIB) /* if the compression flag is set, */
     mrep |= ISR_ZLIB;           /* transfer it to the report mode */
   #endif
+  if (apriori->mode & APR_BINARY)  /* if to write binary format, */
+    mrep |= ISR_BINARY|ISR_TIDBIN;  /* transfer it to the report mode */
+  #ifdef USE_THREADS            /* if to use an output thread */
+  if (apriori->mode & APR_ASYNC)/* if to write asynchronously, */
+    mrep |= ISR_ASYNC;          /* transfer it to the report mode */
+  #endif
 
   /* --- configure item set reporter --- */
-  w = tbg_wgt(apriori->tabag);  /* set support and size range */
+  if (apriori->tasrc) {         /* if to stream the transactions */
+    base = tsrc_base(apriori->tasrc);
+    w    = tsrc_wgt (apriori->tasrc); }
+  else {                        /* if the transactions are in memory */
+    base = tbg_base (apriori->tabag);
+    w    = tbg_wgt  (apriori->tabag);
+  }                             /* set support and size range */
   smax = (apriori->smax < 0) ? -apriori->smax
        : (apriori->smax/100.0) *(double)w *(1-DBL_EPSILON);
   isr_setsupp(report, (RSUPP)apriori->supp, (RSUPP)floorsupp(smax));
@@ -403,30 +540,65 @@ int apriori_report (APRIORI *apriori, ISREPORT *report)
   if ((apriori->eval & ~APR_INVBXS) == APR_LDRATIO)
     isr_seteval(report, isr_logrto, NULL, +1, apriori->thresh);
   n = (apriori->mode & APR_PREFMT)/* get range of nums. to preformat */
-    ? (TID)ib_maxfrq(tbg_base(apriori->tabag)) : -1;
+    ? (TID)ib_maxfrq(base) : -1;
   if ((isr_prefmt(report, (TID)apriori->supp, n)      != 0)
   ||  (isr_settarg(report, apriori->target, mrep, -1) != 0))
     return E_NOMEM;             /* set pre-format and target type */
+  if ((apriori->mode & APR_TIDS)/* collect trans. ids from the copy */
+  &&  apriori->copy             /* of the unreduced transactions */
+  &&  (isr_tidbag(report, apriori->copy) != 0))
+    return E_NOMEM;             /* (set the trans. bag to use) */
   return 0;                     /* return 'ok' */
 }  /* apriori_report() */
 
 /*--------------------------------------------------------------------*/
 
+int apriori_store (APRIORI *apriori, ISSTORE *store)
+{                               /* --- set in-memory result store */
+  assert(apriori && apriori->report);  /* check the arguments */
+  if (store                     /* check the store mode */
+  && (!(iss_mode(store) & ISS_RULES) != !(apriori->target & ISR_RULES)))
+    return -1;                  /* (rules need a rule store) */
+  isr_setstore(apriori->report, store);
+  return 0;                     /* attach the store to the reporter */
+}  /* apriori_store() */
+
+/*--------------------------------------------------------------------*/
+
+void apriori_threads (APRIORI *apriori, int thcnt)
+{                               /* --- set number of threads */
+  assert(apriori);              /* check the function argument */
+  apriori->thcnt = thcnt;       /* store the number of threads */
+}  /* apriori_threads() */       /* (<= 0: number of processors) */
+
+/*--------------------------------------------------------------------*/
+
 int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
 {                               /* --- apriori algorithm */
   ITEM    m, i, k;              /* number of items, loop variables */
   ITEM    size;                 /* number of items in set/rule */
   ITEM    xmax;                 /* maximum size for extensions */
   int     e, mode;              /* evaluation without flags, mode */
+  int     dense;                /* whether to use bit-parallel count. */
   clock_t t, tt, tc, x;         /* timers for measurements */
+  ITEMBASE *base;               /* underlying item base */
 
   assert(apriori);              /* check the function arguments */
   e = apriori->eval & ~APR_INVBXS; /* check and adapt evaluation */
   if (e <= RE_NONE) prune = ITEM_MIN;
+  dense = (apriori->mode & APR_DENSE) && !apriori->tasrc
+       && (tbg_itemcnt(apriori->tabag) <= BT_MAXCNT)
+       && !(tbg_mode(apriori->tabag) & IB_WEIGHTS)
+       && ((double)tbg_extent(apriori->tabag) >= DENSITY
+          *(double)tbg_cnt(apriori->tabag)
+          *(double)tbg_itemcnt(apriori->tabag));
+  if (dense)                    /* check for bit-parallel counting */
+    XMSG(stderr, "using bit-parallel counting (%"ITEM_FMT" items).\n",
+         tbg_itemcnt(apriori->tabag));
 
   /* --- create transaction tree --- */
   tt = 0;                       /* init. the tree construction time */
-  if (apriori->mode & APR_TATREE) { /* if to use a transaction tree */
+  if ((apriori->mode & APR_TATREE) && !apriori->tasrc && !dense) {
     t = clock();                /* start the timer for construction */
     XMSG(stderr, "building transaction tree ... ");
     apriori->tatree = tat_create(apriori->tabag);
@@ -443,14 +615,19 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
     apriori->mode &= ~IST_PERFECT; /* remove perfect ext. pruning */
   t = clock(); tc = 0;          /* start the timer for the search */
   mode = apriori->mode & ~(IST_PARTIAL|IST_REVERSE);
-  apriori->istree = ist_create(tbg_base(apriori->tabag), mode,
+  base = (apriori->tasrc) ? tsrc_base(apriori->tasrc)
+                          : tbg_base (apriori->tabag);
+  apriori->istree = ist_create(base, mode,
                          apriori->supp, apriori->body, apriori->conf);
   if (!apriori->istree) return cleanup(apriori);
+  ist_setthcnt(apriori->istree, apriori->thcnt);
   xmax = ((apriori->target & (ISR_CLOSED|ISR_MAXIMAL))
       && !(apriori->target & ISR_RULES)
       &&  (apriori->zmax   < ITEM_MAX))
        ? apriori->zmax+1 : apriori->zmax;
-  m = tbg_max(apriori->tabag);  /* compute maximum extension size */
+  m = (apriori->tasrc) ? tsrc_max(apriori->tasrc)
+                       : tbg_max (apriori->tabag);
+                                /* compute maximum extension size */
   if (xmax > m) xmax = m;       /* and limit it to transaction size */
   if (e == APR_LDRATIO)         /* set additional evaluation measure */
        isr_seteval(apriori->report, isr_logrto, NULL,
@@ -460,7 +637,7 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
 
   /* --- check item subsets --- */
   XMSG(stderr, "checking subsets of size 1");
-  m = tbg_itemcnt(apriori->tabag); /* create an item map for pruning */
+  m = ib_cnt(base);             /* create an item map for pruning */
   apriori->map = (ITEM*)malloc((size_t)m *sizeof(ITEM));
   if (!apriori->map) return cleanup(apriori);
   for (i = m; 1; ) {            /* traverse the item set sizes */
@@ -487,6 +664,9 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
       if (apriori->tatree) {    /* if a transaction tree was created */
         if (tat_filter(apriori->tatree, size+1, (int*)apriori->map, 0))
           return cleanup(apriori); }   /* filter the transaction tree */
+      else if (apriori->tasrc)  /* if to stream the transactions, */
+        tsrc_filter(apriori->tasrc, size+1, (int*)apriori->map);
+      else if (dense) ;         /* (bit columns need no filtering) */
       else {                    /* if there is only a transaction bag */
         tbg_filter(apriori->tabag, size+1, (int*)apriori->map, 0);
         tbg_sort  (apriori->tabag, 0, 0); /* remove unnecessary items */
@@ -497,11 +677,24 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
     size += 1;                  /* increment the item set size */
     XMSG(stderr, " %"ITEM_FMT, size);          /* and print it */
     x = clock();                /* start the timer for counting */
-    if (apriori->tatree) ist_countx(apriori->istree, apriori->tatree);
-    else                 ist_countb(apriori->istree, apriori->tabag);
+    if      (apriori->tatree)
+      ist_countx(apriori->istree, apriori->tatree);
+    else if (apriori->tasrc) {  /* if to stream the transactions */
+      k = ist_counts(apriori->istree, apriori->tasrc);
+      if (k < 0) { cleanup(apriori); return (int)k; } }
+    else if (dense) {           /* if to use bit-parallel counting */
+      k = ist_countm(apriori->istree, apriori->tabag);
+      if (k < 0) return cleanup(apriori);
+      if (k > 0) {              /* if the weights are not integer, */
+        dense = 0;              /* fall back to normal counting */
+        ist_countb(apriori->istree, apriori->tabag);
+      } }
+    else ist_countb(apriori->istree, apriori->tabag);
     ist_commit(apriori->istree);/* count the transaction tree/bag */
     tc = clock() -x;            /* compute the new counting time */
   }
+  if (apriori->tasrc)           /* remove the item filter */
+    tsrc_filter(apriori->tasrc, 0, NULL);
   free(apriori->map);           /* delete the filter map */
   apriori->map = NULL;          /* and the transaction tree */
   if (apriori->tatree && !(apriori->mode & APR_NOCLEAN)) {
@@ -537,10 +730,14 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
 
   /* --- report item sets/association rules --- */
   CLOCK(t);                     /* start the output timer */
-  XMSG(stderr, "writing %s ... ", isr_name(apriori->report));
+  XMSG(stderr, "writing %s ... ", (isr_name(apriori->report))
+       ? isr_name(apriori->report) : "<memory>");
   ist_init(apriori->istree, order); /* initialize the extraction */
-  if (ist_report(apriori->istree, apriori->report, apriori->target) < 0)
-    return cleanup(apriori);    /* report item sets/association rules */
+  if ((ist_report(apriori->istree, apriori->report,
+                  apriori->target) < 0)
+  ||  (isr_store(apriori->report)  /* report item sets/rules */
+  &&   iss_error(isr_store(apriori->report))))
+    return cleanup(apriori);    /* check for a store error */
   XMSG(stderr, "[%"SIZE_FMT" %s(s)]", isr_repcnt(apriori->report),
                (apriori->target == ISR_RULES) ? "rule" : "set");
   XMSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
@@ -551,6 +748,73 @@ int apriori_mine (APRIORI *apriori, ITEM prune, double filter,int order)
   return 0;                     /* return 'ok' */
 }  /* apriori_mine() */
 
+/*--------------------------------------------------------------------*/
+
+int apriori_surr (APRIORI *apriori, ITEM prune, double filter,
+                  int order, TBGSURRFN *fn, int cnt,
+                  unsigned int seed, ISREPORT *report)
+{                               /* --- mine surrogate data sets */
+  int     i, k, n;              /* loop variables, batch size */
+  int     r = 0;                /* error indicator */
+  int     mode;                 /* search mode for the surrogates */
+  TBGSURR *sb;                  /* batch of surrogate data sets */
+  TABAG   *bag;                 /* copy of a surrogate data set */
+  APRIORI *sub;                 /* miner for a surrogate data set */
+
+  assert(apriori && apriori->copy  /* check the function arguments */
+  &&     fn && (cnt > 0) && report);
+  if ((fn == tbg_shuffle) && !tbg_istab(apriori->copy))
+    return E_NOTAB;             /* column shuffles need table data */
+  mode = apriori->mode & ~(APR_VERBOSE|APR_NOCLEAN|APR_BINARY
+                          |APR_TIDS|APR_SURR);
+  #ifdef USE_THREADS            /* remove the flags that refer to */
+  mode &= ~APR_ASYNC;           /* the output or the original data */
+  #endif                        /* (surrogates only fill a spectrum) */
+  n  = (cnt < SURRBATCH) ? cnt : SURRBATCH;
+  sb = tbs_create(apriori->copy, fn, n, seed, apriori->thcnt);
+  if (!sb) return E_NOMEM;      /* create a surrogate batch */
+  for (k = 0; (k < cnt) && (r == 0); k += n) {
+    if (tbs_next(sb) != 0) {    /* generate the next batch */
+      r = E_NOMEM; break; }     /* of surrogate data sets */
+    for (i = 0; (i < n) && (k+i < cnt) && (r == 0); i++) {
+      bag = tbg_clone(tbs_bag(sb, i));
+      sub = apriori_create(apriori->target,
+                           apriori->smin, apriori->smax,
+                           apriori->conf *100.0,
+                           apriori->zmin, apriori->zmax,
+                           apriori->eval, apriori->agg,
+                           apriori->thresh *100.0,
+                           apriori->algo, mode);
+      if (!bag || !sub) r = E_NOMEM;
+      else if (((r = apriori_data  (sub, bag, APR_NORECODE, 0)) == 0)
+      &&       ((r = apriori_report(sub, report))               == 0))
+        r = (isr_setup(report) < 0) ? E_NOMEM
+          : apriori_mine(sub, prune, filter, order);
+      if (sub) apriori_delete(sub, 0);
+      if (bag) tbg_delete(bag, 0);
+    }                           /* mine a copy of each surrogate, */
+  }                             /* because it is sorted and reduced */
+  tbs_delete(sb);               /* delete the surrogate batch */
+  return r;                     /* return an error indicator */
+}  /* apriori_surr() */
+
+/*----------------------------------------------------------------------
+The surrogate data sets are generated from the copy of the recoded,
+but not yet reduced transactions, which is kept if the flag APR_SURR
+is set in the mode when apriori_data() is called. Each surrogate is
+mined with the same parameters as the original data (except that no
+output is written), so that the given reporter, to which a pattern
+spectrum should have been added, collects the pattern signatures of
+all surrogates. The surrogates are generated in batches of SURRBATCH
+data sets with tbs_next(), using as many threads as were set with
+apriori_threads(); since the random number generators of the slots
+of a batch are seeded from the master seed and the slot index, the
+result does not depend on the number of threads. Note that the item
+set tree takes the support of the single items from the item base,
+which is correct for the surrogate methods, because they preserve
+the item frequencies (tbg_random() only approximately).
+----------------------------------------------------------------------*/
+
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
@@ -709,12 +973,19 @@ static int setbdr (ISREPORT *report, SUPP w, ITEM zmin,
 /*--------------------------------------------------------------------*/
 
 #ifndef NDEBUG                  /* if debug version */
+  #ifdef APRIACC                /* if accretion-style version, */
+  #define DELSRC                /* there is no transaction source */
+  #else                         /* if standard version */
+  #define DELSRC  if (tasrc) tsrc_delete(tasrc, 0); \
+                  if (store) iss_delete(store);
+  #endif
   #undef  CLEANUP               /* clean up memory and close files */
   #define CLEANUP \
   if (apriori) apriori_delete(apriori, 0); \
   if (twrite)  twr_delete(twrite, 1);      \
   if (report)  isr_delete(report, 0);      \
   if (tabag)   tbg_delete(tabag,  0);      \
+  DELSRC                                   \
   if (tread)   trd_delete(tread,  1);      \
   if (ibase)   ib_delete (ibase);          \
   if (border)  free(border);
@@ -799,7 +1070,9 @@ int main (int argc, char *argv[])
                     "(default: %d)\n", sort);
     printf("         (1: ascending, -1: descending, 0: do not sort,\n"
            "          2: ascending, -2: descending w.r.t. "
-                    "transaction size sum)\n");
+                    "transaction size sum,\n"
+           "          3: ascending, -3: descending, "
+                    "then co-occurring items close)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -1018,6 +1291,10 @@ int main (int argc, char *argv[])
   CCHAR   *fn_out  = NULL;      /* name of the output file */
   CCHAR   *fn_sel  = NULL;      /* name of item selection file */
   CCHAR   *fn_psp  = NULL;      /* name of pattern spectrum file */
+  CCHAR   *fn_hhs  = NULL;      /* name of heavy hitter file */
+  CCHAR   *fn_bin  = NULL;      /* name of binary cache file */
+  CCHAR   *fn_tid  = NULL;      /* name of trans. id list file */
+  CCHAR   *fn_srp  = NULL;      /* name of surrogate spectrum file */
   CCHAR   *recseps = NULL;      /* record  separators */
   CCHAR   *fldseps = NULL;      /* field   separators */
   CCHAR   *blanks  = NULL;      /* blank   characters */
@@ -1047,6 +1324,14 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     stream   = 0;         /* flag for streaming transactions */
+  int     inmem    = 0;         /* flag for writing from a store */
+  long    hhsize   = 1024;      /* number of heavy hitter pairs */
+  int     thcnt    = 1;         /* number of threads for rules */
+  int     surr     = 2;         /* surrogate generation method */
+  long    srcnt    = 100;       /* number of surrogate data sets */
+  long    seed     = 0;         /* seed for random numbers */
+  size_t  z;                    /* loop variable for stored records */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -1098,7 +1383,9 @@ int main (int argc, char *argv[])
                     "(default: %d)\n", sort);
     printf("         (1: ascending, -1: descending, 0: do not sort,\n"
            "          2: ascending, -2: descending w.r.t. "
-                    "transaction size sum)\n");
+                    "transaction size sum,\n"
+           "          3: ascending, -3: descending, "
+                    "then co-occurring items close)\n");
     printf("-u#      filter unused items from transactions    "
                     "(default: %g)\n", filter);
     printf("         (0: do not filter items w.r.t. usage in sets,\n"
@@ -1108,6 +1395,11 @@ int main (int argc, char *argv[])
                     "(default: prune)\n");
     printf("-y       a-posteriori pruning of infrequent item sets\n");
     printf("-T       do not organize transactions as a prefix tree\n");
+    printf("-D       use bit-parallel counting "
+                    "(for at most 64 items, dense data)\n");
+    printf("-l       do not load transactions "
+                    "(re-read them for each level)\n");
+    printf("-B#      binary cache file for re-reading transactions\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -1116,6 +1408,27 @@ int main (int argc, char *argv[])
                     "as given with option -m#)\n");
     printf("-R#      read item selection/appearance indicators\n");
     printf("-P#      write a pattern spectrum to a file\n");
+    printf("-H#      write heavy hitter items and pairs to a file\n");
+    printf("-K#      number of counters for heavy hitter pairs "
+                    "(default: %ld)\n", hhsize);
+    printf("-L#      write transaction id lists to a file "
+                    "(not for rules)\n");
+    printf("-M       collect item sets/rules in memory "
+                    "and write them at the end\n");
+    printf("-Y#      write a pattern spectrum of surrogate data "
+                    "to a file\n");
+    printf("         (average number of item sets "
+                    "per size and support)\n");
+    printf("-J#      number of surrogate data sets            "
+                    "(default: %ld)\n", srcnt);
+    printf("-G#      surrogate data generation method         "
+                    "(default: %d)\n", surr);
+    printf("         (0: identity (original data), "
+                    "1: random item permutation,\n"
+           "          2: swap randomization, "
+                    "3: column shuffling (table data))\n");
+    printf("-U#      seed for random number generation    "
+                    "    (default: time)\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
     printf("-N       do not pre-format some integer numbers   "
@@ -1126,6 +1439,17 @@ int main (int argc, char *argv[])
     printf("-z       compress output with zlib (deflate)      "
                     "(default: plain text)\n");
     #endif                      /* print compression option */
+    printf("-O       write item sets/rules in binary format   "
+                    "(default: text)\n");
+    printf("         (item dictionary in header, see isbin.h;\n");
+    printf("          also for transaction id lists, option -L#)\n");
+    #ifdef USE_THREADS          /* if to use an output thread */
+    printf("-A       write output in a separate thread        "
+                    "(default: no)\n");
+    printf("-X#      number of threads for rules/surrogates   "
+                    "(default: %d)\n", thcnt);
+    printf("         (<= 0: number of processors)\n");
+    #endif                      /* print thread options */
     printf("-h#      record header  for output                "
                     "(default: \"%s\")\n", hdr);
     printf("-k#      item separator for output                "
@@ -1155,7 +1479,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: l [A-Z]\[CFINPRSTZ] */
+  /* free option characters: [A-Z]\[ABCDFHIKLMNOPRSTXZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse the arguments */
@@ -1182,15 +1506,31 @@ int main (int argc, char *argv[])
           case 'x': mode  &= ~APR_PERFECT;           break;
           case 'y': mode  |=  APR_POST;              break;
           case 'T': mode  &= ~APR_TATREE;            break;
+          case 'D': mode  |=  APR_DENSE;             break;
+          case 'l': stream = 1;                      break;
+          case 'B': optarg = &fn_bin; stream = 1;    break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
+          case 'H': optarg = &fn_hhs;                break;
+          case 'K': hhsize =       strtol(s, &s, 0); break;
+          case 'L': optarg = &fn_tid;                break;
+          case 'M': inmem  = 1;                      break;
+          case 'Y': optarg = &fn_srp;                break;
+          case 'J': srcnt  =       strtol(s, &s, 0); break;
+          case 'G': surr   = (int) strtol(s, &s, 0); break;
+          case 'U': seed   =       strtol(s, &s, 0); break;
           case 'Z': stats  = 1;                      break;
           case 'N': mode  &= ~APR_PREFMT;            break;
           case 'g': scan   = 1;                      break;
           #ifdef USE_ZLIB       /* if optional output compression */
           case 'z': mode  |= APR_ZLIB;               break;
           #endif                /* set the compression flag */
+          case 'O': mode  |= APR_BINARY;             break;
+          #ifdef USE_THREADS    /* if to use an output thread */
+          case 'A': mode  |= APR_ASYNC;              break;
+          case 'X': thcnt  = (int)strtol(s, &s, 0);  break;
+          #endif                /* set the writer thread flag */
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
           case 'I': optarg = &imp;                   break;
@@ -1223,6 +1563,8 @@ int main (int argc, char *argv[])
     error(E_CONF, conf);        /* check the minimum confidence */
   if ((!fn_inp || !*fn_inp) && (fn_sel && !*fn_sel))
     error(E_STDIN);             /* stdin must not be used twice */
+  if ((!fn_inp || !*fn_inp) && stream && !fn_bin)
+    error(E_STREAM);            /* stdin cannot be re-read */
   switch (target) {             /* check and translate target type */
     case 's': target = ISR_ALL;              break;
     case 'f': target = ISR_FREQUENT;         break;
@@ -1270,7 +1612,24 @@ int main (int argc, char *argv[])
   if ((filter <= -1) || (filter >= 1))
     filter = 0;                 /* check and adapt the filter option */
   if (target & ISR_RULES)       /* if to find association rules, */
-    fn_psp = NULL;              /* no pattern spectrum possible */
+    fn_psp = fn_hhs = fn_tid = fn_srp = NULL;
+                                /* no pattern spectrum possible */
+  if (stream && fn_srp)         /* surrogates need the loaded trans. */
+    error(E_STROPT, 'Y');       /* (not possible with streaming) */
+  if (stream && fn_tid)         /* trans. ids need the loaded trans. */
+    error(E_STROPT, 'L');       /* (not possible with streaming) */
+  if (fn_srp) {                 /* if to mine surrogate data sets, */
+    if ((surr < 0) || (surr > 3))    /* check the method */
+      error(E_SURR, surr);      /* and the number of surrogates */
+    if ((srcnt < 1) || (srcnt > INT_MAX))
+      error(E_SRCNT, srcnt);    /* note the need for a copy */
+    mode |= APR_SURR;           /* of the unreduced transactions */
+    if (seed == 0) seed = (long)time(NULL);
+  }                             /* get a default seed value */
+  if (fn_tid) mode |= APR_TIDS; /* set the trans. id list flag */
+  if (fn_hhs && ((hhsize < 1)  /* check the number of counters */
+  ||  ((unsigned long)hhsize > HH_MAXSIZE)))
+    error(E_HHSIZE, hhsize);    /* of the heavy hitter sketch */
   if (info == dflt) {           /* if default info. format is used, */
     if (target != ISR_RULES)    /* set default according to target */
          info = (smin < 0) ? " (%a)"     : " (%S)";
@@ -1300,19 +1659,29 @@ int main (int argc, char *argv[])
   }                             /* print a log message */
 
   /* --- read transaction database --- */
-  tabag = tbg_create(ibase);    /* create a transaction bag */
-  if (!tabag) error(E_NOMEM);   /* to store the transactions */
   CLOCK(t);                     /* start timer, open input file */
   if (trd_open(tread, NULL, fn_inp) != 0)
     error(E_FOPEN, trd_name(tread));
   MSG(stderr, "reading %s ... ", trd_name(tread));
-  k = tbg_read(tabag, tread, mtar);
-  if (k < 0) error(-k, tbg_errmsg(tabag, NULL, 0));
-  trd_delete(tread, 1);         /* read the transaction database, */
-  tread = NULL;                 /* then delete the table reader */
-  m = ib_cnt(ibase);            /* get the number of items, */
-  n = tbg_cnt(tabag);           /* the number of transactions, */
-  w = tbg_wgt(tabag);           /* the total transaction weight */
+  if (stream) {                 /* if not to load the transactions */
+    tasrc = tsrc_create(ibase, mtar);
+    if (!tasrc) error(E_NOMEM); /* create a transaction source */
+    if (tsrc_file(tasrc, tread, fn_bin) != 0)
+      error(E_FOPEN, fn_bin);   /* set the file as the source */
+    n = tsrc_scan(tasrc);       /* and execute the first pass */
+    if (n < 0) error((int)-n, ib_errmsg(ibase, NULL, 0));
+    w = tsrc_wgt(tasrc); }      /* get the total transaction weight */
+  else {                        /* if to load the transactions */
+    tabag = tbg_create(ibase);  /* create a transaction bag */
+    if (!tabag) error(E_NOMEM); /* to store the transactions */
+    k = tbg_read(tabag, tread, mtar);
+    if (k < 0) error(-k, tbg_errmsg(tabag, NULL, 0));
+    trd_delete(tread, 1);       /* read the transaction database, */
+    tread = NULL;               /* then delete the table reader */
+    n = tbg_cnt(tabag);         /* get the number of transactions */
+    w = tbg_wgt(tabag);         /* and the total transaction weight */
+  }
+  m = ib_cnt(ibase);            /* get the number of items */
   MSG(stderr, "[%"ITEM_FMT" item(s), %"TID_FMT, m, n);
   if (w != (SUPP)n) { MSG(stderr, "/%"SUPP_FMT, w); }
   MSG(stderr, " transaction(s)] done [%.2fs].", SEC_SINCE(t));
@@ -1324,7 +1693,9 @@ int main (int argc, char *argv[])
   apriori = apriori_create(target, smin, smax, conf, zmin, zmax,
                            eval, agg, thresh, algo, mode);
   if (!apriori) error(E_NOMEM); /* create an Apriori miner */
-  k = apriori_data(apriori, tabag, 0, sort);
+  apriori_threads(apriori, thcnt); /* set the number of threads */
+  k = (tasrc) ? apriori_source(apriori, tasrc, 0, sort)
+              : apriori_data  (apriori, tabag, 0, sort);
   if (k) error(k);              /* prepare data for Apriori */
   report = isr_create(ibase);   /* create an item set reporter */
   if (!report) error(E_NOMEM);  /* and configure it */
@@ -1334,18 +1705,34 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set the support border (if any) */
   if (fn_psp && (isr_addpsp(report, NULL) < 0))
     error(E_NOMEM);             /* set a pattern spectrum if req. */
+  if (fn_hhs && (isr_addhhs(report, (size_t)hhsize) < 0))
+    error(E_NOMEM);             /* set heavy hitter sketches if req. */
   if (isr_setfmt(report, scan, hdr, sep, imp, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
-  if (k) error(k, isr_name(report));
+  if (inmem) {                  /* if to collect the results */
+    store = iss_create((target & ISR_RULES) ? ISS_RULES : ISS_SETS);
+    if (!store) error(E_NOMEM); /* create an item set/rule store */
+    apriori_store(apriori, store); }   /* and attach it */
+  else {                        /* if to write the results directly */
+    k = isr_open(report, NULL, fn_out);
+    if (k) error(k, isr_name(report));
+  }                             /* open the item set output file */
+  if (fn_tid) {                 /* if to write trans. id lists */
+    k = isr_tidopen(report, NULL, fn_tid);
+    if (k) error(k, isr_tidname(report));
+  }                             /* open the trans. id list file */
   if (isr_setup(report) < 0)    /* open the output file and */
     error(E_NOMEM);             /* set up the item set reporter */
   k = apriori_mine(apriori, prune, filter, order);
-  if (k) error(k);              /* find frequent item sets */
+  if (k) error(k, (fn_bin) ? fn_bin : fn_inp);
+  if (store && iss_error(store))/* find frequent item sets */
+    error(E_NOMEM);             /* and check the result store */
   if (stats)                    /* print item set statistics */
     isr_prstats(report, stdout, 0);
   if (isr_close(report) != 0)   /* close item set output file */
     error(E_FWRITE, isr_name(report));
+  if (isr_tidclose(report) != 0)/* close trans. id output file */
+    error(E_FWRITE, isr_tidname(report));
 
   /* --- write pattern spectrum --- */
   if (fn_psp) {                 /* if to write a pattern spectrum */
@@ -1364,6 +1751,75 @@ int main (int argc, char *argv[])
     MSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
   }                             /* write a log message */
 
+  /* --- write heavy hitters --- */
+  if (fn_hhs) {                 /* if to write heavy hitters */
+    CLOCK(t);                   /* start timer, create table write */
+    twrite = twr_create();      /* create a table writer and */
+    if (!twrite) error(E_NOMEM);/* open the output file */
+    if (twr_open(twrite, NULL, fn_hhs) != 0)
+      error(E_FOPEN,  twr_name(twrite));
+    MSG(stderr, "writing %s ... ", twr_name(twrite));
+    if ((hh_report(isr_gethhs(report, 0), twrite, ibase) != 0)
+    ||  (hh_report(isr_gethhs(report, 1), twrite, ibase) != 0))
+      error(E_FWRITE, twr_name(twrite));
+    twr_delete(twrite, 1);      /* write items and item pairs */
+    twrite = NULL;              /* and delete the table writer */
+    MSG(stderr, "[%"SIZE_FMT" item(s), %"SIZE_FMT" pair(s)]",
+        hh_cnt(isr_gethhs(report, 0)), hh_cnt(isr_gethhs(report, 1)));
+    MSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  }                             /* write a log message */
+
+  /* --- write collected item sets/rules --- */
+  if (store) {                  /* if the results are in memory */
+    CLOCK(t);                   /* start timer, detach the store */
+    isr_setstore(report, NULL); /* and remove the border, because */
+    isr_clrbdr(report);         /* the records were filtered already */
+    k = isr_open(report, NULL, fn_out);
+    if (k) error(k, isr_name(report));
+    MSG(stderr, "writing %s ... ", isr_name(report));
+    for (z = 0; z < iss_cnt(store); z++) {
+      k = (target & ISR_RULES)  /* traverse the stored records */
+        ? isr_rule(report, iss_items(store, z), iss_size(store, z),
+                   iss_supp(store, z), iss_body(store, z),
+                   iss_head(store, z), iss_eval(store, z))
+        : isr_iset(report, iss_items(store, z), iss_size(store, z),
+                   iss_supp(store, z), 0, iss_eval(store, z));
+      if (k < 0) error(E_NOMEM);/* write an item set or rule */
+    }                           /* in the normal output format */
+    if (isr_close(report) != 0) /* close the output file */
+      error(E_FWRITE, isr_name(report));
+    MSG(stderr, "[%"SIZE_FMT" %s(s)]", iss_cnt(store),
+        (target & ISR_RULES) ? "rule" : "set");
+    MSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  }                             /* write a log message */
+
+  /* --- mine surrogate data sets --- */
+  if (fn_srp) {                 /* if to mine surrogate data sets */
+    CLOCK(t);                   /* start timer, print log message */
+    MSG(stderr, "mining %ld surrogate data set(s) ... ", srcnt);
+    isr_delete(report, 0);      /* replace the item set reporter */
+    report = isr_create(ibase); /* with one that only collects */
+    if (!report) error(E_NOMEM);/* a pattern spectrum */
+    if (isr_addpsp(report, NULL) < 0) error(E_NOMEM);
+    k = apriori_surr(apriori, prune, filter, order, surrfn[surr],
+                     (int)srcnt, (unsigned int)seed, report);
+    if (k) error(k);            /* mine the surrogate data sets */
+    MSG(stderr, "done [%.2fs].\n", SEC_SINCE(t));
+    CLOCK(t);                   /* start timer, create table write */
+    psp    = isr_getpsp(report);/* get the pattern spectrum */
+    twrite = twr_create();      /* create a table writer and */
+    if (!twrite) error(E_NOMEM);/* open the output file */
+    if (twr_open(twrite, NULL, fn_srp) != 0)
+      error(E_FOPEN,  twr_name(twrite));
+    MSG(stderr, "writing %s ... ", twr_name(twrite));
+    if (psp_report(psp, twrite, 1.0/(double)srcnt) != 0)
+      error(E_FWRITE, twr_name(twrite));
+    twr_delete(twrite, 1);      /* write the pattern spectrum */
+    twrite = NULL;              /* and delete the table writer */
+    MSG(stderr, "[%"SIZE_FMT" signature(s)]", psp_sigcnt(psp));
+    MSG(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  }                             /* write a log message */
+
   /* --- clean up --- */
   CLEANUP;                      /* clean up memory and close files */
   SHOWMEM;                      /* show (final) memory usage */
@@ -9,6 +9,15 @@
             2014.08.28 functions apr_data() and apr_report() added
             2016.11.04 apriori miner object and interface introduced
             2017.05.30 optional output compression with zlib added
+            2026.10.16 function apriori_source() added (streaming)
+            2026.10.16 bit-parallel counting added (APR_DENSE)
+            2026.10.16 binary output format added (APR_BINARY)
+            2026.10.16 function apriori_store() added (in-memory)
+            2026.10.16 output writer thread added (APR_ASYNC)
+            2026.10.16 function apriori_threads() added (parallel rules)
+            2026.10.17 transaction id lists of item sets added (APR_TIDS)
+            2026.10.17 bit-parallel counting removed from APR_DEFAULT
+            2026.10.17 function apriori_surr() added (surrogate data)
 ----------------------------------------------------------------------*/
 #ifndef __APRIORI__
 #define __APRIORI__
@@ -54,10 +63,17 @@
 #define APR_PERFECT   IST_PERFECT  /* perfect extension pruning */
 #define APR_TATREE    0x0200    /* use transaction tree */
 #define APR_POST      0x0400    /* use a-posteriori pruning */
+#ifdef USE_THREADS              /* if to use an output thread */
+#define APR_ASYNC     0x0040    /* write output in a separate thread */
+#endif
+#define APR_BINARY    0x0800    /* write binary output format */
 #define APR_PREFMT    0x1000    /* pre-format integer numbers */
+#define APR_DENSE     0x2000    /* bit-parallel counting (<= 64 items) */
 #ifdef USE_ZLIB                 /* if optional output compression */
 #define APR_ZLIB      0x4000    /* flag for output compression */
 #endif
+#define APR_TIDS      0x10000   /* write transaction id lists */
+#define APR_SURR      0x20000   /* keep trans. for surrogate data */
 #define APR_DEFAULT   (APR_PERFECT|APR_TATREE)
 #ifdef NDEBUG
 #define APR_NOCLEAN   0x8000    /* do not clean up memory */
@@ -82,7 +98,17 @@ extern APRIORI* apriori_create (int target, double smin, double smax,
 extern void     apriori_delete (APRIORI *apriori, int deldar);
 extern int      apriori_data   (APRIORI *apriori, TABAG *tabag,
                                 int mode, int sort);
+extern int      apriori_source (APRIORI *apriori, TASRC *src,
+                                int mode, int sort);
 extern int      apriori_report (APRIORI *apriori, ISREPORT *report);
+extern int      apriori_store  (APRIORI *apriori, ISSTORE *store);
+extern void     apriori_threads(APRIORI *apriori, int thcnt);
 extern int      apriori_mine   (APRIORI *apriori, ITEM prune,
                                 double filter, int order);
+#ifdef TA_SURR
+extern int      apriori_surr   (APRIORI *apriori, ITEM prune,
+                                double filter, int order,
+                                TBGSURRFN *fn, int cnt,
+                                unsigned int seed, ISREPORT *report);
+#endif
 #endif
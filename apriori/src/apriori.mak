@@ -9,6 +9,9 @@
 #           2011.10.18 special program version apriacc added
 #           2013.10.19 modules tabread and patspec added
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 module tasrc added (transaction sources)
+#           2026.10.17 module hhsketch added (heavy hitter sketch)
+#           2026.10.17 module random added (surrogate data sets)
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\apriori\src
 UTILDIR  = ..\..\util\src
@@ -27,17 +30,20 @@ LIBS     =
 HDRS_1   = $(UTILDIR)\fntypes.h    $(UTILDIR)\arrays.h    \
            $(UTILDIR)\symtab.h     $(MATHDIR)\gamma.h     \
            $(MATHDIR)\chi2.h       $(MATHDIR)\ruleval.h   \
-           $(TRACTDIR)\tract.h     $(TRACTDIR)\report.h
+           $(TRACTDIR)\tract.h     $(TRACTDIR)\report.h   \
+           $(TRACTDIR)\tasrc.h
 HDRS     = $(HDRS_1)               $(UTILDIR)\error.h     \
            $(UTILDIR)\tabread.h    $(UTILDIR)\tabwrite.h  \
-           $(TRACTDIR)\patspec.h   istree.h
+           $(UTILDIR)\random.h     $(TRACTDIR)\patspec.h  \
+           $(TRACTDIR)\hhsketch.h  istree.h
 OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\idmap.obj   \
            $(UTILDIR)\escape.obj   $(UTILDIR)\tabread.obj \
            $(UTILDIR)\tabwrite.obj $(UTILDIR)\scform.obj  \
-           $(MATHDIR)\gamma.obj    $(MATHDIR)\chi2.obj    \
-           $(MATHDIR)\ruleval.obj  $(TRACTDIR)\tatree.obj \
-           $(TRACTDIR)\patspec.obj $(TRACTDIR)\report.obj \
-           isttat.obj
+           $(UTILDIR)\random.obj   $(MATHDIR)\gamma.obj   \
+           $(MATHDIR)\chi2.obj     $(MATHDIR)\ruleval.obj \
+           $(TRACTDIR)\tatree.obj  $(TRACTDIR)\patspec.obj \
+           $(TRACTDIR)\report.obj  $(TRACTDIR)\hhsketch.obj \
+           $(TRACTDIR)\tasrc.obj   isttat.obj
 PRGS     = apriori.exe apriacc.exe
 
 #-----------------------------------------------------------------------
@@ -96,6 +102,10 @@ $(UTILDIR)\tabwrite.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak tabwrite.obj ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(UTILDIR)\random.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak random.obj   ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(UTILDIR)\scform.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak scform.obj   ADDFLAGS="$(ADDFLAGS)"
@@ -120,10 +130,18 @@ $(TRACTDIR)\patspec.obj:
 	cd $(TRACTDIR)
 	$(MAKE) /f tract.mak patspec.obj ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(TRACTDIR)\hhsketch.obj:
+	cd $(TRACTDIR)
+	$(MAKE) /f tract.mak hhsketch.obj ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 $(TRACTDIR)\report.obj:
 	cd $(TRACTDIR)
 	$(MAKE) /f tract.mak report.obj  ADDFLAGS="$(ADDFLAGS)"
 	cd $(THISDIR)
+$(TRACTDIR)\tasrc.obj:
+	cd $(TRACTDIR)
+	$(MAKE) /f tract.mak tasrc.obj   ADDFLAGS="$(ADDFLAGS)"
+	cd $(THISDIR)
 
 #-----------------------------------------------------------------------
 # Install
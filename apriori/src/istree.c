@@ -91,6 +91,13 @@
             2014.11.14 bug in function evaluate() fixed (negative index)
             2015.02.25 bug in function r4set() fixed (ITEMOF(node))
             2016.11.19 bug in function ist_filter() fixed (path length)
+            2026.10.16 simulated cache for counter accesses (BENCH)
+            2026.10.16 function ist_counts() added (transaction source)
+            2026.10.16 function ist_countm() added (bit-parallel counting)
+            2026.10.16 closed/maximal filtering via immediate subsets
+            2026.10.16 parallel rule generation over root subtrees
+            2026.10.17 transaction weights checked in ist_countm()
+            2026.10.17 trans. bit columns built only once in ist_countm()
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -101,6 +108,9 @@
 #include "istree.h"
 #include "chi2.h"
 #include "gamma.h"
+#ifdef USE_THREADS
+#include "threads.h"
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -124,6 +134,13 @@
 #define HDONLY      ITEM_MIN    /* flag for head only item in path */
 #define ITEMOF(n)   ((ITEM)((n)->item & ~HDONLY))
 #define ISHDONLY(n) ((n)->item < 0)
+#ifdef BENCH                    /* if benchmark version */
+#define CS_LINES    512         /* number of simulated cache lines */
+#define CS_SHIFT    6           /* log2 of the cache line size */
+#define TOUCH(p)    cs_touch(p) /* note an access to a counter */
+#else                           /* if normal version */
+#define TOUCH(p)    ((void)0)   /* counter accesses are not noted */
+#endif
 #define int         1           /* to check definition of SUPP */
 #define long        2           /* for double precision type */
 #define double      3
@@ -133,7 +150,7 @@
 #define CLRSKIP(n)  ((n) = copysign((n),+1.0))
 #define IS2SKIP(n)  signbit(n)
 #define COUNT(n)    copysign((n),+1.0)
-#define INC(n,w)    ((n) += copysign((w),(n)))
+#define INC(n,w)    (TOUCH(&(n)), (n) += copysign((w),(n)))
 /* Double precision floating-point support requires the compiler   */
 /* and the underlying system to comply with the IEEE standard for  */
 /* floating-point arithmetic (IEEE 754), which allows for a number */
@@ -148,7 +165,7 @@
 #define CLRSKIP(n)  ((n) &= ~SKIP)
 #define IS2SKIP(n)  ((n) < 0)
 #define COUNT(n)    ((n) &  ~SKIP)
-#define INC(n,w)    ((n) += (w))
+#define INC(n,w)    (TOUCH(&(n)), (n) += (w))
 #endif
 #undef int                      /* remove preprocessor definitions */
 #undef long                     /* needed for the type checking */
@@ -167,9 +184,55 @@
 /* Note that not all 64 bit architectures need pointers to be aligned */
 /* to addresses divisible by 8. Use ALIGN8 only if this is the case.  */
 
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+#ifdef USE_THREADS              /* if to use threads */
+
+typedef struct {                /* --- rule generation worker --- */
+  ISTREE   tree;                /* copy of tree with own path buffer */
+  ISREPORT *rep;                /* item set reporter of the worker */
+  ISSTORE  *store;              /* store for the generated rules */
+  THRMUTEX *mutex;              /* mutex for the task counter */
+  ITEM     *next;               /* next task (index in root node) */
+  int      *owner;              /* worker that processed each task */
+  size_t   *ends;               /* end of the rules of each task */
+  int      id;                  /* identifier of the worker */
+  int      err;                 /* error indicator */
+} RULEWORK;                     /* (rule generation worker) */
+
+#endif
+
 /*----------------------------------------------------------------------
   Auxiliary Functions
 ----------------------------------------------------------------------*/
+#ifdef BENCH
+
+static size_t cs_tags[CS_LINES];/* tags of the simulated cache lines */
+static size_t cs_acc = 0;       /* number of counter accesses */
+static size_t cs_mis = 0;       /* number of simulated cache misses */
+
+/*--------------------------------------------------------------------*/
+
+static void cs_touch (const void *p)
+{                               /* --- simulate a counter access */
+  size_t a = (size_t)p >> CS_SHIFT;   /* get the cache line address */
+  size_t *t = cs_tags +(a & (CS_LINES-1));
+
+  cs_acc += 1;                  /* count the counter access */
+  if (*t == a) return;          /* if the line is cached, abort */
+  *t = a; cs_mis += 1;          /* otherwise replace the cached line */
+}  /* cs_touch() */              /* and count the cache miss */
+
+/* The counter updates in the functions count() and countx() are fed */
+/* into a direct-mapped cache with CS_LINES lines of 2^CS_SHIFT bytes */
+/* (32kB, like a typical L1 data cache), which makes it possible to   */
+/* compare how well different item codings keep the counters updated */
+/* for the same transaction together, independent of the hardware.  */
+
+#endif
+/*--------------------------------------------------------------------*/
+
 
 static ITEM search (ITEM id, ISTNODE **chn, ITEM n)
 {                               /* --- find a child node (index) */
@@ -373,6 +436,82 @@ static void count (ISTNODE *node,
   }
 }  /* count() */
 
+/*--------------------------------------------------------------------*/
+
+typedef struct {                /* --- bit-parallel counting data --- */
+  TID         wds;              /* number of words per column */
+  TID         uwd;              /* number of words with unit weights */
+  int         pls;              /* number of weight planes */
+  const BITTA *cols;            /* transaction bit columns of items */
+  const BITTA *wpl;             /* weight planes (bits of weights) */
+} BITCNT;                       /* (bit-parallel counting data) */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP bitsupp (const BITCNT *bc, const BITTA *a, const BITTA *b)
+{                               /* --- support of column intersection */
+  TID         i;                /* loop variable for words */
+  int         k;                /* loop variable for weight planes */
+  size_t      n;                /* number of set bits */
+  SUPP        s;                /* support of the intersection */
+  const BITTA *p;               /* to traverse the weight planes */
+
+  for (n = 0, i = 0; i < bc->uwd; i++)
+    n += (size_t)bt_popcnt(a[i] & b[i]);
+  s = (SUPP)n;                  /* count the set bits of the words */
+  if (bc->pls <= 0) return s;   /* with unit weight transactions */
+  for (k = 0; k < bc->pls; k++) {
+    p = bc->wpl +(size_t)k *(size_t)bc->wds;
+    for (n = 0, i = bc->uwd; i < bc->wds; i++)
+      n += (size_t)bt_popcnt(a[i] & b[i] & p[i]);
+    s += (SUPP)(n << k);        /* count the set bits per plane */
+  }                             /* and weight them with the plane */
+  return s;                     /* return the (weighted) support */
+}  /* bitsupp() */
+
+/*--------------------------------------------------------------------*/
+
+static void countm (ISTNODE *node, const BITTA *tids, BITTA *buf,
+                    const BITCNT *bc, ITEM beg)
+{                               /* --- count with transaction bits */
+  ITEM        i, k;             /* loop variable, item */
+  TID         j;                /* loop variable for words */
+  SUPP        s;                /* support of an item set */
+  BITTA       any;              /* whether intersection is not empty */
+  ITEM        *map;             /* item identifier map */
+  ISTNODE     **chn;            /* array of child nodes */
+  const BITTA *col;             /* transaction bit column of an item */
+
+  assert(node && bc && buf);    /* check the function arguments */
+  map = (node->offset >= 0) ? NULL : (ITEM*)(node->cnts +node->size);
+  if (node->chcnt == 0) {       /* if this is a new node (leaf) */
+    for (i = 0; i < node->size; i++) {
+      k = (map) ? map[i] : node->offset +i;
+      if (k < beg) continue;    /* traverse the counters */
+      col = bc->cols +(size_t)k *(size_t)bc->wds;
+      s   = bitsupp(bc, (tids) ? tids : col, col);
+      if (s != 0) INC(node->cnts[i], s);
+    } }                         /* add the support to the counter */
+  else if (node->chcnt > 0) {   /* if there are child nodes */
+    chn = (map) ? (ISTNODE**)(map +node->size)
+                : (ISTNODE**)(node->cnts +node->size);
+    ALIGN(chn);                 /* get the child node array */
+    for (i = 0; i < node->chcnt; i++) {
+      if (!chn[i]) continue;    /* traverse the existing children */
+      k = ITEMOF(chn[i]);       /* get the item of the child */
+      if (k < beg) continue;    /* and the transaction bit column */
+      col = bc->cols +(size_t)k *(size_t)bc->wds;
+      if (tids) {               /* if there is a path prefix, */
+        for (any = 0, j = 0; j < bc->wds; j++)
+          any |= buf[j] = tids[j] & col[j];
+        if (!any) continue;     /* intersect the bit columns and */
+        col = buf;              /* skip the child if the intersection */
+      }                         /* is empty (no supporting trans.) */
+      countm(chn[i], col, buf +bc->wds, bc, k+1);
+    }                           /* count the transactions */
+  }                             /* recursively for the child */
+}  /* countm() */
+
 /*--------------------------------------------------------------------*/
 #ifdef TATREEFN
 #ifdef TATCOMPACT
@@ -643,9 +782,16 @@ ISTREE* ist_create (ITEMBASE *base, int mode,
   ist->depth  = 1;
   #ifdef BENCH                  /* if benchmark version */
   ist->ndcnt  = 1; ist->ndprn = ist->mapsz = 0;
-  ist->sccnt  = ist->scnec = n; ist->scprn = 0;
+  ist->sccnt  = ist->scnec = (size_t)n; ist->scprn = 0;
   ist->cpcnt  = ist->cpnec =    ist->cpprn = 0;
+  memset(cs_tags, 0, sizeof(cs_tags));
+  cs_acc = cs_mis = 0;          /* clear the simulated cache */
   #endif                        /* initialize the benchmark variables */
+  ist->thcnt  = 1;              /* default: single thread */
+  ist->cbag   = NULL;           /* there are no trans. bit columns */
+  ist->cols   = NULL;           /* (built by ist_countm()) */
+  ist->cwds   = ist->cuwd = 0;
+  ist->cpls   = 0;
   ist_setsize(ist, 1, ITEM_MAX);
   ist_seteval(ist, IST_NONE, IST_NONE, 1, ITEM_MAX);
   ist_init(ist, 0);             /* initialize the extraction vars. */
@@ -673,7 +819,8 @@ void ist_delete (ISTREE *ist)
         t = node; node = node->succ; free(t); }
     }                           /* delete all nodes */
   }                             /* by traversing the levels */
-  free(ist->lvls);              /* delete the level array, */
+  if (ist->cols) free(ist->cols);  /* delete the bit columns, */
+  free(ist->lvls);              /* the level array, */
   free(ist->map);               /* the identifier map, */
   free(ist->buf);               /* the path buffer, */
   free(ist);                    /* and the tree body */
@@ -732,6 +879,128 @@ void ist_countx (ISTREE *ist, const TATREE *tree)
 #endif
 /*--------------------------------------------------------------------*/
 
+int ist_counts (ISTREE *ist, TASRC *src)
+{                               /* --- count a transaction source */
+  int   r;                      /* result of tsrc_next() */
+  TRACT *t;                     /* to traverse the transactions */
+
+  assert(ist && src);           /* check the function arguments */
+  if (tsrc_max(src) < ist->height)
+    return 0;                   /* check for suff. long transactions */
+  if (tsrc_rewind(src) != 0)    /* restart the transaction source */
+    return tsrc_error(src);     /* (start a new pass) */
+  while ((r = tsrc_next(src, &t)) == 0) {
+    if (ta_size(t) >= ist->height)  /* traverse the transactions */
+      count(ist->lvls[0], ta_items(t), ta_size(t), ta_wgt(t),
+            ist->height);       /* count the transaction recursively */
+  }                             /* (items are recoded and sorted) */
+  return (r < 0) ? r : 0;       /* return an error indicator */
+}  /* ist_counts() */
+
+/*--------------------------------------------------------------------*/
+
+static int bitcols (ISTREE *ist, TABAG *bag)
+{                               /* --- build transaction bit columns */
+  TID         i, n;             /* loop variable, number of trans. */
+  TID         u, o, r;          /* number of unit weight trans., pos. */
+  ITEM        k;                /* loop variable for items */
+  int         p;                /* loop variable for weight planes */
+  SUPP        w, x;             /* (maximum) transaction weight */
+  size_t      v, z;             /* weight as bit pattern, col. size */
+  BITTA       b, m;             /* bit-represented transaction, mask */
+  BITTA       *cols, *wpl;      /* trans. bit columns, weight planes */
+  const BITTA *bits;            /* bit-represented transactions */
+
+  assert(ist && bag);           /* check the function arguments */
+  if (ist->cols) { free(ist->cols); ist->cols = NULL; }
+  ist->cbag = NULL;             /* delete existing bit columns */
+  bits = tbg_bits(bag);         /* get the bit-represented trans. */
+  if (!bits) return -1;         /* (requires at most 64 items) */
+  n = tbg_cnt(bag);             /* get the number of transactions */
+  for (x = 0, u = i = 0; i < n; i++) {
+    w = ta_wgt(tbg_tract(bag, i));
+    if ((w < 0) || (w > (SUPP)TID_MAX) || (w != (SUPP)(TID)w))
+      return 1;                 /* weights must be small integers */
+    if (w > x) x = w;           /* determine the maximum weight */
+    if (w == 1) u++;            /* of a transaction and count */
+  }                             /* the transactions with unit weight */
+  ist->cpls = 0;                /* with unit weights no planes needed */
+  if (x > 1) { for (v = (size_t)x; v > 0; v >>= 1) ist->cpls++; }
+  ist->cwds = (n +63) >> 6;     /* get the number of words per column */
+  ist->cuwd = (ist->cpls > 0) ? u >> 6 : ist->cwds;
+  z    = (size_t)ist->cwds;     /* get the size of a column */
+  cols = (BITTA*)calloc(z *(size_t)(BT_MAXCNT+BT_MAXCNT +ist->cpls),
+                        sizeof(BITTA));
+  if (!cols) return -1;         /* allocate columns and buffers */
+  wpl = cols +(size_t)BT_MAXCNT *z;
+  for (o = 0, i = 0; i < n; i++) {
+    v = (size_t)ta_wgt(tbg_tract(bag, i));
+    r = (v == 1) ? o++ : u++;   /* place unit weight transactions */
+    m = (BITTA)1 << (r & 63);   /* before all other transactions */
+    for (b = bits[i], k = 0; b != 0; b >>= 1, k++)
+      if (b & 1) cols[(size_t)k *z +(size_t)(r >> 6)] |= m;
+    for (p = 0; p < ist->cpls; p++)  /* set the transaction bits */
+      if ((v >> p) & 1)         /* and the weight plane bits */
+        wpl[(size_t)p *z +(size_t)(r >> 6)] |= m;
+  }
+  ist->cols = cols;             /* note the bit columns and */
+  ist->cbag = bag;              /* the bag they were built from */
+  return 0;                     /* return 'ok' */
+}  /* bitcols() */
+
+/*--------------------------------------------------------------------*/
+
+int ist_countm (ISTREE *ist, TABAG *bag)
+{                               /* --- count with transaction bits */
+  int    r;                     /* result of bitcols() */
+  BITCNT bc;                    /* bit-parallel counting data */
+
+  assert(ist && bag);           /* check the function arguments */
+  if (tbg_max(bag) < ist->height)
+    return 0;                   /* check for suff. long transactions */
+  if (ist->cbag != bag) {       /* if no bit columns for the bag, */
+    r = bitcols(ist, bag);      /* build the transaction bit columns */
+    if (r != 0) return r;       /* (transposed bit-represented trans.) */
+  }
+  bc.wds  = ist->cwds;          /* get the bit-parallel counting data */
+  bc.uwd  = ist->cuwd;          /* (number of words per column etc.) */
+  bc.pls  = ist->cpls;
+  bc.cols = ist->cols;
+  bc.wpl  = ist->cols +(size_t)BT_MAXCNT *(size_t)bc.wds;
+  countm(ist->lvls[0], NULL, ist->cols +(size_t)(BT_MAXCNT +bc.pls)
+                                       *(size_t)bc.wds, &bc, 0);
+  return 0;                     /* count the transactions */
+}  /* ist_countm() */
+
+/*----------------------------------------------------------------------
+Bit-parallel counting can be used if there are at most 64 items. The
+transactions are represented by bit masks (see tbg_bits()), which are
+transposed into one bit column per item (bit i of the column of item
+k is set if transaction i contains item k). The support of an item set
+is then obtained by intersecting the bit columns of its items (which
+is done incrementally along the paths in the item set tree) and
+counting the set bits. Transaction weights (which result from
+combining equal transactions) are handled by splitting them into
+their binary digits: each digit yields a weight plane, in which the
+bits of all transactions are set that have this binary digit set.
+The bit count of an intersection with a weight plane is multiplied
+by the value of the corresponding binary digit. Since usually most
+transactions have unit weight, these transactions are placed first,
+so that the words that contain only such transactions can be counted
+without the weight planes. This requires integer transaction weights
+(which need not be the case if SUPP is double). If a weight is not a
+non-negative integer (or too large), the function returns 1 without
+counting, so that the caller can fall back to ist_countb().
+The bit columns (together with the weight planes and the buffers for
+the intersections) are built on the first call and kept in the item
+set tree, so that they are not rebuilt for every level. They are
+rebuilt only if the function is called with a different bag, and are
+deleted with the tree. Hence the bag must not be changed between the
+calls (for example, it must not be filtered or reduced).
+----------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+
 void ist_commit (ISTREE *ist)
 {                               /* --- commit transaction counting */
   ITEM    i;                    /* loop variable, counter index */
@@ -834,8 +1103,8 @@ void ist_prune (ISTREE *ist)
       node->size = ++n-i;       /* set the new node size */
       #ifdef BENCH              /* if benchmark version */
       k = node->size -(n-i);    /* get the number of pruned counters */
-      ist->sccnt -= k;          /* update the number of counters */
-      ist->scprn += k;          /* and of pruned counters */
+      ist->sccnt -= (size_t)k;  /* update the number of counters */
+      ist->scprn += (size_t)k;  /* and of pruned counters */
       #endif                    /* update the memory usage */
       if (i > 0) {              /* if there are leading infreq. items */
         node->offset += i;      /* set the new item offset */
@@ -850,9 +1119,9 @@ void ist_prune (ISTREE *ist)
       k = node->size -n;        /* get the number of pruned counters */
       if (k <= 0) continue;     /* if no items were pruned, continue */
       #ifdef BENCH              /* if benchmark version, */
-      ist->sccnt -= k;          /* update the number of counters */
-      ist->scprn += k;          /* and of pruned counters */
-      ist->mapsz -= k;          /* update the total item map size */
+      ist->sccnt -= (size_t)k;  /* update the number of counters */
+      ist->scprn += (size_t)k;  /* and of pruned counters */
+      ist->mapsz -= (size_t)k;  /* update the total item map size */
       #endif
       node->size = n;           /* set the new node size */
       memmove(c+n, map, (size_t)n *sizeof(ITEM));
@@ -873,8 +1142,8 @@ void ist_prune (ISTREE *ist)
       node->chcnt = ++n-i;      /* set the new number of children */
       #ifdef BENCH              /* if benchmark version, */
       k = node->chcnt -(n-i);   /* get the number of pruned pointers */
-      ist->cpcnt -= k;          /* update the number of pointers */
-      ist->cpprn += k;          /* and of pruned pointers */
+      ist->cpcnt -= (size_t)k;  /* update the number of pointers */
+      ist->cpprn += (size_t)k;  /* and of pruned pointers */
       #endif
       for (k = 0; i < n; i++)   /* remove all empty children */
         chn[k++] = (chn[i] && (chn[i]->size > 0)) ? chn[i] : NULL; }
@@ -887,8 +1156,8 @@ void ist_prune (ISTREE *ist)
       node->chcnt = k;          /* set the new number of children */
       #ifdef BENCH              /* if benchmark version, */
       n -= k;                   /* get the number of pruned pointers */
-      ist->cpcnt -= n;          /* update the number of pointers */
-      ist->cpprn += n;          /* and of pruned pointers */
+      ist->cpcnt -= (size_t)n;  /* update the number of pointers */
+      ist->cpprn += (size_t)n;  /* and of pruned pointers */
       #endif
     }
     if (node->chcnt <= 0)       /* if all children were removed, */
@@ -973,15 +1242,15 @@ static ISTNODE* child (ISTREE *ist, ISTNODE *node, ITEM index, SUPP pex)
   }                             /* note the item identifier */
   if (m <= 0) return NULL;      /* if no child is needed, abort */
   #ifdef BENCH                  /* if benchmark version, */
-  ist->scnec += m;              /* sum the necessary counters */
+  ist->scnec += (size_t)m;      /* sum the necessary counters */
   #endif
 
   /* --- decide on node structure --- */
   n = ist->map[m-1] -ist->map[0] +1;
   k = (m+m < n) ? n = m : 0;    /* compute the range of items */
   #ifdef BENCH                  /* if benchmark version, */
-  ist->sccnt += n;              /* sum the number of counters */
-  ist->mapsz += k;              /* sum the size of the maps */
+  ist->sccnt += (size_t)n;      /* sum the number of counters */
+  ist->mapsz += (size_t)k;      /* sum the size of the maps */
   ist->ndcnt += 1;              /* count the node to be created */
   #endif
 
@@ -1075,7 +1344,7 @@ static ISTNODE** children (ISTREE *ist, ISTNODE **np, ISTNODE **end)
   if (n <= 0) {                 /* if no child node was created, */
     node->chcnt = ITEM_MIN; return end; }       /* skip the node */
   #ifdef BENCH                  /* if benchmark version, */
-  ist->cpnec += n;              /* sum the number of */
+  ist->cpnec += (size_t)n;      /* sum the number of */
   #endif                        /* necessary child pointers */
   chn = np; par = node->parent; /* get the parent node */
   if (par) {                    /* if there is a parent node */
@@ -1107,7 +1376,7 @@ static ISTNODE** children (ISTREE *ist, ISTNODE **np, ISTNODE **end)
   *np = *chn = node;            /* update the node pointer and */
   node->chcnt = n;              /* note the number of children */
   #ifdef BENCH                  /* if benchmark version, */
-  ist->cpcnt += n;              /* sum the number of child pointers */
+  ist->cpcnt += (size_t)n;      /* sum the number of child pointers */
   #endif                        /* (whether necessary or not) */
   if (node->offset >= 0) {      /* if a pure array is used */
     chn = (ISTNODE**)(node->cnts +node->size);
@@ -1483,15 +1752,48 @@ static void clear (ISTNODE *node, ITEM *items, ITEM n, SUPP supp)
 
 /*--------------------------------------------------------------------*/
 
+static void mark (ISTNODE *node, ITEM *items, ITEM n, SUPP supp)
+{                               /* --- set an item set flag */
+  ITEM    i, k;                 /* array index, number of children */
+  ISTNODE **chn;                /* child node array */
+
+  assert(node                   /* check the function arguments */
+  &&    (n >= 0) && (items || (n <= 0)));
+  for ( ; --n > 0; items++) {   /* follow the set/path from the node */
+    k = CHILDCNT(node);         /* if there are no children, */
+    if (k <= 0) return;         /* the item set does not exist */
+    if (node->offset >= 0) {    /* if a pure array is used */
+      chn = (ISTNODE**)(node->cnts +node->size);
+      ALIGN(chn);               /* get the child node array */
+      i = *items -ITEMOF(chn[0]);
+      if (i >= k) return; }     /* compute the child array index */
+    else {                      /* if an identifier map is used */
+      chn = (ISTNODE**)((ITEM*)(node->cnts +node->size) +node->size);
+      ALIGN(chn);               /* get the child node array */
+      i = search(*items, chn, k);
+    }                           /* find the child array index */
+    if ((i < 0) || !(node = chn[i]))
+      return;                   /* go to the corresponding child */
+  }                             /* (if it exists) */
+  k = node->size;               /* get the number of counters */
+  if (node->offset >= 0) {      /* if a pure array is used, */
+    i = *items -node->offset;   /* compute the counter index and */
+    if (i >= k) return; }       /* check whether counter exists */
+  else                          /* if an identifier map is used */
+    i = ia_bsearch(*items, (ITEM*)(node->cnts +k), (size_t)k);
+  if (i < 0) return;            /* if no counter exists, abort */
+  if (node->cnts[i] <= supp)    /* if the support is low enough, */
+    SETSKIP(node->cnts[i]);     /* set skip flag of the item set */
+}  /* mark() */
+
+/*--------------------------------------------------------------------*/
+
 void ist_clomax (ISTREE *ist, int target)
 {                               /* --- filter for closed/maximal sets */
   ITEM    i, k, n, h;           /* loop variables, buffers */
-  ITEM    item;                 /* buffer for an item */
   SUPP    supp;                 /* minimum support for a superset */
-  ITEM    *map;                 /* item identifier map */
-  ITEM    *path;                /* path to access superset support */
+  ITEM    *path;                /* path to access subset support */
   ISTNODE *node, *curr;         /* to traverse the nodes */
-  ISTNODE **chn;                /* child node array */
 
   assert(ist);                  /* check the function argument */
   if (!ist->valid)              /* if the levels are not valid, */
@@ -1566,98 +1868,38 @@ void ist_clomax (ISTREE *ist, int target)
   for (i = node->size; --i >= 0; )  /* mark empty set if necessary */
     if (node->cnts[i] >= supp) { SETSKIP(ist->wgt); break; }
 
-  /* --- process intermediate levels --- */
-  supp = SUPP_MAX;              /* set default support filter (max.) */
-  for (h = 0; h < ist->height-1; h++) {   /* traverse the tree levels */
+  /* --- process the tree levels --- */
+  node = ist->lvls[0];          /* traverse the root node elements */
+  for (i = node->size; --i >= 0; )
+    if (node->cnts[i] < ist->smin)
+      SETSKIP(node->cnts[i]);   /* mark infrequent single items */
+  for (h = 1; h < ist->height; h++) {  /* traverse the tree levels */
     for (node = ist->lvls[h]; node; node = node->succ) {
       for (i = node->size; --i >= 0; ) {  /* traverse the nodes */
-        if (node->cnts[i] < ist->smin) {  /* check for min. support */
+        supp = node->cnts[i];   /* get the support of the set */
+        if (supp < ist->smin) { /* check for minimum support */
           SETSKIP(node->cnts[i]); continue; }
-        item = ITEMAT(node, i); /* get item and min. superset support */
-        supp = (target & IST_MAXIMAL) ? ist->smin : node->cnts[i];
-
-        /* -- check supersets in child -- */
-        n = CHILDCNT(node);     /* get the number of children */
-        if (n > 0) {            /* if there are child nodes */
-          if (node->offset >= 0) { /* if pure array is used */
-            chn  = (ISTNODE**)(node->cnts +node->size);
-            ALIGN(chn);         /* get the child node array */
-            k    = item -ITEMOF(chn[0]);
-            curr = ((k < 0) || (k >= n)) ? NULL : chn[k]; }
-          else {                /* if an identifier map is used */
-            chn  = (ISTNODE**)((ITEM*)(node->cnts +node->size)
-                                                  +node->size);
-            ALIGN(chn);         /* get the child node array */
-            k    = search(item, chn, n);
-            curr = (k < 0)               ? NULL : chn[k];
-          }                     /* get child node for current item */
-          if (curr) {           /* if the child node exists */
-            for (k = curr->size; --k >= 0; )
-              if (curr->cnts[k] >= supp) break;
-            if (k >= 0) { SETSKIP(node->cnts[i]); continue; }
-          }                     /* if a superset in the tail has */
-        }                       /* sufficient support, mark set */
-
-        /* -- check other supersets -- */
-        path = ist->buf +ist->height +1;
-        *--path = item;         /* init. the path for lookups and */
-        n = 1;                  /* traverse the path to the root */
-        if (ist->mode & IST_REVERSE) {
-          for (curr = node; curr; curr = curr->parent) {
-            if (curr->offset >= 0) {   /* if a pure array is used */
-              k = *path -curr->offset; /* get index of current item */
-              while (++k < curr->size) {  /* traverse succ. items */
-                path[-1] = curr->offset +k;
-                if (getsupp(curr, path-1, n+1) >= supp) break;
-              } }               /* if a superset qualifies, abort */
-            else {              /* if an identifier map is used */
-              map = (ITEM*)(curr->cnts +(k = curr->size));
-              k   = ia_bisect(*path, map, (size_t)k);
-              while (++k < curr->size) {  /* traverse succ. items */
-                path[-1] = ((ITEM*)(curr->cnts +curr->size))[k];
-                if (getsupp(curr, path-1, n+1) >= supp) break;
-              }                 /* if a superset qualifies, abort */
-            }
-            if (k < curr->size) /* if a superset has been found, */
-              break;            /* abort the search */
-            if (path <= ist->buf) { curr = NULL; break; }
-            *--path = ITEMOF(curr); n += 1;
-          } }                   /* extend the item set suffix/path */
-        else {
-          for (curr = node; curr; curr = curr->parent) {
-            if (curr->offset >= 0) {   /* if a pure array is used */
-              k = *path -curr->offset; /* get index of current item */
-              if (k > curr->size) k = curr->size;
-              while (--k >= 0){ /* traverse the preceding items */
-                path[-1] = curr->offset +k;
-                if (getsupp(curr, path-1, n+1) >= supp) break;
-              } }               /* if a superset qualifies, abort */
-            else {              /* if an identifier map is used */
-              map = (ITEM*)(curr->cnts +(k = curr->size));
-              k   = ia_bisect(*path, map, (size_t)k);
-              while (--k >= 0){ /* traverse the preceding items */
-                path[-1] = ((ITEM*)(curr->cnts +curr->size))[k];
-                if (getsupp(curr, path-1, n+1) >= supp) break;
-              }                 /* if a superset qualifies, abort */
-            }
-            if (k >= 0)         /* if a superset has been found, */
-              break;            /* abort the search */
-            if (path <= ist->buf) { curr = NULL; break; }
-            *--path = ITEMOF(curr); n += 1;
-          }                     /* extend the item set suffix/path */
-        }
-        if (curr) SETSKIP(node->cnts[i]);
-      }                         /* if frequent/equal support superset */
-    }                           /* was found, the current item set */
-  }                             /* is not closed/maximal, resp. */
-
-  /* --- process deepest level --- */
-  for (node = ist->lvls[h]; node; node = node->succ)
-    for (i = node->size; --i >= 0; )
-      if (node->cnts[i] < ist->smin)
-        SETSKIP(node->cnts[i]); /* mark infrequent item sets only */
-  /* All frequent item sets on the deepest level tree must be closed */
-  /* and maximal, because they do not have supersets (in the tree).  */
+        if (target & IST_MAXIMAL) supp = SUPP_MAX;
+        curr = node->parent;    /* get parent of the current node */
+        path = ist->buf +ist->height;
+        *--path = ITEMAT(node, i); /* mark item corresp. to index */
+        mark(curr, path, 1, supp);
+        *--path = ITEMOF(node);    /* mark item corresp. to node */
+        mark(curr, path, 1, supp);
+        for (n = 1; curr->parent; curr = curr->parent) {
+          mark(curr->parent, path, ++n, supp);
+          *--path = ITEMOF(curr);
+        }                       /* climb up the tree and mark */
+      }                         /* all n-1 subsets as not closed */
+    }                           /* (not maximal) if their support */
+  }                             /* does not exceed the value of supp */
+  /* Instead of checking for each item set all possible one item     */
+  /* supersets (which requires a lookup for every item that may be   */
+  /* added), each frequent item set marks its immediate subsets,     */
+  /* which requires only as many lookups as the set has items. Since */
+  /* the levels are processed top down and an item set is marked     */
+  /* only while its supersets are processed, the support of an item  */
+  /* set is always read before its skip flag is set by this loop.    */
 }  /* ist_clomax() */
 
 /*--------------------------------------------------------------------*/
@@ -2106,6 +2348,132 @@ static int rules (ISTREE *ist, ISREPORT *rep, ISTNODE *node)
   return 0;                     /* return 'ok' */
 }  /* rules() */
 
+/*--------------------------------------------------------------------*/
+#ifdef USE_THREADS
+
+static WORKERDEF(rulework, p)
+{                               /* --- rule generation worker */
+  RULEWORK *w = (RULEWORK*)p;   /* type the worker data */
+  ISTREE   *ist = &w->tree;     /* item set tree to work on */
+  ISTNODE  *root;               /* root node of the tree */
+  ISTNODE  **chn;               /* child node array of the root */
+  ITEM     i, k, c, off;        /* task index, buffers, item offset */
+  SUPP     supp;                /* support of current item */
+
+  root = ist->lvls[0];          /* get the root node and */
+  chn  = (ISTNODE**)(root->cnts +root->size);
+  ALIGN(chn);                   /* its child node array */
+  c    = CHILDCNT(root);        /* and the number of children */
+  off  = (c > 0) ? ITEMOF(chn[0]) : 0;
+  while (!w->err) {             /* while there is no error */
+    thr_lock(w->mutex);         /* get the next task */
+    i = (*w->next)++;           /* (i.e. the next item */
+    thr_unlock(w->mutex);       /* of the root node) */
+    if (i >= root->size) break; /* check for more tasks */
+    w->owner[i] = w->id;        /* note the processing worker */
+    supp = COUNT(root->cnts[i]);
+    if (supp >= ist->smin) {    /* if the item is frequent */
+      k = root->offset +i;      /* compute the item identifier */
+      isr_add(w->rep, k, supp); /* add the item to the reporter */
+      k -= off;                 /* compute the child node index */
+      if ((k >= 0)              /* if the corresp. child node exists, */
+      &&  (k <  c) && chn[k]    /* recursively report the subtree */
+      &&  (rules(ist, w->rep, chn[k]) < 0)) w->err = -1;
+      if (r4set(ist, w->rep, root, i) < 0) w->err = -1;
+      isr_remove(w->rep, 1);    /* report rules for the item */
+    }                           /* and remove it again */
+    if (iss_error(w->store)) w->err = -1;
+    w->ends[i] = iss_cnt(w->store);
+  }                             /* note the end of the task's rules */
+  return THREAD_OK;             /* return a dummy result */
+}  /* rulework() */
+
+/*--------------------------------------------------------------------*/
+
+static int prules (ISTREE *ist, ISREPORT *rep)
+{                               /* --- parallel rule reporting */
+  int      i, n;                /* loop variable, number of threads */
+  int      r = 0;               /* result of function call */
+  ITEM     k, next = 0;         /* loop variable, next task */
+  ITEM     cnt;                 /* number of tasks (root items) */
+  size_t   x;                   /* loop variable for rules */
+  size_t   pos[THR_MAX];        /* read positions in the stores */
+  int      *owner;              /* worker that processed each task */
+  size_t   *ends;               /* end of the rules of each task */
+  ISSTORE  *s;                  /* store to read rules from */
+  THRMUTEX mutex;               /* mutex for the task counter */
+  RULEWORK *w;                  /* data of the rule workers */
+
+  assert(ist && rep);           /* check the function arguments */
+  n   = (ist->thcnt > 0) ? ist->thcnt : thr_cnt();
+  cnt = ist->lvls[0]->size;     /* get the number of threads */
+  if (n > THR_MAX)    n = THR_MAX;   /* and the number of tasks */
+  if (n > (int)cnt)   n = (int)cnt;  /* (one task per item */
+  if (n <= 1) return rules(ist, rep, ist->lvls[0]); /* in the root) */
+  w     = (RULEWORK*)calloc((size_t)n, sizeof(RULEWORK));
+  owner = (int*)     malloc((size_t)cnt *sizeof(int));
+  ends  = (size_t*)  malloc((size_t)cnt *sizeof(size_t));
+  if (!w || !owner || !ends) r = -1;
+  for (i = 0; (r == 0) && (i < n); i++) {
+    w[i].tree   = *ist;         /* traverse the workers */
+    w[i].tree.buf = (ITEM*)malloc((size_t)(ist->height+1)
+                                  *sizeof(ITEM));
+    w[i].rep    = isr_createx(isr_base(rep), isr_size(rep));
+    w[i].store  = iss_create(ISS_RULES);
+    if (!w[i].tree.buf || !w[i].rep || !w[i].store) { r = -1; break; }
+    isr_setsupp (w[i].rep, isr_smin(rep), isr_smax(rep));
+    isr_setsize (w[i].rep, isr_zmin(rep), isr_zmax(rep));
+    isr_setstore(w[i].rep, w[i].store);
+    w[i].mutex  = &mutex; w[i].next = &next;
+    w[i].owner  = owner;  w[i].ends = ends;
+    w[i].id     = i;      w[i].err  = 0;
+  }                             /* create a reporter and a store */
+  if (r == 0) {                 /* if all workers could be created */
+    thr_mxinit(&mutex);         /* initialize the task counter mutex */
+    if (thr_run(rulework, w, sizeof(RULEWORK), n) != 0) r = -1;
+    thr_mxfree(&mutex);         /* generate rules in parallel */
+    for (i = 0; i < n; i++) {   /* check the workers for errors */
+      if (w[i].err) r = -1;     /* and initialize the positions */
+      pos[i] = 0;               /* for reading the rules */
+    }
+  }
+  for (k = 0; (r == 0) && (k < cnt); k++) {
+    s = w[i = owner[k]].store;  /* traverse the tasks in item order */
+    for (x = pos[i]; x < ends[k]; x++) {
+      r = isr_rule(rep, iss_items(s, x), iss_size(s, x),
+                   iss_supp(s, x), iss_body(s, x), iss_head(s, x),
+                   iss_eval(s, x));
+      if (r < 0) break;         /* report the rules of the task */
+    }                           /* in the order of the sequential */
+    pos[i] = ends[k];           /* version (concatenate the rules */
+  }                             /* of the tasks in item order) */
+  for (i = n; --i >= 0; ) {     /* traverse the workers */
+    if (!w) break;              /* and delete their data */
+    if (w[i].store)    iss_delete(w[i].store);
+    if (w[i].rep)      isr_delete(w[i].rep, 0);
+    if (w[i].tree.buf) free(w[i].tree.buf);
+  }
+  if (ends)  free(ends);        /* delete the task arrays */
+  if (owner) free(owner);       /* and the worker data */
+  if (w)     free(w);
+  return r;                     /* return the error status */
+}  /* prules() */
+
+/*----------------------------------------------------------------------
+The function prules() distributes the items of the root node (that is,
+the subtrees of the item set tree below them) as tasks over a set of
+worker threads. Each worker has its own item set reporter without an
+output file, which collects the generated rules in an item set store.
+Tasks are assigned dynamically (next unprocessed root item), because
+the subtrees differ greatly in size. Since the tree is not modified
+while rules are generated, no locking is needed apart from the task
+counter; each worker only needs its own path buffer (used in r4set()).
+Afterwards the stored rules are passed to the actual reporter in the
+order of the root items, which yields the same output (rule order) as
+the sequential function rules(), independent of the number of threads
+and of the assignment of tasks to threads.
+----------------------------------------------------------------------*/
+#endif
 /*--------------------------------------------------------------------*/
 
 int ist_report (ISTREE *ist, ISREPORT *rep, int target)
@@ -2117,8 +2485,13 @@ int ist_report (ISTREE *ist, ISREPORT *rep, int target)
 
   assert(ist && rep);           /* check the function arguments */
   if (target & ISR_RULES) {     /* if to report association rules */
-    if (!ist->order)            /* if no size order is requested */
-      r = rules(ist, rep, ist->lvls[0]);
+    if (!ist->order) {          /* if no size order is requested */
+      #ifdef USE_THREADS        /* if to use threads */
+      if ((ist->thcnt != 1) && (ist->lvls[0]->offset >= 0))
+        r = prules(ist, rep);   /* generate rules in parallel */
+      else                      /* (over root subtrees) */
+      #endif
+      r = rules(ist, rep, ist->lvls[0]); }
     else {                      /* if a size order is requested */
       while (1) {               /* extract assoc. rules from tree */
         k = ist_rule(ist, ist->map, &supp, &body, &head, &val);
@@ -2176,6 +2549,8 @@ void ist_stats (ISTREE *ist)
   printf("number of child pointers   : %"SIZE_FMT"\n", ist->cpcnt);
   printf("necessary child pointers   : %"SIZE_FMT"\n", ist->cpnec);
   printf("pruned    child pointers   : %"SIZE_FMT"\n", ist->cpprn);
+  printf("number of counter updates  : %"SIZE_FMT"\n", cs_acc);
+  printf("simulated cache misses     : %"SIZE_FMT"\n", cs_mis);
 }  /* ist_stats() */
 
 #endif
@@ -43,6 +43,10 @@
             2014.08.01 minimum improvement of evaluation measure removed
             2014.08.14 function ist_addchn() and related functions added
             2014.08.21 parameter 'body' added to function ist_create()
+            2026.10.16 function ist_counts() added (transaction source)
+            2026.10.16 function ist_countm() added (bit-parallel counting)
+            2026.10.16 function ist_setthcnt() added (parallel rules)
+            2026.10.17 trans. bit columns kept in the item set tree
 ----------------------------------------------------------------------*/
 #ifndef __ISTREE__
 #define __ISTREE__
@@ -50,6 +54,7 @@
 #include <limits.h>
 #include "ruleval.h"
 #include "report.h"
+#include "tasrc.h"
 
 /*----------------------------------------------------------------------
   Preprocessor Definitions
@@ -120,6 +125,12 @@ typedef struct {                /* --- item set tree --- */
   ITEM     *path;               /* current path / (partial) item set */
   int      hdonly;              /* head only item in current set */
   ITEM     *map;                /* to create identifier maps */
+  int      thcnt;               /* number of threads for rules */
+  TABAG    *cbag;               /* bag of the trans. bit columns */
+  BITTA    *cols;               /* trans. bit columns (ist_countm()) */
+  TID      cwds;                /* number of words per column */
+  TID      cuwd;                /* number of words with unit weights */
+  int      cpls;                /* number of weight planes */
 #ifdef BENCH                    /* if benchmark version */
   size_t   ndcnt;               /* number of item set tree nodes */
   size_t   ndprn;               /* number of pruned tree nodes */
@@ -146,6 +157,8 @@ extern void      ist_count   (ISTREE *ist,
                               const ITEM *items, ITEM n, SUPP wgt);
 extern void      ist_countt  (ISTREE *ist, const TRACT  *tract);
 extern void      ist_countb  (ISTREE *ist, const TABAG  *bag);
+extern int       ist_counts  (ISTREE *ist, TASRC *src);
+extern int       ist_countm  (ISTREE *ist, TABAG  *bag);
 #ifdef TATREEFN
 extern void      ist_countx  (ISTREE *ist, const TATREE *tree);
 #endif
@@ -180,6 +193,7 @@ extern void      ist_setsize (ISTREE *ist, ITEM zmin, ITEM zmax);
 extern void      ist_seteval (ISTREE *ist, int eval, int agg,
                               double thresh, ITEM prune);
 
+extern void      ist_setthcnt(ISTREE *ist, int thcnt);
 extern void      ist_init    (ISTREE *ist, int order);
 extern ITEM      ist_iset    (ISTREE *ist, ITEM *items, SUPP *supp,
                               double *eval);
@@ -208,6 +222,7 @@ extern void      ist_show    (ISTREE *ist);
 #define ist_getwgt(t)     ((t)->wgt & ~SUPP_MIN)
 #define ist_setwgt(t,n)   ((t)->wgt = (n))
 #define ist_incwgt(t,n)   ((t)->wgt = ((t)->wgt & ~SUPP_MIN) +(n))
+#define ist_setthcnt(t,n) ((t)->thcnt = (n))
 #define ist_depth(t)      ((t)->depth)
 #define ist_xable(t,n)    ((t)->depth+(n) <= (t)->zmax)
 
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+if [[ "$1" == "-h" ]]; then
+  echo "usage: check.sh [bindir]"
+  echo "bindir  directory with the programs dti and dtp"
+  echo "        (default: programs are searched in the path)"
+  exit
+fi
+
+bin=${1:+$1/}
+tmp=check.tmp
+
+rm -rf $tmp; mkdir $tmp
+${bin}dti -a drug.dom drug.tab $tmp/drug.dt 2>/dev/null
+${bin}dti -cAge -evar -s drug.dom drug.tab $tmp/drug.rt 2>/dev/null
+${bin}dti iris.dom iris.tab $tmp/iris.dt 2>/dev/null
+${bin}dti -s monk1.dom monk1.tab $tmp/monk1.dt 2>/dev/null
+${bin}dtp $tmp/monk1.dt $tmp/monk1.pdt monk1.tab 2>/dev/null
+${bin}dti vote.dom vote.tab $tmp/vote.dt 2>/dev/null
+${bin}dtp $tmp/vote.dt $tmp/vote.pdt 2>/dev/null
+${bin}dti wine.dom wine.tab $tmp/wine.dt 2>/dev/null
+
+err=0
+for f in drug.dt drug.rt iris.dt monk1.dt monk1.pdt \
+         vote.dt vote.pdt wine.dt; do
+  if cmp -s $f $tmp/$f; then echo "$f: ok"
+  else                       echo "$f: differs"; err=1; fi
+done
+rm -rf $tmp
+exit $err
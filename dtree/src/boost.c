@@ -0,0 +1,669 @@
+/*----------------------------------------------------------------------
+  File    : boost.c
+  Contents: boosted regression trees management
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <assert.h>
+#include "boost.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define BLKSIZE     256         /* block size for the arrays */
+
+/* --- error messages --- */
+/* error codes 0 to -15 defined in scanner.h */
+#define E_ATTEXP    (-16)       /* attribute expected */
+#define E_UNKATT    (-17)       /* unknown attribute */
+#define E_VALEXP    (-18)       /* attribute value expected */
+#define E_UNKVAL    (-19)       /* unknown attribute value */
+#define E_DUPVAL    (-20)       /* duplicate attribute value */
+#define E_LOSS      (-21)       /* unknown/invalid loss function */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- boosted trees output info --- */
+  FILE    *file;                /* output file */
+  int     ind;                  /* indentation (in characters) */
+  int     pos;                  /* position in output line */
+  int     max;                  /* maximal line length */
+  char    buf[4*AS_MAXLEN+64];  /* output buffer */
+} DBOUT;                        /* (boosted trees output info) */
+
+/*----------------------------------------------------------------------
+  Constants
+----------------------------------------------------------------------*/
+static const char *lossnames[] = {
+  "squared",                    /* LS_SQUARED  */
+  "logistic",                   /* LS_LOGISTIC */
+  "multinomial",                /* LS_MULTI    */
+};
+
+#ifdef DB_PARSE
+static const char *msgs[] = {   /* error messages */
+  /*      0 to  -7 */  NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+  /*     -8 to -15 */  NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+  /* E_ATTEXP  -16 */  "#attribute expected instead of '%s'",
+  /* E_UNKATT  -17 */  "#unknown attribute '%s'",
+  /* E_VALEXP  -18 */  "#attribute value expected instead of '%s'",
+  /* E_UNKVAL  -19 */  "#unknown attribute value '%s'",
+  /* E_DUPVAL  -20 */  "#duplicate attribute value '%s'",
+  /* E_LOSS    -21 */  "#invalid loss function '%s'",
+};
+#endif
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+DTBOOST* db_create (ATTSET *attset, ATTID trgid, int loss,
+                    double rate, const double *init)
+{                               /* --- create boosted trees */
+  VALID   c, k;                 /* loop variable, number of scores */
+  VALID   clscnt;               /* number of classes */
+  int     type;                 /* type of the target attribute */
+  DTBOOST *db;                  /* created boosted trees */
+
+  assert(attset && (trgid >= 0) && (trgid < as_attcnt(attset)));
+  type   = att_type(as_att(attset, trgid));
+  clscnt = (type == AT_NOM) ? att_valcnt(as_att(attset, trgid)) : 0;
+  if ((type == AT_NOM)          /* check the loss function */
+  ?   ((loss != LS_MULTI) && ((loss != LS_LOGISTIC) || (clscnt != 2)))
+  :   (loss != LS_SQUARED))     /* (squared error for a metric, */
+    return NULL;                /* logistic/multinomial loss */
+  k  = (loss == LS_MULTI) ? clscnt : 1;     /* for a nominal target) */
+  db = (DTBOOST*)malloc(sizeof(DTBOOST));
+  if (!db) return NULL;         /* create the base structure */
+  db->init = (double*)malloc((size_t)(k+k+2) *sizeof(double));
+  if (!db->init) { free(db); return NULL; }
+  db->scrs   = db->init +k;     /* create the score buffers */
+  db->attset = attset;          /* note the attribute set, */
+  db->trgid  = trgid;           /* the target's id, */
+  db->target = as_att(attset, trgid);  /* the target attribute, */
+  db->type   = type;            /* the target's type, */
+  db->loss   = loss;            /* the loss function, */
+  db->k      = k;               /* the number of scores, */
+  db->rate   = rate;            /* and the learning rate */
+  for (c = 0; c < k; c++)       /* copy the initial scores */
+    db->init[c] = (init) ? init[c] : 0;
+  db->cnt   = db->size  = 0; db->roots = NULL;
+  db->ncnt  = db->nsize = 0; db->nodes = NULL;
+  db->kcnt  = db->ksize = 0; db->kids  = NULL;
+  return db;                    /* return the created boosted trees */
+}  /* db_create() */
+
+/*--------------------------------------------------------------------*/
+
+void db_delete (DTBOOST *db, int delas)
+{                               /* --- delete boosted trees */
+  assert(db);                   /* check the function argument */
+  if (db->kids)  free(db->kids);     /* delete the child indices, */
+  if (db->nodes) free(db->nodes);    /* the nodes, */
+  if (db->roots) free(db->roots);    /* and the root indices */
+  if (delas) as_delete(db->attset);  /* delete attribute set */
+  free(db->init);               /* delete the score buffers */
+  free(db);                     /* and the base structure */
+}  /* db_delete() */
+
+/*--------------------------------------------------------------------*/
+
+static int newnode (DTBOOST *db)
+{                               /* --- get a new node */
+  int    n;                     /* new size of the node array */
+  DBNODE *p;                    /* new node array */
+
+  assert(db);                   /* check the function argument */
+  if (db->ncnt >= db->nsize) {  /* if the node array is full */
+    n = db->nsize +((db->nsize > BLKSIZE) ? db->nsize : BLKSIZE);
+    p = (DBNODE*)realloc(db->nodes, (size_t)n *sizeof(DBNODE));
+    if (!p) return -1;          /* enlarge the node array */
+    db->nodes = p; db->nsize = n;
+  }                             /* set the new array */
+  return db->ncnt++;            /* return the index of the new node */
+}  /* newnode() */
+
+/*--------------------------------------------------------------------*/
+
+static int newkids (DTBOOST *db, VALID cnt)
+{                               /* --- get new child indices */
+  int i, n;                     /* loop variable, new array size */
+  int *p;                       /* new child index array */
+
+  assert(db && (cnt > 0));      /* check the function arguments */
+  if (db->kcnt +cnt > db->ksize) { /* if the array is too small */
+    n = db->ksize +((db->ksize > BLKSIZE) ? db->ksize : BLKSIZE);
+    if (n < db->kcnt +cnt) n = db->kcnt +cnt;
+    p = (int*)realloc(db->kids, (size_t)n *sizeof(int));
+    if (!p) return -1;          /* enlarge the child index array */
+    db->kids = p; db->ksize = n;
+  }                             /* set the new array */
+  for (i = 0; i < cnt; i++)     /* clear the new child indices */
+    db->kids[db->kcnt+i] = -1;  /* (no child for any branch) */
+  db->kcnt += cnt;              /* return the index of the first */
+  return db->kcnt -cnt;         /* of the new child indices */
+}  /* newkids() */
+
+/*--------------------------------------------------------------------*/
+
+static int convert (DTBOOST *db, DTREE *dt)
+{                               /* --- convert the current node */
+  int    i, x, c, r;            /* node index, child indices */
+  VALID  b, d, n;               /* branch index, destination, size */
+  DBNODE *node;                 /* created node */
+
+  assert(db && dt);             /* check the function arguments */
+  i = newnode(db);              /* create a new node */
+  if (i < 0) return -1;         /* (nodes are in pre-order) */
+  node = db->nodes +i;          /* note the value of the node */
+  node->val = (DTFLT)dt_value(dt);
+  node->cut = 0; node->size = 0; node->kids = 0;
+  if (dt_atleaf(dt)) {          /* if the node is a leaf, */
+    node->attid = -1; node->type = 0; return i; }   /* abort */
+  node->attid = dt_attid(dt);   /* note the test attribute */
+  node->type  = att_type(as_att(db->attset, node->attid));
+  node->cut   = dt_cutval(dt);  /* and the cut value */
+  node->size  = n = dt_width(dt);
+  node->kids  = x = newkids(db, n);
+  if (x < 0) return -1;         /* create the child indices */
+  for (b = 0; b < n; b++) {     /* traverse the branches */
+    if (dt_dest(dt, b) != b) continue;  /* skip links */
+    r = dt_down(dt, b, 0);      /* go down to the child */
+    if (r < 0) return -1;       /* (if it exists) */
+    c = (r == 0) ? convert(db, dt) : 0;
+    dt_up(dt, 0);               /* convert the subtree recursively */
+    if (c < 0) return -1;       /* and go up again */
+    if (r == 0) db->kids[x+b] = c;
+  }                             /* note the index of the child */
+  for (b = 0; b < n; b++) {     /* traverse the branches again */
+    d = dt_dest(dt, b);         /* and resolve the links */
+    if (d != b) db->kids[x+b] = db->kids[x+d];
+  }
+  return i;                     /* return the index of the node */
+}  /* convert() */
+
+/*--------------------------------------------------------------------*/
+
+int db_add (DTBOOST *db, DTREE *dt)
+{                               /* --- add a tree */
+  int n, i;                     /* new size of root array, index */
+  int *p;                       /* new root array */
+
+  assert(db && dt);             /* check the function arguments */
+  if ((dt_attset(dt) != db->attset)
+  ||  (dt_trgid(dt)  != db->trgid))
+    return -1;                  /* check the target attribute */
+  if (db->cnt >= db->size) {    /* if the root array is full */
+    n = db->size +((db->size > BLKSIZE) ? db->size : BLKSIZE);
+    p = (int*)realloc(db->roots, (size_t)n *sizeof(int));
+    if (!p) return -1;          /* enlarge the root array */
+    db->roots = p; db->size = n;/* and set the new array */
+  }
+  dt_up(dt, 1);                 /* go to the root of the tree */
+  if (dt->root)                 /* convert the nodes of the tree */
+    i = convert(db, dt);        /* (depth first, pre-order) */
+  else {                        /* if the tree is empty, */
+    i = newnode(db);            /* create a leaf with value 0 */
+    if (i >= 0) { db->nodes[i].attid = -1; db->nodes[i].type = 0;
+                  db->nodes[i].size  =  0; db->nodes[i].kids = 0;
+                  db->nodes[i].cut   =  0; db->nodes[i].val  = 0; }
+  }
+  dt_up(dt, 1);                 /* return to the root of the tree */
+  if (i < 0) return -1;         /* check for an error */
+  db->roots[db->cnt++] = i;     /* add the tree */
+  return 0;                     /* return 'ok' */
+}  /* db_add() */
+
+/*----------------------------------------------------------------------
+The function db_add() converts a decision/regression tree (as grown
+by the function dt_boost()) into a compact representation and appends
+it to the trees; the tree itself is not stored and may be deleted
+afterwards. The nodes of all trees are stored in one array, in
+depth-first order (pre-order), and each test node refers to a section
+of an array of child indices, with one entry per branch (value or
+side of the cut), in which merged branches (subsets of values) have
+been resolved and -1 indicates a missing child. The value of a node
+(score increment) is taken from the field trg.f of the tree node.
+For a multinomial loss the trees must be added in the order rounds
+by classes, that is, tree i contributes to the score of class i % k.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Execution Functions
+----------------------------------------------------------------------*/
+
+int db_exec (DTBOOST *db, TUPLE *tuple, INST *res, double *conf)
+{                               /* --- execute boosted trees */
+  int          t, i;            /* loop variable, child index */
+  VALID        c, k;            /* class index, branch index */
+  const DBNODE *node;           /* to traverse the nodes */
+  const INST   *val;            /* value of the test attribute */
+  double       *s, max, sum;    /* scores, maximal score, sum */
+
+  assert(db && res);            /* check the function arguments */
+  s = db->scrs;                 /* get the score buffer */
+  for (c = 0; c < db->k; c++)   /* initialize the scores */
+    s[c] = db->init[c];
+  for (t = 0; t < db->cnt; t++) {
+    node = db->nodes +db->roots[t];
+    while (node->attid >= 0) {  /* traverse the tree */
+      val = (tuple) ? tpl_colval(tuple, node->attid)
+          : att_inst(as_att(db->attset, node->attid));
+      if      (node->type == AT_NOM) /* get the index of the branch */
+        k = val->n;             /* for the value of the tuple */
+      else if (node->type == AT_INT)
+        k = isnull(val->i) ? -1 : ((val->i <= node->cut) ? 0 : 1);
+      else
+        k = isnan (val->f) ? -1 : ((val->f <= node->cut) ? 0 : 1);
+      if ((k < 0) || (k >= node->size))
+        break;                  /* stop at null/unknown values */
+      i = db->kids[node->kids +k];
+      if (i < 0) break;         /* stop at missing children */
+      node = db->nodes +i;      /* and go down to the child */
+    }                           /* add the value of the reached node */
+    s[t % db->k] += (double)node->val;  /* to the score */
+  }
+  if      (db->loss == LS_SQUARED) {  /* if squared error loss, */
+    res->f = (DTFLT)s[0];       /* the score is the prediction */
+    if (conf) *conf = 0; }      /* (no confidence available) */
+  else if (db->loss == LS_LOGISTIC) { /* if logistic loss */
+    s[1] = 1/(1 +exp(-s[0]));   /* compute the probability */
+    s[0] = 1 -s[1];             /* of the two classes */
+    res->n = (s[1] > 0.5) ? 1 : 0;
+    if (conf) *conf = s[res->n]; }
+  else {                        /* if multinomial loss (softmax) */
+    for (max = s[0], c = 1; c < db->k; c++)
+      if (s[c] > max) max = s[c];
+    for (sum = 0, c = 0; c < db->k; c++)
+      sum += s[c] = exp(s[c] -max);
+    for (k = 0, c = 0; c < db->k; c++) {
+      s[c] /= sum;              /* compute the class probabilities */
+      if (s[c] > s[k]) k = c;   /* and find the most probable class */
+    }
+    res->n = k;                 /* set the classification result */
+    if (conf) *conf = s[k];     /* and its probability */
+  }
+  return 0;                     /* return 'ok' */
+}  /* db_exec() */
+
+/*----------------------------------------------------------------------
+A tuple is passed down each tree until it reaches a leaf, a null
+value, a value for which there is no branch, or a missing child, and
+the value of the reached node is added to the score it belongs to,
+which is the same routing that is used in dt_boost() for the training
+rows. The prediction is the summed score (squared error), the class
+with the higher logistic probability, or the class with the highest
+softmax probability; db_prob() returns the class probabilities.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Description Functions
+----------------------------------------------------------------------*/
+
+static void put (DBOUT *out, const char *s, int len)
+{                               /* --- print a (wrapped) token */
+  int i;                        /* loop variable */
+
+  assert(out && s);             /* check the function arguments */
+  if ((out->pos +len > out->max) && (out->pos > out->ind)) {
+    fputc('\n', out->file);     /* if the line would get too long, */
+    for (i = out->ind; --i >= 0; ) fputc(' ', out->file);
+    out->pos = out->ind;        /* start a new (indented) line */
+    if (*s == ' ') { s++; len--; }
+  }                             /* (skip a leading blank) */
+  fputs(s, out->file);          /* print the token */
+  out->pos += len;              /* and advance the position */
+}  /* put() */
+
+/*--------------------------------------------------------------------*/
+
+static void nodeout (DBOUT *out, DTBOOST *db, int i)
+{                               /* --- print a node (recursively) */
+  VALID  b, v, n;               /* branch indices, counter */
+  int    x, c;                  /* child index offset, child index */
+  int    len;                   /* length of the output */
+  ATT    *att;                  /* test attribute */
+  const DBNODE *node;           /* node to print */
+
+  assert(out && db && (i >= 0));/* check the function arguments */
+  node = db->nodes +i;          /* get the node and print its value */
+  len  = sprintf(out->buf, "%.9g", (double)node->val);
+  put(out, out->buf, len);      /* (the score increment) */
+  if (node->attid < 0) return;  /* if the node is a leaf, abort */
+  att = as_att(db->attset, node->attid);
+  len = 2 +(int)scn_format(out->buf +2, att_name(att), 0);
+  out->buf[0] = ' '; out->buf[1] = '(';
+  if (node->type != AT_NOM)     /* print the test attribute */
+    len += sprintf(out->buf +len, "|%.16g", node->cut);
+  strcpy(out->buf +len, ") {"); /* and the cut value */
+  put(out, out->buf, len += 3); /* of a metric attribute */
+  x = node->kids;               /* get the child indices */
+  for (n = b = 0; b < node->size; b++) {
+    c = db->kids[x+b];          /* traverse the branches */
+    if (c < 0) continue;        /* skip missing children */
+    if (node->type == AT_NOM) { /* if the attribute is nominal, */
+      for (v = 0; v < b; v++)   /* check whether the child */
+        if (db->kids[x+v] == c) break;  /* was already printed */
+      if (v < b) continue;      /* (merged branches) */
+    }
+    if (n++ > 0) put(out, ",", 1);  /* print a separator */
+    if (node->type != AT_NOM) { /* if the attribute is metric, */
+      put(out, (b == 0) ? " <:" : " >:", 3); }    /* print the side */
+    else {                      /* if the attribute is nominal, */
+      for (v = b; v < node->size; v++) {    /* print the values */
+        if (db->kids[x+v] != c) continue;   /* of the child */
+        out->buf[0] = (v > b) ? ',' : ' ';
+        len = 1 +(int)scn_format(out->buf +1, att_valname(att, v), 0);
+        put(out, out->buf, len);
+      }
+      put(out, ":", 1);         /* terminate the value list */
+    }
+    put(out, " ", 1);           /* print the subtree */
+    nodeout(out, db, c);        /* (recursively) */
+  }
+  put(out, " }", 2);            /* terminate the branch list */
+}  /* nodeout() */
+
+/*--------------------------------------------------------------------*/
+
+int db_desc (DTBOOST *db, FILE *file, int mode, int maxlen)
+{                               /* --- describe boosted trees */
+  int   i, len, l;              /* loop variables */
+  VALID c;                      /* loop variable for classes */
+  DBOUT out;                    /* output information */
+
+  assert(db && file);           /* check the function arguments */
+  len = (maxlen > 0) ? maxlen -2 : 70;
+
+  /* --- print header (as a comment) --- */
+  if (mode & DT_TITLE) {        /* if the title flag is set */
+    fputs("/*", file); for (l = len; --l >= 0; ) fputc('-', file);
+    fprintf(file, "\n  boosted regression trees (%d trees)\n", db->cnt);
+    for (l = len; --l >= 0; ) fputc('-', file);
+    fputs("*/\n", file);        /* print a title header */
+  }                             /* (as a comment) */
+
+  /* --- print the parameters --- */
+  fputs("dboost(", file);       /* boosted trees indicator */
+  scn_format(out.buf, att_name(db->target), 0);
+  fputs(out.buf, file);         /* format and print */
+  fputs(") = {\n", file);       /* the target attribute's name */
+  fprintf(file, "  loss : %s,\n", lossnames[db->loss]);
+  fprintf(file, "  rate : %.16g,\n", db->rate);
+  fputs("  init : ", file);     /* print the loss function, */
+  if (db->loss != LS_MULTI)     /* the learning rate, and */
+    fprintf(file, "%.16g", db->init[0]);  /* the initial scores */
+  else {                        /* (per class for a multinomial loss) */
+    fputs("{ ", file);          /* start the list of initial scores */
+    for (c = 0; c < db->k; c++) {
+      if (c > 0) fputs(", ", file);
+      scn_format(out.buf, att_valname(db->target, c), 0);
+      fprintf(file, "%s: %.16g", out.buf, db->init[c]);
+    }                           /* print the initial class scores */
+    fputs(" }", file);          /* terminate the list */
+  }
+  fputs(",\n", file);           /* terminate the initial scores */
+
+  /* --- print the trees --- */
+  fputs("  trees: {", file);    /* start the tree list */
+  out.file = file;              /* initialize the output info. */
+  out.max  = (maxlen <= 0) ? INT_MAX : maxlen;
+  out.ind  = 6;                 /* (continuation lines) */
+  for (i = 0; i < db->cnt; i++) {
+    fputs((i > 0) ? ",\n    " : "\n    ", file);
+    out.pos = 4;                /* print the trees one per line */
+    nodeout(&out, db, db->roots[i]);
+  }
+  fputs((db->cnt > 0) ? "\n  }\n};\n" : " }\n};\n", file);
+
+  /* --- print additional information (as a comment) --- */
+  if (mode & DT_INFO) {         /* if the add. info. flag is set */
+    fputs("\n/*", file); for (l = len; --l >= 0; ) fputc('-', file);
+    fprintf(file, "\n  number of rounds: %d", db->cnt /db->k);
+    fprintf(file, "\n  number of trees : %d", db->cnt);
+    fprintf(file, "\n  number of nodes : %d\n", db->ncnt);
+    for (l = len; --l >= 0; ) fputc('-', file);
+    fputs("*/\n", file);        /* print additional information */
+  }                             /* (as a comment) */
+  return ferror(file) ? -1 : 0; /* return the writing result */
+}  /* db_desc() */
+
+/*----------------------------------------------------------------------
+The trees are described in a compact format, one tree per line (with
+continuation lines if maxlen > 0), in which a node is described by its
+value (score increment), which is followed, for a test node, by the
+test attribute and the cut value (metric attribute) in parentheses
+and a list of branches in braces, for example:
+  0.0125 (a|1.5) { <: -0.05, >: 0.1 (b) { x,y: 0.2, z: -0.1 } }
+Since a tuple with a null value for a test attribute stops at the
+test node, the inner nodes also need a value.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Parse Functions
+----------------------------------------------------------------------*/
+#ifdef DB_PARSE
+
+static int nodein (DTBOOST *db, SCANNER *scan)
+{                               /* --- read a node (recursively) */
+  int    i, x, c;               /* node index, child indices */
+  int    t;                     /* buffer for token */
+  VALID  b, v, n;               /* branch indices, number of branches */
+  ATTID  attid;                 /* identifier of test attribute */
+  ATT    *att;                  /* test attribute */
+  double f;                     /* buffer for a number */
+
+  assert(db && scan);           /* check the function arguments */
+  SCN_NUM(scan);                /* check for a number */
+  f = strtod(scn_value(scan), NULL);
+  if ((f < DTFLT_MIN) || (f > DTFLT_MAX)) SCN_ERROR(scan, E_NUMBER);
+  SCN_NEXT(scan);               /* get and consume the node value */
+  i = newnode(db);              /* create a new node */
+  if (i < 0) SCN_ERROR(scan, E_NOMEM);
+  db->nodes[i].val   = (DTFLT)f;/* store the node value */
+  db->nodes[i].attid = -1;   db->nodes[i].type = 0;
+  db->nodes[i].size  =  0;   db->nodes[i].kids = 0;
+  db->nodes[i].cut   =  0;      /* initialize a leaf */
+  if (scn_token(scan) != '(')   /* if no test follows, */
+    return i;                   /* the node is a leaf */
+  SCN_NEXT(scan);               /* consume '(' */
+  t = scn_token(scan);          /* check for a name */
+  if ((t != T_ID) && (t != T_NUM)) SCN_ERRVAL(scan, E_ATTEXP);
+  attid = as_attid(db->attset, scn_value(scan));
+  if ((attid < 0) || (attid == db->trgid))
+    SCN_ERRVAL(scan, E_UNKATT); /* get and check the attribute */
+  SCN_NEXT(scan);               /* consume the attribute name */
+  att = as_att(db->attset, attid);
+  n   = (att_type(att) == AT_NOM) ? att_valcnt(att) : 2;
+  db->nodes[i].attid = attid;   /* store the test attribute */
+  db->nodes[i].type  = att_type(att);
+  db->nodes[i].size  = n;       /* and the number of branches */
+  if (att_type(att) != AT_NOM){ /* if the attribute is metric, */
+    SCN_CHAR(scan, '|');        /* consume '|' */
+    SCN_NUM (scan);             /* check for a number */
+    db->nodes[i].cut = strtod(scn_value(scan), NULL);
+    SCN_NEXT(scan);             /* get and consume the cut value */
+  }
+  SCN_CHAR(scan, ')');          /* consume ')' */
+  x = newkids(db, (n > 0) ? n : 1);
+  if (x < 0) SCN_ERROR(scan, E_NOMEM);
+  db->nodes[i].kids = x;        /* create the child indices */
+  SCN_CHAR(scan, '{');          /* consume '{' */
+  for (v = -1; scn_token(scan) != '}'; ) {
+    if (v >= 0) SCN_CHAR(scan, ',');  /* consume ',' (separator) */
+    if (att_type(att) != AT_NOM) {    /* if the attribute is metric */
+      t = scn_token(scan);      /* get the branch indicator */
+      if      (t == '<') b = 0; /* if lower   than cut: index 0 */
+      else if (t == '>') b = 1; /* if greater than cut: index 1 */
+      else SCN_ERRVAL(scan, E_VALEXP);
+      if (db->kids[x+b] >= 0) SCN_ERRVAL(scan, E_DUPVAL);
+      db->kids[x+b] = INT_MAX;  /* mark the branch as used */
+      SCN_NEXT(scan);           /* and consume the indicator */
+      v = b; }
+    else {                      /* if the attribute is nominal */
+      while (1) {               /* read a list of values */
+        t = scn_token(scan);    /* check for a name */
+        if ((t != T_ID) && (t != T_NUM)) SCN_ERRVAL(scan, E_VALEXP);
+        v = att_valid(att, scn_value(scan));
+        if (v < 0)               SCN_ERRVAL(scan, E_UNKVAL);
+        if (db->kids[x+v] >= 0)  SCN_ERRVAL(scan, E_DUPVAL);
+        db->kids[x+v] = INT_MAX;/* get and check the value */
+        SCN_NEXT(scan);         /* and mark the branch as used */
+        if (scn_token(scan) != ',') break;
+        SCN_NEXT(scan);         /* if no other value follows, abort, */
+      }                         /* otherwise consume ',' */
+    }
+    SCN_CHAR(scan, ':');        /* consume ':' */
+    c = nodein(db, scan);       /* read the subtree recursively */
+    if (c < 0) return c;        /* and set it as the child */
+    for (b = 0; b < n; b++)     /* of all marked branches */
+      if (db->kids[x+b] == INT_MAX) db->kids[x+b] = c;
+  }
+  SCN_NEXT(scan);               /* consume '}' */
+  return i;                     /* return the index of the node */
+}  /* nodein() */
+
+/*--------------------------------------------------------------------*/
+
+static int parse (ATTSET *attset, SCANNER *scan, DTBOOST **pdb)
+{                               /* --- read boosted trees */
+  ATTID  trgid;                 /* class attribute identifier */
+  int    loss;                  /* loss function */
+  int    type;                  /* type of the target attribute */
+  int    i, t;                  /* index of a tree, token */
+  VALID  c, k;                  /* class index, number of scores */
+  double rate;                  /* learning rate */
+  ATT    *att;                  /* target attribute */
+  int    *p;                    /* new root array */
+
+  assert(attset && scan && pdb);/* check the function arguments */
+  if ((scn_token(scan) != T_ID)
+  ||  (strcmp(scn_value(scan), "dboost") != 0))
+    SCN_ERROR(scan, E_STREXP, "dboost");
+  SCN_NEXT(scan);               /* consume 'dboost' */
+  SCN_CHAR(scan, '(');          /* consume '(' */
+  t = scn_token(scan);          /* check for a name */
+  if ((t != T_ID) && (t != T_NUM)) SCN_ERRVAL(scan, E_ATTEXP);
+  trgid = as_attid(attset, scn_value(scan));
+  if (trgid < 0)                   SCN_ERRVAL(scan, E_UNKATT);
+  att  = as_att(attset, trgid); /* get the target attribute */
+  type = att_type(att);         /* and its type */
+  SCN_NEXT(scan);               /* consume the target attribute name */
+  SCN_CHAR(scan, ')');          /* consume ')' */
+  SCN_CHAR(scan, '=');          /* consume '=' */
+  SCN_CHAR(scan, '{');          /* consume '{' */
+
+  /* --- read the parameters --- */
+  if ((scn_token(scan) != T_ID)
+  ||  (strcmp(scn_value(scan), "loss") != 0))
+    SCN_ERROR(scan, E_STREXP, "loss");
+  SCN_NEXT(scan);               /* consume 'loss' */
+  SCN_CHAR(scan, ':');          /* consume ':' */
+  if (scn_token(scan) != T_ID)  SCN_ERRVAL(scan, E_LOSS);
+  for (loss = LS_MULTI; loss >= 0; loss--)
+    if (strcmp(scn_value(scan), lossnames[loss]) == 0) break;
+  if (loss < 0)                 SCN_ERRVAL(scan, E_LOSS);
+  SCN_NEXT(scan);               /* get and consume the loss function */
+  SCN_CHAR(scan, ',');          /* consume ',' */
+  if ((scn_token(scan) != T_ID)
+  ||  (strcmp(scn_value(scan), "rate") != 0))
+    SCN_ERROR(scan, E_STREXP, "rate");
+  SCN_NEXT(scan);               /* consume 'rate' */
+  SCN_CHAR(scan, ':');          /* consume ':' */
+  SCN_NUM (scan);               /* check for a number */
+  rate = strtod(scn_value(scan), NULL);
+  if (!(rate > 0))              SCN_ERROR(scan, E_NUMBER);
+  SCN_NEXT(scan);               /* get and consume the learning rate */
+  SCN_CHAR(scan, ',');          /* consume ',' */
+  *pdb = db_create(attset, trgid, loss, rate, NULL);
+  if (!*pdb) {                  /* create the boosted trees */
+    if (((type == AT_NOM) ? (loss == LS_SQUARED)
+                          : (loss != LS_SQUARED))
+    ||  ((loss == LS_LOGISTIC) && (att_valcnt(att) != 2)))
+      SCN_ERROR(scan, E_LOSS, lossnames[loss]);
+    SCN_ERROR(scan, E_NOMEM);   /* check whether the loss function */
+  }                             /* fits the target attribute */
+  k = (*pdb)->k;                /* get the number of scores */
+
+  /* --- read the initial scores --- */
+  if ((scn_token(scan) != T_ID)
+  ||  (strcmp(scn_value(scan), "init") != 0))
+    SCN_ERROR(scan, E_STREXP, "init");
+  SCN_NEXT(scan);               /* consume 'init' */
+  SCN_CHAR(scan, ':');          /* consume ':' */
+  if (loss != LS_MULTI) {       /* if there is only one score */
+    SCN_NUM(scan);              /* check for a number */
+    (*pdb)->init[0] = strtod(scn_value(scan), NULL);
+    SCN_NEXT(scan); }           /* get and consume the score */
+  else {                        /* if there is one score per class */
+    SCN_CHAR(scan, '{');        /* consume '{' */
+    for (c = 0; c < k; c++) (*pdb)->init[c] = NAN;
+    for (c = 0; c < k; c++) {   /* traverse the classes */
+      if (c > 0) SCN_CHAR(scan, ',');  /* consume ',' */
+      t = scn_token(scan);      /* check for a name */
+      if ((t != T_ID) && (t != T_NUM)) SCN_ERRVAL(scan, E_VALEXP);
+      i = (int)att_valid(att, scn_value(scan));
+      if (i < 0)                       SCN_ERRVAL(scan, E_UNKVAL);
+      if (!isnan((*pdb)->init[i]))     SCN_ERRVAL(scan, E_DUPVAL);
+      SCN_NEXT(scan);           /* get and consume the class */
+      SCN_CHAR(scan, ':');      /* consume ':' */
+      SCN_NUM (scan);           /* check for a number */
+      (*pdb)->init[i] = strtod(scn_value(scan), NULL);
+      SCN_NEXT(scan);           /* get and consume the score */
+    }
+    SCN_CHAR(scan, '}');        /* consume '}' */
+  }
+  SCN_CHAR(scan, ',');          /* consume ',' */
+
+  /* --- read the trees --- */
+  if ((scn_token(scan) != T_ID)
+  ||  (strcmp(scn_value(scan), "trees") != 0))
+    SCN_ERROR(scan, E_STREXP, "trees");
+  SCN_NEXT(scan);               /* consume 'trees' */
+  SCN_CHAR(scan, ':');          /* consume ':' */
+  SCN_CHAR(scan, '{');          /* consume '{' */
+  while (scn_token(scan) != '}') {
+    if ((*pdb)->cnt > 0) SCN_CHAR(scan, ',');
+    if ((*pdb)->cnt >= (*pdb)->size) {
+      t = (*pdb)->size +(((*pdb)->size > BLKSIZE)
+                        ? (*pdb)->size : BLKSIZE);
+      p = (int*)realloc((*pdb)->roots, (size_t)t *sizeof(int));
+      if (!p) SCN_ERROR(scan, E_NOMEM);
+      (*pdb)->roots = p; (*pdb)->size = t;
+    }                           /* enlarge the root array */
+    i = nodein(*pdb, scan);     /* read the next tree */
+    if (i < 0) return i;        /* and add it */
+    (*pdb)->roots[(*pdb)->cnt++] = i;
+  }
+  SCN_NEXT(scan);               /* consume '}' */
+  SCN_CHAR(scan, '}');          /* consume '}' */
+  SCN_CHAR(scan, ';');          /* consume ';' */
+  return 0;                     /* return 'ok' */
+}  /* parse() */
+
+/*--------------------------------------------------------------------*/
+
+DTBOOST* db_parse (ATTSET *attset, SCANNER *scan)
+{                               /* --- parse boosted trees */
+  DTBOOST *db = NULL;           /* created boosted trees */
+
+  assert(attset && scan);       /* check the function arguments */
+  scn_setmsgs(scan, msgs, (int)(sizeof(msgs)/sizeof(*msgs)));
+  scn_first(scan);              /* set messages, get first token */
+  if (parse(attset, scan, &db) != 0) {
+    if (db) db_delete(db, 0);   /* parse the boosted trees */
+    return NULL;                /* if an error occurred, */
+  }                             /* delete the trees and abort */
+  return db;                    /* return the created trees */
+}  /* db_parse() */
+
+#endif  /* #ifdef DB_PARSE */
@@ -0,0 +1,83 @@
+/*----------------------------------------------------------------------
+  File    : boost.h
+  Contents: boosted regression trees management
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created
+----------------------------------------------------------------------*/
+#ifndef __BOOST__
+#define __BOOST__
+#ifdef DB_PARSE
+#ifndef DT_PARSE
+#define DT_PARSE
+#endif
+#endif
+#include "dtree.h"
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- compact tree node --- */
+  ATTID  attid;                 /* test attribute (-1: leaf) */
+  int    type;                  /* type of the test attribute */
+  VALID  size;                  /* number of branches */
+  int    kids;                  /* index of the first child index */
+  double cut;                   /* cut value for a metric attribute */
+  DTFLT  val;                   /* value of the node (score incr.) */
+} DBNODE;                       /* (compact tree node) */
+
+typedef struct {                /* --- boosted regression trees --- */
+  ATTSET *attset;               /* attribute set */
+  ATTID  trgid;                 /* identifier of target attribute */
+  ATT    *target;               /* target attribute */
+  int    type;                  /* type of target attribute */
+  int    loss;                  /* loss function, e.g. LS_SQUARED */
+  VALID  k;                     /* number of scores (trees per round) */
+  double rate;                  /* learning rate (shrinkage) */
+  int    cnt;                   /* number of trees */
+  int    size;                  /* size of the root array */
+  int    *roots;                /* indices of the root nodes */
+  int    ncnt, nsize;           /* number of nodes, array size */
+  DBNODE *nodes;                /* nodes of all trees (pre-order) */
+  int    kcnt, ksize;           /* number of child indices, size */
+  int    *kids;                 /* child indices of all nodes */
+  double *init;                 /* initial scores */
+  double *scrs;                 /* buffer for scores/probabilities */
+} DTBOOST;                      /* (boosted regression trees) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern DTBOOST* db_create (ATTSET *attset, ATTID trgid, int loss,
+                           double rate, const double *init);
+extern void     db_delete (DTBOOST *db, int delas);
+extern ATTSET*  db_attset (DTBOOST *db);
+extern ATT*     db_target (DTBOOST *db);
+extern ATTID    db_trgid  (DTBOOST *db);
+extern int      db_type   (DTBOOST *db);
+extern int      db_loss   (DTBOOST *db);
+extern int      db_cnt    (DTBOOST *db);
+extern int      db_add    (DTBOOST *db, DTREE *dt);
+
+extern int      db_exec   (DTBOOST *db, TUPLE *tuple,
+                           INST *res, double *conf);
+extern double   db_prob   (DTBOOST *db, VALID clsid);
+
+extern int      db_desc   (DTBOOST *db, FILE *file, int mode,
+                           int maxlen);
+#ifdef DB_PARSE
+extern DTBOOST* db_parse  (ATTSET *attset, SCANNER *scan);
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define db_attset(b)     ((b)->attset)
+#define db_target(b)     ((b)->target)
+#define db_trgid(b)      ((b)->trgid)
+#define db_type(b)       ((b)->type)
+#define db_loss(b)       ((b)->loss)
+#define db_cnt(b)        ((b)->cnt)
+
+#define db_prob(b,i)     ((b)->scrs[i])
+
+#endif
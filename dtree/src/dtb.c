@@ -0,0 +1,456 @@
+/*----------------------------------------------------------------------
+  File    : dtb.c
+  Contents: gradient boosted regression trees induction
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created (from dtf.c)
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+#ifndef AS_READ
+#define AS_READ
+#endif
+#ifndef AS_PARSE
+#define AS_PARSE
+#endif
+#ifndef AS_DESC
+#define AS_DESC
+#endif
+#include "attset.h"
+#ifndef TAB_READ
+#define TAB_READ
+#endif
+#include "table.h"
+#ifndef DT_GROW
+#define DT_GROW
+#endif
+#include "boost.h"
+#include "error.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define PRGNAME     "dtb"
+#define DESCRIPTION "gradient boosted regression trees induction"
+#define VERSION     "version 1.0 (2026.10.17)         " \
+                    "(c) 2026        Christian Borgelt"
+
+/* --- error codes --- */
+/* error codes 0 to -5 defined in attset.h */
+#define E_OPTION     (-6)       /* unknown option */
+#define E_OPTARG     (-7)       /* missing option argument */
+#define E_ARGCNT     (-8)       /* wrong number of arguments */
+#define E_PARSE      (-9)       /* parse error on domain file */
+#define E_ATTCNT    (-10)       /* no usable attributes found */
+#define E_UNKTRG    (-11)       /* unknown  target attribute */
+#define E_MULTRG    (-12)       /* multiple target attributes */
+#define E_RNDCNT    (-13)       /* invalid number of rounds */
+#define E_BALANCE   (-14)       /* unknown balancing mode */
+#define E_RATE      (-15)       /* invalid learning rate */
+#define E_MINCNT    (-16)       /* invalid minimal number of tuples */
+
+#define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
+
+/*----------------------------------------------------------------------
+  Constants
+----------------------------------------------------------------------*/
+/* --- error messages --- */
+static const char *errmsgs[] = {
+  /* E_NONE      0 */  "no error",
+  /* E_NOMEM    -1 */  "not enough memory",
+  /* E_FOPEN    -2 */  "cannot open file %s",
+  /* E_FREAD    -3 */  "read error on file %s",
+  /* E_FWRITE   -4 */  "write error on file %s",
+  /* E_STDIN    -5 */  "double assignment of standard input",
+  /* E_OPTION   -6 */  "unknown option -%c",
+  /* E_OPTARG   -7 */  "missing option argument",
+  /* E_ARGCNT   -8 */  "wrong number of arguments",
+  /* E_PARSE    -9 */  "parse error(s) on file %s",
+  /* E_ATTCNT  -10 */  "no (usable) attributes (need at least 1)",
+  /* E_UNKTRG  -11 */  "unknown target attribute '%s'",
+  /* E_MULTRG  -12 */  "multiple target attributes",
+  /* E_RNDCNT  -13 */  "invalid number of rounds %d",
+  /* E_BALANCE -14 */  "unknown balancing mode %c",
+  /* E_RATE    -15 */  "invalid learning rate %g",
+  /* E_MINCNT  -16 */  "invalid minimal number of tuples %g",
+  /*           -17 */  "unknown error"
+};
+
+/*----------------------------------------------------------------------
+  Global Variables
+----------------------------------------------------------------------*/
+static CCHAR    *prgname;       /* program name for error messages */
+static SCANNER  *scan   = NULL; /* scanner (for domain file) */
+static TABREAD  *tread  = NULL; /* table reader */
+static ATTSET   *attset = NULL; /* attribute set */
+static TABLE    *table  = NULL; /* (training) data table */
+static DTBOOST  *boost  = NULL; /* boosted regression trees */
+static DTREE    **trees = NULL; /* array of grown trees */
+static char     *occ    = NULL; /* flags for occurring attributes */
+static FILE     *out    = NULL; /* output file */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+#ifndef NDEBUG
+  #undef  CLEANUP               /* clean up memory and close files */
+  #define CLEANUP \
+  if (boost)  db_delete(boost, 0);  \
+  if (trees)  free(trees);          \
+  if (occ)    free(occ);            \
+  if (table)  tab_delete(table, 0); \
+  if (attset) as_delete(attset);    \
+  if (tread)  trd_delete(tread, 1); \
+  if (scan)   scn_delete(scan,  1); \
+  if (out && (out != stdout)) fclose(out);
+#endif
+
+GENERROR(error, exit)           /* generic error reporting function */
+
+/*--------------------------------------------------------------------*/
+
+static int read_table (ATTSET *attset, TABREAD *tread,
+                       CCHAR *fn_tab, CCHAR *fn_hdr, int mode,
+                       TABLE **tab)
+{                               /* --- read a table file */
+  int     k;                    /* return value of read function */
+  ATTID   m;                    /* number of attributes */
+  TPLID   n;                    /* number of data tuples */
+  double  w;                    /* weight of data tuples */
+  clock_t t;                    /* for time measurements */
+
+  /* --- read table header --- */
+  if (fn_hdr) {                 /* if a header file is given */
+    t = clock();                /* start timer, open input file */
+    if (trd_open(tread, NULL, fn_hdr) != 0) return E_FOPEN;
+    fprintf(stderr, "reading %s ... ", trd_name(tread));
+    k = as_read(attset, tread, (mode & ~AS_DFLT) | AS_ATT);
+    if (k < 0) return -k;       /* read table header */
+    trd_close(tread);           /* and close the file */
+    fprintf(stderr, "[%"ATTID_FMT" attribute(s)]", as_attcnt(attset));
+    fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+    mode &= ~(AS_ATT|AS_DFLT);  /* print a success message and */
+  }                             /* remove the attribute flag */
+
+  /* --- read table --- */
+  t = clock();                  /* start timer, open input file */
+  if (trd_open(tread, NULL, fn_tab) != 0) return E_FOPEN;
+  fprintf(stderr, "reading %s ... ", trd_name(tread));
+  *tab = tab_create("table", attset, tpl_delete);
+  if (!*tab) return E_NOMEM;    /* create a data table */
+  k = tab_read(*tab, tread, mode);
+  if (k < 0) return -k;         /* read the table file */
+  trd_close(tread);             /* and close the file */
+  m = tab_attcnt(*tab);         /* get the number of attributes */
+  n = tab_tplcnt(*tab);         /* and the number of data tuples */
+  w = tab_tplwgt(*tab);         /* and print a success message */
+  fprintf(stderr, "[%"ATTID_FMT" attribute(s),", m);
+  fprintf(stderr, " %"TPLID_FMT, n);
+  if (w != (double)n) fprintf(stderr, "/%g", w);
+  fprintf(stderr, " tuple(s)] done [%.2fs].\n", SEC_SINCE(t));
+
+  return 0;                   /* return 'ok' */
+}  /* read_table() */
+
+/*--------------------------------------------------------------------*/
+
+int main (int argc, char* argv[])
+{                               /* --- main function */
+  int     i, k = 0;             /* loop variables, counter, buffer */
+  char    *s;                   /* to traverse options */
+  CCHAR   **optarg = NULL;      /* option argument */
+  CCHAR   *fn_dom  = NULL;      /* name of domain file */
+  CCHAR   *fn_hdr  = NULL;      /* name of table header file */
+  CCHAR   *fn_tab  = NULL;      /* name of table file */
+  CCHAR   *fn_db   = NULL;      /* name of boosted trees file */
+  CCHAR   *recseps = NULL;      /* record     separators */
+  CCHAR   *fldseps = NULL;      /* field      separators */
+  CCHAR   *blanks  = NULL;      /* blank      characters */
+  CCHAR   *nullchs = NULL;      /* null value characters */
+  CCHAR   *comment = NULL;      /* comment    characters */
+  CCHAR   *trgname = NULL;      /* name of the target attribute */
+  ATTID   trgid    = -1;        /* id/index of target column */
+  WEIGHT  mincnt   = 2.0F;      /* minimal number of cases */
+  ATTID   maxht    = 4;         /* maximal height of trees */
+  int     cnt      = 100;       /* number of boosting rounds */
+  double  rate     = 0.1;       /* learning rate (shrinkage) */
+  int     multi    = 0;         /* flag for multinomial loss */
+  int     loss;                 /* loss function */
+  int     mode     = AS_ATT|AS_NOXATT; /* table file read mode */
+  int     flags    = DT_NOPRUNE;/* flags, e.g. DF_SUBSET */
+  int     bincnt   = 255;       /* number of bins for metric atts. */
+  int     thcnt    = 1;         /* number of threads */
+  int     balance  = 0;         /* flag for balancing class freqs. */
+  int     maxlen   = 0;         /* maximal output line length */
+  ATT     *att;                 /* to traverse the attributes */
+  ATTID   m, c, used;           /* number of attributes (in trees) */
+  VALID   z;                    /* number of trees per round */
+  double  size, ht;             /* average number of nodes/levels */
+  double  init[2];              /* initial scores (one or two) */
+  double  *inits = init;        /* initial scores (per class) */
+  double  err;                  /* training error */
+  TPLID   n;                    /* number of data tuples */
+  double  w;                    /* weight of data tuples */
+  clock_t t;                    /* timer for measurements */
+
+  prgname = argv[0];            /* get program name for error msgs. */
+
+  /* --- print startup/usage message --- */
+  if (argc > 1) {               /* if arguments are given */
+    fprintf(stderr, "%s - %s\n", argv[0], DESCRIPTION);
+    fprintf(stderr, VERSION); } /* print a startup message */
+  else {                        /* if no argument is given */
+    printf("usage: %s [options] domfile [-d|-h hdrfile] "
+                     "tabfile dbfile\n", argv[0]);
+    printf("%s\n", DESCRIPTION);
+    printf("%s\n", VERSION);
+    printf("-c#      target attribute name                  "
+                    "(default: last attribute)\n");
+    printf("-N#      number of boosting rounds              "
+                    "(default: %d)\n", cnt);
+    printf("-L#      learning rate (shrinkage)              "
+                    "(default: %g)\n", rate);
+    printf("-M       use multinomial loss also for two classes\n");
+    printf("         (default: logistic loss for two classes,\n");
+    printf("         squared error for a metric target)\n");
+    printf("-q#      balance class frequencies (weight tuples)\n");
+    printf("         (l: lower, b: boost, s: shift tuple weights;\n");
+    printf("          uppercase letters: use integer factors)\n");
+    printf("-t#      maximal height of the trees            "
+                    "(default: %"ATTID_FMT")\n", maxht);
+    printf("-k#      minimal tuples in two branches         "
+                    "(default: %g)\n", mincnt);
+    printf("-j       split nominal attributes "
+                    "one value against rest\n");
+    printf("-s       try to form subsets on nominal attributes\n");
+    printf("-B       enforce binary subsets splits (with -s)\n");
+    printf("-H#      number of bins for metric attributes   "
+                    "(default: %d)\n", bincnt);
+    printf("         (histogram-based cuts, at most 255 bins,\n");
+    printf("         <= 0: exact cuts)\n");
+    #ifdef USE_THREADS
+    printf("-T#      number of threads                      "
+                    "(default: %d)\n", thcnt);
+    printf("         (attributes are evaluated in parallel,\n");
+    printf("         <= 0: number of processors)\n");
+    #endif
+    printf("-l#      output line length                     "
+                    "(default: no limit)\n");
+    printf("-r#      record     separators                  "
+                    "(default: \"\\n\")\n");
+    printf("-f#      field      separators                  "
+                    "(default: \" \\t,\")\n");
+    printf("-b#      blank      characters                  "
+                    "(default: \" \\t\\r\")\n");
+    printf("-u#      null value characters                  "
+                    "(default: \"?*\")\n");
+    printf("-C#      comment    characters                  "
+                    "(default: \"#\")\n");
+    printf("-n       number of tuple occurrences in last field\n");
+    printf("domfile  file containing domain descriptions\n");
+    printf("-d       use default header "
+                    "(attribute names = field numbers)\n");
+    printf("-h       read table header  "
+                    "(attribute names) from hdrfile\n");
+    printf("hdrfile  file containing table header "
+                    "(attribute names)\n");
+    printf("tabfile  table file to read "
+                    "(attribute names in first record)\n");
+    printf("dbfile   file to write induced "
+                    "boosted regression trees to\n");
+    return 0;                   /* print a usage message */
+  }                             /* and abort the program */
+
+  /* --- evaluate arguments --- */
+  for (i = 1; i < argc; i++) {  /* traverse arguments */
+    s = argv[i];                /* get option argument */
+    if (optarg) { *optarg = s; optarg = NULL; continue; }
+    if ((*s == '-') && *++s) {  /* -- if argument is an option */
+      while (1) {               /* traverse characters */
+        switch (*s++) {         /* evaluate option */
+          case 'c': optarg    = &trgname;                break;
+          case 'N': cnt       =   (int)strtol(s, &s, 0); break;
+          case 'L': rate      =         strtod(s, &s);   break;
+          case 'M': multi     = 1;                       break;
+          case 'q': balance   = (*s) ? *s++ : 0;         break;
+          case 'k': mincnt    = (WEIGHT)strtod(s, &s);   break;
+          case 'j': flags    |= DT_1INN;                 break;
+          case 's': flags    |= DT_SUBSET;               break;
+          case 'B': flags    |= DT_BINARY;               break;
+          case 'H': bincnt    =   (int)strtol(s, &s, 0); break;
+          case 'T': thcnt     =   (int)strtol(s, &s, 0); break;
+          case 't': maxht     = (ATTID)strtol(s, &s, 0); break;
+          case 'l': maxlen    =   (int)strtol(s, &s, 0); break;
+          case 'b': optarg    = &blanks;                 break;
+          case 'f': optarg    = &fldseps;                break;
+          case 'r': optarg    = &recseps;                break;
+          case 'u': optarg    = &nullchs;                break;
+          case 'C': optarg    = &comment;                break;
+          case 'n': mode     |= AS_WEIGHT;               break;
+          case 'd': mode     |= AS_DFLT;                 break;
+          case 'h': optarg    = &fn_hdr;                 break;
+          default : error(E_OPTION, *--s);               break;
+        }                       /* set option variables */
+        if (!*s) break;         /* if at end of string, abort loop */
+        if (optarg) { *optarg = s; optarg = NULL; break; }
+      } }                       /* get option argument */
+    else {                      /* -- if argument is no option */
+      switch (k++) {            /* evaluate non-option */
+        case  0: fn_dom = s;      break;
+        case  1: fn_tab = s;      break;
+        case  2: fn_db  = s;      break;
+        default: error(E_ARGCNT); break;
+      }                         /* note file names */
+    }
+  }
+  if (optarg) error(E_OPTARG);  /* check the option argument */
+  if (k != 3) error(E_ARGCNT);  /* and the number of arguments */
+  if (fn_hdr && (strcmp(fn_hdr, "-") == 0))
+    fn_hdr = "";                /* convert "-" to "" for consistency */
+  i = ( fn_hdr && !*fn_hdr) ? 1 : 0;
+  if  (!fn_dom || !*fn_dom) i++;
+  if  (!fn_tab || !*fn_tab) i++;/* check assignments of stdin: */
+  if (i > 1) error(E_STDIN);    /* stdin must not be used twice */
+  if (cnt <= 0)     error(E_RNDCNT, cnt);
+  if (!(rate > 0))  error(E_RATE,   rate);
+  if (mincnt < 0)   error(E_MINCNT, mincnt);
+  if ((        balance  !=  0)  && (tolower(balance) != 'l')
+  &&  (tolower(balance) != 'b') && (tolower(balance) != 's'))
+    error(E_BALANCE, balance);  /* check the balancing mode */
+  fputc('\n', stderr);          /* terminate the startup message */
+
+  /* --- parse domain descriptions --- */
+  attset = as_create("domains", att_delete);
+  if (!attset) error(E_NOMEM);  /* create an attribute set */
+  scan = scn_create();          /* create a scanner */
+  if (!scan)   error(E_NOMEM);  /* for the domain file */
+  t = clock();                  /* start timer, open input file */
+  if (scn_open(scan, NULL, fn_dom) != 0)
+    error(E_FOPEN, scn_name(scan));
+  fprintf(stderr, "reading %s ... ", scn_name(scan));
+  if ((as_parse(attset, scan, AT_ALL, 1) != 0)
+  ||  !scn_eof(scan, 1))        /* parse domain descriptions */
+    error(E_PARSE, scn_name(scan));
+  scn_delete(scan, 1);          /* delete the scanner and */
+  scan = NULL;                  /* clear the scanner variable */
+  m    = as_attcnt(attset);     /* get the number of attributes */
+  fprintf(stderr, "[%"ATTID_FMT" attribute(s)]", m);
+  fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  if (m <= 0) error(E_ATTCNT);  /* check for at least one attribute */
+
+  /* --- determine id of target attribute --- */
+  trgid = as_target(attset, trgname, 1);
+  if (trgid < 0) error(trgname ? E_UNKTRG : E_MULTRG, trgname);
+
+  /* --- determine the loss function --- */
+  att = as_att(attset, trgid);  /* get the target attribute */
+  if      (att_type(att) != AT_NOM) loss = LS_SQUARED;
+  else if (!multi && (att_valcnt(att) == 2)) loss = LS_LOGISTIC;
+  else                              loss = LS_MULTI;
+  z = (loss == LS_MULTI) ? att_valcnt(att) : 1;
+
+  /* --- read data table --- */
+  tread = trd_create();         /* create a table reader and */
+  if (!tread) error(E_NOMEM);   /* configure the characters */
+  trd_allchs(tread, recseps, fldseps, blanks, nullchs, comment);
+  k = read_table(attset, tread, fn_tab, fn_hdr, mode, &table);
+  if (k == E_NOMEM) error(E_NOMEM);
+  if (k == E_FOPEN) error(E_FOPEN, trd_name(tread));
+  if (k >  0)       error(k, as_errmsg(attset, NULL, 0));
+  trd_delete(tread, 1);         /* read the table body and */
+  tread = NULL;                 /* delete the table reader */
+
+  /* --- reduce and balance table --- */
+  t = clock();                  /* start timer, print log message */
+  fprintf(stderr, "reducing%s table ... ",
+                  (balance) ? " and balancing" : "");
+  n = tab_reduce(table);        /* reduce table for speed up */
+  w = tab_tplwgt(table);        /* and get the total weight */
+  if (balance                   /* if the balance flag is set */
+  && (att_type(as_att(attset, trgid)) == AT_NOM)) {
+      k = (tolower(balance) == 'l') ? -2
+        : (tolower(balance) == 'b') ? -1 : 0;
+      i = (tolower(balance) != balance);
+      w = tab_balance(table, trgid, k, NULL, i);
+    if (w < 0) error(E_NOMEM);  /* balance the class frequencies */
+  }                             /* and get the new weight sum */
+  fprintf(stderr, "[%"TPLID_FMT, n);
+  if (w != (double)n) fprintf(stderr, "/%g", w);
+  fprintf(stderr, " tuple(s)] done [%.2fs].\n", SEC_SINCE(t));
+
+  /* --- grow boosted regression trees --- */
+  t = clock();                  /* start timer, print log message */
+  fprintf(stderr, "boosting regression trees ... ");
+  trees = (DTREE**)malloc((size_t)cnt *(size_t)z *sizeof(DTREE*));
+  occ   = (char*)  calloc((size_t)m, sizeof(char));
+  if (z > 2) inits = (double*)malloc((size_t)z *sizeof(double));
+  if (!trees || !occ || !inits) error(E_NOMEM);
+  k = dt_boost(table, trgid, loss, rate, maxht, mincnt, flags,
+               bincnt, trees, cnt, inits, &err, thcnt);
+  if (k == 0)                   /* grow the regression trees and */
+    boost = db_create(attset, trgid, loss, rate, inits);
+  if (inits != init) free(inits);
+  if (!boost) error(E_NOMEM);   /* collect them in boosted trees */
+  size = ht = 0;                /* (in compact form) */
+  for (i = 0; i < cnt*z; i++) { /* traverse the grown trees */
+    dt_attchk(trees[i]);        /* mark occurring attributes */
+    for (c = 0; c < m; c++)     /* and collect them over all trees */
+      if (att_getmark(as_att(attset, c)) >= 0) occ[c] = 1;
+    size += (double)dt_size(trees[i]);
+    ht   += (double)dt_height(trees[i]);
+    k = db_add(boost, trees[i]);/* sum the sizes and heights */
+    dt_delete(trees[i], 0);     /* convert and delete the tree */
+    if (k != 0) {               /* on failure delete the others */
+      while (++i < cnt*z) dt_delete(trees[i], 0);
+      error(E_NOMEM);           /* and abort the program */
+    }
+  }
+  for (used = c = 0; c < m; c++) {  /* mark the attributes that */
+    att_setmark(as_att(attset, c), occ[c] ? 0 : -1);    /* occur */
+    if (occ[c]) used++;         /* in at least one tree and */
+  }                             /* count these attributes */
+  fprintf(stderr, "[%d round(s)/%d tree(s)/%"ATTID_FMT"+1 attribute(s)",
+          cnt, cnt*z, used-1);
+  fprintf(stderr, "/%.1f level(s)/%.1f node(s)]",
+          ht/(cnt*z), size/(cnt*z));
+  fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  if (err >= 0) {               /* if a training error exists */
+    if (att_type(att) == AT_NOM)/* print misclassification rate */
+      fprintf(stderr, "training error: %.2f%%\n", 100*err);
+    else                        /* or mean squared error */
+      fprintf(stderr, "training mse: %g, rmse: %g\n", err, sqrt(err));
+  }
+
+  /* --- write boosted regression trees --- */
+  t = clock();                  /* start timer, open output file */
+  if (strcmp(fn_db, "-") == 0) fn_db = "";
+  if (fn_db && *fn_db) { out = fopen(fn_db, "w"); }
+  else                 { out = stdout; fn_db = "<stdout>"; }
+  fprintf(stderr, "writing %s ... ", fn_db);
+  if (!out) error(E_FOPEN, fn_db);
+  if (as_desc(attset, out, AS_TITLE|AS_MARKED|AS_IVALS, maxlen) != 0)
+    error(E_FWRITE, fn_db);     /* describe attribute domains */
+  fputc('\n', out);             /* leave one line empty */
+  if (db_desc(boost, out, DT_TITLE|DT_INFO, maxlen) != 0)
+    error(E_FWRITE, fn_db);     /* describe the boosted trees */
+  if (out && (((out == stdout) ? fflush(out) : fclose(out)) != 0))
+    error(E_FWRITE, fn_db);     /* close the output file and */
+  out = NULL;                   /* print a success message */
+  fprintf(stderr, "[%d tree(s)/%"ATTID_FMT"+1 attribute(s)]", cnt*z,
+          used-1);
+  fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+
+  /* --- clean up --- */
+  CLEANUP;                      /* clean up memory and close files */
+  SHOWMEM;                      /* show (final) memory usage */
+  return 0;                     /* return 'ok' */
+}  /* main() */
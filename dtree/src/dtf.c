@@ -0,0 +1,588 @@
+/*----------------------------------------------------------------------
+  File    : dtf.c
+  Contents: decision and regression forest induction
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created (from dti.c)
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+#ifndef AS_READ
+#define AS_READ
+#endif
+#ifndef AS_PARSE
+#define AS_PARSE
+#endif
+#ifndef AS_DESC
+#define AS_DESC
+#endif
+#include "attset.h"
+#ifndef TAB_READ
+#define TAB_READ
+#endif
+#include "table.h"
+#ifndef DT_GROW
+#define DT_GROW
+#endif
+#include "forest.h"
+#include "error.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define PRGNAME     "dtf"
+#define DESCRIPTION "decision and regression forest induction"
+#define VERSION     "version 1.0 (2026.10.17)         " \
+                    "(c) 2026        Christian Borgelt"
+
+/* --- error codes --- */
+/* error codes 0 to -5 defined in attset.h */
+#define E_OPTION     (-6)       /* unknown option */
+#define E_OPTARG     (-7)       /* missing option argument */
+#define E_ARGCNT     (-8)       /* wrong number of arguments */
+#define E_PARSE      (-9)       /* parse error on domain file */
+#define E_ATTCNT    (-10)       /* no usable attributes found */
+#define E_UNKTRG    (-11)       /* unknown  target attribute */
+#define E_MULTRG    (-12)       /* multiple target attributes */
+#define E_TREECNT   (-13)       /* invalid number of trees */
+#define E_BALANCE   (-14)       /* unknown balancing mode */
+#define E_MEASURE   (-15)       /* unknown selection measure */
+#define E_MINCNT    (-16)       /* invalid minimal number of tuples */
+
+#define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- measure information --- */
+  int  code;                    /* measure code */
+  char *name;                   /* name of the measure */
+} MINFO;                        /* (measure information) */
+
+/*----------------------------------------------------------------------
+  Constants
+----------------------------------------------------------------------*/
+/* --- measures for nominal targets --- */
+static const MINFO nomtab[] = {
+  { FEM_NONE,    "none"    },   /* no measure */
+  { FEM_INFGAIN, "infgain" },   /* information gain */
+  { FEM_INFGBAL, "infgbal" },   /* balanced information gain */
+  { FEM_INFGR,   "infgr"   },   /* information gain ratio */
+  { FEM_INFSGR1, "infsgr1" },   /* sym. information gain ratio 1 */
+  { FEM_INFSGR2, "infsgr2" },   /* sym. information gain ratio 2 */
+  { FEM_QIGAIN,  "qigain"  },   /* quadratic information gain */
+  { FEM_QIGBAL,  "qigbal"  },   /* balanced quad. information gain */
+  { FEM_QIGR,    "qigr"    },   /* quadratic information gain ratio */
+  { FEM_QISGR1,  "qisgr1"  },   /* sym. quad. info. gain ratio 1 */
+  { FEM_QISGR2,  "qisgr2"  },   /* sym. quad. info. gain ratio 2 */
+  { FEM_GINI,    "gini"    },   /* gini index */
+  { FEM_GINISYM, "ginisym" },   /* symmetric gini index */
+  { FEM_GINIMOD, "ginimod" },   /* modified gini index */
+  { FEM_RELIEF,  "relief"  },   /* relief measure */
+  { FEM_WDIFF,   "wdiff"   },   /* weighted differences */
+  { FEM_CHI2,    "chi2"    },   /* chi^2 measure */
+  { FEM_CHI2NRM, "chi2nrm" },   /* normalized chi^2 measure */
+  { FEM_WEVID,   "wevid"   },   /* weight of evidence */
+  { FEM_RELEV,   "relev"   },   /* relevance */
+  { FEM_RELMOD,  "relmod"  },   /* modified relevance */
+  { FEM_BDM,     "bdm"     },   /* Bayesian-Dirichlet / K2 metric */
+  { FEM_BDMOD,   "bdmod"   },   /* modified BD / K2 metric */
+  { FEM_RDLREL,  "rdlrel"  },   /* red. of description length 1 */
+  { FEM_RDLABS,  "rdlabs"  },   /* red. of description length 2 */
+  { FEM_STOCO,   "stoco"   },   /* stochastic complexity */
+  { FEM_SPCGAIN, "spcgain" },   /* specificity gain */
+  { FEM_SPCGBAL, "spcgbal" },   /* balanced specificity gain */
+  { FEM_SPCGR,   "spcgr"   },   /* specificity gain ratio */
+  { FEM_SPCSGR1, "spcsgr1" },   /* sym. specificity gain ratio 1 */
+  { FEM_SPCSGR2, "spcsgr2" },   /* sym. specificity gain ratio 2 */
+  { -1,          NULL      }    /* sentinel */
+};
+
+/* --- measures for metric targets --- */
+static const MINFO mettab[] = {
+  { VEM_NONE,    "none"    },   /* no measure */
+  { VEM_SSE,     "sse"     },   /* sum of squared errors */
+  { VEM_MSE,     "mse"     },   /* mean squared error */
+  { VEM_RMSE,    "rmse"    },   /* square root of mean squared error */
+  { VEM_VAR,     "var"     },   /* variance (unbiased estimator) */
+  { VEM_SDEV,    "sd"      },   /* standard deviation (from variance) */
+  { -1,          NULL      }    /* sentinel */
+};
+
+/* --- error messages --- */
+static const char *errmsgs[] = {
+  /* E_NONE      0 */  "no error",
+  /* E_NOMEM    -1 */  "not enough memory",
+  /* E_FOPEN    -2 */  "cannot open file %s",
+  /* E_FREAD    -3 */  "read error on file %s",
+  /* E_FWRITE   -4 */  "write error on file %s",
+  /* E_STDIN    -5 */  "double assignment of standard input",
+  /* E_OPTION   -6 */  "unknown option -%c",
+  /* E_OPTARG   -7 */  "missing option argument",
+  /* E_ARGCNT   -8 */  "wrong number of arguments",
+  /* E_PARSE    -9 */  "parse error(s) on file %s",
+  /* E_ATTCNT  -10 */  "no (usable) attributes (need at least 1)",
+  /* E_UNKTRG  -11 */  "unknown target attribute '%s'",
+  /* E_MULTRG  -12 */  "multiple target attributes",
+  /* E_TREECNT -13 */  "invalid number of trees %d",
+  /* E_BALANCE -14 */  "unknown balancing mode %c",
+  /* E_MEASURE -15 */  "unknown attribute selection measure %s",
+  /* E_MINCNT  -16 */  "invalid minimal number of tuples %g",
+  /*           -17 */  "unknown error"
+};
+
+/*----------------------------------------------------------------------
+  Global Variables
+----------------------------------------------------------------------*/
+static CCHAR    *prgname;       /* program name for error messages */
+static SCANNER  *scan   = NULL; /* scanner (for domain file) */
+static TABREAD  *tread  = NULL; /* table reader */
+static ATTSET   *attset = NULL; /* attribute set */
+static TABLE    *table  = NULL; /* (training) data table */
+static DTFOREST *forest = NULL; /* decision/regression forest */
+static DTREE    **trees = NULL; /* array of grown trees */
+static char     *occ    = NULL; /* flags for occurring attributes */
+static FILE     *out    = NULL; /* forest output file */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+#ifndef NDEBUG
+  #undef  CLEANUP               /* clean up memory and close files */
+  #define CLEANUP \
+  if (forest) df_delete(forest, 0); \
+  if (trees)  free(trees);          \
+  if (occ)    free(occ);            \
+  if (table)  tab_delete(table, 0); \
+  if (attset) as_delete(attset);    \
+  if (tread)  trd_delete(tread, 1); \
+  if (scan)   scn_delete(scan,  1); \
+  if (out && (out != stdout)) fclose(out);
+#endif
+
+GENERROR(error, exit)           /* generic error reporting function */
+
+/*--------------------------------------------------------------------*/
+
+static void help (void)
+{                               /* --- print help on sel. measures */
+  int i;                        /* loop variable */
+
+  fprintf(stderr, "\n");        /* terminate startup message */
+  printf("\nattribute selection measures (option -e#)\n");
+  printf("measures for nominal target attributes:\n");
+  printf("  name       measure\n");
+  for (i = 0; nomtab[i].name; i++)
+    printf("  %-9s  %s\n", nomtab[i].name, ft_mname(nomtab[i].code));
+  printf("\nMeasures wdiff, bdm, bdmod, rdlrel, rdlabs "
+         "take a sensitivity\n"
+         "parameter (-z#, default: 0, i.e. normal sensitivity)\n");
+  printf("Measures bdm and bdmod take a prior (-p#, positive number)\n"
+         "or an equivalent sample size (-p#, negative number).\n");
+  printf("\nmeasures for metric target attributes:\n");
+  printf("  name       measure\n");
+  for (i = 0; mettab[i].name; i++)
+    printf("  %-9s  %s\n", mettab[i].name, vt_mname(mettab[i].code));
+  exit(0);                      /* print a list of selection measures */
+}  /* help() */                 /* and abort the program */
+
+/*--------------------------------------------------------------------*/
+
+static int code (const MINFO *tab, const char *name)
+{                               /* --- get measure code */
+  assert(tab && name);          /* check the function arguments */
+  for ( ; tab->name; tab++)     /* look up name in table */
+    if (strcmp(tab->name, name) == 0)
+      return tab->code;         /* return the measure code */
+  return -1;                    /* or an error indicator */
+}  /* code() */
+
+/*--------------------------------------------------------------------*/
+
+static int read_table (ATTSET *attset, TABREAD *tread,
+                       CCHAR *fn_tab, CCHAR *fn_hdr, int mode,
+                       TABLE **tab)
+{                               /* --- read a table file */
+  int     k;                    /* return value of read function */
+  ATTID   m;                    /* number of attributes */
+  TPLID   n;                    /* number of data tuples */
+  double  w;                    /* weight of data tuples */
+  clock_t t;                    /* for time measurements */
+
+  /* --- read table header --- */
+  if (fn_hdr) {                 /* if a header file is given */
+    t = clock();                /* start timer, open input file */
+    if (trd_open(tread, NULL, fn_hdr) != 0) return E_FOPEN;
+    fprintf(stderr, "reading %s ... ", trd_name(tread));
+    k = as_read(attset, tread, (mode & ~AS_DFLT) | AS_ATT);
+    if (k < 0) return -k;       /* read table header */
+    trd_close(tread);           /* and close the file */
+    fprintf(stderr, "[%"ATTID_FMT" attribute(s)]", as_attcnt(attset));
+    fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+    mode &= ~(AS_ATT|AS_DFLT);  /* print a success message and */
+  }                             /* remove the attribute flag */
+
+  /* --- read table --- */
+  t = clock();                  /* start timer, open input file */
+  if (trd_open(tread, NULL, fn_tab) != 0) return E_FOPEN;
+  fprintf(stderr, "reading %s ... ", trd_name(tread));
+  *tab = tab_create("table", attset, tpl_delete);
+  if (!*tab) return E_NOMEM;    /* create a data table */
+  k = tab_read(*tab, tread, mode);
+  if (k < 0) return -k;         /* read the table file */
+  trd_close(tread);             /* and close the file */
+  m = tab_attcnt(*tab);         /* get the number of attributes */
+  n = tab_tplcnt(*tab);         /* and the number of data tuples */
+  w = tab_tplwgt(*tab);         /* and print a success message */
+  fprintf(stderr, "[%"ATTID_FMT" attribute(s),", m);
+  fprintf(stderr, " %"TPLID_FMT, n);
+  if (w != (double)n) fprintf(stderr, "/%g", w);
+  fprintf(stderr, " tuple(s)] done [%.2fs].\n", SEC_SINCE(t));
+
+  return 0;                   /* return 'ok' */
+}  /* read_table() */
+
+/*--------------------------------------------------------------------*/
+
+int main (int argc, char* argv[])
+{                               /* --- main function */
+  int     i, k = 0;             /* loop variables, counter, buffer */
+  char    *s;                   /* to traverse options */
+  CCHAR   **optarg = NULL;      /* option argument */
+  CCHAR   *fn_dom  = NULL;      /* name of domain file */
+  CCHAR   *fn_hdr  = NULL;      /* name of table header file */
+  CCHAR   *fn_tab  = NULL;      /* name of table file */
+  CCHAR   *fn_df   = NULL;      /* name of forest file */
+  CCHAR   *recseps = NULL;      /* record     separators */
+  CCHAR   *fldseps = NULL;      /* field      separators */
+  CCHAR   *blanks  = NULL;      /* blank      characters */
+  CCHAR   *nullchs = NULL;      /* null value characters */
+  CCHAR   *comment = NULL;      /* comment    characters */
+  CCHAR   *trgname = NULL;      /* name of the target attribute */
+  ATTID   trgid    = -1;        /* id/index of target column */
+  CCHAR   *mname   = NULL;      /* name of att. selection measure */
+  int     measure  = 3;         /* attribute selection measure */
+  int     wgtd     = FEF_WGTD;  /* flag for weighted measure */
+  double  params[] = { 0, 0 };  /* selection measure parameters */
+  double  minval   = -INFINITY; /* minimal value of selection measure */
+  WEIGHT  mincnt   = 2.0F;      /* minimal number of cases */
+  ATTID   maxht    = ATTID_MAX; /* maximal height of trees */
+  int     cnt      = 100;       /* number of trees */
+  ATTID   subcnt   = 0;         /* number of attributes per node */
+  long    seed;                 /* seed for random numbers */
+  int     mode     = AS_ATT|AS_NOXATT; /* table file read mode */
+  int     flags    = DT_NOPRUNE;/* flags, e.g. DF_SUBSET */
+  int     bincnt   = 0;         /* number of bins for metric atts. */
+  int     thcnt    = 1;         /* number of threads */
+  int     balance  = 0;         /* flag for balancing class freqs. */
+  int     maxlen   = 0;         /* maximal output line length */
+  int     desc     = 0;         /* description mode */
+  const   MINFO *ntab;          /* table of measure names */
+  ATT     *att;                 /* to traverse the attributes */
+  ATTID   m, c, used;           /* number of attributes (in trees) */
+  double  size, ht;             /* average number of nodes/levels */
+  double  oob;                  /* out-of-bag error */
+  TPLID   n;                    /* number of data tuples */
+  double  w;                    /* weight of data tuples */
+  clock_t t;                    /* timer for measurements */
+
+  prgname = argv[0];            /* get program name for error msgs. */
+  seed    = (long)time(NULL);   /* and get a default seed value */
+
+  /* --- print startup/usage message --- */
+  if (argc > 1) {               /* if arguments are given */
+    fprintf(stderr, "%s - %s\n", argv[0], DESCRIPTION);
+    fprintf(stderr, VERSION); } /* print a startup message */
+  else {                        /* if no argument is given */
+    printf("usage: %s [options] domfile [-d|-h hdrfile] "
+                     "tabfile dffile\n", argv[0]);
+    printf("%s\n", DESCRIPTION);
+    printf("%s\n", VERSION);
+    printf("-c#      target attribute name                  "
+                    "(default: last attribute)\n");
+    printf("-N#      number of trees                        "
+                    "(default: %d)\n", cnt);
+    printf("-A#      number of attributes per node          "
+                    "(default: sqrt/third)\n");
+    printf("         (random subset of the usable attributes,\n");
+    printf("         <= 0: square root (nominal target) or\n");
+    printf("         one third (metric target) of their number)\n");
+    printf("-S#      seed value for random number generator "
+                    "(default: time)\n");
+    printf("-q#      balance class frequencies (weight tuples)\n");
+    printf("         (l: lower, b: boost, s: shift tuple weights;\n");
+    printf("          uppercase letters: use integer factors)\n");
+    printf("-e#      attribute selection measure            "
+                    "(default: infgr/rmse)\n");
+    printf("-!       print a list of available "
+                    "attribute selection measures\n");
+    printf("-z#      sensitivity parameter                  "
+                    "(default: %g)\n", params[0]);
+    printf("         (for measures wdiff, bdm, bdmod, "
+                    "rdlen1, rdlen2)\n");
+    printf("-p#      prior (positive) or "
+                    "equivalent sample size (negative)\n");
+    printf("         (for measures bdm, bdmod)\n");
+    printf("-w       do not weight measure with fraction "
+                    "of known values\n");
+    printf("-i#      minimal value of selection measure     "
+                    "(default: no limit)\n");
+    printf("-t#      maximal height of the trees            "
+                    "(default: no limit)\n");
+    printf("-k#      minimal tuples in two branches         "
+                    "(default: %g)\n", mincnt);
+    printf("-j       split nominal attributes "
+                    "one value against rest\n");
+    printf("-s       try to form subsets on nominal attributes\n");
+    printf("-B       enforce binary subsets splits (with -s)\n");
+    printf("-P       do basic pruning of grown trees\n");
+    printf("-H#      number of bins for metric attributes   "
+                    "(default: %d)\n", bincnt);
+    printf("         (histogram-based cuts, at most 255 bins,\n");
+    printf("         <= 0: exact cuts)\n");
+    #ifdef USE_THREADS
+    printf("-T#      number of threads                      "
+                    "(default: %d)\n", thcnt);
+    printf("         (trees are grown in parallel,\n");
+    printf("         <= 0: number of processors)\n");
+    #endif
+    printf("-l#      output line length                     "
+                    "(default: no limit)\n");
+    printf("-a       align values of test attributes        "
+                    "(default: do not align)\n");
+    printf("-R       print relative frequencies (in percent)\n");
+    printf("-r#      record     separators                  "
+                    "(default: \"\\n\")\n");
+    printf("-f#      field      separators                  "
+                    "(default: \" \\t,\")\n");
+    printf("-b#      blank      characters                  "
+                    "(default: \" \\t\\r\")\n");
+    printf("-u#      null value characters                  "
+                    "(default: \"?*\")\n");
+    printf("-C#      comment    characters                  "
+                    "(default: \"#\")\n");
+    printf("-n       number of tuple occurrences in last field\n");
+    printf("domfile  file containing domain descriptions\n");
+    printf("-d       use default header "
+                    "(attribute names = field numbers)\n");
+    printf("-h       read table header  "
+                    "(attribute names) from hdrfile\n");
+    printf("hdrfile  file containing table header "
+                    "(attribute names)\n");
+    printf("tabfile  table file to read "
+                    "(attribute names in first record)\n");
+    printf("dffile   file to write induced "
+                    "decision/regression forest to\n");
+    return 0;                   /* print a usage message */
+  }                             /* and abort the program */
+
+  /* --- evaluate arguments --- */
+  for (i = 1; i < argc; i++) {  /* traverse arguments */
+    s = argv[i];                /* get option argument */
+    if (optarg) { *optarg = s; optarg = NULL; continue; }
+    if ((*s == '-') && *++s) {  /* -- if argument is an option */
+      while (1) {               /* traverse characters */
+        switch (*s++) {         /* evaluate option */
+          case '!': help();                              break;
+          case 'c': optarg    = &trgname;                break;
+          case 'N': cnt       =   (int)strtol(s, &s, 0); break;
+          case 'A': subcnt    = (ATTID)strtol(s, &s, 0); break;
+          case 'S': seed      =        strtol(s, &s, 0); break;
+          case 'q': balance   = (*s) ? *s++ : 0;         break;
+          case 'e': optarg    = &mname;                  break;
+          case 'z': params[0] =         strtod(s, &s);   break;
+          case 'p': params[1] =         strtod(s, &s);   break;
+          case 'i': minval    =         strtod(s, &s);   break;
+          case 'w': wgtd      = 0;                       break;
+          case 'k': mincnt    = (WEIGHT)strtod(s, &s);   break;
+          case 'j': flags    |= DT_1INN;                 break;
+          case 's': flags    |= DT_SUBSET;               break;
+          case 'B': flags    |= DT_BINARY;               break;
+          case 'P': flags    &= ~DT_NOPRUNE;             break;
+          case 'H': bincnt    =   (int)strtol(s, &s, 0); break;
+          case 'T': thcnt     =   (int)strtol(s, &s, 0); break;
+          case 't': maxht     = (ATTID)strtol(s, &s, 0); break;
+          case 'l': maxlen    =   (int)strtol(s, &s, 0); break;
+          case 'a': desc     |= DT_ALIGN;                break;
+          case 'R': desc     |= DT_REL;                  break;
+          case 'b': optarg    = &blanks;                 break;
+          case 'f': optarg    = &fldseps;                break;
+          case 'r': optarg    = &recseps;                break;
+          case 'u': optarg    = &nullchs;                break;
+          case 'C': optarg    = &comment;                break;
+          case 'n': mode     |= AS_WEIGHT;               break;
+          case 'd': mode     |= AS_DFLT;                 break;
+          case 'h': optarg    = &fn_hdr;                 break;
+          default : error(E_OPTION, *--s);               break;
+        }                       /* set option variables */
+        if (!*s) break;         /* if at end of string, abort loop */
+        if (optarg) { *optarg = s; optarg = NULL; break; }
+      } }                       /* get option argument */
+    else {                      /* -- if argument is no option */
+      switch (k++) {            /* evaluate non-option */
+        case  0: fn_dom = s;      break;
+        case  1: fn_tab = s;      break;
+        case  2: fn_df  = s;      break;
+        default: error(E_ARGCNT); break;
+      }                         /* note file names */
+    }
+  }
+  if (optarg) error(E_OPTARG);  /* check the option argument */
+  if (k != 3) error(E_ARGCNT);  /* and the number of arguments */
+  if (fn_hdr && (strcmp(fn_hdr, "-") == 0))
+    fn_hdr = "";                /* convert "-" to "" for consistency */
+  i = ( fn_hdr && !*fn_hdr) ? 1 : 0;
+  if  (!fn_dom || !*fn_dom) i++;
+  if  (!fn_tab || !*fn_tab) i++;/* check assignments of stdin: */
+  if (i > 1) error(E_STDIN);    /* stdin must not be used twice */
+  if (cnt <= 0)   error(E_TREECNT, cnt);
+  if (mincnt < 0) error(E_MINCNT,  mincnt);
+  if ((        balance  !=  0)  && (tolower(balance) != 'l')
+  &&  (tolower(balance) != 'b') && (tolower(balance) != 's'))
+    error(E_BALANCE, balance);  /* check the balancing mode */
+  fputc('\n', stderr);          /* terminate the startup message */
+
+  /* --- parse domain descriptions --- */
+  attset = as_create("domains", att_delete);
+  if (!attset) error(E_NOMEM);  /* create an attribute set */
+  scan = scn_create();          /* create a scanner */
+  if (!scan)   error(E_NOMEM);  /* for the domain file */
+  t = clock();                  /* start timer, open input file */
+  if (scn_open(scan, NULL, fn_dom) != 0)
+    error(E_FOPEN, scn_name(scan));
+  fprintf(stderr, "reading %s ... ", scn_name(scan));
+  if ((as_parse(attset, scan, AT_ALL, 1) != 0)
+  ||  !scn_eof(scan, 1))        /* parse domain descriptions */
+    error(E_PARSE, scn_name(scan));
+  scn_delete(scan, 1);          /* delete the scanner and */
+  scan = NULL;                  /* clear the scanner variable */
+  m    = as_attcnt(attset);     /* get the number of attributes */
+  fprintf(stderr, "[%"ATTID_FMT" attribute(s)]", m);
+  fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  if (m <= 0) error(E_ATTCNT);  /* check for at least one attribute */
+
+  /* --- determine id of target attribute --- */
+  trgid = as_target(attset, trgname, 1);
+  if (trgid < 0) error(trgname ? E_UNKTRG : E_MULTRG, trgname);
+
+  /* --- translate measure --- */
+  att = as_att(attset, trgid);  /* get the target attribute */
+  if (att_type(att) == AT_NOM){ /* if nominal target attribute */
+    if (!mname) mname = "infgr";/* set default measure name and */
+    ntab = nomtab; }            /* get the nominal name table */
+  else {                        /* if metric target attribute */
+    if (!mname) mname = "rmse"; /* set default measure name and */
+    ntab = mettab;              /* get the metric name table, */
+  }                             /* then get the measure code */
+  s = strchr(mname, ':');       /* check for a double measure */
+  if (!s)                       /* if only a single measure name, */
+    measure = code(ntab,mname); /* simply get the measure code */
+  else {                        /* if a double measure name */
+    *s = 0;          measure = code(ntab, mname);
+    if (measure < 0) measure = code(ntab, s+1);
+    *s = ':';                   /* check both measure names */
+  }                             /* (nominal and metric target) */
+  if (measure < 0) error(E_MEASURE, mname);
+  measure |= wgtd;              /* add flag for weighted measure */
+
+  /* --- read data table --- */
+  tread = trd_create();         /* create a table reader and */
+  if (!tread) error(E_NOMEM);   /* configure the characters */
+  trd_allchs(tread, recseps, fldseps, blanks, nullchs, comment);
+  k = read_table(attset, tread, fn_tab, fn_hdr, mode, &table);
+  if (k == E_NOMEM) error(E_NOMEM);
+  if (k == E_FOPEN) error(E_FOPEN, trd_name(tread));
+  if (k >  0)       error(k, as_errmsg(attset, NULL, 0));
+  trd_delete(tread, 1);         /* read the table body and */
+  tread = NULL;                 /* delete the table reader */
+
+  /* --- reduce and balance table --- */
+  t = clock();                  /* start timer, print log message */
+  fprintf(stderr, "reducing%s table ... ",
+                  (balance) ? " and balancing" : "");
+  n = tab_reduce(table);        /* reduce table for speed up */
+  w = tab_tplwgt(table);        /* and get the total weight */
+  if (balance                   /* if the balance flag is set */
+  && (att_type(as_att(attset, trgid)) == AT_NOM)) {
+      k = (tolower(balance) == 'l') ? -2
+        : (tolower(balance) == 'b') ? -1 : 0;
+      i = (tolower(balance) != balance);
+      w = tab_balance(table, trgid, k, NULL, i);
+    if (w < 0) error(E_NOMEM);  /* balance the class frequencies */
+  }                             /* and get the new weight sum */
+  fprintf(stderr, "[%"TPLID_FMT, n);
+  if (w != (double)n) fprintf(stderr, "/%g", w);
+  fprintf(stderr, " tuple(s)] done [%.2fs].\n", SEC_SINCE(t));
+
+  /* --- grow decision/regression forest --- */
+  t = clock();                  /* start timer, print log message */
+  fprintf(stderr, "growing %s forest ... ",
+          (att_type(att) == AT_NOM) ? "decision" : "regression");
+  forest = df_create(attset, trgid);
+  trees  = (DTREE**)malloc((size_t)cnt *sizeof(DTREE*));
+  occ    = (char*)  calloc((size_t)m, sizeof(char));
+  if (!forest || !trees || !occ) error(E_NOMEM);
+  if (dt_forest(table, trgid, measure, params, minval, maxht, mincnt,
+                flags, bincnt, subcnt, trees, cnt, (unsigned int)seed,
+                &oob, thcnt) != 0)
+    error(E_NOMEM);             /* grow the decision/regression trees */
+  size = ht = 0;                /* and collect them in a forest */
+  for (i = 0; i < cnt; i++) {   /* traverse the grown trees */
+    dt_attchk(trees[i]);        /* mark occurring attributes */
+    for (c = 0; c < m; c++)     /* and collect them over all trees */
+      if (att_getmark(as_att(attset, c)) >= 0) occ[c] = 1;
+    size += (double)dt_size(trees[i]);
+    ht   += (double)dt_height(trees[i]);
+    if (df_add(forest, trees[i]) != 0) {
+      while (i < cnt) dt_delete(trees[i++], 0);
+      error(E_NOMEM);           /* sum the sizes and heights */
+    }                           /* and add the tree to the forest */
+  }
+  for (used = c = 0; c < m; c++) {  /* mark the attributes that */
+    att_setmark(as_att(attset, c), occ[c] ? 0 : -1);    /* occur */
+    if (occ[c]) used++;         /* in at least one tree and */
+  }                             /* count these attributes */
+  fprintf(stderr, "[%d tree(s)/%"ATTID_FMT"+1 attribute(s)", cnt,
+          used-1);
+  fprintf(stderr, "/%.1f level(s)/%.1f node(s)]", ht/cnt, size/cnt);
+  fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+  if (oob >= 0) {               /* if an out-of-bag error exists */
+    if (att_type(att) == AT_NOM)/* print misclassification rate */
+      fprintf(stderr, "out-of-bag error: %.2f%%\n", 100*oob);
+    else                        /* or mean squared error */
+      fprintf(stderr, "out-of-bag mse: %g, rmse: %g\n", oob, sqrt(oob));
+  }
+
+  /* --- write decision/regression forest --- */
+  t = clock();                  /* start timer, open output file */
+  if (strcmp(fn_df, "-") == 0) fn_df = "";
+  if (fn_df && *fn_df) { out = fopen(fn_df, "w"); }
+  else                 { out = stdout; fn_df = "<stdout>"; }
+  fprintf(stderr, "writing %s ... ", fn_df);
+  if (!out) error(E_FOPEN, fn_df);
+  if (as_desc(attset, out, AS_TITLE|AS_MARKED|AS_IVALS, maxlen) != 0)
+    error(E_FWRITE, fn_df);     /* describe attribute domains */
+  fputc('\n', out);             /* leave one line empty */
+  if (df_desc(forest, out, DT_TITLE|DT_INFO|desc, maxlen) != 0)
+    error(E_FWRITE, fn_df);     /* describe the forest */
+  if (out && (((out == stdout) ? fflush(out) : fclose(out)) != 0))
+    error(E_FWRITE, fn_df);     /* close the output file and */
+  out = NULL;                   /* print a success message */
+  fprintf(stderr, "[%d tree(s)/%"ATTID_FMT"+1 attribute(s)]", cnt,
+          used-1);
+  fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
+
+  /* --- clean up --- */
+  CLEANUP;                      /* clean up memory and close files */
+  SHOWMEM;                      /* show (final) memory usage */
+  return 0;                     /* return 'ok' */
+}  /* main() */
@@ -36,6 +36,10 @@
             2013.08.29 adapted to new function as_target()
             2014.10.24 changed from LGPL license to MIT license
             2015.09.30 forward selection of attributes based on AUC
+            2026.10.17 option -T# added (parallel attribute evaluation)
+            2026.10.17 option -H# added (histogram-based cuts)
+            2026.10.17 options -X#, -P#, -S# added (cross-validation)
+            2026.10.17 parallel forward selection (function dt_cands())
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -62,7 +66,11 @@
 #ifndef DT_GROW
 #define DT_GROW
 #endif
+#ifndef DT_PRUNE
+#define DT_PRUNE
+#endif
 #include "dtree.h"
+#include "random.h"
 #include "error.h"
 #ifdef STORAGE
 #include "storage.h"
@@ -73,8 +81,8 @@
 ----------------------------------------------------------------------*/
 #define PRGNAME     "dti"
 #define DESCRIPTION "decision and regression tree induction"
-#define VERSION     "version 4.3 (2016.11.11)         " \
-                    "(c) 1997-2016   Christian Borgelt"
+#define VERSION     "version 4.4 (2026.10.17)         " \
+                    "(c) 1997-2026   Christian Borgelt"
 
 /* --- error codes --- */
 /* error codes 0 to -5 defined in attset.h */
@@ -89,6 +97,11 @@
 #define E_BALANCE   (-14)       /* unknown balancing mode */
 #define E_MEASURE   (-15)       /* unknown selection measure */
 #define E_MINCNT    (-16)       /* invalid minimal number of tuples */
+#define E_FOLDS     (-17)       /* invalid number of folds */
+#define E_PRUNE     (-18)       /* invalid pruning parameter */
+
+#define MAXPRUNE    16          /* maximal number of pruning params. */
+#define NOVWGT      1e-12       /* weight for non-occurring values */
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
@@ -105,6 +118,12 @@ typedef struct {                /* --- prediction for AUC comp. --- */
   double trg;                   /* actual target value */
 } PRED;                         /* (prediction pair) */
 
+typedef struct {                /* --- validation data --- */
+  TABLE  *valid;                /* validation data table */
+  double *trgs;                 /* target values of the tuples */
+  double *aucs;                 /* minimum/maximum AUC per attribute */
+} VALDATA;                      /* (validation data) */
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -174,7 +193,9 @@ static const char *errmsgs[] = {
   /* E_BALANCE -14 */  "unknown balancing mode %c",
   /* E_MEASURE -15 */  "unknown attribute selection measure %s",
   /* E_MINCNT  -16 */  "invalid minimal number of tuples %g",
-  /*           -17 */  "unknown error"
+  /* E_FOLDS   -17 */  "invalid number of folds %d",
+  /* E_PRUNE   -18 */  "invalid pruning parameter(s) %s",
+  /*           -19 */  "unknown error"
 };
 
 /*----------------------------------------------------------------------
@@ -193,15 +214,6 @@ static FILE    *out    = NULL;  /* decision tree output file */
   Forward Selection of Attributes
 ----------------------------------------------------------------------*/
 
-static int cleanup (int errcode, PRED *preds, DTREE *dtree)
-{                               /* --- clean up after an error */
-  if (dtree) dt_delete(dtree, 0);
-  if (preds) free(preds);       /* free all allocated memory */
-  return errcode;               /* return the error code */
-}  /* cleanup() */
-
-/*--------------------------------------------------------------------*/
-
 static int predcmp (const void *a, const void *b, void *data)
 {                               /* --- compare two predictions */
   if (((PRED*)a)->out > ((PRED*)b)->out) return +1;
@@ -226,24 +238,74 @@ static void printtime (void)
 
 /*--------------------------------------------------------------------*/
 
+static int auc (DTREE *dtree, ATTID attid, void *data)
+{                               /* --- compute AUC of a tree */
+  VALDATA *vd = (VALDATA*)data; /* type the validation data */
+  TPLID   j, n;                 /* loop variable, number of tuples */
+  PRED    *preds;               /* decision tree predictions */
+  INST    res;                  /* result of prediction */
+  double  p;                    /* prediction confidence/probability */
+  TPLID   neg, pos, sum;        /* negative and positive counters */
+  double  amin, amax;           /* area under the ROC curve (AUC) */
+
+  assert(dtree && data);        /* check the function arguments */
+  n = tab_tplcnt(vd->valid);    /* get number of validation tuples */
+  preds = (PRED*)malloc((size_t)n *sizeof(PRED));
+  if (!preds) return -1;        /* create a prediction array */
+  for (j = 0; j < n; j++) {     /* traverse the validation tuples */
+    dt_exec(dtree, tab_tpl(vd->valid, j), NOVWGT, &res, NULL, NULL);
+    preds[j].out = dt_conf(dtree, 1);
+    preds[j].trg = vd->trgs[j]; /* collect confidence of prediction */
+  }                             /* and the (precomputed) target */
+  obj_qsort(preds, (size_t)n, sizeof(PRED), +1, predcmp, NULL);
+  neg  = pos  = sum = 0;        /* initialize the case counters */
+  amin = amax = 0;              /* and the area under the ROC curve */
+  p = preds[0].out;             /* get the first prediction */
+  for (j = n; --j >= 0; ) {     /* traverse the cases (in reverse) */
+    if (preds[j].out != p) {    /* if the prediction changes */
+      p     = preds[j].out;     /* note the new prediction value */
+      amin += (double)neg *(double)sum;
+      sum  += pos;              /* add current rectangle to AUC */
+      amax += (double)neg *(double)sum;
+      neg   = pos = 0;          /* and reinitialize the counters */
+    }                           /* (for next prediction value) */
+    if (preds[j].trg > 0) pos += 1;
+    else                  neg += 1;
+  }                             /* update the case counters */
+  amin += (double)neg *(double)sum;
+  sum  += pos;                  /* add last rectangle to AUC */
+  amax += (double)neg *(double)sum;
+  amin /= p = (double)sum *(double)(n -sum);
+  amax /= p;                    /* normalize by rectangle area */
+  vd->aucs[attid+attid]   = 2.0 *amin -1.0;
+  vd->aucs[attid+attid+1] = 2.0 *amax -1.0;
+  free(preds);                  /* store area above diagonal */
+  return 0;                     /* (minimum/maximum) and return 'ok' */
+}  /* auc() */
+
+/*----------------------------------------------------------------------
+The function auc() is called by dt_cands() for the tree that is grown
+with a candidate attribute, possibly in several threads at the same
+time. Hence it works on its own prediction array and stores the AUC
+values in the slots of the candidate. The target values of the
+validation tuples are extracted only once (function fwdsel()).
+----------------------------------------------------------------------*/
+
 static int fwdsel (TABLE *table, TABLE *valid, ATTID trgid,
                    int measure, double *params, double minval,
                    ATTID maxht, double mincnt, int flags,
-                   ATTID maxsel, int verbose)
+                   int bincnt, int thcnt, ATTID maxsel, int verbose)
 {                               /* --- forward selection of atts. */
   ATTSET  *attset;              /* underlying attribute set */
-  TPLID   j, n;                 /* loop variables for tuples */
-  TUPLE   *tpl;                 /* to traverse the tuples */
+  TPLID   j, n;                 /* loop variable, number of tuples */
   ATTID   i, k, m;              /* loop variables for attributes */
+  ATTID   c, x;                 /* number of candidates, loop var. */
+  ATTID   *cands;               /* candidate attributes */
   ATT     *att;                 /* to traverse the attributes */
-  PRED    *preds;               /* decision tree predictions */
-  INST    res;                  /* result of prediction */
-  double  p;                    /* prediction confidence/probability */
-  TPLID   neg, pos, sum;        /* negative and positive counters */
+  VALDATA vd;                   /* validation data for AUC comp. */
   double  amin, amax, aavg;     /* area under the ROC curve (AUC) */
   double  bmin, bmax, bavg;     /* best minimum/maximum/average AUC */
   ATTID   bid;                  /* index of best attribute */
-  DTREE   *dtree = NULL;        /* decision tree classifier */
   clock_t t;                    /* for time measurements */
 
   assert(table                  /* check the function arguments */
@@ -256,53 +318,41 @@ static int fwdsel (TABLE *table, TABLE *valid, ATTID trgid,
   assert(att_valcnt(att) <= 2); /* check for at most two classes */
   if (att_valcnt(att) < 2) return 0;
   n = tab_tplcnt(valid);        /* get number of validation tuples */
-  preds = (PRED*)malloc((size_t)n *sizeof(PRED));
-  if (!preds) return E_NOMEM;   /* create a prediction array */
+  vd.valid = valid;             /* and create the target array */
+  vd.trgs  = (double*)malloc((size_t)(n+m+m) *sizeof(double));
+  cands    = (ATTID*) malloc((size_t)m *sizeof(ATTID));
+  if (!vd.trgs || !cands) {     /* create the candidate array */
+    if (vd.trgs) free(vd.trgs); /* and the AUC array */
+    if (cands)   free(cands);
+    return E_NOMEM;
+  }
+  vd.aucs = vd.trgs +n;         /* traverse the validation tuples */
+  for (j = 0; j < n; j++)       /* and collect their target values */
+    vd.trgs[j] = (double)tpl_colval(tab_tpl(valid, j), trgid)->n;
 
   t = clock();                  /* start timer, print log message */
   fprintf(stderr, "selecting attributes ...\n");
   bmin = bmax = bavg = -1.0;    /* clear the best attribute value */
   for (k = 0; k < m-1; k++) {   /* forward selection of attributes */
+    for (c = i = 0; i < m; i++) {    /* traverse the attributes, */
+      if (att_getmark(as_att(attset, i)) >= 0)
+        continue;               /* skip target and selected attribs. */
+      cands[c++] = i;           /* collect the candidates */
+      if (maxsel < -1) break;   /* (only the first if to select */
+    }                           /* the attributes in a fixed order) */
+
+    /* --- decision tree induction and evaluation --- */
+    if ((c > 0)                 /* grow and evaluate the trees */
+    &&  (dt_cands(table, trgid, measure, params, minval, maxht,
+                  mincnt, flags, bincnt, cands, c, auc, &vd,
+                  thcnt) != 0)) {
+      free(cands); free(vd.trgs); return E_NOMEM; }
     bid = -1;                   /* clear the best attribute */
-    for (i = 0; i < m; i++) {   /* traverse the attributes */
-      att = as_att(attset, i);  /* skip target and selected attribs. */
-      if (att_getmark(att) >= 0) continue;
-      att_setmark(att, 0);      /* mark the attribute as selected */
-
-      /* --- decision tree induction --- */
-      dtree = dt_grow(table, trgid, measure, params, minval,
-                      maxht, mincnt, flags);
-      if (!dtree) return cleanup(E_NOMEM, preds, dtree);
-
-      /* --- evaluate model on validation data --- */
-      for (j = 0; j < n; j++) { /* traverse the validation tuples */
-        tpl = tab_tpl(valid, j);/* (assess the model performance) */
-        preds[j].trg = (double)tpl_colval(tpl, trgid)->n;
-        dt_exec(dtree, tpl, 1e-12, &res, NULL, NULL);
-        preds[j].out = dt_conf(dtree, 1);
-      }                         /* collect confidence of prediction */
-      obj_qsort(preds, (size_t)n, sizeof(PRED), +1, predcmp, NULL);
-      neg  = pos  = sum = 0;    /* initialize the case counters */
-      amin = amax = 0;          /* and the area under the ROC curve */
-      p = preds[0].out;         /* get the first prediction */
-      for (j = n; --j >= 0; ) { /* traverse the cases (in reverse) */
-        if (preds[j].out != p){ /* if the prediction changes */
-          p     = preds[j].out; /* note the new prediction value */
-          amin += (double)neg *(double)sum;
-          sum  += pos;          /* add current rectangle to AUC */
-          amax += (double)neg *(double)sum;
-          neg   = pos = 0;      /* and reinitialize the counters */
-        }                       /* (for next prediction value) */
-        if (preds[j].trg > 0) pos += 1;
-        else                  neg += 1;
-      }                         /* update the case counters */
-      amin += (double)neg *(double)sum;
-      sum  += pos;              /* add last rectangle to AUC */
-      amax += (double)neg *(double)sum;
-      amin /= p = (double)sum *(double)(n -sum);
-      amax /= p;                /* normalize by rectangle area */
-      amin = 2.0 *amin -1.0;    /* compute area above diagonal */
-      amax = 2.0 *amax -1.0;    /* (minimum/maximum/average) */
+    for (x = 0; x < c; x++) {   /* traverse the candidates */
+      i    = cands[x];          /* get the attribute */
+      att  = as_att(attset, i); /* and its AUC values */
+      amin = vd.aucs[i+i];      /* (minimum/maximum/average) */
+      amax = vd.aucs[i+i+1];
       aavg = 0.5 *amin +0.5 *amax;
       if (verbose) {            /* if verbose reporting requested */
         printtime();            /* print the current date and time */
@@ -311,12 +361,7 @@ static int fwdsel (TABLE *table, TABLE *valid, ATTID trgid,
       }                         /* print minimum and maximum AUC */
       if ((aavg > bavg) || (maxsel < -2)) {  /* update best att. */
         bavg = aavg; bmin = amin; bmax = amax; bid = i; }
-
-      /* --- clean up the variables --- */
-      dt_delete(dtree, 0); dtree = NULL;
-      att_setmark(att, -1);     /* unmark the current attribute */
-      if (maxsel < -1) break;   /* abort the loop if to select */
-    }                           /* the attributes in a fixed order */
+    }
 
     if (bid < 0) break;         /* if no attribute selected, abort */
     printtime();                /* print the current date and time */
@@ -334,10 +379,152 @@ static int fwdsel (TABLE *table, TABLE *valid, ATTID trgid,
   }
   fprintf(stderr, "attribute selection [%"ATTID_FMT" attribute(s)]", k);
   fprintf(stderr, " done [%.2fs].\n", SEC_SINCE(t));
-  free(preds);                  /* delete the prediction array */
+  free(cands);                  /* delete the candidate array */
+  free(vd.trgs);                /* and the target/AUC array */
   return 0;                     /* return 'ok' */
 }  /* fwdsel() */
 
+/*----------------------------------------------------------------------
+In each step of the forward selection, the trees for all candidate
+attributes (all attributes that are not yet selected) are grown and
+evaluated in one call of dt_cands(), which shares the training matrix
+and the presorted lists or bins between the trees and processes the
+candidates in parallel (with thcnt threads). Only after all
+candidates have been evaluated, the AUC values are reported and the
+best attribute is selected (in the order of the attributes).
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Cross-Validation
+----------------------------------------------------------------------*/
+
+static int xval (TABLE *table, ATTID trgid, int measure, double *params,
+                 double minval, ATTID maxht, double mincnt, int flags,
+                 int bincnt, int thcnt, int folds,
+                 const double *prune, int pcnt, long seed)
+{                               /* --- k-fold cross-validation */
+  TPLID   i, n;                 /* loop variable, number of tuples */
+  TUPLE   *tpl;                 /* to traverse the tuples */
+  int     k, p, c;              /* loop variables for folds/params. */
+  int     type;                 /* type of the target attribute */
+  const INST *trg;              /* value of the target attribute */
+  DTREE   **trees;              /* trees grown for the folds */
+  DTREE   *dt;                  /* (pruned) tree to evaluate */
+  double  *errs, *wgts, *size;  /* errors, weights and sizes */
+  double  *e, *s, d, w;         /* to traverse the errors, buffers */
+  INST    res;                  /* result of prediction */
+  clock_t t;                    /* for time measurements */
+
+  assert(table && (folds > 1)); /* check the function arguments */
+  t = clock();                  /* start timer, print log message */
+  fprintf(stderr, "cross-validating [%d fold(s)] ... ", folds);
+  type = att_type(tab_col(table, trgid));
+  n    = tab_tplcnt(table);     /* get the number of tuples */
+  rseed((unsigned int)seed);    /* shuffle the tuples and for */
+  tab_shuffle(table, 0, n, drand);   /* a nominal target sort */
+  if (type == AT_NOM)           /* them w.r.t. the class, so that */
+    tab_sort(table, 0, n, +1, tpl_cmp1, &trgid);
+  for (i = 0; i < n; i++)       /* the folds are stratified */
+    tpl_setmark(tab_tpl(table, i), (TPLID)(i % folds));
+  trees = (DTREE**)malloc((size_t)folds *sizeof(DTREE*));
+  errs  = (double*)calloc((size_t)(pcnt+1) *(size_t)(folds+folds+1)
+                          +(size_t)folds, sizeof(double));
+  if (!trees || !errs) {        /* create the tree and error arrays */
+    if (trees) free(trees);     /* on failure delete the arrays */
+    if (errs)  free(errs);      /* and abort the function */
+    return E_NOMEM;
+  }
+  size = errs +(pcnt+1) *folds; /* organize the error array */
+  wgts = size +(pcnt+1) *folds; /* (errors and sizes per fold and */
+  if (dt_xval(table, trgid, measure, params, minval, maxht, mincnt,
+              flags, bincnt, trees, folds, thcnt) != 0) {
+    free(trees); free(errs); return E_NOMEM; }
+
+  /* --- evaluate the trees on their folds --- */
+  for (k = 0; k < folds; k++) { /* traverse the folds */
+    for (p = 0; p <= pcnt; p++){/* and the pruning parameters */
+      if (p <= 0) dt = trees[k];/* evaluate the grown tree and */
+      else {                    /* prune a copy for each parameter */
+        dt = dt_clone(trees[k]);
+        if (!dt || (dt_prune(dt, PM_CLVL, prune[p-1], 0, 0, 0, NULL)
+                    != 0)) { if (dt) dt_delete(dt, 0); break; }
+      }
+      e = errs +p *folds +k;    /* get the error and size entries */
+      size[p *folds +k] = (double)dt_size(dt);
+      for (i = 0; i < n; i++) { /* traverse the tuples of the fold */
+        tpl = tab_tpl(table, i);
+        if (tpl_getmark(tpl) != (TPLID)k) continue;
+        trg = tpl_colval(tpl, trgid);
+        if (((type == AT_NOM) && isnone(trg->n))
+        ||  ((type == AT_INT) && isnull(trg->i))
+        ||  ((type == AT_FLT) && isnan (trg->f)))
+          continue;             /* skip tuples with null target */
+        w = tpl_getwgt(tpl);    /* get the tuple weight */
+        if (p <= 0) wgts[k] += w;
+        dt_exec(dt, tpl, NOVWGT, &res, NULL, NULL);
+        if (type == AT_NOM) {   /* if the target is nominal, */
+          if (res.n != trg->n)  /* count misclassifications */
+            *e += w; }
+        else {                  /* if the target is metric, */
+          d = (double)res.f -((type == AT_INT)    /* sum the */
+            ? (double)trg->i : (double)trg->f);   /* squared */
+          *e += w *d*d;         /* errors */
+        }
+      }
+      if (p > 0) dt_delete(dt, 0);
+    }                           /* delete the pruned copy */
+    dt_delete(trees[k], 0);     /* delete the grown tree */
+    if (p <= pcnt) break;       /* check for a pruning error */
+  }
+  while (++k < folds) dt_delete(trees[k], 0);
+  free(trees);                  /* delete the remaining trees */
+  if (p <= pcnt) { free(errs); return E_NOMEM; }
+  fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t));
+
+  /* --- report the errors --- */
+  fprintf(stderr, "fold     weight");
+  for (p = 0; p <= pcnt; p++) { /* print a table header */
+    if (p <= 0) fprintf(stderr, "    grown  nodes");
+    else        fprintf(stderr, "  c=%-5g  nodes", prune[p-1]);
+  }                             /* (one column per pruning param.) */
+  fputc('\n', stderr);
+  for (k = 0; k <= folds; k++) {/* traverse the folds and the total */
+    if (k < folds) fprintf(stderr, "%4d", k+1);
+    else           fprintf(stderr, " all");
+    for (w = 0, c = 0; c < folds; c++)
+      if ((k >= folds) || (c == k)) w += wgts[c];
+    fprintf(stderr, " %10g", w);/* print the weight of the fold(s) */
+    for (p = 0; p <= pcnt; p++) {
+      e = errs +p *folds; s = size +p *folds;
+      for (d = 0, c = 0; c < folds; c++)
+        if ((k >= folds) || (c == k)) d += e[c];
+      fprintf(stderr, (type == AT_NOM) ? "  %6.2f%%" : "  %7.4g",
+              (w > 0) ? ((type == AT_NOM) ? 100 *d/w : d/w) : 0);
+      for (d = 0, c = 0; c < folds; c++)
+        if ((k >= folds) || (c == k)) d += s[c];
+      fprintf(stderr, " %6.1f", (k < folds) ? d : d/folds);
+    }                           /* print errors and tree sizes */
+    fputc('\n', stderr);        /* (error rates for a nominal target, */
+  }                             /* mean squared errors otherwise) */
+  free(errs);                   /* delete the error array */
+  return 0;                     /* return 'ok' */
+}  /* xval() */
+
+/*----------------------------------------------------------------------
+The function xval() replaces a cross-validation with the programs
+tsplit, tmerge, dti and dtx (see the script ex/xval.sh): the tuples
+of the (not reduced) table are shuffled and, for a nominal target,
+sorted w.r.t. the class, and then assigned to the folds round robin
+by setting their marks, so that the folds are stratified. All trees
+are grown by dt_xval() (in parallel, on one training matrix), each
+tree is evaluated on the tuples of its fold, and optionally copies of
+it are pruned with confidence level pruning for each of the given
+parameters and evaluated as well. For each fold and for all folds
+together the error rate (nominal target) or the mean squared error
+(metric target) and the number of nodes (average for all folds) are
+reported.
+----------------------------------------------------------------------*/
+
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
@@ -456,6 +643,7 @@ int main (int argc, char* argv[])
   CCHAR   *trgname = NULL;      /* name of the target attribute */
   ATTID   trgid    = -1;        /* id/index of target column */
   CCHAR   *mname   = NULL;      /* name of att. selection measure */
+  CCHAR   *pnames  = NULL;      /* list of pruning parameters */
   int     measure  = 3;         /* attribute selection measure */
   int     wgtd     = FEF_WGTD;  /* flag for weighted measure */
   double  params[] = { 0, 0 };  /* selection measure parameters */
@@ -466,6 +654,12 @@ int main (int argc, char* argv[])
   int     verbose  = 0;         /* flag for verbose reporting */
   int     mode     = AS_ATT|AS_NOXATT; /* table file read mode */
   int     flags    = 0;         /* flags, e.g. DF_SUBSET */
+  int     bincnt   = 0;         /* number of bins for metric atts. */
+  int     thcnt    = 1;         /* number of threads */
+  int     folds    = 0;         /* number of cross-validation folds */
+  double  prune[MAXPRUNE];      /* pruning parameters (conf. levels) */
+  int     pcnt     = 0;         /* number of pruning parameters */
+  long    seed;                 /* seed for random numbers */
   int     balance  = 0;         /* flag for balancing class freqs. */
   int     maxlen   = 0;         /* maximal output line length */
   int     desc     = 0;         /* description mode */
@@ -481,6 +675,7 @@ int main (int argc, char* argv[])
   clock_t t;                    /* timer for measurements */
 
   prgname = argv[0];            /* get program name for error msgs. */
+  seed    = (long)time(NULL);   /* and get a default seed value */
 
   /* --- print startup/usage message --- */
   if (argc > 1) {               /* if arguments are given */
@@ -520,6 +715,26 @@ int main (int argc, char* argv[])
     printf("-s       try to form subsets on nominal attributes\n");
     printf("-B       enforce binary subsets splits (with -s)\n");
     printf("-g       do not do basic pruning of grown tree\n");
+    printf("-H#      number of bins for metric attributes   "
+                    "(default: %d)\n", bincnt);
+    printf("         (histogram-based cuts, at most 255 bins,\n");
+    printf("         <= 0: exact cuts)\n");
+    #ifdef USE_THREADS
+    printf("-T#      number of threads                      "
+                    "(default: %d)\n", thcnt);
+    printf("         (for attribute evaluation/selection, subtrees,\n");
+    printf("         folds, <= 0: number of processors)\n");
+    #endif
+    printf("-X#      number of cross-validation folds       "
+                    "(default: none)\n");
+    printf("         (report errors on folds before growing "
+                    "the final tree)\n");
+    printf("-P#      list of pruning confidence levels      "
+                    "(default: none)\n");
+    printf("         (comma separated, e.g. 0.1,0.25,0.5; "
+                    "only with -X#)\n");
+    printf("-S#      seed value for random number generator "
+                    "(default: time)\n");
     printf("-v#      file name of validation data set       "
                     "(default: none)\n");
     printf("         (for a forward selection of attributes,\n");
@@ -558,7 +773,7 @@ int main (int argc, char* argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
 
-  /* remaining option characters: o A[D-Q][S-U][W-Z] */
+  /* remaining option characters: o A[D-G][I-O]QUW[YZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse arguments */
@@ -580,6 +795,11 @@ int main (int argc, char* argv[])
           case 's': flags    |= DT_SUBSET;               break;
           case 'B': flags    |= DT_BINARY;               break;
           case 'g': flags    |= DT_NOPRUNE;              break;
+          case 'H': bincnt    =   (int)strtol(s, &s, 0); break;
+          case 'T': thcnt     =   (int)strtol(s, &s, 0); break;
+          case 'X': folds     =   (int)strtol(s, &s, 0); break;
+          case 'P': optarg    = &pnames;                 break;
+          case 'S': seed      =        strtol(s, &s, 0); break;
           case 'v': optarg    = &fn_val;                 break;
           case 'm': maxsel    =   (int)strtol(s, &s, 0); break;
           case 'V': verbose   = 1;                       break;
@@ -619,6 +839,18 @@ int main (int argc, char* argv[])
   if  (!fn_tab || !*fn_tab) i++;/* check assignments of stdin: */
   if (i > 1) error(E_STDIN);    /* stdin must not be used twice */
   if (mincnt < 0) error(E_MINCNT, mincnt);
+  if ((folds < 0) || (folds == 1)) error(E_FOLDS, folds);
+  if (pnames) {                 /* if pruning parameters are given */
+    for (s = (char*)pnames; *s; ) {
+      if (pcnt >= MAXPRUNE) error(E_PRUNE, pnames);
+      prune[pcnt] = strtod(s, &s);
+      if ((prune[pcnt] <= 0) || (prune[pcnt] > 1))
+        error(E_PRUNE, pnames); /* get and check the next parameter */
+      pcnt++;                   /* (confidence levels in (0,1]) */
+      if      (*s == ',') s++;  /* skip a separator */
+      else if (*s)    error(E_PRUNE, pnames);
+    }                           /* check for a valid list */
+  }
   if ((        balance  !=  0)  && (tolower(balance) != 'l')
   &&  (tolower(balance) != 'b') && (tolower(balance) != 's'))
     error(E_BALANCE, balance);  /* check the balancing mode */
@@ -692,7 +924,11 @@ int main (int argc, char* argv[])
   t = clock();                  /* start timer, print log message */
   fprintf(stderr, "reducing%s table ... ",
                   (balance) ? " and balancing" : "");
-  n = tab_reduce(table);        /* reduce table for speed up */
+  n = (folds > 0)               /* reduce table for speed up */
+    ? tab_tplcnt(table) : tab_reduce(table);
+                                /* (but not for cross-validation, */
+                                /* so that equal tuples can be */
+                                /* distributed over the folds) */
   w = tab_tplwgt(table);        /* and get the total weight */
   if (balance                   /* if the balance flag is set */
   && (att_type(as_att(attset, trgid)) == AT_NOM)) {
@@ -709,7 +945,7 @@ int main (int argc, char* argv[])
   /* --- forward selection of attributes --- */
   if (valid) {                  /* if to select attributes */
     fwdsel(table, valid, trgid, measure, params, minval,
-           maxht, mincnt, flags, maxsel, verbose);
+           maxht, mincnt, flags, bincnt, thcnt, maxsel, verbose);
     /* The result of the attribute selection is represented  */
     /* by attribute markers in the underlying attribute set. */
     tab_delete(valid, 0);       /* delete the validation data */
@@ -727,13 +963,20 @@ int main (int argc, char* argv[])
     free(perm);                 /* to the front of the table */
   }                             /* and delete permutation array */
 
+  /* --- cross-validation --- */
+  if (folds > 0) {              /* if to do a cross-validation */
+    k = xval(table, trgid, measure, params, minval, maxht, mincnt,
+             flags & ~DT_EVAL, bincnt, thcnt, folds, prune, pcnt, seed);
+    if (k != 0) error(k);       /* grow and evaluate the trees */
+  }                             /* on the folds of the table */
+
   /* --- grow (final) decision/regression tree --- */
   t = clock();                  /* start timer, print log message */
   fprintf(stderr, "growing %s tree ... ",
           (att_type(att) == AT_NOM) ? "decision" : "regression");
   if (flags & DT_EVAL) maxht = 2;
   dtree = dt_grow(table, trgid, measure, params, minval,
-                  maxht, mincnt, flags);
+                  maxht, mincnt, flags, bincnt, thcnt);
   if (!dtree) error(E_NOMEM);   /* grow decision/regression tree */
   used  = dt_attchk(dtree);     /* mark occuring attributes */
   maxht = dt_height(dtree);     /* get the height of the tree */
@@ -29,6 +29,13 @@
             2013.08.23 adapted to definitions ATTID, VALID, TPLID etc.
             2015.09.30 functions dt_supp() and dt_conf() added
             2015.11.12 parameter thsel added to function dt_prune()
+            2026.10.17 parameter thcnt added to function dt_grow()
+            2026.10.17 parameter bincnt added to function dt_grow()
+            2026.10.17 function dt_forest() added (random forests)
+            2026.10.17 function dt_boost() added (gradient boosting)
+            2026.10.17 function dt_xval() added (cross-validation)
+            2026.10.17 function dt_clone() added (copy a tree)
+            2026.10.17 function dt_cands() added (attribute selection)
 ----------------------------------------------------------------------*/
 #ifndef __DTREE__
 #define __DTREE__
@@ -66,6 +73,10 @@
 #define PM_CLVL     2           /* confidence level pruning */
 #define PM_MDL      3           /* minimum description length pruning */
                                 /* (PM_MDL not implemented yet) */
+/* --- boosting loss functions --- */
+#define LS_SQUARED  0           /* squared error (metric target) */
+#define LS_LOGISTIC 1           /* logistic loss (two classes) */
+#define LS_MULTI    2           /* multinomial (softmax) loss */
 /* --- flags/modes --- */
 #define DT_LEAF     0x0100      /* whether node is a leaf */
 #define DT_LINK     0x0200      /* whether node contains links */
@@ -131,11 +142,14 @@ typedef struct {                /* --- decision tree --- */
   TUPLE  *tuple;                /* tuple to classify */
 } DTREE;                        /* (decision tree) */
 
+typedef int DT_EVALFN (DTREE *dt, ATTID attid, void *data);
+
 /*----------------------------------------------------------------------
   Functions
 ----------------------------------------------------------------------*/
 extern DTREE*   dt_create (ATTSET *attset, ATTID trgid);
 extern void     dt_delete (DTREE *dt, int delas);
+extern DTREE*   dt_clone  (const DTREE *dt);
 extern ATTSET*  dt_attset (DTREE *dt);
 extern ATT*     dt_target (DTREE *dt);
 extern ATTID    dt_trgid  (DTREE *dt);
@@ -170,7 +184,29 @@ extern ATTID    dt_attcnt (DTREE *dt);
 #ifdef DT_GROW
 extern DTREE*   dt_grow   (TABLE *table, ATTID trgid,
                            int measure, double *params, double minval,
-                           ATTID maxht, double mincnt, int flags);
+                           ATTID maxht, double mincnt, int flags,
+                           int bincnt, int thcnt);
+extern int      dt_forest (TABLE *table, ATTID trgid,
+                           int measure, double *params, double minval,
+                           ATTID maxht, double mincnt, int flags,
+                           int bincnt, ATTID subcnt,
+                           DTREE **trees, int cnt, unsigned int seed,
+                           double *oob, int thcnt);
+extern int      dt_boost  (TABLE *table, ATTID trgid, int loss,
+                           double rate, ATTID maxht, double mincnt,
+                           int flags, int bincnt,
+                           DTREE **trees, int cnt, double *init,
+                           double *err, int thcnt);
+extern int      dt_xval   (TABLE *table, ATTID trgid,
+                           int measure, double *params, double minval,
+                           ATTID maxht, double mincnt, int flags,
+                           int bincnt, DTREE **trees, int cnt,
+                           int thcnt);
+extern int      dt_cands  (TABLE *table, ATTID trgid,
+                           int measure, double *params, double minval,
+                           ATTID maxht, double mincnt, int flags,
+                           int bincnt, const ATTID *cands, int cnt,
+                           DT_EVALFN *eval, void *data, int thcnt);
 #endif
 #ifdef DT_PRUNE
 extern int      dt_prune  (DTREE *dt, int method, double param,
@@ -206,7 +242,7 @@ extern RULESET* dt_rules  (DTREE *dt);
 #define dt_atleaf(t)     ((t)->curr && ((t)->curr->flags & DT_LEAF))
 #define dt_attid(t)      (((t)->curr) ? (t)->curr->attid : -1)
 #define dt_width(t)      (((t)->curr) ? (t)->curr->size  : -1)
-#define dt_cutval(t)     (((t)->curr) ? (t)->curr->cut   : UV_FLT)
+#define dt_cutval(t)     (((t)->curr) ? (t)->curr->cut   : NV_FLT)
 #define dt_freq(t)       (((t)->curr) ? (t)->curr->frq   : -1)
 #define dt_mfcls(t)      (((t)->curr) ? (t)->curr->trg.n : -1)
 #define dt_value(t)      (((t)->curr) ? (t)->curr->trg.f : -1)
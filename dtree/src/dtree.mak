@@ -5,6 +5,10 @@
 # History : 2003.01.27 file created
 #           2006.07.20 adapted to Visual Studio 8
 #           2016.04.20 completed dependencies on header files
+#           2026.10.17 forest programs 'dtf' and 'dfx' added
+#           2026.10.17 boosting programs 'dtb' and 'dbx' added
+#           2026.10.17 pruning objects added to DTI_O (cross-valid.)
+#           2026.10.17 object dtree2.obj (growing and pruning) added
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\dtree\src
 UTILDIR  = ..\..\util\src
@@ -33,8 +37,13 @@ OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\escape.obj   \
            $(TABLEDIR)\attset1.obj $(TABLEDIR)\attset2.obj \
            $(TABLEDIR)\attset3.obj
 TABOBJS  = $(TABLEDIR)\table1.obj  $(TABLEDIR)\tab2ro.obj
-DTI_O    = $(MATHDIR)\gamma.obj    $(OBJS) $(TABOBJS) \
-           ft_eval.obj vt_eval.obj dtree1.obj dt_grow.obj dti.obj
+DTI_O    = $(MATHDIR)\gamma.obj    $(MATHDIR)\normal.obj \
+           $(UTILDIR)\random.obj   $(OBJS) $(TABOBJS) \
+           ft_eval.obj vt_eval.obj dtree1.obj dtree2.obj dti.obj
+DTF_O    = $(MATHDIR)\gamma.obj    $(UTILDIR)\random.obj \
+           $(OBJS) $(TABOBJS) \
+           ft_eval.obj vt_eval.obj dtree1.obj dt_grow.obj \
+           forest.obj dtf.obj
 DTP_O    = $(MATHDIR)\normal.obj   $(OBJS) $(TABOBJS) \
            frqtab.obj vartab.obj dt_exec.obj dt_prune.obj dtp.obj
 DTX_O    = $(UTILDIR)\tabwrite.obj $(OBJS) $(TABOBJS) \
@@ -42,7 +51,16 @@ DTX_O    = $(UTILDIR)\tabwrite.obj $(OBJS) $(TABOBJS) \
 DTR_O    = $(OBJS) rules.obj dt_rule.obj dtr.obj
 RSX_O    = $(UTILDIR)\tabwrite.obj $(OBJS) $(TABOBJS) \
            rs_pars.obj rsx.obj
-PRGS     = dti.exe dtp.exe dtx.exe dtr.exe rsx.exe
+DFX_O    = $(UTILDIR)\tabwrite.obj $(OBJS) $(TABOBJS) \
+           dt_exec.obj df_pars.obj dfx.obj
+DTB_O    = $(MATHDIR)\gamma.obj    $(UTILDIR)\random.obj \
+           $(OBJS) $(TABOBJS) \
+           ft_eval.obj vt_eval.obj dtree1.obj dt_grow.obj \
+           boost.obj dtb.obj
+DBX_O    = $(UTILDIR)\tabwrite.obj $(OBJS) $(TABOBJS) \
+           dt_exec.obj db_pars.obj dbx.obj
+PRGS     = dti.exe dtp.exe dtx.exe dtr.exe rsx.exe dtf.exe dfx.exe \
+           dtb.exe dbx.exe
 
 #-----------------------------------------------------------------------
 # Build Programs
@@ -64,11 +82,23 @@ dtr.exe:      $(DTR_O) dtree.mak
 rsx.exe:      $(RSX_O) dtree.mak
 	$(LD) $(LDFLAGS) $(RSX_O) $(LIBS) /out:$@
 
+dtf.exe:      $(DTF_O) dtree.mak
+	$(LD) $(LDFLAGS) $(DTF_O) $(LIBS) /out:$@
+
+dfx.exe:      $(DFX_O) dtree.mak
+	$(LD) $(LDFLAGS) $(DFX_O) $(LIBS) /out:$@
+
+dtb.exe:      $(DTB_O) dtree.mak
+	$(LD) $(LDFLAGS) $(DTB_O) $(LIBS) /out:$@
+
+dbx.exe:      $(DBX_O) dtree.mak
+	$(LD) $(LDFLAGS) $(DBX_O) $(LIBS) /out:$@
+
 #-----------------------------------------------------------------------
 # Main Programs
 #-----------------------------------------------------------------------
-dti.obj:      $(HDRS) $(UTILDIR)\arrays.h frqtab.h vartab.h dtree.h
-dti.obj:      dti.c dtree.mak
+dti.obj:      $(HDRS) $(UTILDIR)\arrays.h $(UTILDIR)\random.h
+dti.obj:      frqtab.h vartab.h dtree.h dti.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) dti.c /Fo$@
 
 dtp.obj:      $(HDRS) frqtab.h vartab.h dtree.h
@@ -87,6 +117,22 @@ rsx.obj:      $(HDRS) $(UTILDIR)\tabwrite.h rules.h
 rsx.obj:      rules.h rsx.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) rsx.c /Fo$@
 
+dtf.obj:      $(HDRS) frqtab.h vartab.h dtree.h forest.h
+dtf.obj:      dtf.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) dtf.c /Fo$@
+
+dfx.obj:      $(HDRS) $(UTILDIR)\tabwrite.h frqtab.h vartab.h
+dfx.obj:      dtree.h forest.h dfx.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) dfx.c /Fo$@
+
+dtb.obj:      $(HDRS) frqtab.h vartab.h dtree.h boost.h
+dtb.obj:      dtb.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) dtb.c /Fo$@
+
+dbx.obj:      $(HDRS) $(UTILDIR)\tabwrite.h frqtab.h vartab.h
+dbx.obj:      dtree.h boost.h dbx.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) dbx.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Frequency Table Management
 #-----------------------------------------------------------------------
@@ -114,7 +160,7 @@ dtree1.obj:   $(HDRS_1) frqtab.h vartab.h
 dtree1.obj:   $(HDRS) dtree1.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) dtree1.c /Fo$@
 
-dt_grow.obj:  $(HDRS_2) frqtab.h vartab.h
+dt_grow.obj:  $(HDRS_2) $(UTILDIR)\random.h frqtab.h vartab.h
 dt_grow.obj:  $(HDRS) dtree2.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) /D DT_GROW dtree2.c /Fo$@
 
@@ -122,6 +168,10 @@ dt_prune.obj: $(HDRS_2) frqtab.h vartab.h
 dt_prune.obj: $(HDRS) $(MATHDIR)\normal.h dtree2.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) /D DT_PRUNE dtree2.c /Fo$@
 
+dtree2.obj:   $(HDRS_2) $(UTILDIR)\random.h frqtab.h vartab.h
+dtree2.obj:   $(HDRS) $(MATHDIR)\normal.h dtree2.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) /D DT_GROW /D DT_PRUNE dtree2.c /Fo$@
+
 dt_exec.obj:  $(HDRS_1) frqtab.h vartab.h
 dt_exec.obj:  $(HDRS) dtree1.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) /D DT_PARSE dtree1.c /Fo$@
@@ -130,6 +180,28 @@ dt_rule.obj:  $(HDRS_1) frqtab.h vartab.h rules.h
 dt_rule.obj:  $(HDRS) dtree1.c dtree.mak
 	$(CC) $(CFLAGS) $(INCS) /D DT_PARSE /D DT_RULES dtree1.c /Fo$@
 
+#-----------------------------------------------------------------------
+# Decision and Regression Forest Management
+#-----------------------------------------------------------------------
+forest.obj:   $(HDRS_1) frqtab.h vartab.h
+forest.obj:   dtree.h forest.h forest.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) forest.c /Fo$@
+
+df_pars.obj:  $(HDRS_1) frqtab.h vartab.h
+df_pars.obj:  dtree.h forest.h forest.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) /D DF_PARSE forest.c /Fo$@
+
+#-----------------------------------------------------------------------
+# Boosted Regression Trees Management
+#-----------------------------------------------------------------------
+boost.obj:    $(HDRS_1) frqtab.h vartab.h
+boost.obj:    dtree.h boost.h boost.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) boost.c /Fo$@
+
+db_pars.obj:  $(HDRS_1) frqtab.h vartab.h
+db_pars.obj:  dtree.h boost.h boost.c dtree.mak
+	$(CC) $(CFLAGS) $(INCS) /D DB_PARSE boost.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Rule and Rule Set Management
 #-----------------------------------------------------------------------
@@ -164,6 +236,10 @@ $(UTILDIR)\scanner.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak scanner.obj
 	cd $(THISDIR)
+$(UTILDIR)\random.obj:
+	cd $(UTILDIR)
+	$(MAKE) /f util.mak random.obj
+	cd $(THISDIR)
 $(UTILDIR)\parser.obj:
 	cd $(UTILDIR)
 	$(MAKE) /f util.mak parser.obj
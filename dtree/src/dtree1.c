@@ -29,6 +29,7 @@
             2011.07.28 adapted to modified attset and utility modules
             2013.08.23 adapted to definitions ATTID, VALID, TPLID etc.
             2014.10.22 bug in function dt_exec() fixed (support)
+            2026.10.17 function dt_clone() added (copy a tree)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -115,6 +116,36 @@ static void delete (DTNODE *node)
 
 /*--------------------------------------------------------------------*/
 
+static DTNODE* clone (const DTNODE *node)
+{                               /* --- recursively copy a subtree */
+  VALID  i;                     /* loop variable */
+  size_t z;                     /* size of the node */
+  DTNODE *dup;                  /* created copy of the node */
+
+  assert(node);                 /* check the function argument */
+  z   = sizeof(DTNODE) -sizeof(DTDATA)
+      + (size_t)node->size *sizeof(DTDATA);
+  dup = (DTNODE*)malloc(z);     /* create a node of the same size */
+  if (!dup) return NULL;        /* and copy the node data */
+  memcpy(dup, node, z);         /* (incl. the class frequencies) */
+  if (node->flags & DT_LEAF)    /* if the node is a leaf, */
+    return dup;                 /* there are no children to copy */
+  for (i = 0; i < node->size; i++) {
+    if (islink(node->data+i, node))
+      dup->data[i].link = dup->data +(node->data[i].link -node->data);
+    else dup->data[i].child = NULL;
+  }                             /* redirect the links to the copy */
+  for (i = 0; i < node->size; i++) {
+    if (!node->data[i].child || islink(node->data+i, node))
+      continue;                 /* traverse the children */
+    dup->data[i].child = clone(node->data[i].child);
+    if (!dup->data[i].child) { delete(dup); return NULL; }
+  }                             /* recursively copy the subtrees */
+  return dup;                   /* return the created copy */
+}  /* clone() */
+
+/*--------------------------------------------------------------------*/
+
 static void aggr (DTNODE *node, VALID n, double *buf)
 {                               /* --- aggregate node data */
   VALID  i, k;                  /* loop variables */
@@ -258,6 +289,35 @@ void dt_delete (DTREE *dt, int delas)
 
 /*--------------------------------------------------------------------*/
 
+DTREE* dt_clone (const DTREE *dt)
+{                               /* --- clone a decision tree */
+  DTREE *dup;                   /* created clone */
+
+  assert(dt);                   /* check the function argument */
+  dup = dt_create(dt->attset, dt->trgid);
+  if (!dup) return NULL;        /* create an empty tree */
+  if (dt->root) {               /* if the tree is not empty, */
+    dup->root = clone(dt->root);/* copy the nodes recursively */
+    if (!dup->root) { dt_delete(dup, 0); return NULL; }
+  }                             /* (on failure delete the clone) */
+  dup->curr   = dup->root;      /* set the node cursor to the root */
+  dup->attcnt = dt->attcnt;     /* copy the tree information */
+  dup->height = dt->height;     /* (number of attributes, height, */
+  dup->size   = dt->size;       /* number of nodes, and */
+  dup->total  = dt->total;      /* total frequency) */
+  return dup;                   /* return the created clone */
+}  /* dt_clone() */
+
+/*----------------------------------------------------------------------
+The function dt_clone() creates a deep copy of a decision/regression
+tree that refers to the same attribute set (links between branches of
+a node are redirected to the copy). The clone can be pruned (see
+function dt_prune()) without affecting the original tree. Attribute
+evaluations and cut values (DT_EVAL) are not copied.
+----------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+
 void dt_up (DTREE *dt, int root)
 {                               /* --- go up in decision tree */
   assert(dt);                   /* check argument */
@@ -43,15 +43,34 @@
             2013.08.23 adapted to definitions ATTID, VALID, TPLID etc.
             2015.11.12 parameter thsel added to function dt_prune()
             2016.11.11 static variables eliminated from functions
+            2026.10.17 presorted index lists for metric attributes added
+            2026.10.17 parallel attribute evaluation (param. thcnt)
+            2026.10.17 parallel growing of subtrees (pool of contexts)
+            2026.10.17 used flags of nominal attributes reset after test
+            2026.10.17 histogram-based cuts for metric atts. (bincnt)
+            2026.10.17 columnar training matrix (rows instead of tuples)
+            2026.10.17 function dt_forest() added (random forests)
+            2026.10.17 function dt_boost() added (gradient boosting)
+            2026.10.17 ordered binary subsets for two classes/metric trg.
+            2026.10.17 ordered subsets only for exact measures (gain/Gini/sse)
+            2026.10.17 function dt_xval() added (cross-validation)
+            2026.10.17 function dt_cands() added (attribute selection)
+            2026.10.17 adapt() copies the node instead of using realloc()
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <math.h>
 #include <assert.h>
 #include "arrays.h"
 #include "normal.h"
+#include "random.h"
 #include "dtree.h"
+#ifdef USE_THREADS
+#include "gamma.h"
+#include "threads.h"
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -63,10 +82,42 @@
 #define EPSILON     1e-6        /* to handle roundoff errors */
 #define MINERROR    0.1         /* minimum error for division */
 #define MAXFACT     1e6         /* maximum factor for error estim. */
+#define THRMIN      1024        /* min. number of tuples for threads */
+#define BINNULL     UCHAR_MAX   /* bin code for a null value */
+#define NOVWGT      1e-12       /* weight for non-occurring values */
+#define DT_GRAD     0x4000      /* grow on gradients (boosting) */
+#define MAXSCORE    30.0        /* maximal absolute score (boosting) */
+
+/*--------------------------------------------------------------------*/
+
+#define int         1           /* to check definitions */
+#define long        2           /* for certain types */
+#define ptrdiff_t   3
+
+#if   TPLID==int                /* sort function for row indices */
+#define row_qsort   i2c_qsort   /* (with a comparison function) */
+#elif TPLID==long
+#define row_qsort   l2c_qsort
+#else
+#define row_qsort   x2c_qsort
+#endif
+
+#if   VALID==int                /* sort function for value ids. */
+#define val_qsort   i2c_qsort   /* (with a comparison function) */
+#elif VALID==long
+#define val_qsort   l2c_qsort
+#else
+#define val_qsort   x2c_qsort
+#endif
+
+#undef int                      /* remove preprocessor definitions */
+#undef long                     /* needed for the type checking */
+#undef ptrdiff_t
 
 /* --- functions --- */
 #define islink(d,n) (((d)->link >= (n)->data) && \
                      ((d)->link <  (n)->data +(n)->size))
+#define treeseed(s,i) ((s) +(unsigned int)(i) *2654435761U)
 
 /*----------------------------------------------------------------------
   Type Definitions
@@ -77,19 +128,75 @@ typedef struct {                /* --- tuple selection info. --- */
   DTINT  ival;                  /* column value (integer) */
   double fval;                  /* column value (float) */
   DTDATA *data;                 /* data array of the current node */
+  const INST *vals;             /* column of the training matrix */
 } TSEL;                         /* (tuple selection information) */
 
 typedef TPLID  GRPFN  (TUPLE **tpls, TPLID n, const TSEL *tsel);
+typedef TPLID  ROWFN  (TPLID *rows, TPLID n, const TSEL *tsel);
+typedef int    ROWCMPFN (TPLID r1, TPLID r2, void *data);
 typedef double ESTFN  (DTREE *dtree, double n, double e);
 
+typedef struct {                /* --- bins of a metric attribute --- */
+  int           cnt;            /* number of bins */
+  unsigned char *codes;         /* bin codes (indexed by tuple id) */
+  double        *min;           /* minimum values of the bins */
+  double        *max;           /* maximum values of the bins */
+} BINS;                         /* (bins of a metric attribute) */
+
 typedef struct grow   *PGROW;   /* to avoid warning in def. of EVALFN */
-typedef double EVALFN (PGROW gi, TUPLE **tpls, TPLID n,
+typedef double EVALFN (PGROW gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut);
 
+#ifdef USE_THREADS
+typedef struct {                /* --- pool of grow contexts --- */
+  THRMUTEX mutex;               /* mutex for the idle contexts */
+  int      cnt;                 /* number of idle contexts */
+  PGROW    idle[THR_MAX];       /* idle (unused) grow contexts */
+} CTXPOOL;                      /* (pool of grow contexts) */
+
+typedef struct {                /* --- attribute evaluation worker --- */
+  PGROW    gi;                  /* grow context of the worker */
+  TPLID    *rows;               /* rows of the current node */
+  TPLID    n;                   /* number of rows */
+  ATTID    *next;               /* next attribute to evaluate */
+  THRMUTEX *mutex;              /* mutex for the attribute counter */
+  ATTID    col;                 /* best attribute found by worker */
+  double   best;                /* worth of the best attribute */
+  double   cut;                 /* cut value of the best attribute */
+} EVALWORK;                     /* (attribute evaluation worker) */
+
+typedef struct {                /* --- subtree growing task --- */
+  PGROW    gi;                  /* grow context of the task */
+  DTDATA   *data;               /* branch with the leaf to grow */
+  TPLID    *rows;               /* rows of the subtree */
+  TPLID    n;                   /* number of rows */
+  double   err;                 /* number of errors of the subtree */
+  int      done;                /* whether the task was executed */
+} GROWTASK;                     /* (subtree growing task) */
+
+typedef struct {                /* --- forest/fold/cand. worker --- */
+  PGROW    gi;                  /* shared grow information */
+  PGROW    w;                   /* bagging context of the worker */
+  TPLID    n;                   /* number of rows */
+  DTREE    **trees;             /* array of trees to grow */
+  int      cnt;                 /* number of trees to grow */
+  int      *next;               /* next tree to grow */
+  THRMUTEX *mutex;              /* mutex for the tree counter */
+  unsigned int seed;            /* seed for the random numbers */
+  const int *folds;             /* fold indices of the rows */
+  const ATTID *cands;           /* candidate attributes */
+  DT_EVALFN *eval;              /* tree evaluation function */
+  void     *data;               /* data for evaluation function */
+  int      err;                 /* error status of the worker */
+} BAGWORK;                      /* (forest/fold/candidate worker) */
+#endif
+
 typedef struct grow {           /* --- tree grow information --- */
   DTREE  *dtree;                /* current decision/regression tree */
   ATTSET *attset;               /* attribute set of decision tree */
-  TUPLE  **tpls;                /* array of tuples with known class */
+  TPLID  *rows;                 /* rows of tuples with known class */
+  INST   **cols;                /* columns of the training matrix */
+  WEIGHT *wgts;                 /* weights of the rows */
   EVALFN *eval_nom;             /* eval. function for nominal atts. */
   EVALFN *eval_met;             /* eval. function for metric  atts. */
   void   *curr;                 /* freq./var. table for current att. */
@@ -107,6 +214,23 @@ typedef struct grow {           /* --- tree grow information --- */
   char   *used;                 /* used flags for attributes */
   double *evals;                /* evaluations of attributes */
   double *cuts;                 /* cut values of attributes */
+  TPLID  **lists;               /* presorted lists of metric atts. */
+  TPLID  *buf;                  /* buffer for partitioning lists */
+  char   *sel;                  /* selection flags (per row) */
+  BINS   *bins;                 /* bins of metric attributes */
+  int    bincnt;                /* maximal number of bins */
+  void   *hist;                 /* freq./var. table for histograms */
+  const INST *trgs;             /* target column (or gradients) */
+  INST   *grad;                 /* gradients/residuals (boosting) */
+  VALID  maxcnt;                /* maximal number of values */
+  RNG    *rng;                  /* random number generator (forest) */
+  ATTID  subcnt;                /* number of attributes per node */
+#ifdef USE_THREADS
+  int      thcnt;               /* number of threads */
+  CTXPOOL  *pool;               /* pool of idle grow contexts */
+  PGROW    *ctxs;               /* all additional grow contexts */
+#endif
+  size_t size;                  /* size of this structure (bytes) */
   VALID  sets[1];               /* index array for value subsets */
 } GROW;                         /* (tree grow information) */
 
@@ -126,6 +250,107 @@ typedef struct {                /* --- tree pruning information --- */
 /*----------------------------------------------------------------------
   Grouping Functions
 ----------------------------------------------------------------------*/
+#ifdef DT_GROW
+
+static TPLID row_nom (TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group nominal values */
+  TPLID *src, *dst, t;          /* source and destination, buffer */
+
+  assert(rows && tsel && (n >= 0));   /* check the function arguments */
+  for (src = dst = rows; --n >= 0; src++)
+    if (tsel->vals[*src].n == tsel->nval) {
+      t = *src; *src = *dst; *dst++ = t; }
+  return (TPLID)(dst -rows);    /* group qualifying rows */
+}  /* row_nom() */              /* and return their number */
+
+/*--------------------------------------------------------------------*/
+
+static TPLID row_set (TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group a set of values */
+  TPLID *src, *dst, t;          /* source and destination, buffer */
+  VALID i;                      /* check value and link */
+
+  assert(rows && tsel && (n >= 0));   /* check the function arguments */
+  for (src = dst = rows; --n >= 0; src++)
+    if (((i = tsel->vals[*src].n) == tsel->nval)
+    ||  (tsel->data[i].link -tsel->data == tsel->nval)) {
+      t = *src; *src = *dst; *dst++ = t; }
+  return (TPLID)(dst -rows);    /* group qualifying rows */
+}  /* row_set() */              /* and return their number */
+
+/*--------------------------------------------------------------------*/
+
+static TPLID row_nullint (TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group null values (integer) */
+  TPLID *src, *dst, t;          /* source and destination, buffer */
+
+  assert(rows && tsel && (n >= 0));   /* check the function arguments */
+  for (src = dst = rows; --n >= 0; src++)
+    if (isnull(tsel->vals[*src].i)) {
+      t = *src; *src = *dst; *dst++ = t; }
+  return (TPLID)(dst -rows);    /* group qualifying rows */
+}  /* row_nullint() */          /* and return their number */
+
+/*--------------------------------------------------------------------*/
+
+static TPLID row_int (TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group greater than (integer) */
+  TPLID *src, *dst, t;          /* source and destination, buffer */
+
+  assert(rows && tsel && (n >= 0));   /* check the function arguments */
+  for (src = dst = rows; --n >= 0; src++)
+    if (tsel->vals[*src].i > tsel->ival) {
+      t = *src; *src = *dst; *dst++ = t; }
+  return (TPLID)(dst -rows);    /* group qualifying rows */
+}  /* row_int() */              /* and return their number */
+
+/*--------------------------------------------------------------------*/
+
+static TPLID row_nullflt (TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group null values (float) */
+  TPLID *src, *dst, t;          /* source and destination, buffer */
+
+  assert(rows && tsel && (n >= 0));   /* check the function arguments */
+  for (src = dst = rows; --n >= 0; src++)
+    if (isnan(tsel->vals[*src].f)) {
+      t = *src; *src = *dst; *dst++ = t; }
+  return (TPLID)(dst -rows);    /* group qualifying rows */
+}  /* row_nullflt() */          /* and return their number */
+
+/*--------------------------------------------------------------------*/
+
+static TPLID row_flt (TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group greater than (float) */
+  TPLID *src, *dst, t;          /* source and destination, buffer */
+
+  assert(rows && tsel && (n >= 0));   /* check the function arguments */
+  for (src = dst = rows; --n >= 0; src++)
+    if (tsel->vals[*src].f > tsel->fval) {
+      t = *src; *src = *dst; *dst++ = t; }
+  return (TPLID)(dst -rows);    /* group qualifying rows */
+}  /* row_flt() */              /* and return their number */
+
+/*--------------------------------------------------------------------*/
+
+static void mul_row (WEIGHT *wgts, const TPLID *rows, TPLID n, double f)
+{                               /* --- multiply row weights */
+  assert(wgts && rows && (n >= 0));   /* check the function arguments */
+  while (--n >= 0)              /* multiply with weighting factor */
+    wgts[rows[n]] *= (WEIGHT)f;
+}  /* mul_row() */
+
+/*----------------------------------------------------------------------
+The functions row_nom() to row_flt() are the counterparts of the
+functions grp_nom() to grp_flt() for the columnar training matrix that
+is used for growing a tree (see function matrix()): they group row
+indices instead of tuples, reading the values of the test attribute
+from its column (tsel->vals). Likewise mul_row() multiplies weights
+in the weight column of the matrix.
+----------------------------------------------------------------------*/
+
+#endif
+/*--------------------------------------------------------------------*/
+#ifdef DT_PRUNE
 
 static TPLID grp_nom (TUPLE **tpls, TPLID n, const TSEL *tsel)
 {                               /* --- group nominal values */
@@ -215,7 +440,6 @@ static void mul_wgt (TUPLE **tpls, TPLID n, double f)
 }  /* mul_wgt() */
 
 /*--------------------------------------------------------------------*/
-#ifdef DT_PRUNE
 
 static double sum_wgt (TUPLE **tpls, TPLID n)
 {                               /* --- sum tuple weights */
@@ -233,24 +457,50 @@ static double sum_wgt (TUPLE **tpls, TPLID n)
 ----------------------------------------------------------------------*/
 #ifdef DT_GROW
 
-static int cmp_int (const void *p1, const void *p2, void *data)
-{                               /* --- compare a column of two tuples */
-  DTINT i1 = tpl_colval((TUPLE*)p1, (ATTID)(ptrdiff_t)data)->i;
-  DTINT i2 = tpl_colval((TUPLE*)p2, (ATTID)(ptrdiff_t)data)->i;
+static int cmp_int (TPLID r1, TPLID r2, void *data)
+{                               /* --- compare two rows of a column */
+  DTINT i1 = ((const INST*)data)[r1].i;
+  DTINT i2 = ((const INST*)data)[r2].i;
   if     (i1 < i2) return -1;   /* get column values and */
   return (i1 > i2) ? 1 : 0;     /* return sign of their difference */
 }  /* cmp_int() */
 
 /*--------------------------------------------------------------------*/
 
-static int cmp_flt (const void *p1, const void *p2, void *data)
-{                               /* --- compare a column of two tuples */
-  DTFLT f1 = tpl_colval((TUPLE*)p1, (ATTID)(ptrdiff_t)data)->f;
-  DTFLT f2 = tpl_colval((TUPLE*)p2, (ATTID)(ptrdiff_t)data)->f;
+static int cmp_flt (TPLID r1, TPLID r2, void *data)
+{                               /* --- compare two rows of a column */
+  DTFLT f1 = ((const INST*)data)[r1].f;
+  DTFLT f2 = ((const INST*)data)[r2].f;
+  if (isnan(f1)) return (isnan(f2)) ? 0 : -1;
+  if (isnan(f2)) return +1;     /* null values precede all others */
   if     (f1 < f2) return -1;   /* get column values and */
   return (f1 > f2) ? 1 : 0;     /* return sign of their difference */
 }  /* cmp_flt() */
 
+/*--------------------------------------------------------------------*/
+
+static int cmp_prop (VALID v1, VALID v2, void *data)
+{                               /* --- compare two attribute values */
+  double p1 = ft_frq_xy((FRQTAB*)data, v1, 1)
+            * ft_frq_x ((FRQTAB*)data, v2);
+  double p2 = ft_frq_xy((FRQTAB*)data, v2, 1)
+            * ft_frq_x ((FRQTAB*)data, v1);
+  if (p1 < p2) return -1;       /* compare the relative frequencies */
+  if (p1 > p2) return +1;       /* of the second class (cross mult.) */
+  return (v1 < v2) ? -1 : (v1 > v2) ? +1 : 0;
+}  /* cmp_prop() */             /* break ties by the value ids */
+
+/*--------------------------------------------------------------------*/
+
+static int cmp_mean (VALID v1, VALID v2, void *data)
+{                               /* --- compare two attribute values */
+  double m1 = vt_colmean((VARTAB*)data, v1);
+  double m2 = vt_colmean((VARTAB*)data, v2);
+  if (m1 < m2) return -1;       /* compare the target means */
+  if (m1 > m2) return +1;       /* of the attribute values */
+  return (v1 < v2) ? -1 : (v1 > v2) ? +1 : 0;
+}  /* cmp_mean() */             /* break ties by the value ids */
+
 #endif
 /*----------------------------------------------------------------------
   Auxiliary Functions for Growing and Pruning
@@ -299,7 +549,7 @@ static DTNODE* leaf_nom (DTREE *dt, FRQTAB *frqtab, VALID x)
   node = (DTNODE*)malloc(sizeof(DTNODE)
                         +sizeof(DTDATA) *(size_t)(dt->clscnt-1));
   if (!node) return NULL;       /* create a leaf node */
-  node->flags |= DT_LEAF;       /* set the leaf flag */
+  node->flags  = DT_LEAF;       /* set the leaf flag */
   node->attid  = dt->trgid;     /* store the class attribute id */
   node->size   = dt->clscnt;    /* and the number of classes */
   /* It is convenient to abuse the cut value for storing the   */
@@ -342,9 +592,9 @@ static DTNODE* leaf_met (DTREE *dt, VARTAB *vartab, VALID x)
   assert(dt && vartab           /* check the function arguments */
   &&    (vt_known (vartab)    > 0)
   &&    (vt_colfrq(vartab, x) > 0));
-  node = (DTNODE*)malloc(sizeof(DTNODE) -sizeof(DTDATA));
+  node = (DTNODE*)malloc(sizeof(DTNODE));
   if (!node) return NULL;       /* create a leaf node */
-  node->flags |= DT_LEAF;       /* set the leaf flag */
+  node->flags  = DT_LEAF;       /* set the leaf flag */
   node->attid  = dt->trgid;     /* store the target attribute id */
   node->size   = 0;             /* clear the array size */
   /* Again the cut value is abused for storing the frequency */
@@ -391,24 +641,21 @@ static DTNODE* adapt (ATTSET *attset, DTNODE *node)
 {                               /* --- adapt test node to new values */
   VALID  i, n;                  /* loop variable, number of values */
   DTNODE *adpt;                 /* adapted test node */
-  DTDATA *data;                 /* address of old data array */
 
   assert(attset && node);       /* check the function arguments */
   n = att_valcnt(as_att(attset, node->attid));
   if (node->size >= n)          /* get number of values and check the */
     return node;                /* node's data array size against it */
-  data = node->data;            /* note address of the old data array */
-  adpt = (DTNODE*)realloc(node, sizeof(DTNODE)
+  adpt = (DTNODE*)malloc(sizeof(DTNODE)
                         +(size_t)(n-1) *sizeof(DTDATA));
   if (!adpt) return NULL;       /* create a new test node */
-  if ((adpt != node)            /* if the node has been changed */
-  &&  (adpt->flags & DT_LINK)){ /* and it contains links */
-    for (i = 0; i < adpt->size; i++) {
-      if ((adpt->data[i].link >= data)
-      &&  (adpt->data[i].link <  data +adpt->size))
-        adpt->data[i].link = adpt->data +(data->link -data);
-    }                           /* adapt the link, i.e., compute the */
-  }                             /* address of the new array field */
+  memcpy(adpt, node, sizeof(DTNODE) /* and copy the old node */
+               +(size_t)(node->size-1) *sizeof(DTDATA));
+  for (i = 0; i < node->size; i++) {
+    if (islink(node->data+i, node))
+      adpt->data[i].link = adpt->data +(node->data[i].link -node->data);
+  }                             /* adapt the links, i.e., compute */
+  free(node);                   /* the addresses of the new fields */
   while (adpt->size < n)        /* clear the new child pointers */
     adpt->data[adpt->size++].child = NULL;
   return adpt;                  /* return the enlarged node */
@@ -459,7 +706,7 @@ static DTNODE* collapse (DTREE *dt, DTNODE *node)
     node->flags |= DT_LEAF;     /* turn the node into a leaf, */
     node->attid  = dt->trgid;   /* store the target identifier, */
     node->size   = 0;           /* and clear the array size */
-    return (DTNODE*)realloc(node, sizeof(DTNODE) -sizeof(DTDATA));
+    return (DTNODE*)realloc(node, sizeof(DTNODE));
   }                             /* shrink the node to leaf size */
 
   /* --- nominal target attribute --- */
@@ -502,22 +749,22 @@ static ATTID count (DTREE *dt, DTNODE *node, ATTID height)
 ----------------------------------------------------------------------*/
 #ifdef DT_GROW
 
-static double nom_nom (GROW *gi, TUPLE **tpls, TPLID n,
+static double nom_nom (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* --- evaluate a nominal attribute */
-  ATTID clsid;                  /* class attribute identifier */
   VALID k, m;                   /* loop variables for values */
-  VALID cls, val;               /* class and attribute value */
+  const INST   *cls, *val;      /* class and attribute column */
+  const WEIGHT *wgt;            /* weight column */
 
-  assert(gi && tpls && (n > 0));/* check the function arguments */
+  assert(gi && rows && (n > 0));/* check the function arguments */
   k = att_valcnt(as_att(gi->attset, attid));
   ft_init((FRQTAB*)gi->curr, k, gi->dtree->clscnt);
-  clsid = gi->dtree->trgid;     /* initialize the frequency table */
-  while (--n >= 0) {            /* and traverse the tuples */
-    cls = tpl_colval(tpls[n], clsid)->n;
-    val = tpl_colval(tpls[n], attid)->n;
-    ft_add((FRQTAB*)gi->curr, val, cls, tpl_getxwgt(tpls[n]));
-  }                             /* fill the frequency table */
+  cls = gi->trgs;               /* initialize the freq. table */
+  val = gi->cols[attid];        /* get the class and attribute column */
+  wgt = gi->wgts;               /* and the weight column */
+  while (--n >= 0)              /* traverse the rows */
+    ft_add((FRQTAB*)gi->curr, val[rows[n]].n, cls[rows[n]].n,
+           wgt[rows[n]]);       /* fill the frequency table */
   ft_marg(gi->curr);            /* and marginalize it */
   if (gi->flags & (DT_SUBSET|DT_1INN))  /* if only called to compute */
     return 0;                   /* initial table, abort the function */
@@ -530,27 +777,29 @@ static double nom_nom (GROW *gi, TUPLE **tpls, TPLID n,
 
 /*--------------------------------------------------------------------*/
 
-static double nom_bin (GROW *gi, TUPLE **tpls, TPLID n,
+static double nom_bin (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* --- eval. bin splits of nom. att. */
-  TPLID  m;                     /* loop variable  for tuples */
+  TPLID  m;                     /* loop variable  for rows */
   VALID  i, k;                  /* loop variables for values */
-  ATTID  clsid;                 /* class attribute identifier */
   VALID  valcnt;                /* number of values */
-  VALID  cls, val;              /* class and attribute value */
+  VALID  val;                   /* attribute value */
+  const INST   *cls, *vals;     /* class and attribute column */
+  const WEIGHT *wgt;            /* weight column */
   double curr, best;            /* current and best worth */
 
-  assert(gi && tpls && (n > 0));/* check the function arguments */
-  clsid  = gi->dtree->trgid;    /* get class id and number of values */
+  assert(gi && rows && (n > 0));/* check the function arguments */
+  cls    = gi->trgs;
+  vals   = gi->cols[attid];     /* get the class and attribute column */
+  wgt    = gi->wgts;            /* and the number of values */
   valcnt = att_valcnt(as_att(gi->attset, attid));
   best   = WORTHLESS; k = -1;   /* init. evaluation and value index */
   for (i = 0; i < valcnt; i++){ /* and the attribute values */
     ft_init((FRQTAB*)gi->curr, 2, gi->dtree->clscnt);
-    for (m = 0; m < n; m++) {   /* traverse the tuples */
-      cls = tpl_colval(tpls[m], clsid)->n;
-      val = tpl_colval(tpls[m], attid)->n;
+    for (m = 0; m < n; m++) {   /* traverse the rows */
+      val = vals[rows[m]].n;
       val = (val == i) ? 1 : (val < 0) ? val : 0;
-      ft_add((FRQTAB*)gi->curr, val, cls, tpl_getxwgt(tpls[m]));
+      ft_add((FRQTAB*)gi->curr, val, cls[rows[m]].n, wgt[rows[m]]);
     }                           /* fill the frequency table */
     ft_marg(gi->curr);          /* and marginalize it */
     if ((ft_frq_x((FRQTAB*)gi->curr, 0) < gi->mincnt)
@@ -560,7 +809,7 @@ static double nom_bin (GROW *gi, TUPLE **tpls, TPLID n,
     if (curr > best) { best = curr; k = i; }
   }                             /* find best evaluation */
   if (k < 0) return WORTHLESS;  /* check for a useful split */
-  nom_nom(gi, tpls, n, attid, cut);
+  nom_nom(gi, rows, n, attid, cut);
   val = (k <= 0) ? 1 : 0;       /* compute initial frequency table */
   for (i = 0; i < valcnt; i++)  /* combine all but one value */
     if ((i != k) && (i != val)) ft_comb((FRQTAB*)gi->curr, i, val);
@@ -569,7 +818,79 @@ static double nom_bin (GROW *gi, TUPLE **tpls, TPLID n,
 
 /*--------------------------------------------------------------------*/
 
-static double nom_set (GROW *gi, TUPLE **tpls, TPLID n,
+static double nom_ord (GROW *gi, VALID valcnt)
+{                               /* --- eval. ordered binary subsets */
+  VALID  i, k;                  /* loop variable, best cut index */
+  VALID  cls;                   /* loop variable for classes */
+  VALID  *sets;                 /* to traverse subset index array */
+  FRQTAB *tab, *cut;            /* value table and cut table */
+  double frq, sum;              /* frequency of value, upper part */
+  double curr, best;            /* current and best worth */
+
+  assert(gi && (valcnt >= 0));  /* check the function arguments */
+  if (valcnt < 2) return WORTHLESS;   /* check for a possible split */
+  tab  = (FRQTAB*)gi->curr;     /* get the value table */
+  cut  = (FRQTAB*)gi->mett;     /* and the cut table */
+  sets = gi->sets;              /* sort the value sets by the */
+  val_qsort(sets, (size_t)valcnt, +1, cmp_prop, tab);  /* rel. freq. */
+  ft_init(cut, 2, 2);           /* of the second class */
+  for (cls = 0; cls < 2; cls++){/* copy the null value column */
+    ft_add(cut, -1, cls, ft_frq_xy(tab, -1, cls));
+    for (i = 0; i < valcnt; i++)/* and put all value sets */
+      ft_add(cut, 1, cls, ft_frq_xy(tab, sets[i], cls));
+  }                             /* into the upper part */
+  ft_marg(cut);                 /* marginalize the cut table */
+  sum  = ft_frq_x(cut, 1);      /* and get the weight of upper part */
+  best = WORTHLESS; k = -1;     /* init. the worth and the cut index */
+  for (i = 0; i < valcnt-1; i++) {   /* traverse the possible cuts */
+    frq = ft_frq_x(tab, sets[i]);    /* move the next value set */
+    for (cls = 0; cls < 2; cls++)    /* to the lower part */
+      ft_move(cut, 1, 0, cls, ft_frq_xy(tab, sets[i], cls));
+    sum -= frq;                 /* update the weight of upper part */
+    if (ft_frq_x(cut, 0) < gi->mincnt)
+      continue;                 /* skip cuts with too small parts */
+    if (sum < gi->mincnt) break;/* (the lower part only grows) */
+    curr = ft_eval(cut, gi->measure, gi->params);
+    if (curr > best) { best = curr; k = i; }
+  }                             /* evaluate the cut table */
+  if (k < 0) return WORTHLESS;  /* check for a useful split */
+  for (i = 1; i <= k; i++)      /* combine the value sets */
+    ft_comb(tab, sets[i], sets[0]);   /* below the best cut */
+  for (i = k+2; i < valcnt; i++)      /* and above the best cut */
+    ft_comb(tab, sets[i], sets[k+1]);
+  return ft_eval(tab, gi->measure, gi->params);
+}  /* nom_ord() */              /* return the worth of the split */
+
+/*----------------------------------------------------------------------
+The functions nom_ord() and met_ord() find the best binary split of
+the (supported) values of a nominal attribute without trying pairs of
+value sets to merge. For a target with two classes and for a metric
+target the best split into two value sets (w.r.t. the information
+gain and the Gini index or the sum of squared errors, respectively)
+separates the values sorted by the relative frequency of the second
+class or by the target mean (Breiman et al. 1984, Sec. 4.2 and 9.4),
+because these measures are the reduction of a weighted sum of a
+concave impurity of the parts. Hence it suffices to sort the values
+and to traverse the k-1 cuts between them, moving one value set at a
+time from the upper to the lower part of a two column table (as for
+a metric attribute). This takes O(k log k) time instead of the O(k^3)
+evaluations of the greedy merging in nom_set() and met_set(), which
+matters for attributes with thousands of values. The functions are
+used only if a binary split is enforced (flag DT_BINARY) and only for
+the measures FEM_INFGAIN and FEM_GINI (two classes) and VEM_SSE and
+VEM_MSE (metric target), for which the order is provably optimal.
+(Weighting with the fraction of known values does not change this,
+since the factor is the same for all cuts.) Ratio measures, the
+quadratic information gain, the root mean squared error and the
+variance/standard deviation (with their frq-1 normalization) do not
+have this property, so for them the greedy merging is kept. The
+functions leave the best split as combined value sets in the value
+table, as the merging does.
+----------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+
+static double nom_set (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* -- evaluate subsets of nom. att. */
   VALID  i, k, cls;             /* loop variables */
@@ -580,8 +901,8 @@ static double nom_set (GROW *gi, TUPLE **tpls, TPLID n,
   double fsrc, fdst, fmax;      /* frequencies of sets to combine */
   double curr, prev, best;      /* current/previous/best worth */
 
-  assert(gi && tpls && (n > 0));     /* check the function arguments */
-  nom_nom(gi, tpls, n, attid, cut);  /* compute initial freq. table */
+  assert(gi && rows && (n > 0));     /* check the function arguments */
+  nom_nom(gi, rows, n, attid, cut);  /* compute initial freq. table */
 
   /* --- remove unsupported and merge single class values --- */
   valcnt = att_valcnt(as_att(gi->attset, attid));
@@ -611,6 +932,11 @@ static double nom_set (GROW *gi, TUPLE **tpls, TPLID n,
   }                             /* count reasonable tuple sets */
   valcnt = (VALID)(sets -gi->sets);
   sets   = gi->sets;            /* compute new number of values */
+  if ((gi->flags & DT_BINARY)   /* if to find a binary split */
+  &&  (gi->dtree->clscnt == 2)  /* for a two class problem */
+  &&  (((gi->measure & 0xff) == FEM_INFGAIN)
+  ||   ((gi->measure & 0xff) == FEM_GINI)))
+    return nom_ord(gi, valcnt); /* traverse the ordered values */
 
   /* --- find best pair mergers --- */
   prev = ft_eval((FRQTAB*)gi->curr, gi->measure, gi->params);
@@ -664,59 +990,64 @@ static double nom_set (GROW *gi, TUPLE **tpls, TPLID n,
 
 /*--------------------------------------------------------------------*/
 
-static double nom_met (GROW *gi, TUPLE **tpls, TPLID n,
+static double nom_met (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* --- evaluate a metric attribute */
-  TPLID  i;                     /* loop variable for tuples */
-  ATTID  k;                     /* class attribute identifier */
+  TPLID  i;                     /* loop variable for rows */
   int    type;                  /* type of the test attribute */
-  VALID  cls;                   /* class of current tuple */
-  INST   *val, *pval;           /* value of current and prec. tuple */
-  double wgt,  sum = 0;         /* tuple weight, sum of tuple weights */
+  VALID  cls;                   /* class of current row */
+  const INST   *vals, *clss;    /* attribute and class column */
+  const WEIGHT *wgts;           /* weight column */
+  const INST   *val, *pval;     /* value of current and prec. row */
+  double wgt,  sum = 0;         /* row weight, sum of row weights */
   double curr, best;            /* current and best cut worth */
 
-  assert(gi && tpls && (n > 0) && cut);   /* check the function args. */
+  assert(gi && rows && (n > 0) && cut);   /* check the function args. */
 
   /* --- build initial frequency table --- */
   type = att_type(as_att(gi->attset, attid));
-  ptr_qsort(tpls, (size_t)n, +1, (type == AT_FLT)
-            ? cmp_flt : cmp_int, (void*)(ptrdiff_t)attid);
+  vals = gi->cols[attid];       /* get the attribute column */
+  if (gi->lists && gi->lists[attid])  /* get the presorted rows */
+    rows = gi->lists[attid] +(rows -gi->rows);
+  else row_qsort(rows, (size_t)n, +1, (type == AT_FLT)
+                 ? cmp_flt : cmp_int, (void*)vals);
   ft_init((FRQTAB*)gi->mett, 2, gi->dtree->clscnt);
-  k = gi->dtree->trgid;         /* sort tuples and initialize table */
-  while (1) {                   /* traverse tuples with null value */
-    if (n <= 1)                 /* if there is at most one tuple */
+  clss = gi->trgs;              /* sort rows, init. the table, */
+  wgts = gi->wgts;              /* get the class and weight column */
+  while (1) {                   /* traverse rows with null value */
+    if (n <= 1)                 /* if there is at most one row */
       return WORTHLESS;         /* with a known att. value, abort */
-    val = tpl_colval(*tpls, attid);  /* get the next value */
+    val = vals +*rows;          /* get the next value */
     if ((type == AT_INT) ? !isnull(val->i) : !isnan(val->f))
       break;                    /* if the value is known, abort loop */
-    n--;                        /* go to the next tuple */
-    cls = tpl_colval (*tpls, k)->n;    /* get the class */
-    wgt = tpl_getxwgt(*tpls++); /* and the tuple weight */
+    n--;                        /* go to the next row */
+    cls = clss[*rows].n;        /* get the class */
+    wgt = wgts[*rows++];        /* and the row weight */
     ft_add((FRQTAB*)gi->mett, -1, cls, wgt);
-  }                             /* store the tuple weight */
-  do {                          /* traverse tuples with known value */
-    if (--n <= 0)               /* if there is no tuple left for */
+  }                             /* store the row weight */
+  do {                          /* traverse rows with known value */
+    if (--n <= 0)               /* if there is no row left for */
       return WORTHLESS;         /* the other side of the cut, abort */
-    cls = tpl_colval (*tpls, k)->n;    /* get the class */
-    wgt = tpl_getxwgt(*tpls++); /* and the tuple weight */
+    cls = clss[*rows].n;        /* get the class */
+    wgt = wgts[*rows++];        /* and the row weight */
     ft_add((FRQTAB*)gi->mett, 0, cls, wgt);
-    sum += wgt;                 /* store the tuple weight */
+    sum += wgt;                 /* store the row weight */
   } while (sum < gi->mincnt);   /* while minimal size not reached */
-  for (i = n; --i >= 0; ) {     /* traverse the remaining tuples */
-    cls = tpl_colval (tpls[i], k)->n;  /* get the class */
-    wgt = tpl_getxwgt(tpls[i]); /* and the tuple weight */
+  for (i = n; --i >= 0; ) {     /* traverse the remaining rows */
+    cls = clss[rows[i]].n;      /* get the class */
+    wgt = wgts[rows[i]];        /* and the row weight */
     ft_add((FRQTAB*)gi->mett, 1, cls, wgt);
-  }                             /* store the tuple weight */
+  }                             /* store the row weight */
   ft_marg(gi->mett);            /* marginalize frequency table and */
   sum = ft_frq_x((FRQTAB*)gi->mett,1); /* get weight of upper part */
   if (sum < gi->mincnt) return WORTHLESS;
 
   /* --- find the best cut value --- */
-  pval = tpl_colval(*(tpls-1), attid);
+  pval = vals +*(rows-1);
   best = WORTHLESS;             /* note the class and the value and */
   *cut = NAN;                   /* init. the worth and the cut value */
-  while (1) {                   /* traverse the tuples above the cut */
-    val = tpl_colval(*tpls, attid);  /* if next value differs */
+  while (1) {                   /* traverse the rows above the cut */
+    val = vals +*rows;          /* if next value differs */
     if ((type == AT_INT) ? (val->i > pval->i)
     :     (0.5F *(pval->f +val->f) > pval->f)) {
       curr = ft_eval((FRQTAB*)gi->mett, gi->measure, gi->params);
@@ -728,39 +1059,103 @@ static double nom_met (GROW *gi, TUPLE **tpls, TPLID n,
              : (0.5F *(        val->f +pval->f));
       }                         /* compute the cut value as the */
     }                           /* average of the adjacent values */
-    if (--n <= 0) break;        /* if on the last tuple, abort loop */
-    sum -= wgt = tpl_getxwgt(*tpls); /* get and sum the tuple weight */
+    if (--n <= 0) break;        /* if on the last row, abort loop */
+    sum -= wgt = wgts[*rows];   /* get and sum the row weight */
     if (sum < gi->mincnt)       /* if the weight of the remaining */
-      break;                    /* tuples is too small, abort loop */
-    cls = tpl_colval(*tpls, k)->n;
+      break;                    /* rows is too small, abort loop */
+    cls = clss[*rows].n;
     ft_move((FRQTAB*)gi->mett, 1, 0, cls, wgt);
-    pval = val; tpls++;         /* move weight in frequency table, */
-  }                             /* note the value, and get next tuple */
+    pval = val; rows++;         /* move weight in frequency table, */
+  }                             /* note the value, and get next row */
   return best;                  /* return worth of best cut */
 }  /* nom_met() */
 
+/*--------------------------------------------------------------------*/
+
+static double nom_hst (GROW *gi, TPLID *rows, TPLID n,
+                       ATTID attid, double *cut)
+{                               /* --- evaluate a binned metric att. */
+  TPLID  i;                     /* loop variable for rows */
+  int    b, p;                  /* current and previous bin */
+  VALID  cls;                   /* class of current row */
+  const INST   *clss;           /* class column */
+  const WEIGHT *wgts;           /* weight column */
+  BINS   *bins;                 /* bins of the test attribute */
+  FRQTAB *hist, *tab;           /* histogram and cut table */
+  double wgt, sum;              /* row weight, sum of row weights */
+  double curr, best;            /* current and best cut worth */
+
+  assert(gi && rows && (n > 0) && cut);   /* check the function args. */
+
+  /* --- build histogram and initial frequency table --- */
+  bins = gi->bins +attid;       /* get the bins of the attribute */
+  hist = (FRQTAB*)gi->hist;     /* and the frequency tables */
+  tab  = (FRQTAB*)gi->mett;     /* (histogram and cut table) */
+  ft_init(hist, bins->cnt, gi->dtree->clscnt);
+  ft_init(tab,  2,         gi->dtree->clscnt);
+  clss = gi->trgs;
+  wgts = gi->wgts;              /* get the class and weight column */
+  for (i = 0; i < n; i++) {     /* traverse the rows */
+    b   = bins->codes[rows[i]]; /* get the bin, the class, */
+    cls = clss[rows[i]].n;      /* and the row weight */
+    wgt = wgts[rows[i]];
+    if (b == BINNULL) { ft_add(tab, -1, cls, wgt); continue; }
+    ft_add(hist, b, cls, wgt);  /* store rows with a null value */
+    ft_add(tab,  1, cls, wgt);  /* separately and all others in the */
+  }                             /* histogram and in the upper part */
+  ft_marg(hist);                /* marginalize the frequency tables */
+  ft_marg(tab);                 /* and get the weight of upper part */
+  sum = ft_frq_x(tab, 1);
+
+  /* --- find the best cut value --- */
+  best = WORTHLESS;             /* init. the worth and the cut value */
+  *cut = NAN;                   /* (a cut is possible only between */
+  for (p = -1, b = 0; b < bins->cnt; b++) {   /* non-empty bins) */
+    wgt = ft_frq_x(hist, b);    /* get the weight of the bin */
+    if (wgt <= 0) continue;     /* and skip empty bins */
+    if ((p >= 0) && (ft_frq_x(tab, 0) >= gi->mincnt)) {
+      if (sum < gi->mincnt)     /* if the weight of the remaining */
+        break;                  /* tuples is too small, abort loop */
+      curr = ft_eval(tab, gi->measure, gi->params);
+      if (curr >= best) {       /* evaluate the frequency table, */
+        best = curr;            /* update the best cut worth and */
+        ft_copy((FRQTAB*)gi->curr, tab);   /* copy the table */
+        *cut = (att_type(as_att(gi->attset, attid)) == AT_INT)
+             ? (0.5F *(bins->min[b] +bins->max[p]))
+             : (0.5F *((DTFLT)bins->min[b] +(DTFLT)bins->max[p]));
+      }                         /* compute the cut value as the */
+    }                           /* average of the adjacent values */
+    for (cls = 0; cls < gi->dtree->clscnt; cls++)
+      if (ft_frq_xy(hist, b, cls) > 0)   /* move the bin contents */
+        ft_move(tab, 1, 0, cls, ft_frq_xy(hist, b, cls));
+    sum -= wgt; p = b;          /* to the lower part of the table */
+  }                             /* and note the (non-empty) bin */
+  return best;                  /* return worth of best cut */
+}  /* nom_hst() */
+
 /*----------------------------------------------------------------------
   Evaluation Functions for Metric Target Attributes
 ----------------------------------------------------------------------*/
 
-static double met_nom (GROW *gi, TUPLE **tpls, TPLID n,
+static double met_nom (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* --- evaluate a nominal attribute */
-  ATTID  i;                     /* class attribute identifier */
   VALID  k, m;                  /* loop variables for values */
-  VALID  val;                   /* attribute value */
-  INST   *inst;                 /* instance of the target attribute */
+  const INST   *trgs, *vals;    /* target and attribute column */
+  const WEIGHT *wgts;           /* weight column */
   double trg;                   /* value of target attribute */
 
-  assert(gi && tpls && (n > 0));/* check the function arguments */
+  assert(gi && rows && (n > 0));/* check the function arguments */
   k = att_valcnt(as_att(gi->attset, attid));
   vt_init((VARTAB*)gi->curr, k);
-  i = gi->dtree->trgid;         /* initialize the variation table */
-  for (tpls += n; --n >= 0; ) { /* and traverse the tuples */
-    inst = tpl_colval(*--tpls, i);
-    trg  = (gi->type == AT_INT) ? (double)inst->i : (double)inst->f;
-    val  = tpl_colval(*tpls, attid)->n;
-    vt_add((VARTAB*)gi->curr, val, trg, tpl_getxwgt(*tpls));
+  trgs = gi->trgs;              /* initialize the var. table */
+  vals = gi->cols[attid];       /* get the target, attribute, */
+  wgts = gi->wgts;              /* and weight column */
+  for (rows += n; --n >= 0; ) { /* traverse the rows */
+    --rows;                     /* get the target value */
+    trg = (gi->type == AT_INT) ? (double)trgs[*rows].i
+                               : (double)trgs[*rows].f;
+    vt_add((VARTAB*)gi->curr, vals[*rows].n, trg, wgts[*rows]);
   }                             /* fill the variation table */
   vt_calc(gi->curr);            /* and calculate aggregates */
   if (gi->flags & (DT_SUBSET|DT_1INN))  /* if only called to compute */
@@ -774,30 +1169,32 @@ static double met_nom (GROW *gi, TUPLE **tpls, TPLID n,
 
 /*--------------------------------------------------------------------*/
 
-static double met_bin (GROW *gi, TUPLE **tpls, TPLID n,
+static double met_bin (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* --- eval. bin splits of nom. att. */
-  TPLID  m;                     /* loop variable  for tuples */
+  TPLID  m;                     /* loop variable  for rows */
   VALID  i, k;                  /* loop variables for values */
-  ATTID  clsid;                 /* class attribute identifier */
   VALID  valcnt;                /* number of values */
   VALID  val;                   /* attribute value */
-  INST   *inst;                 /* instance of the target attribute */
+  const INST   *trgs, *vals;    /* target and attribute column */
+  const WEIGHT *wgts;           /* weight column */
   double trg;                   /* value of target attribute */
   double curr, best;            /* current and best worth */
 
-  assert(gi && tpls && (n > 0));/* check the function arguments */
-  clsid  = gi->dtree->trgid;    /* get class id and number of values */
+  assert(gi && rows && (n > 0));/* check the function arguments */
+  trgs   = gi->trgs;
+  vals   = gi->cols[attid];     /* get the target, attribute, */
+  wgts   = gi->wgts;            /* and weight column */
   valcnt = att_valcnt(as_att(gi->attset, attid));
   best   = WORTHLESS; k = -1;   /* init. evaluation and value index */
   for (i = 0; i < valcnt; i++){ /* and the attribute values */
     vt_init((VARTAB*)gi->curr, 2);
-    for (m = 0; m < n; m++) {   /* traverse the tuples */
-      inst = tpl_colval(tpls[m], clsid);
-      trg  = (gi->type == AT_INT) ? (double)inst->i : (double)inst->f;
-      val  = tpl_colval(tpls[m], attid)->n;
-      val  = (val == i) ? 1 : (val < 0) ? val : 0;
-      vt_add((VARTAB*)gi->curr, val, trg, tpl_getxwgt(tpls[m]));
+    for (m = 0; m < n; m++) {   /* traverse the rows */
+      trg = (gi->type == AT_INT) ? (double)trgs[rows[m]].i
+                                 : (double)trgs[rows[m]].f;
+      val = vals[rows[m]].n;
+      val = (val == i) ? 1 : (val < 0) ? val : 0;
+      vt_add((VARTAB*)gi->curr, val, trg, wgts[rows[m]]);
     }                           /* fill the variation table */
     vt_calc(gi->curr);          /* and calculate aggregates */
     if ((vt_colfrq((VARTAB*)gi->curr, 0) < gi->mincnt)
@@ -807,7 +1204,7 @@ static double met_bin (GROW *gi, TUPLE **tpls, TPLID n,
     if (curr > best) { best = curr; k = i; }
   }                             /* find best evaluation */
   if (k < 0) return WORTHLESS;  /* check for a useful split */
-  met_nom(gi, tpls, n, attid, cut);
+  met_nom(gi, rows, n, attid, cut);
   val = (k <= 0) ? 1 : 0;       /* compute initial frequency table */
   for (i = 0; i < valcnt; i++)  /* combine all but one value */
     if ((i != k) && (i != val)) vt_comb((VARTAB*)gi->curr, i, val);
@@ -816,7 +1213,59 @@ static double met_bin (GROW *gi, TUPLE **tpls, TPLID n,
 
 /*--------------------------------------------------------------------*/
 
-static double met_set (GROW *gi, TUPLE **tpls, TPLID n,
+static double met_ord (GROW *gi, TPLID *rows, TPLID n,
+                       ATTID attid, VALID valcnt)
+{                               /* --- eval. ordered binary subsets */
+  VALID  i, k;                  /* loop variable, best cut index */
+  VALID  *sets;                 /* to traverse subset index array */
+  const INST   *trgs, *vals;    /* target and attribute column */
+  const WEIGHT *wgts;           /* weight column */
+  double trg;                   /* value of target attribute */
+  VARTAB *tab, *cut;            /* value table and cut table */
+  double frq, sum;              /* frequency of value, upper part */
+  double curr, best;            /* current and best worth */
+
+  assert(gi && rows && (n > 0) && (valcnt >= 0));
+  if (valcnt < 2) return WORTHLESS;   /* check for a possible split */
+  tab  = (VARTAB*)gi->curr;     /* get the value table */
+  cut  = (VARTAB*)gi->mett;     /* and the cut table */
+  sets = gi->sets;              /* sort the value sets by the */
+  val_qsort(sets, (size_t)valcnt, +1, cmp_mean, tab);  /* mean */
+  vt_init(cut, 2);              /* initialize the cut table */
+  trgs = gi->trgs;              /* get the target, attribute, */
+  vals = gi->cols[attid];       /* and weight column */
+  wgts = gi->wgts;              /* and traverse the rows */
+  for (rows += n; --n >= 0; ) { /* (put all rows with a known */
+    --rows;                     /* value into the upper part) */
+    trg = (gi->type == AT_INT) ? (double)trgs[*rows].i
+                               : (double)trgs[*rows].f;
+    vt_add(cut, (vals[*rows].n < 0) ? -1 : 1, trg, wgts[*rows]);
+  }                             /* fill the cut table */
+  vt_calc(cut);                 /* and calculate aggregates */
+  sum  = vt_colfrq(cut, 1);     /* get the weight of upper part */
+  best = WORTHLESS; k = -1;     /* init. the worth and the cut index */
+  for (i = 0; i < valcnt-1; i++) {   /* traverse the possible cuts */
+    frq = vt_colfrq(tab, sets[i]);   /* move the next value set */
+    vt_mvsum(cut, 1, 0, frq,         /* to the lower part */
+             vt_colsum(tab, sets[i]), vt_colssv(tab, sets[i]));
+    sum -= frq;                 /* update the weight of upper part */
+    if (vt_colfrq(cut, 0) < gi->mincnt)
+      continue;                 /* skip cuts with too small parts */
+    if (sum < gi->mincnt) break;/* (the lower part only grows) */
+    curr = vt_eval(cut, gi->measure, gi->params);
+    if (curr > best) { best = curr; k = i; }
+  }                             /* evaluate the cut table */
+  if (k < 0) return WORTHLESS;  /* check for a useful split */
+  for (i = 1; i <= k; i++)      /* combine the value sets */
+    vt_comb(tab, sets[i], sets[0]);   /* below the best cut */
+  for (i = k+2; i < valcnt; i++)      /* and above the best cut */
+    vt_comb(tab, sets[i], sets[k+1]);
+  return vt_eval(tab, gi->measure, gi->params);
+}  /* met_ord() */              /* return the worth of the split */
+
+/*--------------------------------------------------------------------*/
+
+static double met_set (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* -- evaluate subsets of nom. att. */
   VALID  i, k;                  /* loop variables */
@@ -827,8 +1276,8 @@ static double met_set (GROW *gi, TUPLE **tpls, TPLID n,
   double fsrc, fdst, fmax;      /* frequencies of sets to combine */
   double curr, prev, best;      /* current/previous/best worth */
 
-  assert(gi && tpls && (n > 0));     /* check the function arguments */
-  met_nom(gi, tpls, n, attid, cut);  /* compute initial freq. table */
+  assert(gi && rows && (n > 0));     /* check the function arguments */
+  met_nom(gi, rows, n, attid, cut);  /* compute initial freq. table */
 
   /* --- collect supported values --- */
   valcnt = att_valcnt(as_att(gi->attset, attid));
@@ -845,7 +1294,11 @@ static double met_set (GROW *gi, TUPLE **tpls, TPLID n,
   }                             /* count reasonable tuple sets */
   valcnt = (VALID)(sets -gi->sets);
   sets   = gi->sets;            /* compute new number of values */
-
+  if ((gi->flags & DT_BINARY)   /* if to find a binary split */
+  &&  (((gi->measure & 0xff) == VEM_SSE)
+  ||   ((gi->measure & 0xff) == VEM_MSE)))
+    return met_ord(gi, rows, n, attid, valcnt);
+                                /* traverse the ordered values */
   /* --- find best pair mergers --- */
   prev = vt_eval((VARTAB*)gi->curr, gi->measure, gi->params);
   if (valcnt <= 2)              /* check whether a merge is possible */
@@ -894,64 +1347,66 @@ static double met_set (GROW *gi, TUPLE **tpls, TPLID n,
 
 /*--------------------------------------------------------------------*/
 
-static double met_met (GROW *gi, TUPLE **tpls, TPLID n,
+static double met_met (GROW *gi, TPLID *rows, TPLID n,
                        ATTID attid, double *cut)
 {                               /* --- evaluate a metric attribute */
-  TPLID  i;                     /* loop variable for tuples */
-  ATTID  k;                     /* class attribute identifier */
+  TPLID  i;                     /* loop variable for rows */
   int    type, t;               /* type of the test/target attribute */
-  INST   *inst;                 /* target instance of current tuple */
-  double trg;                   /* target value    of current tuple */
-  INST   *val, *pval;           /* value of current and prec. tuple */
-  double wgt,  sum = 0;         /* tuple weight, sum of tuple weights */
+  const INST   *vals, *trgs;    /* attribute and target column */
+  const WEIGHT *wgts;           /* weight column */
+  double trg;                   /* target value    of current row */
+  const INST   *val, *pval;     /* value of current and prec. row */
+  double wgt,  sum = 0;         /* row weight, sum of row weights */
   double curr, best;            /* current and best cut worth */
 
-  assert(gi && tpls && (n > 0) && cut);   /* check the function args. */
+  assert(gi && rows && (n > 0) && cut);   /* check the function args. */
 
   /* --- build initial variation table --- */
   type = att_type(as_att(gi->attset, attid));
-  ptr_qsort(tpls, (size_t)n, +1, (type == AT_FLT)
-            ? cmp_flt : cmp_int, (void*)(ptrdiff_t)attid);
-  vt_init((VARTAB*)gi->mett,2); /* sort tuples and initialize table */
-  k = gi->dtree->trgid;         /* note the target attribute index */
-  t = gi->dtree->type;          /* and the target type */
-  while (1) {                   /* traverse tuples with null value */
-    if (n <= 1)                 /* if there is at most one tuple */
+  vals = gi->cols[attid];       /* get the attribute column */
+  if (gi->lists && gi->lists[attid])  /* get the presorted rows */
+    rows = gi->lists[attid] +(rows -gi->rows);
+  else row_qsort(rows, (size_t)n, +1, (type == AT_FLT)
+                 ? cmp_flt : cmp_int, (void*)vals);
+  vt_init((VARTAB*)gi->mett,2); /* sort rows and initialize table */
+  trgs = gi->trgs;              /* get the target column, */
+  t    = gi->type;              /* the target type, */
+  wgts = gi->wgts;              /* and the weight column */
+  while (1) {                   /* traverse rows with null value */
+    if (n <= 1)                 /* if there is at most one row */
       return WORTHLESS;         /* with a known att. value, abort */
-    val = tpl_colval(*tpls, attid);   /* get the next value */
+    val = vals +*rows;          /* get the next value */
     if ((type == AT_INT) ? !isnull(val->i) : !isnan(val->f))
       break;                    /* if the value is known, abort loop */
-    n--;                        /* go to the next tuple */
-    inst = tpl_colval(*tpls, k);
-    trg  = (t == AT_INT) ? (double)inst->i : (double)inst->f;
-    wgt  = tpl_getxwgt(*tpls++);/* get the target value */
+    n--;                        /* go to the next row */
+    trg = (t == AT_INT) ? (double)trgs[*rows].i : (double)trgs[*rows].f;
+    wgt = wgts[*rows++];        /* get the target value */
     vt_add((VARTAB*)gi->mett, -1, trg, wgt);
-  }                             /* store the tuple weight */
-  do {                          /* traverse tuples with known value */
-    if (--n <= 0)               /* if there is no tuple left for */
+  }                             /* store the row weight */
+  do {                          /* traverse rows with known value */
+    if (--n <= 0)               /* if there is no row left for */
       return WORTHLESS;         /* the other side of the cut, abort */
-    inst = tpl_colval(*tpls, k);
-    trg  = (t == AT_INT) ? (double)inst->i : (double)inst->f;
-    wgt  = tpl_getxwgt(*tpls++);   /* get the target value and */
-    vt_add(gi->mett, 0, trg, wgt); /* store the tuple weight */
+    trg = (t == AT_INT) ? (double)trgs[*rows].i : (double)trgs[*rows].f;
+    wgt = wgts[*rows++];           /* get the target value and */
+    vt_add(gi->mett, 0, trg, wgt); /* store the row weight */
     sum += wgt;                    /* in the variation table */
   } while (sum < gi->mincnt);   /* while minimal size not reached */
-  for (i = n; --i >= 0; ) {     /* traverse the remaining tuples */
-    inst = tpl_colval(tpls[i], k);
-    trg  = (t == AT_INT) ? (double)inst->i : (double)inst->f;
-    wgt  = tpl_getxwgt(tpls[i]);/* get the target value */
+  for (i = n; --i >= 0; ) {     /* traverse the remaining rows */
+    trg = (t == AT_INT) ? (double)trgs[rows[i]].i
+                        : (double)trgs[rows[i]].f;
+    wgt = wgts[rows[i]];        /* get the target value */
     vt_add((VARTAB*)gi->mett, 1, trg, wgt);
-  }                             /* store the tuple weight */
+  }                             /* store the row weight */
   vt_calc((VARTAB*)gi->mett);   /* calculate aggregates and get */
   sum = vt_colfrq((VARTAB*)gi->mett,1); /* weight of upper part */
   if (sum < gi->mincnt) return WORTHLESS;
 
   /* --- find the best cut value --- */
-  pval = tpl_colval(*(tpls-1), attid);
+  pval = vals +*(rows-1);
   best = WORTHLESS;             /* note the class and the value and */
   *cut = NAN;                   /* init. the worth and the cut value */
-  while (1) {                   /* traverse the tuples above the cut */
-    val = tpl_colval(*tpls, attid);  /* if next value differs */
+  while (1) {                   /* traverse the rows above the cut */
+    val = vals +*rows;          /* if next value differs */
     if ((type == AT_INT) ? (val->i > pval->i)
     :     (0.5F *(pval->f +val->f) > pval->f)) {
       curr = vt_eval((VARTAB*)gi->mett, gi->measure, gi->params);
@@ -963,39 +1418,459 @@ static double met_met (GROW *gi, TUPLE **tpls, TPLID n,
              : (0.5F *(        val->f +pval->f));
       }                         /* compute the cut value as the */
     }                           /* average of the adjacent values */
-    if (--n <= 0) break;        /* if on the last tuple, abort loop */
-    sum -= wgt = tpl_getxwgt(*tpls); /* get and sum the tuple weight */
+    if (--n <= 0) break;        /* if on the last row, abort loop */
+    sum -= wgt = wgts[*rows];   /* get and sum the row weight */
     if (sum < gi->mincnt)       /* if the weight of the remaining */
-      break;                    /* tuples is too small, abort loop */
-    inst = tpl_colval(*tpls, k);
-    trg  = (t == AT_INT) ? (double)inst->i : (double)inst->f;
+      break;                    /* rows is too small, abort loop */
+    trg = (t == AT_INT) ? (double)trgs[*rows].i : (double)trgs[*rows].f;
     vt_move((VARTAB*)gi->mett, 1, 0, trg, wgt);
-    pval = val; tpls++;         /* move weight in variation table, */
-  }                             /* note the value, and get next tuple */
+    pval = val; rows++;         /* move weight in variation table, */
+  }                             /* note the value, and get next row */
   return best;                  /* return worth of best cut */
 }  /* met_met() */
 
+/*--------------------------------------------------------------------*/
+
+static double met_hst (GROW *gi, TPLID *rows, TPLID n,
+                       ATTID attid, double *cut)
+{                               /* --- evaluate a binned metric att. */
+  TPLID  i;                     /* loop variable for rows */
+  int    b, p;                  /* current and previous bin */
+  int    t;                     /* type of the target attribute */
+  const INST   *trgs;           /* target column */
+  const WEIGHT *wgts;           /* weight column */
+  double trg;                   /* target value of current row */
+  BINS   *bins;                 /* bins of the test attribute */
+  VARTAB *hist, *tab;           /* histogram and cut table */
+  double wgt, sum;              /* row weight, sum of row weights */
+  double curr, best;            /* current and best cut worth */
+
+  assert(gi && rows && (n > 0) && cut);   /* check the function args. */
+
+  /* --- build histogram and initial variation table --- */
+  bins = gi->bins +attid;       /* get the bins of the attribute */
+  hist = (VARTAB*)gi->hist;     /* and the variation tables */
+  tab  = (VARTAB*)gi->mett;     /* (histogram and cut table) */
+  vt_init(hist, bins->cnt);     /* initialize the tables */
+  vt_init(tab,  2);
+  trgs = gi->trgs;              /* get the target column, */
+  t    = gi->type;              /* the target type, */
+  wgts = gi->wgts;              /* and the weight column */
+  for (i = 0; i < n; i++) {     /* traverse the rows */
+    b   = bins->codes[rows[i]];
+    trg = (t == AT_INT) ? (double)trgs[rows[i]].i
+                        : (double)trgs[rows[i]].f;
+    wgt = wgts[rows[i]];        /* get bin, target value, and weight */
+    if (b == BINNULL) { vt_add(tab, -1, trg, wgt); continue; }
+    vt_add(hist, b, trg, wgt);  /* store rows with a null value */
+    vt_add(tab,  1, trg, wgt);  /* separately and all others in the */
+  }                             /* histogram and in the upper part */
+  vt_calc(tab);                 /* calculate aggregates and get */
+  sum = vt_colfrq(tab, 1);      /* the weight of the upper part */
+
+  /* --- find the best cut value --- */
+  best = WORTHLESS;             /* init. the worth and the cut value */
+  *cut = NAN;                   /* (a cut is possible only between */
+  for (p = -1, b = 0; b < bins->cnt; b++) {   /* non-empty bins) */
+    wgt = vt_colfrq(hist, b);   /* get the weight of the bin */
+    if (wgt <= 0) continue;     /* and skip empty bins */
+    if ((p >= 0) && (vt_colfrq(tab, 0) >= gi->mincnt)) {
+      if (sum < gi->mincnt)     /* if the weight of the remaining */
+        break;                  /* tuples is too small, abort loop */
+      curr = vt_eval(tab, gi->measure, gi->params);
+      if (curr >= best) {       /* evaluate the variation table, */
+        best = curr;            /* update the best cut worth, and */
+        vt_copy((VARTAB*)gi->curr, tab);   /* copy the table */
+        *cut = (att_type(as_att(gi->attset, attid)) == AT_INT)
+             ? (0.5F *(bins->min[b] +bins->max[p]))
+             : (0.5F *((DTFLT)bins->min[b] +(DTFLT)bins->max[p]));
+      }                         /* compute the cut value as the */
+    }                           /* average of the adjacent values */
+    vt_mvsum(tab, 1, 0, wgt, vt_colsum(hist, b), vt_colssv(hist, b));
+    sum -= wgt; p = b;          /* move the bin contents to the lower */
+  }                             /* part and note the (non-empty) bin */
+  return best;                  /* return worth of best cut */
+}  /* met_hst() */
+
+/*----------------------------------------------------------------------
+The functions nom_hst() and met_hst() evaluate a metric attribute that
+has been discretized into (at most 255) bins (see function binning()).
+Instead of traversing the rows in sorted order, they aggregate the
+rows of a node into a histogram, that is, a frequency or variation
+table with one column per bin, and then find the best cut with a
+single traversal of the non-empty bins, moving the contents of a bin
+as a whole from the upper to the lower part of the cut table. Hence
+only cuts between bins are considered and the cost per node is linear
+in the number of tuples and independent of their order. The cut value
+is the average of the largest value in the last bin below the cut and
+the smallest value in the first bin above it, so that the tuples are
+distributed to the branches exactly as by the histogram.
+----------------------------------------------------------------------*/
+
 /*----------------------------------------------------------------------
   Growing Functions
 ----------------------------------------------------------------------*/
 
-static DTNODE* grow (GROW *gi, DTNODE *leaf, TUPLE **tpls, TPLID n)
-{                               /* --- recursively grow tree */
+static TPLID partition (GROW *gi, ROWFN *grpfn,
+                        TPLID *rows, TPLID n, const TSEL *tsel)
+{                               /* --- group rows and sorted lists */
+  ATTID i;                      /* loop variable for attributes */
+  TPLID r, k;                   /* number of grouped rows */
+  TPLID *src, *dst, *buf;       /* to traverse the sorted lists */
+  TPLID *tmp;                   /* buffer section for the node */
+
+  assert(gi && grpfn && rows && (n >= 0) && tsel);
+  r = grpfn(rows, n, tsel);     /* group the rows themselves */
+  if (!gi->lists || (r <= 0) || (r >= n))
+    return r;                   /* check whether lists must change */
+  tmp = gi->buf +(rows -gi->rows);
+  for (k = r; --k >= 0; )       /* flag the grouped rows */
+    gi->sel[rows[k]] = 1;
+  for (i = as_attcnt(gi->attset); --i >= 0; ) {
+    if (!gi->lists[i]) continue;/* traverse the presorted lists */
+    src = dst = gi->lists[i] +(rows -gi->rows);
+    for (buf = tmp, k = n; --k >= 0; src++) {
+      if (gi->sel[*src]) *dst++ = *src;
+      else               *buf++ = *src;
+    }                           /* split the list section stably */
+    memcpy(dst, tmp, (size_t)(buf -tmp) *sizeof(TPLID));
+  }                             /* append the non-grouped rows */
+  for (k = r; --k >= 0; )       /* clear the selection flags */
+    gi->sel[rows[k]] = 0;
+  return r;                     /* return the number of */
+}  /* partition() */            /* grouped rows */
+
+/*--------------------------------------------------------------------*/
+
+static void merge (GROW *gi, TPLID *rows, TPLID n, TPLID k)
+{                               /* --- merge two runs of the lists */
+  ATTID i;                      /* loop variable for attributes */
+  ROWCMPFN *cmp;                /* comparison function for values */
+  void  *col;                   /* column of the attribute */
+  TPLID *a, *b, *d, *x, *y;     /* to traverse the list runs */
+  TPLID *tmp;                   /* buffer section for the node */
+
+  assert(gi && rows && (n >= 0) && (k >= 0));
+  if (!gi->lists || (k <= 0) || (k >= n))
+    return;                     /* check whether there are two runs */
+  tmp = gi->buf +(rows -gi->rows);
+  for (i = as_attcnt(gi->attset); --i >= 0; ) {
+    if (!gi->lists[i]) continue;/* traverse the presorted lists */
+    cmp = (att_type(as_att(gi->attset, i)) == AT_FLT)
+        ? cmp_flt : cmp_int;    /* get the comparison function */
+    col = (void*)gi->cols[i];   /* and the attribute column */
+    d = gi->lists[i] +(rows -gi->rows);
+    b = d +k; y = d +n;         /* get the second run of the list */
+    if (cmp(b[-1], *b, col) <= 0)
+      continue;                 /* skip lists that are in order */
+    memcpy(tmp, d, (size_t)k *sizeof(TPLID));
+    for (a = tmp, x = a +k; (a < x) && (b < y); )
+      *d++ = (cmp(*b, *a, col) < 0) ? *b++ : *a++;
+    while (a < x) *d++ = *a++;  /* merge the runs (stably) and */
+  }                             /* copy the rest of the first run */
+}  /* merge() */                /* (rest of second run is in place) */
+
+/*--------------------------------------------------------------------*/
+
+static int addrun (GROW *gi, TPLID *rows, TPLID *runs, int c, TPLID r)
+{                               /* --- add a sorted run of the lists */
+  if (!gi->lists || (r <= 0))   /* check whether there are lists */
+    return c;                   /* and whether the run is empty */
+  for (runs[c++] = r; (c > 1) && (runs[c-2] <= 2*runs[c-1]); c--) {
+    merge(gi, rows -runs[c-1] -runs[c-2], runs[c-2] +runs[c-1],
+          runs[c-2]);           /* merge sorted runs of the lists */
+    runs[c-2] += runs[c-1];     /* as long as the next to last run */
+  }                             /* is not larger than twice the last */
+  return c;                     /* (bounds the number of runs) */
+}  /* addrun() */               /* return the new number of runs */
+
+/*----------------------------------------------------------------------
+The functions partition() and merge() maintain the presorted lists of
+metric attributes (see function presort()), which are kept parallel to
+the row array: partition() groups a section of the row array with
+a given grouping function and then splits the same section of all
+lists stably, so that each list section again contains the rows of
+the corresponding section of the row array (in sorted order). Since
+rows with a null value for the test attribute are passed down into
+all branches, the section of a child node may consist of two grouped
+(and thus separately sorted) parts, which merge() combines into one
+sorted list section. Since function grow() restores the sorted order
+of the list sections of its node before it returns, the evaluation
+functions nom_met() and met_met() never need to sort the rows, and
+hence the rows are sorted only once per attribute (in dt_grow()).
+Both functions use only the section of the split buffer that
+corresponds to the processed section of the row array, so that
+subtrees with disjoint row sets can be grown in parallel.
+----------------------------------------------------------------------*/
+
+static double evaluate (GROW *gi, TPLID *rows, TPLID n,
+                        ATTID attid, double *cut)
+{                               /* --- evaluate a single attribute */
+  int    type;                  /* type of the attribute */
+  double worth;                 /* worth of the attribute */
+
+  type = att_type(as_att(gi->attset, attid));
+  if (type == AT_NOM) {         /* if the attribute is nominal */
+    worth = gi->eval_nom(gi, rows, n, attid, NULL);
+    *cut  = NAN; }              /* evaluate a nominal attribute */
+  else                          /* or a metric attribute */
+    worth = gi->eval_met(gi, rows, n, attid, cut);
+  if (gi->flags & DT_EVAL) {    /* if only to evaluate attributes */
+    gi->evals[attid] = worth;   /* store the attribute evaluation */
+    gi->cuts [attid] = (type == AT_NOM) ? 0 : *cut;
+  }                             /* store a possible cut value */
+  return worth;                 /* return the attribute worth */
+}  /* evaluate() */
+
+/*--------------------------------------------------------------------*/
+
+static double selatt (GROW *gi, TPLID *rows, TPLID n, TSEL *tsel)
+{                               /* --- select best test attribute */
   ATTID  i, k;                  /* loop variables */
+  ATTID  c = 0, s = 0;          /* numbers of candidates/selected */
+  double curr, best;            /* current and best worth */
+  double cut;                   /* cut value of current attribute */
+  void   *tab;                  /* exchange buffer for eval. tables */
+
+  best       = WORTHLESS;       /* clear worth of best attribute, */
+  tsel->col  = -1;              /* identifier of best attribute, */
+  tsel->fval = NAN;             /* and cut value (metric atts.) */
+  k = as_attcnt(gi->attset);    /* get the number of attributes */
+  if (gi->rng) {                /* if to select a random subset, */
+    for (i = 0; i < k; i++)     /* count the usable attributes */
+      if (!gi->used[i]) c++;    /* and get the number of attributes */
+    s = gi->subcnt;             /* to select from them */
+  }
+  for (i = 0; i < k; i++) {     /* traverse the attributes, but */
+    if (gi->used[i]) continue;  /* skip used/unusable attributes */
+    if (gi->rng && (rng_dbl(gi->rng) *(double)c-- >= (double)s))
+      continue;                 /* skip non-selected attributes */
+    if (gi->rng) s--;           /* (selection sampling, s out of c) */
+    curr = evaluate(gi, rows, n, i, &cut);
+    if (curr <= best) continue; /* evaluate attribute (compute worth) */
+    best       = curr;          /* if the current worth is better */
+    tsel->col  = i;             /* than that of the best attribute, */
+    tsel->fval = cut;           /* note worth, attribute id, and cut */
+    tab        = gi->best;      /* exchange the freq./var. tables, */
+    gi->best   = gi->curr;      /* so that the current table */
+    gi->curr   = tab;           /* becomes the best table */
+  }                             /* (much more efficient than copying) */
+  return best;                  /* return the worth of best attribute */
+}  /* selatt() */
+
+/*--------------------------------------------------------------------*/
+#ifdef USE_THREADS
+
+static int acquire (GROW *gi, GROW **ctxs, int max)
+{                               /* --- get idle grow contexts */
+  int     i, k;                 /* loop variable, number of contexts */
+  CTXPOOL *pool = gi->pool;     /* pool of idle grow contexts */
+
+  if (!pool || (max <= 0)) return 0;
+  thr_lock(&pool->mutex);       /* lock the pool of contexts */
+  for (k = 0; (k < max) && (pool->cnt > 0); k++)
+    ctxs[k] = pool->idle[--pool->cnt];
+  thr_unlock(&pool->mutex);     /* take idle contexts from the pool */
+  for (i = 0; i < k; i++) {     /* traverse the acquired contexts */
+    memcpy(ctxs[i]->used, gi->used,
+           (size_t)as_attcnt(gi->attset) *sizeof(char));
+    ctxs[i]->maxht = gi->maxht; /* copy the used flags and */
+    ctxs[i]->err   = 0;         /* the maximal (sub)tree height */
+  }                             /* and clear the error indicator */
+  return k;                     /* return the number of contexts */
+}  /* acquire() */
+
+/*--------------------------------------------------------------------*/
+
+static void release (GROW *gi, GROW **ctxs, int cnt)
+{                               /* --- return grow contexts to pool */
+  CTXPOOL *pool = gi->pool;     /* pool of idle grow contexts */
+
+  if (cnt <= 0) return;         /* check for contexts to return */
+  thr_lock(&pool->mutex);       /* lock the pool of contexts */
+  while (--cnt >= 0) pool->idle[pool->cnt++] = ctxs[cnt];
+  thr_unlock(&pool->mutex);     /* put the contexts back */
+}  /* release() */
+
+/*--------------------------------------------------------------------*/
+
+static WORKERDEF(evalwork, p)
+{                               /* --- evaluate attributes (worker) */
+  EVALWORK *w = (EVALWORK*)p;   /* type the worker data */
+  GROW     *gi = w->gi;         /* get the grow context */
+  ATTID    i, k;                /* attribute identifier, number */
+  double   curr;                /* worth of current attribute */
+  double   cut;                 /* cut value of current attribute */
+  void     *tab;                /* exchange buffer for eval. tables */
+
+  k = as_attcnt(gi->attset);    /* get the number of attributes */
+  while (1) {                   /* attribute evaluation loop */
+    thr_lock(w->mutex);         /* get the next attribute */
+    i = (*w->next)++;           /* (attributes are distributed */
+    thr_unlock(w->mutex);       /* dynamically over the workers) */
+    if (i >= k) break;          /* check for the last attribute */
+    if (gi->used[i]) continue;  /* skip used/unusable attributes */
+    curr = evaluate(gi, w->rows, w->n, i, &cut);
+    if ((curr < w->best) || ((curr == w->best)
+    &&  ((w->col < 0) || (i > w->col))))
+      continue;                 /* skip worse (or later) attributes */
+    w->best = curr;             /* if the current worth is better, */
+    w->col  = i;                /* note worth, attribute id, and cut */
+    w->cut  = cut;              /* and exchange the freq./var. tables */
+    tab = gi->best; gi->best = gi->curr; gi->curr = tab;
+  }
+  return THREAD_OK;             /* return a dummy result */
+}  /* evalwork() */
+
+/*--------------------------------------------------------------------*/
+
+static double parsel (GROW *gi, TPLID *rows, TPLID n, TSEL *tsel)
+{                               /* --- select test att. (parallel) */
+  int      i, k;                /* loop variable, number of helpers */
+  ATTID    next = 0;            /* next attribute to evaluate */
+  THRMUTEX mutex;               /* mutex for the attribute counter */
+  GROW     *ctxs[THR_MAX];      /* grow contexts of the helpers */
+  EVALWORK wrks[THR_MAX];       /* attribute evaluation workers */
+  EVALWORK *w, *b;              /* to traverse the workers, best */
+  void     *tab;                /* exchange buffer for eval. tables */
+
+  k = acquire(gi, ctxs, gi->thcnt-1);
+  if (k <= 0)                   /* get contexts for helper threads */
+    return selatt(gi, rows, n, tsel);
+  if (thr_mxinit(&mutex) != 0){ /* create a mutex for the counter */
+    release(gi, ctxs, k); return selatt(gi, rows, n, tsel); }
+  for (i = 0; i <= k; i++) {    /* traverse the workers */
+    w = wrks +i;                /* (the calling thread is worker 0) */
+    w->gi    = (i > 0) ? ctxs[i-1] : gi;
+    w->rows  = rows;  w->n     = n;
+    w->next  = &next; w->mutex = &mutex;
+    w->col   = -1;              /* set the rows of the node and */
+    w->best  = WORTHLESS;       /* the attribute counter and clear */
+    w->cut   = NAN;             /* the best attribute of the worker */
+  }
+  thr_run(evalwork, wrks, sizeof(EVALWORK), k+1);
+  thr_mxfree(&mutex);           /* run the workers, delete the mutex */
+  for (b = w = wrks, i = 1; i <= k; i++) {
+    if ((++w)->col < 0) continue;
+    if ((b->col < 0) || (w->best > b->best)
+    ||  ((w->best == b->best) && (w->col < b->col)))
+      b = w;                    /* find the best attribute over */
+  }                             /* all workers (on ties: lowest id) */
+  tsel->col  = b->col;          /* note the attribute identifier */
+  tsel->fval = b->cut;          /* and the cut value (metric atts.) */
+  if (b->gi != gi) {            /* if not found by the first worker, */
+    tab = gi->best; gi->best = b->gi->best; b->gi->best = tab; }
+  release(gi, ctxs, k);         /* get the freq./var. table and */
+  return b->best;               /* return the helper contexts */
+}  /* parsel() */               /* return the worth of best att. */
+
+#endif
+/*----------------------------------------------------------------------
+The function selatt() evaluates all usable attributes for the tuples
+of a node and selects the first attribute with the highest worth; the
+frequency/variation table of this attribute is left in gi->best. If
+the program is compiled with USE_THREADS, the function parsel() does
+the same with several threads, each of which works on its own grow
+context (a copy of the grow information with its own used flags and
+frequency/variation tables), which it takes from a pool of idle
+contexts (functions acquire() and release()). The attributes are
+distributed dynamically, because their evaluation costs differ
+widely (metric attributes need a traversal of a sorted list, nominal
+attributes with subsets need repeated table evaluations). Ties are
+broken in favor of the attribute with the lowest identifier, so the
+result does not depend on the number of threads. Since the evaluation
+functions only read the training matrix (the presorted lists remove
+the need to sort the rows), the workers can share the row array.
+Threads are used only for nodes with at least THRMIN tuples, because
+for smaller nodes the costs of starting the threads exceed the gain.
+If not all threads can be started, the running workers (among them
+the calling thread) simply evaluate the remaining attributes.
+If a random forest is grown (see function dt_forest()), selatt()
+evaluates only a random subset of gi->subcnt of the usable attributes
+of a node, which is drawn with selection sampling, so that the chosen
+attributes are still evaluated in the order of their identifiers.
+The contexts of a forest never use parsel(), because the trees
+themselves are grown in parallel.
+----------------------------------------------------------------------*/
+
+#ifdef USE_THREADS
+
+static DTNODE* grow (GROW *gi, DTNODE *leaf, TPLID *rows, TPLID n);
+                                /* (needed for recursion in tasks) */
+
+static WORKERDEF(growtask, p)
+{                               /* --- grow a subtree (task) */
+  GROWTASK *t = (GROWTASK*)p;   /* type the task data */
+  t->data->child = grow(t->gi, t->data->child, t->rows, t->n);
+  t->err  = t->gi->err;         /* grow the subtree and */
+  t->done = 1;                  /* note the number of errors */
+  return THREAD_OK;             /* return a dummy result */
+}  /* growtask() */
+
+/*--------------------------------------------------------------------*/
+
+static void subtrees (GROW *gi, GROWTASK *tasks, int cnt)
+{                               /* --- grow subtrees in parallel */
+  int  i, k;                    /* loop variable, number of helpers */
+  GROW *ctxs[THR_MAX];          /* grow contexts of the helpers */
+
+  while (cnt > 0) {             /* while there are tasks left */
+    k = acquire(gi, ctxs, (cnt-1 < THR_MAX) ? cnt-1 : THR_MAX);
+    tasks[0].gi = gi;           /* the calling thread does a task */
+    for (i = 1; i <= k; i++)    /* and the helper threads do */
+      tasks[i].gi = ctxs[i-1];  /* the next k tasks (one each) */
+    if (k > 0) thr_run(growtask, tasks, sizeof(GROWTASK), k+1);
+    release(gi, ctxs, k);       /* run the tasks in parallel */
+    for (i = 0; i <= k; i++) {  /* traverse the executed tasks */
+      if (tasks[i].done) continue;
+      tasks[i].gi = gi; growtask(tasks+i);
+    }                           /* execute tasks that could not be */
+    tasks += k+1; cnt -= k+1;   /* started in the calling thread */
+  }                             /* (this also covers k = 0) */
+}  /* subtrees() */
+
+#endif
+/*----------------------------------------------------------------------
+The function subtrees() grows the subtrees of a node in parallel if
+their tuple sets are disjoint (that is, if there are no tuples with a
+null value for the test attribute, which are passed down into all
+branches with adapted weights). Each helper thread works on its own
+grow context (see function parsel()), which receives a copy of the
+used flags and the maximal height of the calling context, and works
+on the sections of the row array, the presorted lists, and the
+split buffer that correspond to its subtree. The tasks are processed
+in batches: the calling thread grows the first subtree of a batch
+and as many idle contexts as can be acquired grow the next ones.
+Since the number of contexts is bounded by the number of threads,
+attribute evaluation (in parsel()) and subtree growing share the
+same thread budget: close to the root, where nodes are large, the
+threads mostly evaluate attributes, deeper down mostly grow disjoint
+subtrees. The numbers of errors of the subtrees are summed in the
+order of the branches, so the result does not depend on the number
+of threads.
+----------------------------------------------------------------------*/
+
+static DTNODE* grow (GROW *gi, DTNODE *leaf, TPLID *rows, TPLID n)
+{                               /* --- recursively grow tree */
   VALID  m, b;                  /* value identifier/node size */
   TPLID  r, g;                  /* number of grouped tuples */
   ATT    *att;                  /* current/test attribute */
-  double curr, best;            /* current and best worth */
-  double cut;                   /* cut value for best attribute */
-  void   *tab;                  /* exchange buffer for eval. tables */
+  double best;                  /* worth of best attribute */
   DTNODE *node;                 /* created test node (subtree) */
   DTDATA *data;                 /* to traverse the data array */
   TSEL   tsel;                  /* tuple selection information */
-  GRPFN  *group;                /* tuple grouping function */
+  ROWFN  *grpfn;                /* row grouping function */
   double frq, known;            /* tuple frequencies for weighting */
   double e_tree;                /* sum of subtree errors */
+  TPLID  runs[8*sizeof(TPLID)]; /* sizes of sorted runs of the lists */
+  int    c = 0;                 /* number of sorted runs */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  int      i, t = 0;            /* loop variable, number of tasks */
+  GROWTASK *tasks = NULL;       /* tasks for growing subtrees */
+  GROWTASK bin[2];              /* tasks for a binary split */
+  #endif
 
-  assert(leaf && tpls && (n > 0)); /* check the function arguments */
+  assert(leaf && rows && (n > 0)); /* check the function arguments */
 
   /* --- check the leaf node --- */
   gi->err = leaf->err;          /* set the number of leaf errors */
@@ -1005,27 +1880,12 @@ static DTNODE* grow (GROW *gi, DTNODE *leaf, TUPLE **tpls, TPLID n)
     return leaf;                /* simply return the leaf node */
 
   /* --- search for a test attribute --- */
-  best      = WORTHLESS;        /* clear worth of best attribute, */
-  tsel.col  = -1;               /* identifier of best attribute, */
-  tsel.fval = cut = NAN;        /* and cut value (metric atts.) */
-  k = as_attcnt(gi->attset);    /* get the number of attributes */
-  for (i = 0; i < k; i++) {     /* traverse the attributes, but */
-    if (gi->used[i]) continue;  /* skip used/unusable attributes */
-    att = as_att(gi->attset,i); /* evaluate acc. to attribute type */
-    if (att_type(att) == AT_NOM) curr = gi->eval_nom(gi, tpls,n,i,NULL);
-    else                         curr = gi->eval_met(gi, tpls,n,i,&cut);
-    if (gi->flags & DT_EVAL) {  /* if only to evaluate attributes */
-      gi->evals[i] = curr;      /* store the attribute evaluation */
-      gi->cuts [i] = (att_type(att) == AT_NOM) ? 0 : cut;
-    }                           /* store a possible cut value */
-    if (curr <= best) continue; /* evaluate attribute (compute worth) */
-    best      = curr;           /* if the current worth is better */
-    tsel.col  = i;              /* than that of the best attribute, */
-    tsel.fval = cut;            /* note worth, attribute id, and cut */
-    tab       = gi->best;       /* exchange the freq./var. tables, */
-    gi->best  = gi->curr;       /* so that the current table */
-    gi->curr  = tab;            /* becomes the best table */
-  }                             /* (much more efficient than copying) */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  best = ((gi->thcnt > 1) && (n >= THRMIN))
+       ? parsel(gi, rows, n, &tsel) : selatt(gi, rows, n, &tsel);
+  #else                         /* evaluate the attributes in */
+  best = selatt(gi, rows, n, &tsel);    /* parallel or serially */
+  #endif                        /* and select the best attribute */
   if ((gi->flags & DT_LEAF)     /* if only to evaluate attributes */
   ||  (tsel.col < 0)            /* or no test attribute found */
   ||  (best     < gi->minval))  /* or the best attribute is not */
@@ -1034,6 +1894,7 @@ static DTNODE* grow (GROW *gi, DTNODE *leaf, TUPLE **tpls, TPLID n)
   /* --- create a test node --- */
   att  = as_att(gi->attset, tsel.col);
   m    = (att_type(att) == AT_NOM) ? att_valcnt(att) : 2;
+  tsel.vals = gi->cols[tsel.col];  /* get the test attribute column */
   node = (DTNODE*)malloc(sizeof(DTNODE) +(size_t)(m-1) *sizeof(DTDATA));
   if (!node) { gi->err = -1; return leaf; }
   node->flags = 0;              /* create a test node */
@@ -1084,59 +1945,119 @@ static DTNODE* grow (GROW *gi, DTNODE *leaf, TUPLE **tpls, TPLID n)
     if (!(gi->flags & (DT_SUBSET|DT_1INN)))
       gi->used[tsel.col] = -1;  /* mark attribute as used */
     tsel.nval = NV_NOM;         /* group tuples with */
-    g = grp_nom(tpls, n, &tsel);/* a null attribute value */
-    group     = (node->flags & DT_LINK) ? grp_set : grp_nom;
+    g = partition(gi, row_nom, rows, n, &tsel);  /* a null value */
+    grpfn     = (node->flags & DT_LINK) ? row_set : row_nom;
+    #ifdef USE_THREADS          /* if no tuple has a null value, */
+    if ((g <= 0) && (n >= THRMIN) && gi->pool
+    &&  !(gi->flags & DT_EVAL)) /* the subtrees can be grown */
+      tasks = (GROWTASK*)malloc((size_t)node->size *sizeof(GROWTASK));
+    #endif                      /* in parallel (as tasks) */
     frq       = known;          /* get the denominator of the weight */
     tsel.data = data;           /* traverse the attribute values */
     for (data += tsel.nval = node->size; --tsel.nval >= 0; ) {
       if (!(--data)->child      /* if an att. value is not supported */
       ||  islink(data, node))   /* or combined with another value, */
         continue;               /* skip the attribute value */
-      r = group(tpls+g, n-g, &tsel); /* group tuples with next value */
+      r = partition(gi, grpfn, rows+g, n-g, &tsel);  /* group tuples */
+      #ifdef USE_THREADS        /* if to grow subtrees in parallel, */
+      if (tasks) {              /* only collect the subtree */
+        tasks[t].data = data;   /* (there are no null values) */
+        tasks[t].rows = rows; tasks[t].n = r;
+        tasks[t++].done = 0;    /* note the branch and tuples */
+        rows += r; n -= r; continue;
+      }                         /* skip the processed tuples */
+      #endif
       if (g > 0) {              /* if there are null values */
-        mul_wgt(tpls, g, data->child->cut/frq);
+        mul_row(gi->wgts, rows, g, data->child->cut/frq);
         frq = data->child->cut; /* weight tuples with a null value, */
       }                         /* note the denom. for reweighting */
-      data->child = grow(gi, data->child, tpls, r+g);
+      merge(gi, rows, r+g, g);  /* merge nulls into sorted lists */
+      data->child = grow(gi, data->child, rows, r+g);
       if (gi->err < 0) { delete(node); return leaf; }
       e_tree += gi->err;        /* grow a leaf/subtree for the value */
-      if (g > 0)                /* if there are null values, */
-        group(tpls, r+g, &tsel);/* regroup tuples with current value */
-      tpls += r; n -= r;        /* and skip processed tuples */
+      if (g > 0)                /* if there are null values, regroup */
+        partition(gi, grpfn, rows, r+g, &tsel);   /* tuples with value */
+      rows += r; n -= r;        /* and skip processed tuples */
+      c = addrun(gi, rows, runs, c, r);
+    }                           /* merge sorted runs of the lists */
+    #ifdef USE_THREADS          /* if to grow subtrees in parallel */
+    if (tasks) {                /* grow the collected subtrees */
+      subtrees(gi, tasks, t);   /* and sum their errors */
+      for (i = 0; i < t; i++) { /* (in the order of the branches) */
+        if (tasks[i].err < 0) break;
+        e_tree += tasks[i].err; /* check for an error and */
+      }                         /* sum the subtree errors */
+      if (i < t) {              /* if a subtree could not be grown */
+        free(tasks); delete(node); gi->err = -1; return leaf; }
+      for (i = 0; i < t; i++)   /* merge sorted runs of the lists */
+        c = addrun(gi, tasks[i].rows +tasks[i].n, runs, c, tasks[i].n);
+      free(tasks);              /* delete the task array */
     }
-    if (g > 0) mul_wgt(tpls, g, known/frq);
-  }                             /* reweight tuples with null values */
+    #endif
+    if (g > 0)                  /* reweight tuples with null values */
+      mul_row(gi->wgts, rows, g, known/frq);
+    merge(gi, rows, n, g);      /* merge nulls and remaining tuples */
+    while (--c >= 0) {          /* merge the remaining runs */
+      merge(gi, rows -runs[c], n +runs[c], runs[c]);
+      rows -= runs[c]; n += runs[c];
+    }                           /* (restore the sorted order of */
+    if (!(gi->flags & (DT_SUBSET|DT_1INN)))  /* the lists for the */
+      gi->used[tsel.col] = 0;   /* parent node) and unmark the */
+  }                             /* attribute for other branches */
 
   /* --- branch on metric attribute --- */
   else {                        /* if the test attribute is metric */
-    if (att_type(att) == AT_FLT) {              group = grp_flt; }
-    else { tsel.ival = (DTINT)floor(tsel.fval); group = grp_int; }
-    r = group(tpls, n, &tsel);  /* group tuples greater than the cut */
-    group = (att_type(att) == AT_FLT) ? grp_nullflt : grp_nullint;
-    g = group(tpls+r,n-r,&tsel);/* group tuples with a null value */
+    if (att_type(att) == AT_FLT) {              grpfn = row_flt; }
+    else { tsel.ival = (DTINT)floor(tsel.fval); grpfn = row_int; }
+    r = partition(gi, grpfn, rows, n, &tsel);  /* group tuples > cut */
+    grpfn = (att_type(att) == AT_FLT) ? row_nullflt : row_nullint;
+    g = partition(gi, grpfn, rows+r, n-r, &tsel);   /* group nulls */
+    #ifdef USE_THREADS          /* if no tuple has a null value, */
+    if ((g <= 0) && (n >= THRMIN) && gi->pool
+    &&  !(gi->flags & DT_EVAL)) {  /* grow the subtrees in parallel */
+      bin[0].data = data;   bin[0].rows = rows+r; bin[0].n = n-r;
+      bin[1].data = data+1; bin[1].rows = rows;   bin[1].n = r;
+      bin[0].done = bin[1].done = 0;
+      subtrees(gi, bin, 2);     /* grow both subtrees */
+      if ((bin[0].err < 0) || (bin[1].err < 0)) {
+        delete(node); gi->err = -1; return leaf; }
+      e_tree += bin[0].err;     /* sum the subtree errors */
+      e_tree += bin[1].err;     /* (in the order of the branches) */
+      merge(gi, rows, n, r);    /* restore the sorted order */
+      gi->maxht++;              /* of the lists for the parent */
+      goto test;                /* restore the maximal height and */
+    }                           /* continue with the subtree test */
+    #endif
     if (g > 0) {                /* if there are null values */
-      mul_wgt(tpls+r, g, data[0].child->cut/known);
+      mul_row(gi->wgts, rows+r, g, data[0].child->cut/known);
       frq = data[0].child->cut; /* weight tuples with null value */
     }                           /* and note freq. for reweighting */
-    data[0].child = grow(gi, data[0].child, tpls+r, n-r);
+    merge(gi, rows+r, n-r, g);  /* merge nulls into sorted lists */
+    data[0].child = grow(gi, data[0].child, rows+r, n-r);
     if (gi->err < 0) { delete(node); return leaf; }
     e_tree += gi->err;          /* grow a leaf/subtree for <= cut */
     if (g > 0) {                /* if there are null values, */
-      group(tpls+r,n-r, &tsel); /* regroup tuples with a null value */
-      mul_wgt(tpls+r, g, data[1].child->cut/frq);
+      partition(gi, grpfn, rows+r, n-r, &tsel);   /* regroup nulls */
+      mul_row(gi->wgts, rows+r, g, data[1].child->cut/frq);
       frq = data[1].child->cut; /* weight tuples with null value */
     }                           /* and note freq. for reweighting */
-    data[1].child = grow(gi, data[1].child, tpls, r+g);
+    merge(gi, rows, r+g, r);    /* merge nulls into sorted lists */
+    data[1].child = grow(gi, data[1].child, rows, r+g);
     if (gi->err < 0) { delete(node); return leaf; }
     e_tree += gi->err;          /* grow a leaf/subtree for > cut */
     if (g > 0) {                /* if there are null values, */
-      group(tpls, r+g, &tsel);  /* regroup tuples with null */
-      mul_wgt(tpls, g, known/frq);
+      partition(gi, grpfn, rows, r+g, &tsel);     /* regroup nulls */
+      mul_row(gi->wgts, rows, g, known/frq);
     }                           /* reweight tuples with null value */
+    merge(gi, rows+g, n-g, r);  /* restore the sorted order */
+    merge(gi, rows,   n,   g);  /* of the lists for the parent */
   }
   gi->maxht++;                  /* restore maximal (sub)tree height */
 
   /* --- test subtree against leaf --- */
+  #ifdef USE_THREADS
+  test:                         /* (target for parallel binary split) */
+  #endif
   if (!(gi->flags & DT_NOPRUNE)
   &&  (leaf->err < e_tree *(1+EPSILON))) {
     delete(node);               /* if the leaf is not worse */
@@ -1150,18 +2071,301 @@ static DTNODE* grow (GROW *gi, DTNODE *leaf, TUPLE **tpls, TPLID n)
 
 /*--------------------------------------------------------------------*/
 
-static DTREE* cleanup (GROW *gi, int err)
+static TPLID matrix (GROW *gi, TABLE *table, ATTID trgid)
+{                               /* --- build columnar training matrix */
+  ATTID i, k, m;                /* loop variable, numbers of atts. */
+  TPLID r, n;                   /* loop variable, number of rows */
+  TUPLE **tpls;                 /* tuples with known target value */
+  INST  *col;                   /* to traverse the columns */
+
+  assert(gi && table);          /* check the function arguments */
+  tpls = tuples(table, trgid, &n);
+  if (!tpls) return -1;         /* collect tuples with known target */
+  m = as_attcnt(gi->attset);    /* traverse the attributes and count */
+  for (k = i = 0; i < m; i++)   /* the usable ones and the target */
+    if (gi->used[i] <= 0) k++;  /* (only these need a column) */
+  gi->cols = (INST**) malloc((size_t)m *sizeof(INST*)
+                            +(size_t)k *(size_t)n *sizeof(INST));
+  gi->rows = (TPLID*) malloc((size_t)n *sizeof(TPLID));
+  gi->wgts = (WEIGHT*)malloc((size_t)n *sizeof(WEIGHT));
+  if (!gi->cols || !gi->rows || !gi->wgts) {
+    free(tpls); return -1; }    /* allocate the matrix */
+  col = (INST*)(gi->cols +m);   /* traverse the attributes again */
+  for (i = 0; i < m; i++) {     /* and copy the columns */
+    if (gi->used[i] > 0) { gi->cols[i] = NULL; continue; }
+    gi->cols[i] = col;          /* skip unusable attributes */
+    for (r = 0; r < n; r++) *col++ = *tpl_colval(tpls[r], i);
+  }                             /* copy the values of the column */
+  for (r = 0; r < n; r++) {     /* traverse the tuples again */
+    gi->rows[r] = r;            /* set the row indices */
+    gi->wgts[r] = tpl_getxwgt(tpls[r]);
+  }                             /* copy the tuple weights */
+  free(tpls);                   /* delete the tuple array */
+  return n;                     /* return the number of rows */
+}  /* matrix() */
+
+/*----------------------------------------------------------------------
+The function matrix() builds a column-major copy of the tuples with a
+known target value (training matrix), with one contiguous array of
+values for the target and each usable attribute and one array for
+the tuple weights (which are adapted during growing for tuples with a
+null value). A tree is grown on an array of row indices into this
+matrix instead of an array of tuples, so that the evaluation functions
+read only the (contiguous) columns they need instead of accessing one
+value in each tuple, and the tuples themselves are never modified.
+----------------------------------------------------------------------*/
+
+static void presort (GROW *gi, TPLID n)
+{                               /* --- presort rows on metric atts. */
+  ATTID i, k, m;                /* loop variable, numbers of atts. */
+  int   type;                   /* type of the current attribute */
+  TPLID *p;                     /* to traverse the sorted lists */
+
+  assert(gi && (n >= 0));       /* check the function arguments */
+  m = as_attcnt(gi->attset);    /* traverse the attributes */
+  for (k = i = 0; i < m; i++)   /* and count the usable metric ones */
+    if (!gi->used[i] && (att_type(as_att(gi->attset, i)) != AT_NOM))
+      k++;                      /* (only these need sorted lists) */
+  if ((k <= 0) || (n <= 1)) return;
+  gi->lists = (TPLID**)malloc((size_t)m     *sizeof(TPLID*)
+                             +(size_t)(k+1) *(size_t)n *sizeof(TPLID));
+  gi->sel   = (char*)calloc((size_t)n, sizeof(char));
+  if (!gi->lists || !gi->sel) { /* allocate lists and flags */
+    if (gi->lists) { free(gi->lists); gi->lists = NULL; }
+    if (gi->sel)   { free(gi->sel);   gi->sel   = NULL; }
+    return;                     /* on failure tuples are sorted */
+  }                             /* at each node (as a fallback) */
+  gi->buf = p = (TPLID*)(gi->lists +m);
+  for (i = 0; i < m; i++) {     /* traverse the attributes again */
+    type = att_type(as_att(gi->attset, i));
+    if (gi->used[i] || (type == AT_NOM)) {
+      gi->lists[i] = NULL; continue; }
+    gi->lists[i] = p += n;      /* copy the row array and sort it */
+    memcpy(p, gi->rows, (size_t)n *sizeof(TPLID));
+    row_qsort(p, (size_t)n, +1, (type == AT_FLT)
+              ? cmp_flt : cmp_int, (void*)gi->cols[i]);
+  }                             /* (the first n indices after the */
+}  /* presort() */              /* list array are the split buffer) */
+
+/*----------------------------------------------------------------------
+The function presort() sorts the rows once for each usable metric
+attribute (with null values first), so that the evaluation functions
+can find the best cut value for such an attribute with a single
+linear traversal of the (presorted) rows of a node. The sorted
+lists are kept parallel to the row array: the section of a list
+that corresponds to a node is at the same offset as the section of
+the row array (see function partition()). If the memory for the
+lists cannot be allocated, the rows are sorted at each node.
+----------------------------------------------------------------------*/
+
+static int binning (GROW *gi, TPLID n, int bincnt)
+{                               /* --- bin metric attributes */
+  ATTID  i, k, m;               /* loop variable, numbers of atts. */
+  TPLID  j, r, z;               /* tuple indices, number of nulls */
+  TPLID  d;                     /* number of distinct values */
+  int    b, type;               /* bin index, type of attribute */
+  TPLID  *p;                    /* sorted rows */
+  const INST *col;              /* column of the attribute */
+  double v;                     /* value of current tuple */
+  double *bnd;                  /* to traverse the bin bounds */
+  unsigned char *codes;         /* to traverse the bin codes */
+
+  assert(gi && (n >= 0) && (bincnt > 0));
+  if (bincnt > BINNULL) bincnt = BINNULL;
+  m = as_attcnt(gi->attset);    /* traverse the attributes */
+  for (k = i = 0; i < m; i++)   /* and count the usable metric ones */
+    if (!gi->used[i] && (att_type(as_att(gi->attset, i)) != AT_NOM))
+      k++;                      /* (only these need bins) */
+  if ((k <= 0) || (n <= 1)) return -1;
+  gi->bins = (BINS*)calloc(1, (size_t)m *sizeof(BINS)
+                           +(size_t)k *(size_t)(bincnt+bincnt)
+                                      *sizeof(double)
+                           +(size_t)k *(size_t)n);
+  p = (TPLID*)malloc((size_t)n *sizeof(TPLID));
+  gi->hist = (gi->type == AT_NOM)
+           ? (void*)ft_create(bincnt, gi->dtree->clscnt)
+           : (void*)vt_create(bincnt);
+  if (!gi->bins || !p || !gi->hist) {
+    if (gi->bins) { free(gi->bins); gi->bins = NULL; }
+    if (p)        free(p);      /* allocate bins, sort buffer */
+    if (gi->hist) {             /* and the histogram table */
+      if (gi->type == AT_NOM) ft_delete((FRQTAB*)gi->hist);
+      else                    vt_delete((VARTAB*)gi->hist);
+      gi->hist = NULL;          /* on failure the tuples are */
+    }                           /* presorted instead of binned */
+    return -1;                  /* (exact cuts as a fallback) */
+  }
+  bnd   = (double*)(gi->bins +m);
+  codes = (unsigned char*)(bnd +(size_t)k *(size_t)(bincnt+bincnt));
+  for (i = 0; i < m; i++) {     /* traverse the attributes again */
+    type = att_type(as_att(gi->attset, i));
+    if (gi->used[i] || (type == AT_NOM))
+      continue;                 /* skip nominal and unusable atts. */
+    gi->bins[i].codes = codes;  codes += n;
+    gi->bins[i].min   = bnd;    bnd   += bincnt;
+    gi->bins[i].max   = bnd;    bnd   += bincnt;
+    memset(gi->bins[i].codes, BINNULL, (size_t)n);
+    col = gi->cols[i];          /* get the attribute column */
+    memcpy(p, gi->rows, (size_t)n *sizeof(TPLID));
+    row_qsort(p, (size_t)n, +1, (type == AT_FLT)
+              ? cmp_flt : cmp_int, (void*)col);
+    for (z = 0; z < n; z++) {   /* sort rows and skip null values */
+      if ((type == AT_INT) ? !isnull(col[p[z]].i) : !isnan(col[p[z]].f))
+        break;                  /* (null values precede all others) */
+    }
+    for (d = 0, r = z; r < n; r++)   /* count the distinct values */
+      if ((r <= z) || (((type == AT_FLT) ? cmp_flt : cmp_int)
+                       (p[r-1], p[r], (void*)col) != 0))
+        d++;                    /* (one bin per value if possible) */
+    for (b = -1, r = z; r < n; r = j) {
+      v = (type == AT_INT)      /* traverse the distinct values */
+        ? (double)col[p[r]].i : (double)col[p[r]].f;
+      if ((b < 0) || (d <= bincnt)  /* if at the start, if there are */
+      || (((double)(r-z) *bincnt >= (double)(b+1) *(double)(n-z))
+      &&  (b < bincnt-1)))      /* few values, or if the current bin */
+        gi->bins[i].min[++b] = v;   /* has reached its quota, */
+                                /* start a new bin */
+      for (j = r; j < n; j++) { /* traverse rows with same value */
+        if (((type == AT_INT) ? (double)col[p[j]].i
+                              : (double)col[p[j]].f) != v)
+          break;                /* if the value differs, abort, */
+        gi->bins[i].codes[p[j]] = (unsigned char)b;
+      }                         /* otherwise set the bin code */
+      gi->bins[i].max[b] = v;   /* update the maximum of the bin */
+    }
+    gi->bins[i].cnt = b+1;      /* note the number of bins */
+  }
+  free(p);                      /* delete the sort buffer */
+  gi->bincnt = bincnt;          /* note the maximal number of bins */
+  return 0;                     /* return 'ok' */
+}  /* binning() */
+
+/*----------------------------------------------------------------------
+The function binning() discretizes each usable metric attribute into
+at most bincnt (<= 255) bins with (roughly) equal numbers of rows
+(quantile binning). For this the rows are sorted once per attribute
+and a new bin is started at a value change as soon as the current bin
+has received its share of the rows, so that rows with the same value
+always fall into the same bin. An attribute with at most bincnt
+distinct values receives one bin per value and thus yields exactly
+the cuts of the unbinned case.
+The bin of each row is stored as a one byte code (255 for a null
+value), together with the smallest and largest value of each bin,
+from which the cut values are computed (see functions nom_hst() and
+met_hst()). Since no sorted lists need to be maintained while the
+tree is grown, the rows are not presorted in this case.
+----------------------------------------------------------------------*/
+
+#ifdef USE_THREADS
+
+static int contexts (GROW *gi, int thcnt, VALID maxcnt)
+{                               /* --- create additional contexts */
+  int   i;                      /* loop variable */
+  ATTID m;                      /* number of attributes */
+  GROW  *w;                     /* additional grow context */
+
+  if (thcnt <= 0) thcnt = thr_cnt();
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  gi->thcnt = 1;                /* check for multiple threads */
+  if ((!gi->lists && !gi->bins) || (thcnt <= 1)) return 0;
+  gi->pool = (CTXPOOL*)malloc(sizeof(CTXPOOL));
+  if (!gi->pool) return -1;     /* create a pool of contexts */
+  if (thr_mxinit(&gi->pool->mutex) != 0) {
+    free(gi->pool); gi->pool = NULL; return -1; }
+  gi->pool->cnt = 0;            /* create a mutex for the pool */
+  gi->ctxs = (PGROW*)calloc((size_t)(thcnt-1), sizeof(PGROW));
+  if (!gi->ctxs) return -1;     /* create the context array */
+  gi->thcnt = thcnt;            /* note the number of threads */
+  m = as_attcnt(gi->attset);    /* get the number of attributes */
+  for (i = 0; i < thcnt-1; i++) {
+    gi->ctxs[i] = w = (GROW*)malloc(gi->size +(size_t)m *sizeof(char));
+    if (!w) return -1;          /* create a copy of the */
+    memcpy(w, gi, gi->size);    /* tree grow information */
+    w->ctxs = NULL;             /* (shares all read-only data) */
+    w->used = (char*)w +gi->size;   /* set private used flags */
+    if (gi->type == AT_NOM) {   /* if the target is nominal */
+      w->mett = ft_create(2,      gi->dtree->clscnt);
+      w->best = ft_create(maxcnt, gi->dtree->clscnt);
+      w->curr = ft_create(maxcnt, gi->dtree->clscnt);
+      w->hist = (!gi->hist) ? NULL
+              : ft_create(gi->bincnt, gi->dtree->clscnt); }
+    else {                      /* if the target is metric */
+      w->mett = vt_create(2);   /* create private */
+      w->best = vt_create(maxcnt);   /* frequency/variation */
+      w->curr = vt_create(maxcnt);   /* tables for the context */
+      w->hist = (!gi->hist) ? NULL : vt_create(gi->bincnt);
+    }                           /* (the evaluation functions */
+    if (!w->mett || !w->best || !w->curr   /* work on them) */
+    || (gi->hist && !w->hist))  /* check for successful creation */
+      return -1;                /* (histogram only if binned) */
+    gi->pool->idle[gi->pool->cnt++] = w;
+  }                             /* add the context to the pool */
+  logGamma(1.0);                /* initialize the gamma tables */
+  return 0;                     /* (lazy init. is not thread-safe) */
+}  /* contexts() */
+
+/*----------------------------------------------------------------------
+The function contexts() prepares parallel attribute evaluation and
+parallel growing of subtrees (see functions parsel() and subtrees()).
+It creates a pool of thcnt-1 additional grow contexts, each of which
+is a copy of the tree grow information with its own used flags,
+frequency/variation tables, and value subset array, but which shares
+the training matrix, the row array, the presorted lists or the bins,
+the split buffer, and the selection flags with the original. Without
+presorted lists or bins the evaluation functions sort the rows of a
+node in place, so in this case (memory shortage) no threads are used.
+----------------------------------------------------------------------*/
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static void* cleanup (GROW *gi, int err)
 {                               /* --- clean up after an error */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  int  i;                       /* loop variable */
+  GROW *w;                      /* to traverse the contexts */
+
+  if (gi->ctxs) {               /* if there are additional contexts */
+    for (i = 0; i < gi->thcnt-1; i++) {
+      if (!(w = gi->ctxs[i])) break;
+      if (gi->type == AT_NOM) { /* traverse the contexts */
+        if (w->curr) ft_delete(w->curr);
+        if (w->best) ft_delete(w->best);
+        if (w->mett) ft_delete(w->mett);
+        if (w->hist) ft_delete(w->hist); }
+      else {                    /* delete the (private) */
+        if (w->curr) vt_delete(w->curr);
+        if (w->best) vt_delete(w->best);
+        if (w->mett) vt_delete(w->mett);
+        if (w->hist) vt_delete(w->hist);
+      }                         /* frequency/variation tables */
+      free(w);                  /* and the grow information copy */
+    }
+    free(gi->ctxs);             /* delete the context array */
+  }
+  if (gi->pool) {               /* if there is a pool of contexts, */
+    thr_mxfree(&gi->pool->mutex);  /* delete its mutex */
+    free(gi->pool);             /* and the pool itself */
+  }
+  #endif
   if (gi->type == AT_NOM) {     /* if the target is nominal */
     if (gi->curr) ft_delete(gi->curr);
     if (gi->best) ft_delete(gi->best);
-    if (gi->mett) ft_delete(gi->mett); }
+    if (gi->mett) ft_delete(gi->mett);
+    if (gi->hist) ft_delete(gi->hist); }
   else {                        /* if the target is metric */
     if (gi->curr) vt_delete(gi->curr);
     if (gi->best) vt_delete(gi->best);
     if (gi->mett) vt_delete(gi->mett);
+    if (gi->hist) vt_delete(gi->hist);
   }                             /* delete frequency/variation tables */
-  if (gi->tpls) free(gi->tpls); /* and the tuple array */
+  if (gi->grad)  free(gi->grad);   /* delete the gradients, */
+  if (gi->bins)  free(gi->bins);   /* the bins, */
+  if (gi->lists) free(gi->lists);  /* the presorted lists, */
+  if (gi->sel)   free(gi->sel);    /* the selection flags, */
+  if (gi->wgts)  free(gi->wgts);   /* the weight column, */
+  if (gi->rows)  free(gi->rows);   /* the row array, */
+  if (gi->cols)  free(gi->cols);   /* and the training matrix */
   if (err) {                    /* if to clean up after an error */
     if (gi->dtree) dt_delete(gi->dtree, 0);
     if (gi->attset && (gi->flags & DT_DUPAS))
@@ -1172,26 +2376,23 @@ static DTREE* cleanup (GROW *gi, int err)
 
 /*--------------------------------------------------------------------*/
 
-DTREE* dt_grow (TABLE *table, ATTID trgid, int measure, double *params,
-                double minval, ATTID maxht, double mincnt, int flags)
-{                               /* --- grow dec./reg. tree from table */
+static GROW* prepare (TABLE *table, ATTID trgid, int measure,
+                      double *params, double minval, ATTID maxht,
+                      double mincnt, int flags, int bincnt, int thcnt,
+                      TPLID *n)
+{                               /* --- prepare growing a tree */
   ATTID  m, i;                  /* number of attributes */
-  VALID  k;                     /* loop variable for values */
-  TPLID  r;                     /* loop variable for tuples */
-  int    e;                     /* flagless measure, error status */
-  TUPLE  **tp;                  /* to traverse the tuple array */
-  TPLID  tplcnt;                /* number of tuples */
+  VALID  k;                     /* size of the value subset array */
+  int    e;                     /* flagless measure */
   VALID  valcnt;                /* number of possible values */
   VALID  maxcnt;                /* maximal number of values */
   ATTSET *attset;               /* attribute set */
-  INST   *inst;                 /* instance of the target attribute */
-  double val;                   /* value    of the target attribute */
   GROW   *gi;                   /* tree grow information */
   DTREE  *dt;                   /* created decision tree */
 
-  assert(table);                /* check the function argument */
+  assert(table && n);           /* check the function arguments */
 
-  /* --- create an empty decision/regression tree --- */
+  /* --- create the tree grow information --- */
   attset = tab_attset(table);   /* get the attribute set */
   for (maxcnt = 2, i = m = as_attcnt(attset); --i >= 0; ) {
     if (i == trgid) continue;   /* traverse attributes except target */
@@ -1201,11 +2402,14 @@ DTREE* dt_grow (TABLE *table, ATTID trgid, int measure, double *params,
   k  = (flags & DT_SUBSET) ? maxcnt : 1;
   gi = (GROW*)calloc(1, sizeof(GROW) +(size_t)(k-1) *sizeof(VALID));
   if (!gi) return NULL;         /* create the tree grow information */
+  gi->size   = sizeof(GROW) +(size_t)(k-1) *sizeof(VALID);
+  gi->maxcnt = maxcnt;          /* note the maximal number of values */
   gi->flags  = flags;           /* and store the induction flags */
   if (flags & DT_DUPAS) attset = as_clone(attset);
   if (!attset) return cleanup(gi, 1);
   gi->attset = attset;          /* duplicate att. set if requested */
-  gi->type   = att_type(as_att(attset, trgid));
+  gi->type   = (flags & DT_GRAD) ? AT_FLT  /* gradients are metric */
+             : att_type(as_att(attset, trgid));
   if (gi->type == AT_NOM) {     /* if target attribute is nominal */
     e = measure & ~FEF_WGTD;    /* remove the flags from measure code */
     if ((e <= FEM_NONE) || (e >= FEM_UNKNOWN))
@@ -1237,85 +2441,1093 @@ DTREE* dt_grow (TABLE *table, ATTID trgid, int measure, double *params,
   for (i = 0; i < m; i++)       /* traverse the attributes and */
     gi->used[i] = (att_getmark(as_att(attset, i)) >= 0) ? 0 : +1;
   gi->used[trgid] = -1;         /* target is always used */
-  tp = tuples(table, trgid, &tplcnt);
-  if (!tp) return cleanup(gi, 1);
-  gi->tpls = tp;                /* collect tuples with known class */
-
-  /* --- create a root node --- */
+  *n = matrix(gi, table, trgid);
+  if (*n < 0) return cleanup(gi, 1);
+  gi->trgs = gi->cols[trgid];   /* get the target column */
+  if (flags & DT_GRAD) {        /* if to grow on gradients, */
+    gi->grad = (INST*)malloc((size_t)*n *sizeof(INST));
+    if (!gi->grad) return cleanup(gi, 1);
+    gi->trgs = gi->grad;        /* create a gradient column */
+  }                             /* and use it as the target */
+
+  /* --- create evaluation tables --- */
   if (gi->type == AT_NOM) {     /* if target attribute is nominal */
     gi->minerr = MINERROR;      /* set minimum error for division */
-    gi->mett = ft_create(2, dt->clscnt);
-    if (!gi->mett) return cleanup(gi, 1);
+    gi->mett = ft_create(2, dt->clscnt); }
+  else {                        /* if target attribute is metric */
+    gi->minerr = -1.0;          /* set minimum error for division */
+    gi->mett = vt_create(2);    /* create a frequency table */
+  }                             /* or a variation table */
+  if (!gi->mett) return cleanup(gi, 1);
+  if ((gi->maxht <= 0)          /* if the maximum height is zero */
+  ||  (m <= ((dt->type == AT_NOM) /* or no selection measure */
+           ? FEM_NONE : VEM_NONE))) /* is given, only a root */
+    return gi;                  /* node can be created */
+  if (gi->type != AT_NOM) {     /* if target attribute is metric */
+    gi->best = vt_create(maxcnt);    /* create */
+    gi->curr = vt_create(maxcnt);    /* variation tables */
+    if (!gi->best || !gi->curr) return cleanup(gi, 1);
+    if      (flags & DT_1INN)   gi->eval_nom = met_bin;
+    else if (flags & DT_SUBSET) gi->eval_nom = met_set;
+    else                        gi->eval_nom = met_nom;
+    gi->eval_met = met_met; }   /* set the evaluation functions */
+  else {                        /* if target attribute is nominal */
+    gi->best = ft_create(maxcnt, dt->clscnt);
+    gi->curr = ft_create(maxcnt, dt->clscnt);
+    if (!gi->best || !gi->curr) return cleanup(gi, 1);
+    if      (flags & DT_1INN)   gi->eval_nom = nom_bin;
+    else if (flags & DT_SUBSET) gi->eval_nom = nom_set;
+    else                        gi->eval_nom = nom_nom;
+    gi->eval_met = nom_met;     /* create frequency tables and */
+  }                             /* set the evaluation functions */
+  if ((bincnt <= 0)             /* bin or presort the metric atts. */
+  ||  (binning(gi, *n, bincnt) != 0))
+    presort(gi, *n);
+  else                          /* if the attributes are binned, */
+    gi->eval_met = (gi->type == AT_NOM) ? nom_hst : met_hst;
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if (contexts(gi, thcnt, maxcnt) != 0) return cleanup(gi, 1);
+  #endif                        /* create additional grow contexts */
+  return gi;                    /* return the tree grow information */
+}  /* prepare() */
+
+/*----------------------------------------------------------------------
+The function prepare() does all the work that is needed before a tree
+can be grown: it creates the tree grow information with an empty tree,
+builds the training matrix, and creates the evaluation tables and
+either the bins or the presorted lists of the metric attributes. The
+evaluation tables for selecting test attributes (gi->curr and
+gi->best) are created only if a tree with more than a root can be
+grown. Since all these objects are only read while a tree is grown
+(apart from the weight column and the row order), a random forest
+prepares them once and shares them between all of its trees.
+----------------------------------------------------------------------*/
+
+static int root (GROW *gi, TPLID n)
+{                               /* --- create the root of a tree */
+  TPLID  r;                     /* loop variable for rows */
+  TPLID  *rows;                 /* rows of the tuples to use */
+  const INST *trgs;             /* column of the target attribute */
+  double val;                   /* value  of the target attribute */
+  DTREE  *dt;                   /* tree to create the root for */
+
+  assert(gi && (n >= 0));       /* check the function arguments */
+  dt   = gi->dtree;             /* get the tree, the rows */
+  rows = gi->rows;              /* and the target column */
+  trgs = gi->trgs;
+  if (gi->type == AT_NOM) {     /* if target attribute is nominal */
     ft_init((FRQTAB*)gi->mett, 1, dt->clscnt);
-                                /* create and init. a freq. table */
-    for (tp += r = tplcnt; --r >= 0;) {
-      inst = tpl_colval(*--tp, trgid);
-      ft_add((FRQTAB*)gi->mett, 0, inst->n, tpl_getxwgt(*tp));
-    }                           /* aggregate the tuple weight and */
+                                /* init. the frequency table */
+    for (r = n; --r >= 0; )     /* aggregate the row weights */
+      ft_add((FRQTAB*)gi->mett, 0, trgs[rows[r]].n, gi->wgts[rows[r]]);
     ft_marg(gi->mett);          /* marginalize the frequency table */
-    if (ft_known((FRQTAB*)gi->mett) > 0) {  /* if there are tuples */
-      dt->root = leaf_nom(dt, gi->mett, 0);
-      if (!dt->root) return cleanup(gi, 1);
-    } }                         /* create a leaf node as the root */
+    if (ft_known((FRQTAB*)gi->mett) <= 0)
+      return 0;                 /* if there are no tuples, abort */
+    dt->root = leaf_nom(dt, gi->mett, 0); }
   else {                        /* if target attribute is metric */
-    gi->minerr = -1.0;          /* set minimum error for division */
-    gi->mett = vt_create(2);    /* create a variation table */
-    if (!gi->mett) return cleanup(gi, 1);
     vt_init((VARTAB*)gi->mett, 1); /* init. the variation table */
-    for (tp += r = tplcnt; --r >= 0;) {
-      inst = tpl_colval(*--tp, trgid);
-      val  = (dt->type == AT_INT) ? (double)inst->i : (double)inst->f;
-      vt_add((VARTAB*)gi->mett, 0, val, tpl_getxwgt(*tp));
-    }                           /* aggregate the tuple weight and */
-    vt_calc(gi->mett);          /* calculate the var. aggregates */
-    if (vt_known((VARTAB*)gi->mett) > 0) { /* if there are tuples */
-      dt->root = leaf_met(dt, (VARTAB*)gi->mett, 0);
-      if (!dt->root) return cleanup(gi, 1);
-    }                           /* create a root node */
-  }                             /* from the variation table */
-
-  /* --- recursively grow a tree --- */
-  if (dt->root                  /* if a root node has been created */
-  && (gi->maxht > 0)            /* and the maximum height is not zero */
-  && (m > ((dt->type == AT_NOM) /* and a selection measure is given */
-        ? FEM_NONE : VEM_NONE))) {
-    for (i = as_attcnt(attset); --i >= 0; ) {
-      if (i == trgid) continue; /* traverse attributes except class */
-      valcnt = att_valcnt(as_att(attset, i));
-      if (valcnt > maxcnt) maxcnt = valcnt;
-    }                           /* determine maximal number of values */
-    if (gi->type != AT_NOM) {   /* if target attribute is metric */
-      gi->best = vt_create(maxcnt);  /* create */
-      gi->curr = vt_create(maxcnt);  /* variation tables */
-      if (!gi->best || !gi->curr) return cleanup(gi, 1);
-      if      (flags & DT_1INN)   gi->eval_nom = met_bin;
-      else if (flags & DT_SUBSET) gi->eval_nom = met_set;
-      else                        gi->eval_nom = met_nom;
-      gi->eval_met = met_met; } /* set the evaluation functions */
-    else {                      /* if target attribute is nominal */
-      gi->best = ft_create(maxcnt, dt->clscnt);
-      gi->curr = ft_create(maxcnt, dt->clscnt);
-      if (!gi->best || !gi->curr) return cleanup(gi, 1);
-      if      (flags & DT_1INN)   gi->eval_nom = nom_bin;
-      else if (flags & DT_SUBSET) gi->eval_nom = nom_set;
-      else                        gi->eval_nom = nom_nom;
-      gi->eval_met = nom_met;   /* create frequency tables and */
-    }                           /* set the evaluation functions */
-    dt->root = grow(gi, dt->root, tp, tplcnt);
-  }                             /* recursively grow a decision tree */
-  e = (gi->err < 0);            /* get the error status */
-  cleanup(gi, e);               /* clean up the temporary objects */
-  if (e) return NULL;           /* if an error occured, abort */
+    for (r = n; --r >= 0; ) {   /* aggregate the row weights */
+      val = (gi->type == AT_INT) ? (double)trgs[rows[r]].i
+                                 : (double)trgs[rows[r]].f;
+      vt_add((VARTAB*)gi->mett, 0, val, gi->wgts[rows[r]]);
+    }                           /* calculate the var. aggregates */
+    vt_calc(gi->mett);          /* if there are no tuples, abort */
+    if (vt_known((VARTAB*)gi->mett) <= 0) return 0;
+    dt->root = leaf_met(dt, (VARTAB*)gi->mett, 0);
+  }                             /* create a leaf node as the root */
+  return (dt->root) ? 0 : -1;   /* return an error indicator */
+}  /* root() */
 
-  /* --- compute statistics --- */
+/*--------------------------------------------------------------------*/
+
+static void stats (DTREE *dt)
+{                               /* --- compute tree statistics */
   dt->attcnt = -1;              /* invalidate the attribute counter */
   dt->height =  0;              /* determine the tree information */
   dt->total  = (!dt->root) ? 0.0 : dt->root->frq;
   dt->size   = (!dt->root) ? 0   : count(dt, dt->root, 0);
   dt->curr   = dt->root;        /* set the node cursor to the root */
+}  /* stats() */
+
+/*--------------------------------------------------------------------*/
+
+DTREE* dt_grow (TABLE *table, ATTID trgid, int measure, double *params,
+                double minval, ATTID maxht, double mincnt, int flags,
+                int bincnt, int thcnt)
+{                               /* --- grow dec./reg. tree from table */
+  int    e;                     /* error status */
+  TPLID  n;                     /* number of rows */
+  GROW   *gi;                   /* tree grow information */
+  DTREE  *dt;                   /* created decision tree */
+
+  assert(table);                /* check the function argument */
+  gi = prepare(table, trgid, measure, params, minval, maxht, mincnt,
+               flags, bincnt, thcnt, &n);
+  if (!gi) return NULL;         /* prepare growing the tree */
+  dt = gi->dtree;               /* get the (empty) tree */
+  if (root(gi, n) != 0) return cleanup(gi, 1);
+  if (dt->root && gi->curr)     /* create a root node and */
+    dt->root = grow(gi, dt->root, gi->rows, n);
+  e = (gi->err < 0);            /* recursively grow a tree */
+  cleanup(gi, e);               /* clean up the temporary objects */
+  if (e) return NULL;           /* if an error occured, abort */
+  stats(dt);                    /* compute the tree statistics */
   return dt;                    /* return the grown dec./reg. tree */
 }  /* dt_grow() */
 
+/*----------------------------------------------------------------------
+  Random Forest Functions
+----------------------------------------------------------------------*/
+
+static GROW* bagdel (GROW *w)
+{                               /* --- delete a bagging context */
+  if (w->type == AT_NOM) {      /* if the target is nominal */
+    if (w->curr) ft_delete(w->curr);
+    if (w->best) ft_delete(w->best);
+    if (w->mett) ft_delete(w->mett);
+    if (w->hist) ft_delete(w->hist); }
+  else {                        /* if the target is metric */
+    if (w->curr) vt_delete(w->curr);
+    if (w->best) vt_delete(w->best);
+    if (w->mett) vt_delete(w->mett);
+    if (w->hist) vt_delete(w->hist);
+  }                             /* delete frequency/variation tables */
+  if (w->lists) free(w->lists); /* delete the presorted lists, */
+  if (w->sel)   free(w->sel);   /* the selection flags, */
+  if (w->wgts)  free(w->wgts);  /* the weight column, */
+  if (w->rows)  free(w->rows);  /* the row array, */
+  if (w->rng)   rng_delete(w->rng);   /* the random number */
+  free(w); return NULL;         /* generator, and the context */
+}  /* bagdel() */
+
+/*--------------------------------------------------------------------*/
+
+static GROW* bagctx (GROW *gi, TPLID n, int rand)
+{                               /* --- create a bagging context */
+  ATTID i, k, m;                /* loop variable, numbers of atts. */
+  TPLID *p;                     /* to traverse the list sections */
+  VALID c;                      /* number of classes */
+  GROW  *w;                     /* created bagging context */
+
+  assert(gi && (n >= 0));       /* check the function arguments */
+  m = as_attcnt(gi->attset);    /* get the number of attributes */
+  w = (GROW*)malloc(gi->size +(size_t)m *sizeof(char));
+  if (!w) return NULL;          /* create a copy of the */
+  memcpy(w, gi, gi->size);      /* tree grow information */
+  w->used  = (char*)w +gi->size;    /* set private used flags */
+  w->dtree = NULL; w->rows = NULL; w->wgts = NULL;
+  w->lists = NULL; w->buf  = NULL; w->sel  = NULL;
+  w->curr  = w->best = w->mett = w->hist = NULL;
+  #ifdef USE_THREADS            /* clear all private objects */
+  w->thcnt = 1; w->pool = NULL; w->ctxs = NULL;
+  #endif                        /* (trees are grown serially) */
+  w->rows = (TPLID*) malloc((size_t)(n+1) *sizeof(TPLID));
+  w->wgts = (WEIGHT*)malloc((size_t)(n+1) *sizeof(WEIGHT));
+  w->rng  = (rand) ? rng_create(0) : NULL;
+  if (!w->rows || !w->wgts      /* create the row array, the weights, */
+  || (rand && !w->rng))         /* and a random number generator */
+    return bagdel(w);           /* (for the bootstrap and subsets) */
+  if (gi->lists) {              /* if there are presorted lists */
+    for (k = i = 0; i < m; i++) /* count the sorted lists */
+      if (gi->lists[i]) k++;    /* and allocate private lists */
+    w->lists = (TPLID**)malloc((size_t)m     *sizeof(TPLID*)
+                              +(size_t)(k+1) *(size_t)n *sizeof(TPLID));
+    w->sel   = (char*)calloc((size_t)n+1, sizeof(char));
+    if (!w->lists || !w->sel) return bagdel(w);
+    w->buf = p = (TPLID*)(w->lists +m);
+    for (i = 0; i < m; i++)     /* set the list sections */
+      w->lists[i] = (gi->lists[i]) ? (p += n) : NULL;
+  }                             /* (the first n are the split buffer) */
+  c = gi->dtree->clscnt;        /* get the number of classes */
+  if (gi->type == AT_NOM) {     /* if the target is nominal */
+    w->mett = ft_create(2, c);  /* create private frequency tables */
+    if (gi->curr) { w->best = ft_create(gi->maxcnt, c);
+                    w->curr = ft_create(gi->maxcnt, c); }
+    if (gi->hist)   w->hist = ft_create(gi->bincnt, c); }
+  else {                        /* if the target is metric */
+    w->mett = vt_create(2);     /* create private variation tables */
+    if (gi->curr) { w->best = vt_create(gi->maxcnt);
+                    w->curr = vt_create(gi->maxcnt); }
+    if (gi->hist)   w->hist = vt_create(gi->bincnt);
+  }                             /* check for successful creation */
+  if (!w->mett || (gi->curr && (!w->best || !w->curr))
+  ||  (gi->hist && !w->hist)) return bagdel(w);
+  return w;                     /* return the created context */
+}  /* bagctx() */
+
+/*----------------------------------------------------------------------
+A bagging context is a copy of the tree grow information that shares
+the training matrix and the bins with the original, but has its own
+row array, weight column, presorted lists, selection flags, used
+flags, frequency/variation tables, and (if rand is nonzero) random
+number generator. It is reused for all trees that are grown by the
+same worker. Without a random number generator all usable attributes
+are evaluated at each node (see function selatt()).
+----------------------------------------------------------------------*/
+
+static double poisson (RNG *rng, double mean)
+{                               /* --- Poisson distributed number */
+  double k, p, lim;             /* counter, product, limit */
+
+  if (mean <= 0) return 0;      /* check for a positive mean */
+  if (mean > 32) {              /* use a normal approximation */
+    k = floor(mean +sqrt(mean) *rng_norm(rng) +0.5);
+    return (k > 0) ? k : 0;     /* for large means */
+  }                             /* (avoid many random numbers) */
+  lim = exp(-mean);             /* multiply uniform random numbers */
+  for (k = 0, p = rng_dbl(rng); p > lim; k++)
+    p *= rng_dbl(rng);          /* until the product falls */
+  return k;                     /* below exp(-mean) */
+}  /* poisson() */              /* (Knuth's algorithm) */
+
+/*--------------------------------------------------------------------*/
+
+static void bootstrap (GROW *w, const WEIGHT *wgts, TPLID n)
+{                               /* --- draw a bootstrap sample */
+  TPLID r;                      /* loop variable for rows */
+
+  assert(w && wgts);            /* check the function arguments */
+  for (r = 0; r < n; r++)       /* draw the number of occurrences */
+    w->wgts[r] = (WEIGHT)poisson(w->rng, (double)wgts[r]);
+}  /* bootstrap() */            /* of each row in the sample */
+
+/*----------------------------------------------------------------------
+The function bootstrap() draws a bootstrap sample by replacing the
+weight of each row with a Poisson distributed number of occurrences
+with the row weight as its mean (Poisson bootstrap). For unit weights
+this approximates drawing n rows with replacement (the number of
+occurrences of a row is binomially distributed with parameters n and
+1/n, which tends to a Poisson distribution with mean 1), and for a
+row that represents several identical tuples (tab_reduce()) it is
+the same as drawing for each of these tuples individually. Since the
+rows are drawn independently, no cumulative weight array is needed
+and the sample is fully described by a weight column, so that the
+training matrix need not be copied.
+----------------------------------------------------------------------*/
+
+static DTREE* sample (GROW *gi, GROW *w, TPLID n)
+{                               /* --- grow a tree on a sample */
+  ATTID i;                      /* loop variable for attributes */
+  TPLID r, k;                   /* loop variable, number of rows */
+  TPLID *src, *dst;             /* to traverse the sorted lists */
+  DTREE *dt;                    /* created decision tree */
+
+  assert(gi && w);              /* check the function arguments */
+  for (k = r = 0; r < n; r++)   /* collect the rows */
+    if (w->wgts[r] > 0) w->rows[k++] = r;  /* in the sample */
+  for (i = as_attcnt(gi->attset); --i >= 0; ) {
+    if (!w->lists || !w->lists[i]) continue;
+    src = gi->lists[i];         /* traverse the presorted lists */
+    dst = w->lists[i];          /* and copy the drawn rows */
+    for (r = n; --r >= 0; src++)  /* (keeps the sorted order) */
+      if (w->wgts[*src] > 0) *dst++ = *src;
+  }
+  w->dtree = dt = dt_create(gi->attset, gi->dtree->trgid);
+  if (!dt) return NULL;         /* create an empty decision tree */
+  w->maxht = gi->maxht;         /* reset the maximal height */
+  w->err   = 0;                 /* and the error indicator */
+  if (root(w, k) != 0) { dt_delete(dt, 0); return NULL; }
+  if (dt->root && w->curr)      /* create a root node and */
+    dt->root = grow(w, dt->root, w->rows, k);
+  if (w->err < 0) { dt_delete(dt, 0); return NULL; }
+  stats(dt);                    /* recursively grow the tree */
+  return dt;                    /* and compute its statistics */
+}  /* sample() */
+
+/*----------------------------------------------------------------------
+The function sample() grows a tree on the rows that have a positive
+weight in the weight column of a bagging context (see function
+bagctx()), which must have been set before, together with the used
+flags. The rows are collected in their original order and the
+presorted lists of the shared grow information are filtered (only for
+the lists the context has), so that no sorting is needed.
+----------------------------------------------------------------------*/
+
+static DTREE* bag (GROW *gi, GROW *w, TPLID n, unsigned int seed)
+{                               /* --- grow a tree on a bootstrap */
+  assert(gi && w);              /* check the function arguments */
+  memcpy(w->used, gi->used, (size_t)as_attcnt(gi->attset));
+  rng_seed(w->rng, seed);       /* draw a bootstrap sample */
+  bootstrap(w, gi->wgts, n);    /* (weights are numbers of draws) */
+  return sample(gi, w, n);      /* and grow a tree on it */
+}  /* bag() */
+
+/*--------------------------------------------------------------------*/
+#ifdef USE_THREADS
+
+static WORKERDEF(bagwork, p)
+{                               /* --- grow trees (worker) */
+  BAGWORK *b = (BAGWORK*)p;     /* type the worker data */
+  int     t;                    /* index of the tree to grow */
+
+  while (1) {                   /* tree growing loop */
+    thr_lock(b->mutex);         /* get the next tree */
+    t = (*b->next)++;           /* (trees are distributed */
+    thr_unlock(b->mutex);       /* dynamically over the workers) */
+    if (t >= b->cnt) break;     /* check for the last tree */
+    b->trees[t] = bag(b->gi, b->w, b->n, treeseed(b->seed, t));
+  }                             /* grow a tree on a sample */
+  return THREAD_OK;             /* return a dummy result */
+}  /* bagwork() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static int outofbag (GROW *gi, GROW *w, TPLID n,
+                     DTREE **trees, int cnt, unsigned int seed,
+                     double *oob)
+{                               /* --- compute out-of-bag error */
+  int    t;                     /* loop variable for trees */
+  TPLID  r;                     /* loop variable for rows */
+  ATTID  i, m;                  /* loop variable, number of atts. */
+  VALID  c, k, z;               /* class index, number of classes */
+  double *acc, *a;              /* accumulated predictions */
+  double sum, err, d;           /* sum of weights, error, buffer */
+  ATTID  trgid;                 /* identifier of target attribute */
+  INST   res;                   /* prediction of a tree */
+
+  assert(gi && w && trees && oob); /* check the function arguments */
+  trgid = gi->dtree->trgid;     /* get the target attribute */
+  k = (gi->type == AT_NOM) ? gi->dtree->clscnt : 2;
+  acc = (double*)calloc((size_t)n *(size_t)k, sizeof(double));
+  if (!acc) return -1;          /* create the prediction accumulators */
+  m = as_attcnt(gi->attset);    /* get the number of attributes */
+  for (t = 0; t < cnt; t++) {   /* traverse the trees */
+    rng_seed(w->rng, treeseed(seed, t));
+    bootstrap(w, gi->wgts, n);  /* redraw the bootstrap sample */
+    for (a = acc, r = 0; r < n; r++, a += k) {
+      if (w->wgts[r] > 0) continue;   /* traverse out-of-bag rows */
+      for (i = 0; i < m; i++)   /* copy the row to the attribute set */
+        if (gi->cols[i] && (i != trgid))
+          *att_inst(as_att(gi->attset, i)) = gi->cols[i][r];
+      dt_exec(trees[t], NULL, NOVWGT, &res, NULL, NULL);
+      if (gi->type == AT_NOM) { /* if the target is nominal, */
+        for (c = 0; c < k; c++) /* sum the class probabilities */
+          a[c] += dt_conf(trees[t], c); }
+      else {                    /* if the target is metric */
+        a[0] += (double)res.f;  /* sum the predicted values */
+        a[1] += 1;              /* and count the trees */
+      }
+    }
+  }
+  for (sum = err = 0, a = acc, r = 0; r < n; r++, a += k) {
+    if (gi->type == AT_NOM) {   /* if the target is nominal */
+      for (z = 0, c = 1; c < k; c++)
+        if (a[c] > a[z]) z = c; /* find the most probable class */
+      if (a[z] <= 0) continue;  /* skip rows that were always drawn */
+      if (z != gi->cols[trgid][r].n) err += gi->wgts[r]; }
+    else {                      /* if the target is metric */
+      if (a[1] <= 0) continue;  /* skip rows that were always drawn */
+      d = a[0]/a[1] -((gi->dtree->type == AT_INT)
+                     ? (double)gi->cols[trgid][r].i
+                     : (double)gi->cols[trgid][r].f);
+      err += gi->wgts[r] *d*d;  /* sum the squared errors */
+    }
+    sum += gi->wgts[r];         /* sum the weights of the rows */
+  }                             /* (misclassifications or sse) */
+  free(acc);                    /* delete the accumulators */
+  *oob = (sum > 0) ? err/sum : -1;
+  return 0;                     /* return the out-of-bag error */
+}  /* outofbag() */
+
+/*----------------------------------------------------------------------
+The function outofbag() evaluates each tree on the rows that are not
+in its bootstrap sample (which is redrawn from the seed of the tree)
+and aggregates these predictions per row: for a nominal target the
+class probabilities of the trees are summed and the most probable
+class is predicted, for a metric target the predicted values are
+averaged. The out-of-bag error is the (weighted) misclassification
+rate or mean squared error over all rows that were left out by at
+least one tree. The rows are copied to the attribute set for
+dt_exec(), so the current instances of the attribute set change.
+Since the predictions are aggregated in the order of the trees, the
+result does not depend on the number of threads.
+----------------------------------------------------------------------*/
+
+int dt_forest (TABLE *table, ATTID trgid, int measure, double *params,
+               double minval, ATTID maxht, double mincnt, int flags,
+               int bincnt, ATTID subcnt, DTREE **trees, int cnt,
+               unsigned int seed, double *oob, int thcnt)
+{                               /* --- grow a random forest */
+  int     i, k;                 /* loop variable, number of contexts */
+  int     e = 0;                /* error status */
+  TPLID   n;                    /* number of rows */
+  ATTID   a, c;                 /* loop variable, number of atts. */
+  GROW    *gi;                  /* shared tree grow information */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  int      next = 0;            /* next tree to grow */
+  THRMUTEX mutex;               /* mutex for the tree counter */
+  GROW     *ctxs[THR_MAX];      /* bagging contexts of the workers */
+  BAGWORK  wrks[THR_MAX];       /* forest growing workers */
+  #else                         /* if to use a single thread */
+  GROW     *ctxs[1];            /* bagging context */
+  #endif
+
+  assert(table && trees && (cnt > 0));  /* check the arguments */
+  memset(trees, 0, (size_t)cnt *sizeof(DTREE*));
+  if (oob) *oob = -1;           /* clear the trees and the error */
+  gi = prepare(table, trgid, measure, params, minval, maxht, mincnt,
+               flags & ~(DT_EVAL|DT_DUPAS), bincnt, 1, &n);
+  if (!gi) return -1;           /* prepare growing the trees */
+  for (c = 0, a = as_attcnt(gi->attset); --a >= 0; )
+    if (!gi->used[a]) c++;      /* count the usable attributes */
+  if (subcnt <= 0)              /* by default select sqrt(c) (nom.) */
+    subcnt = (gi->type == AT_NOM)     /* or c/3 (metric target) */
+           ? (ATTID)ceil(sqrt((double)c)) : (ATTID)(c/3);
+  gi->subcnt = (subcnt > 0) ? subcnt : 1;
+
+  /* --- create the bagging contexts --- */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if (thcnt <= 0)      thcnt = thr_cnt();
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  if (thcnt > cnt)     thcnt = cnt;
+  #else                         /* get the number of threads */
+  thcnt = 1;                    /* (at most one per tree) */
+  #endif
+  for (k = 0; k < thcnt; k++) { /* create the bagging contexts */
+    ctxs[k] = bagctx(gi, n, 1); /* (one per worker) */
+    if (!ctxs[k]) break;        /* (use fewer workers if memory */
+  }                             /* for all of them is lacking) */
+  if (k <= 0) { cleanup(gi, 1); return -1; }
+
+  /* --- grow the trees --- */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if ((k > 1) && (thr_mxinit(&mutex) == 0)) {
+    logGamma(1.0);              /* initialize the gamma tables */
+    for (i = 0; i < k; i++) {   /* (lazy init. is not thread-safe) */
+      wrks[i].gi    = gi;       /* traverse the workers */
+      wrks[i].w     = ctxs[i];  wrks[i].n     = n;
+      wrks[i].trees = trees;    wrks[i].cnt   = cnt;
+      wrks[i].next  = &next;    wrks[i].mutex = &mutex;
+      wrks[i].seed  = seed;     /* set the tree counter, */
+    }                           /* the tree array, and the seed */
+    thr_run(bagwork, wrks, sizeof(BAGWORK), k);
+    thr_mxfree(&mutex); }       /* grow the trees in parallel */
+  else                          /* if to grow the trees serially */
+  #endif
+  for (i = 0; i < cnt; i++)     /* traverse the trees to grow */
+    trees[i] = bag(gi, ctxs[0], n, treeseed(seed, i));
+  for (i = 0; i < cnt; i++)     /* check whether all trees */
+    if (!trees[i]) e = -1;      /* could be grown */
+
+  /* --- compute the out-of-bag error --- */
+  if (!e && oob)                /* evaluate the trees on the rows */
+    e = outofbag(gi, ctxs[0], n, trees, cnt, seed, oob);
+  while (--k >= 0) bagdel(ctxs[k]); /* delete the contexts */
+  dt_delete(gi->dtree, 0);      /* delete the (empty) tree */
+  gi->dtree = NULL;             /* of the grow information */
+  cleanup(gi, 0);               /* and the grow information itself */
+  if (e) {                      /* if an error occurred */
+    for (i = 0; i < cnt; i++) { if (trees[i]) dt_delete(trees[i], 0); }
+    memset(trees, 0, (size_t)cnt *sizeof(DTREE*));
+  }                             /* delete all grown trees */
+  return e;                     /* return the error status */
+}  /* dt_forest() */
+
+/*----------------------------------------------------------------------
+The function dt_forest() grows cnt trees, each on a bootstrap sample
+of the rows (see function bootstrap()) and with a random subset of
+subcnt usable attributes considered at each node (see function
+selatt(); subcnt <= 0: default sqrt(c) for a nominal and c/3 for a
+metric target, where c is the number of usable attributes). The
+training matrix, the bins or presorted lists and the weights of the
+rows are created only once (function prepare()) and are only read
+while the trees are grown, each by a worker that uses its own bagging
+context (see function bagctx()). The random numbers of a tree are
+drawn from a generator that is seeded from the seed argument and the
+index of the tree, so the grown trees do not depend on the number of
+threads. Flags DT_EVAL and DT_DUPAS are ignored, that is, all trees
+refer to the attribute set of the table.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Cross-Validation Functions
+----------------------------------------------------------------------*/
+
+static DTREE* fold (GROW *gi, GROW *w, TPLID n,
+                    const int *folds, int k)
+{                               /* --- grow a tree without a fold */
+  TPLID r;                      /* loop variable for rows */
+
+  assert(gi && w && folds);     /* check the function arguments */
+  memcpy(w->used, gi->used, (size_t)as_attcnt(gi->attset));
+  for (r = 0; r < n; r++)       /* mask the rows of the fold */
+    w->wgts[r] = (folds[r] == k) ? 0 : gi->wgts[r];
+  return sample(gi, w, n);      /* grow a tree on the other rows */
+}  /* fold() */
+
+/*--------------------------------------------------------------------*/
+#ifdef USE_THREADS
+
+static WORKERDEF(foldwork, p)
+{                               /* --- grow fold trees (worker) */
+  BAGWORK *b = (BAGWORK*)p;     /* type the worker data */
+  int     k;                    /* index of the fold */
+
+  while (1) {                   /* tree growing loop */
+    thr_lock(b->mutex);         /* get the next fold */
+    k = (*b->next)++;           /* (folds are distributed */
+    thr_unlock(b->mutex);       /* dynamically over the workers) */
+    if (k >= b->cnt) break;     /* check for the last fold */
+    b->trees[k] = fold(b->gi, b->w, b->n, b->folds, k);
+  }                             /* grow a tree without the fold */
+  return THREAD_OK;             /* return a dummy result */
+}  /* foldwork() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+int dt_xval (TABLE *table, ATTID trgid, int measure, double *params,
+             double minval, ATTID maxht, double mincnt, int flags,
+             int bincnt, DTREE **trees, int cnt, int thcnt)
+{                               /* --- grow trees for cross-valid. */
+  int     i, k;                 /* loop variable, number of contexts */
+  int     e = 0;                /* error status */
+  TPLID   n, r;                 /* number of rows, loop variable */
+  TUPLE   **tpls;               /* tuples with known target value */
+  int     *folds;               /* fold indices of the rows */
+  GROW    *gi;                  /* shared tree grow information */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  int      next = 0;            /* next fold to process */
+  THRMUTEX mutex;               /* mutex for the fold counter */
+  GROW     *ctxs[THR_MAX];      /* grow contexts of the workers */
+  BAGWORK  wrks[THR_MAX];       /* fold tree growing workers */
+  #else                         /* if to use a single thread */
+  GROW     *ctxs[1];            /* grow context */
+  #endif
+
+  assert(table && trees && (cnt > 0));  /* check the arguments */
+  memset(trees, 0, (size_t)cnt *sizeof(DTREE*));
+  gi = prepare(table, trgid, measure, params, minval, maxht, mincnt,
+               flags & ~(DT_EVAL|DT_DUPAS), bincnt, 1, &n);
+  if (!gi) return -1;           /* prepare growing the trees */
+  folds = (int*)malloc((size_t)(n+1) *sizeof(int));
+  tpls  = tuples(table, trgid, &r);
+  if (!folds || !tpls) {        /* get the fold indices of the rows */
+    if (folds) free(folds);     /* (tuples() yields the tuples in */
+    if (tpls)  free(tpls);      /* the same order as in matrix()) */
+    cleanup(gi, 1); return -1;
+  }
+  assert(r == n);               /* check the number of rows */
+  for (r = 0; r < n; r++)       /* copy the tuple marks */
+    folds[r] = (int)tpl_getmark(tpls[r]);
+  free(tpls);                   /* delete the tuple array */
+
+  /* --- create the grow contexts --- */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if (thcnt <= 0)      thcnt = thr_cnt();
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  if (thcnt > cnt)     thcnt = cnt;
+  #else                         /* get the number of threads */
+  thcnt = 1;                    /* (at most one per fold) */
+  #endif
+  for (k = 0; k < thcnt; k++) { /* create the grow contexts */
+    ctxs[k] = bagctx(gi, n, 0); /* (one per worker) */
+    if (!ctxs[k]) break;        /* (use fewer workers if memory */
+  }                             /* for all of them is lacking) */
+  if (k <= 0) { free(folds); cleanup(gi, 1); return -1; }
+
+  /* --- grow the trees --- */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if ((k > 1) && (thr_mxinit(&mutex) == 0)) {
+    logGamma(1.0);              /* initialize the gamma tables */
+    for (i = 0; i < k; i++) {   /* (lazy init. is not thread-safe) */
+      wrks[i].gi    = gi;       /* traverse the workers */
+      wrks[i].w     = ctxs[i];  wrks[i].n     = n;
+      wrks[i].trees = trees;    wrks[i].cnt   = cnt;
+      wrks[i].next  = &next;    wrks[i].mutex = &mutex;
+      wrks[i].folds = folds;    /* set the fold counter, */
+    }                           /* the tree array, and the folds */
+    thr_run(foldwork, wrks, sizeof(BAGWORK), k);
+    thr_mxfree(&mutex); }       /* grow the trees in parallel */
+  else                          /* if to grow the trees serially */
+  #endif
+  for (i = 0; i < cnt; i++)     /* traverse the folds */
+    trees[i] = fold(gi, ctxs[0], n, folds, i);
+  for (i = 0; i < cnt; i++)     /* check whether all trees */
+    if (!trees[i]) e = -1;      /* could be grown */
+  while (--k >= 0) bagdel(ctxs[k]); /* delete the contexts, */
+  free(folds);                  /* the fold indices, */
+  dt_delete(gi->dtree, 0);      /* the (empty) tree */
+  gi->dtree = NULL;             /* of the grow information */
+  cleanup(gi, 0);               /* and the grow information itself */
+  if (e) {                      /* if an error occurred */
+    for (i = 0; i < cnt; i++) { if (trees[i]) dt_delete(trees[i], 0); }
+    memset(trees, 0, (size_t)cnt *sizeof(DTREE*));
+  }                             /* delete all grown trees */
+  return e;                     /* return the error status */
+}  /* dt_xval() */
+
+/*----------------------------------------------------------------------
+The function dt_xval() grows the trees of a cnt-fold cross-validation:
+the mark of a tuple (tpl_getmark()) is its fold index, and the k-th
+tree is grown on all tuples that are not in fold k (tuples with a mark
+outside [0, cnt) are used for all trees). The training matrix, the
+bins or presorted lists are created only once (function prepare()),
+the folds are masked out by zero weights in the weight column of a
+grow context (see function fold()), and the trees are grown in
+parallel, at most one per worker. Unlike dt_grow(), the subtrees of a
+tree are grown serially. Flags DT_EVAL and DT_DUPAS are ignored.
+Evaluating the trees on their folds is left to the caller.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Attribute Selection Functions
+----------------------------------------------------------------------*/
+
+static int cand (GROW *gi, GROW *w, TPLID n, const ATTID *cands,
+                 int cnt, int k, DT_EVALFN *eval, void *data)
+{                               /* --- grow and evaluate a tree */
+  ATTID i, m;                   /* loop variable, number of atts. */
+  TPLID *p;                     /* to traverse the list sections */
+  DTREE *dt;                    /* grown decision tree */
+  int   r;                      /* result of evaluation function */
+
+  assert(gi && w && cands && eval);  /* check the arguments */
+  m = as_attcnt(gi->attset);    /* get the number of attributes */
+  memcpy(w->used, gi->used, (size_t)m);
+  for (i = 0; i < cnt; i++)     /* mark all other candidates */
+    if (i != k) w->used[cands[i]] = 1;     /* as unusable */
+  if (w->lists) {               /* if there are presorted lists, */
+    for (p = w->buf, i = 0; i < m; i++)    /* keep only the lists */
+      w->lists[i] = (gi->lists[i] && !w->used[i]) ? (p += n) : NULL;
+  }                             /* of the usable attributes */
+  memcpy(w->wgts, gi->wgts, (size_t)n *sizeof(WEIGHT));
+  dt = sample(gi, w, n);        /* grow a tree on all rows */
+  if (!dt) return -1;           /* with the candidate attribute */
+  r = eval(dt, cands[k], data); /* evaluate the grown tree */
+  dt_delete(dt, 0);             /* and delete it again */
+  return (r != 0) ? -1 : 0;     /* return the error status */
+}  /* cand() */
+
+/*----------------------------------------------------------------------
+The function cand() grows a tree with the usable attributes of the
+shared grow information, except the candidates other than the k-th,
+passes it to the evaluation function, and deletes it. Only the lists
+of the usable attributes are copied from the shared presorted lists
+(and split while the tree is grown), so that the cost of growing a
+tree does not depend on the number of candidates.
+----------------------------------------------------------------------*/
+
+#ifdef USE_THREADS
+
+static WORKERDEF(candwork, p)
+{                               /* --- grow cand. trees (worker) */
+  BAGWORK *b = (BAGWORK*)p;     /* type the worker data */
+  int     k;                    /* index of the candidate */
+
+  while (1) {                   /* tree growing loop */
+    thr_lock(b->mutex);         /* get the next candidate */
+    k = (*b->next)++;           /* (candidates are distributed */
+    thr_unlock(b->mutex);       /* dynamically over the workers) */
+    if (k >= b->cnt) break;     /* check for the last candidate */
+    if (cand(b->gi, b->w, b->n, b->cands, b->cnt, k,
+             b->eval, b->data) != 0)
+      b->err = -1;              /* grow and evaluate a tree */
+  }                             /* and note a failure */
+  return THREAD_OK;             /* return a dummy result */
+}  /* candwork() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+int dt_cands (TABLE *table, ATTID trgid, int measure, double *params,
+              double minval, ATTID maxht, double mincnt, int flags,
+              int bincnt, const ATTID *cands, int cnt,
+              DT_EVALFN *eval, void *data, int thcnt)
+{                               /* --- grow trees for candidates */
+  int     i, k;                 /* loop variable, number of contexts */
+  int     e = 0;                /* error status */
+  TPLID   n;                    /* number of rows */
+  ATTSET  *attset;              /* attribute set of the table */
+  ATTID   *marks;               /* buffer for the candidate marks */
+  GROW    *gi;                  /* shared tree grow information */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  int      next = 0;            /* next candidate to process */
+  THRMUTEX mutex;               /* mutex for the candidate counter */
+  GROW     *ctxs[THR_MAX];      /* grow contexts of the workers */
+  BAGWORK  wrks[THR_MAX];       /* candidate tree growing workers */
+  #else                         /* if to use a single thread */
+  GROW     *ctxs[1];            /* grow context */
+  #endif
+
+  assert(table && cands && (cnt > 0) && eval);
+  attset = tab_attset(table);   /* get the attribute set */
+  marks  = (ATTID*)malloc((size_t)cnt *sizeof(ATTID));
+  if (!marks) return -1;        /* create a buffer for the marks */
+  for (i = 0; i < cnt; i++) {   /* traverse the candidates */
+    marks[i] = att_getmark(as_att(attset, cands[i]));
+    att_setmark(as_att(attset, cands[i]), 0);
+  }                             /* make all candidates usable */
+  gi = prepare(table, trgid, measure, params, minval, maxht, mincnt,
+               flags & ~(DT_EVAL|DT_DUPAS), bincnt, 1, &n);
+  for (i = cnt; --i >= 0; )     /* restore the attribute marks */
+    att_setmark(as_att(attset, cands[i]), marks[i]);
+  free(marks);                  /* and delete the mark buffer */
+  if (!gi) return -1;           /* prepare growing the trees */
+
+  /* --- create the grow contexts --- */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if (thcnt <= 0)      thcnt = thr_cnt();
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  if (thcnt > cnt)     thcnt = cnt;
+  #else                         /* get the number of threads */
+  thcnt = 1;                    /* (at most one per candidate) */
+  #endif
+  for (k = 0; k < thcnt; k++) { /* create the grow contexts */
+    ctxs[k] = bagctx(gi, n, 0); /* (one per worker) */
+    if (!ctxs[k]) break;        /* (use fewer workers if memory */
+  }                             /* for all of them is lacking) */
+  if (k <= 0) { cleanup(gi, 1); return -1; }
+
+  /* --- grow and evaluate the trees --- */
+  #ifdef USE_THREADS            /* if to use multiple threads */
+  if ((k > 1) && (thr_mxinit(&mutex) == 0)) {
+    logGamma(1.0);              /* initialize the gamma tables */
+    for (i = 0; i < k; i++) {   /* (lazy init. is not thread-safe) */
+      wrks[i].gi    = gi;       /* traverse the workers */
+      wrks[i].w     = ctxs[i];  wrks[i].n     = n;
+      wrks[i].cnt   = cnt;      wrks[i].cands = cands;
+      wrks[i].next  = &next;    wrks[i].mutex = &mutex;
+      wrks[i].eval  = eval;     wrks[i].data  = data;
+      wrks[i].err   = 0;        /* set the candidate counter, */
+    }                           /* the candidates, and the function */
+    thr_run(candwork, wrks, sizeof(BAGWORK), k);
+    thr_mxfree(&mutex);         /* grow the trees in parallel */
+    for (i = 0; i < k; i++)     /* collect the error status */
+      if (wrks[i].err) e = -1; }  /* of the workers */
+  else                          /* if to grow the trees serially */
+  #endif
+  for (i = 0; i < cnt; i++)     /* traverse the candidates */
+    if (cand(gi, ctxs[0], n, cands, cnt, i, eval, data) != 0)
+      e = -1;                   /* grow and evaluate a tree */
+  while (--k >= 0) bagdel(ctxs[k]); /* delete the contexts, */
+  dt_delete(gi->dtree, 0);      /* the (empty) tree */
+  gi->dtree = NULL;             /* of the grow information */
+  cleanup(gi, 0);               /* and the grow information itself */
+  return e;                     /* return the error status */
+}  /* dt_cands() */
+
+/*----------------------------------------------------------------------
+The function dt_cands() supports a forward selection of attributes:
+for each of the cnt candidate attributes it grows a tree with the
+attributes that are marked in the attribute set of the table (mark
+>= 0) and this candidate and passes the tree to the function eval
+(together with the identifier of the candidate), after which the tree
+is deleted. The candidates should be unmarked; their marks are not
+changed. The training matrix and the bins or presorted lists of all
+candidates are created only once (function prepare()) and the trees
+are grown and evaluated in parallel, at most one per worker, so the
+evaluation function must be thread-safe (for different trees). A
+nonzero result of it is reported as an error. Unlike dt_grow(), tuples
+with a zero weight are ignored. Flags DT_EVAL and DT_DUPAS are ignored.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Gradient Boosting Functions
+----------------------------------------------------------------------*/
+
+static DTREE* gradtree (GROW *gi)
+{                               /* --- create a tree for gradients */
+  DTREE  *dt;                   /* created regression tree */
+  double *p;                    /* reallocated execution buffer */
+  size_t z;                     /* size of the execution buffer */
+
+  assert(gi);                   /* check the function argument */
+  dt = dt_create(gi->attset, gi->dtree->trgid);
+  if (!dt) return NULL;         /* create an empty tree */
+  if (dt->type == AT_NOM) {     /* if the target is nominal, */
+    z = (size_t)as_attcnt(gi->attset) *sizeof(char);
+    if (((size_t)dt->clscnt *sizeof(double) < 3*sizeof(double))
+    &&  (z < 3*sizeof(double))) {
+      p = (double*)realloc(dt->frqs, 3*sizeof(double));
+      if (!p) { dt_delete(dt, 0); return NULL; }
+      dt->frqs = p;             /* enlarge the execution buffer */
+    }                           /* to the size needed for a */
+    dt->type   = AT_FLT;        /* regression tree and turn the */
+    dt->clscnt = 0;             /* tree into a regression tree */
+  }                             /* (for the gradients/residuals) */
+  return dt;                    /* return the created tree */
+}  /* gradtree() */
+
+/*--------------------------------------------------------------------*/
+
+static void clear (DTNODE *node)
+{                               /* --- clear the node aggregates */
+  VALID  i;                     /* loop variable for branches */
+  DTDATA *data;                 /* to traverse the branches */
+
+  assert(node);                 /* check the function argument */
+  node->frq = node->err = 0;    /* clear the derivative sums */
+  if (node->flags & DT_LEAF) return;
+  for (data = node->data, i = node->size; --i >= 0; data++)
+    if (!islink(data, node) && data->child)
+      clear(data->child);       /* recursively clear the subtrees */
+}  /* clear() */
+
+/*--------------------------------------------------------------------*/
+
+static DTNODE* route (GROW *gi, DTNODE *node, TPLID r,
+                      double g, double h)
+{                               /* --- route a row through a tree */
+  VALID  k;                     /* index of the branch to follow */
+  int    type;                  /* type of the test attribute */
+  const INST *val;              /* value of the test attribute */
+  DTDATA *data;                 /* branch to follow */
+
+  assert(gi && node && (r >= 0));  /* check the function arguments */
+  while (1) {                   /* traverse the tree from the root */
+    node->err += g;             /* sum the (weighted) first */
+    node->frq += h;             /* and second derivatives */
+    if (node->flags & DT_LEAF) break;
+    val  = gi->cols[node->attid] +r;
+    type = att_type(as_att(gi->attset, node->attid));
+    if      (type == AT_NOM)    /* get the index of the branch */
+      k = val->n;               /* for the value of the row */
+    else if (type == AT_INT)
+      k = isnull(val->i) ? -1 : ((val->i <= node->cut) ? 0 : 1);
+    else
+      k = isnan (val->f) ? -1 : ((val->f <= node->cut) ? 0 : 1);
+    if ((k < 0) || (k >= node->size))
+      break;                    /* stop at null/unknown values */
+    data = node->data +k;       /* get the branch and */
+    while (islink(data, node))  /* follow the links */
+      data = data->link;        /* (merged branches) */
+    if (!data->child) break;    /* stop at missing children */
+    node = data->child;         /* and go down to the child */
+  }
+  return node;                  /* return the reached node */
+}  /* route() */
+
+/*--------------------------------------------------------------------*/
+
+static void newton (DTNODE *node, double rate)
+{                               /* --- compute the node values */
+  VALID  i;                     /* loop variable for branches */
+  DTDATA *data;                 /* to traverse the branches */
+  double v;                     /* value of the node */
+
+  assert(node);                 /* check the function argument */
+  v = (node->frq > 1e-12) ? rate *node->err /node->frq : 0;
+  if (v < -MAXSCORE) v = -MAXSCORE;
+  if (v > +MAXSCORE) v = +MAXSCORE;
+  node->trg.f = (DTFLT)v;       /* compute a Newton step and */
+  node->err   = 0;              /* clear the gradient sum */
+  if (node->flags & DT_LEAF) return;
+  for (data = node->data, i = node->size; --i >= 0; data++)
+    if (!islink(data, node) && data->child)
+      newton(data->child, rate);/* recursively process the subtrees */
+}  /* newton() */
+
+/*----------------------------------------------------------------------
+The functions clear(), route() and newton() replace the values of the
+nodes of a tree that was grown on the gradients by the (shrunk)
+Newton steps of the loss function: route() passes each row down the
+tree along the path it takes in function dt_exec() (stopping at a
+null value, a value without a branch, or a missing child) and sums
+the weighted first and second derivatives of the loss in all nodes
+on the path (in the fields err and frq). newton() then sets the value
+of each node (trg.f) to the ratio of these sums, multiplied by the
+learning rate (clamped to +/-MAXSCORE), and clears the field err.
+Hence in a grown tree the field frq of a node holds the sum of the
+(weighted) second derivatives, which equals the sum of the row
+weights for the squared error loss. Every node gets a value, because
+a row with a null value for a test attribute stops at the node.
+----------------------------------------------------------------------*/
+
+static void probs (int loss, const double *scrs, double *prbs,
+                   TPLID n, VALID k)
+{                               /* --- compute class probabilities */
+  TPLID  r;                     /* loop variable for rows */
+  VALID  c;                     /* loop variable for classes */
+  double max, sum;              /* maximal score, sum of exponents */
+
+  assert(scrs && prbs && (n >= 0) && (k > 0));
+  if (loss == LS_LOGISTIC) {    /* if logistic loss (two classes) */
+    for (r = 0; r < n; r++)     /* apply the logistic function */
+      prbs[r] = 1/(1 +exp(-scrs[r])); }
+  else {                        /* if multinomial loss (softmax) */
+    for (r = 0; r < n; r++, scrs += k, prbs += k) {
+      for (max = scrs[0], c = 1; c < k; c++)
+        if (scrs[c] > max) max = scrs[c];
+      for (sum = 0, c = 0; c < k; c++)
+        sum += prbs[c] = exp(scrs[c] -max);
+      for (c = 0; c < k; c++) prbs[c] /= sum;
+    }                           /* compute the softmax function */
+  }                             /* (subtract the maximal score */
+}  /* probs() */                /* to avoid an overflow) */
+
+/*--------------------------------------------------------------------*/
+
+int dt_boost (TABLE *table, ATTID trgid, int loss, double rate,
+              ATTID maxht, double mincnt, int flags, int bincnt,
+              DTREE **trees, int cnt, double *init, double *err,
+              int thcnt)
+{                               /* --- grow boosted regression trees */
+  int    i, e = 0;              /* loop variable, error status */
+  TPLID  n, r;                  /* number of rows, loop variable */
+  VALID  c, k, z;               /* class index, number of scores */
+  GROW   *gi;                   /* tree grow information */
+  DTREE  *dt, *master;          /* grown tree, tree of grow info. */
+  DTNODE **nodes;               /* nodes reached by the rows */
+  double *scrs;                 /* scores (predictions) of the rows */
+  double *prbs;                 /* class probabilities of the rows */
+  double *grds, *hess;          /* first and second derivatives */
+  double sum, e2, y, p, w, f;   /* sums, buffers, leaf factor */
+  const INST *trgs;             /* target column */
+  double params[2] = { 0, 0 };  /* (unused) measure parameters */
+
+  assert(table && trees && (cnt > 0) && init && (rate > 0));
+  if (err) *err = -1;           /* clear the training error */
+  gi = prepare(table, trgid, VEM_SSE|VEF_WGTD, params, -INFINITY,
+               maxht, mincnt, (flags & ~(DT_EVAL|DT_DUPAS)) | DT_GRAD,
+               bincnt, thcnt, &n);
+  if (!gi) return -1;           /* prepare growing the trees */
+  master = gi->dtree;           /* note the tree of the grow info. */
+  trgs   = gi->cols[master->trgid];    /* and the target column */
+  assert((master->type == AT_NOM)
+      ? ((loss == LS_MULTI) || ((loss == LS_LOGISTIC)
+                             && (master->clscnt == 2)))
+      : (loss == LS_SQUARED));  /* check the loss function */
+  k = (loss == LS_MULTI) ? master->clscnt : 1;
+  memset(trees, 0, (size_t)cnt *(size_t)k *sizeof(DTREE*));
+  scrs  = (double*)malloc((size_t)n *(size_t)(k+k+2) *sizeof(double));
+  nodes = (DTNODE**)malloc((size_t)n *sizeof(DTNODE*));
+  if (!scrs || !nodes) {        /* create the score buffers */
+    if (scrs)  free(scrs);
+    if (nodes) free(nodes);
+    dt_delete(master, 0); gi->dtree = NULL; cleanup(gi, 0);
+    return -1;                  /* on failure clean up */
+  }                             /* and abort the function */
+  prbs = scrs +(size_t)n *(size_t)k;
+  grds = prbs +(size_t)n *(size_t)k;
+  hess = grds +n;               /* organize the buffers */
+
+  /* --- compute the initial scores --- */
+  for (c = 0; c < k; c++) init[c] = 0;
+  for (sum = 0, r = 0; r < n; r++) {
+    w = gi->wgts[r]; sum += w;  /* traverse the rows */
+    if      (loss == LS_SQUARED)    /* sum the target values */
+      init[0] += w *((master->type == AT_INT)
+                    ? (double)trgs[r].i : (double)trgs[r].f);
+    else if (loss == LS_LOGISTIC)   /* sum the weights of class 1 */
+      init[0] += (trgs[r].n == 1) ? w : 0;
+    else                            /* sum the class weights */
+      init[trgs[r].n] += w;
+  }
+  for (c = 0; c < k; c++) {     /* traverse the scores */
+    p = (sum > 0) ? init[c]/sum : 0;   /* compute the mean value */
+    if (loss != LS_SQUARED) {   /* if to compute a class score, */
+      p = (loss == LS_LOGISTIC) /* get the log-odds of class 1 */
+        ? ((p <= 0) ? -MAXSCORE : (p >= 1) ? MAXSCORE : log(p/(1-p)))
+        : ((p <= 0) ? -MAXSCORE : log(p));  /* or the log-prior */
+      if (p < -MAXSCORE) p = -MAXSCORE;  /* clamp the score */
+      if (p > +MAXSCORE) p = +MAXSCORE;  /* to a sensible range */
+    }
+    init[c] = p;                /* store the initial score */
+  }
+  for (r = 0; r < n; r++)       /* initialize the row scores */
+    for (c = 0; c < k; c++) scrs[r*k+c] = init[c];
+  f = (loss == LS_MULTI) ? (double)(k-1)/(double)k : 1.0;
+  f *= rate;                    /* compute the leaf value factor */
+
+  /* --- grow the trees --- */
+  for (i = 0; (i < cnt) && !e; i++) {
+    if (loss != LS_SQUARED)     /* compute the class probabilities */
+      probs(loss, scrs, prbs, n, k);
+    for (c = 0; c < k; c++) {   /* traverse the scores */
+      for (r = 0; r < n; r++) { /* compute the derivatives */
+        if (loss == LS_SQUARED) {
+          y = (master->type == AT_INT)
+            ? (double)trgs[r].i : (double)trgs[r].f;
+          grds[r] = y -scrs[r]; hess[r] = 1; }
+        else {                  /* residual of the squared error */
+          p = prbs[r*k+c];      /* or of the class probability */
+          y = (trgs[r].n == ((loss == LS_MULTI) ? c : 1)) ? 1 : 0;
+          grds[r] = y -p; hess[r] = p *(1-p);
+        }                       /* (negative gradient and hessian) */
+        gi->grad[r].f = (DTFLT)grds[r];
+      }                         /* set the gradients as the target */
+      trees[i*k+c] = dt = gradtree(gi);
+      if (!dt) { e = -1; break; }
+      gi->dtree = dt;           /* create a tree for the gradients */
+      gi->err   = 0;            /* and clear the error indicator */
+      if (root(gi, n) != 0) { e = -1; break; }
+      if (dt->root && gi->curr) /* create a root node and */
+        dt->root = grow(gi, dt->root, gi->rows, n);
+      if (gi->err < 0) { e = -1; break; }
+      stats(dt);                /* recursively grow the tree */
+      if (!dt->root) continue;  /* and compute its statistics */
+      clear(dt->root);          /* route the rows through the tree */
+      for (r = 0; r < n; r++) { /* and sum the derivatives */
+        w = gi->wgts[r];        /* per node on each path */
+        nodes[r] = route(gi, dt->root, r, w*grds[r], w*hess[r]);
+      }
+      newton(dt->root, f);      /* compute the node values and */
+      for (r = 0; r < n; r++)   /* update the scores of the rows */
+        scrs[r*k+c] += (double)nodes[r]->trg.f;
+    }
+  }
+  gi->dtree = master;           /* restore the tree of grow info. */
+
+  /* --- compute the training error --- */
+  if (!e && err) {              /* if to compute the error */
+    if (loss != LS_SQUARED)     /* compute the class probabilities */
+      probs(loss, scrs, prbs, n, k);
+    for (sum = e2 = 0, r = 0; r < n; r++) {
+      w = gi->wgts[r]; sum += w;/* traverse the rows */
+      if      (loss == LS_SQUARED) {
+        y = ((master->type == AT_INT)
+            ? (double)trgs[r].i : (double)trgs[r].f) -scrs[r];
+        e2 += w *y*y; }         /* sum the squared errors */
+      else if (loss == LS_LOGISTIC) {
+        z = (prbs[r] > 0.5) ? 1 : 0;
+        if (z != trgs[r].n) e2 += w; }
+      else {                    /* sum the misclassifications */
+        for (z = 0, c = 1; c < k; c++)
+          if (prbs[r*k+c] > prbs[r*k+z]) z = c;
+        if (z != trgs[r].n) e2 += w;
+      }                         /* (predict the most probable */
+    }                           /* class, compare to the target) */
+    *err = (sum > 0) ? e2/sum : -1;
+  }
+  free(nodes); free(scrs);      /* delete the buffers */
+  dt_delete(master, 0);         /* delete the (empty) tree */
+  gi->dtree = NULL;             /* of the grow information */
+  cleanup(gi, 0);               /* and the grow information itself */
+  if (e) {                      /* if an error occurred */
+    for (i = cnt*k; --i >= 0; ) { if (trees[i]) dt_delete(trees[i], 0); }
+    memset(trees, 0, (size_t)cnt *(size_t)k *sizeof(DTREE*));
+  }                             /* delete all grown trees */
+  return e;                     /* return the error status */
+}  /* dt_boost() */
+
+/*----------------------------------------------------------------------
+The function dt_boost() grows cnt rounds of regression trees by
+gradient boosting: in each round, the negative gradients of the loss
+function at the current scores of the rows are computed and stored
+in a dense column (gi->grad), which is used as the (metric) target for
+growing a regression tree with the sum of squared errors as the
+selection measure. The values of the nodes of this tree are then
+replaced by (shrunk) Newton steps (see function newton()) and added
+to the scores of the rows. The loss function is the squared error
+(LS_SQUARED, metric target, one tree per round, init[0] is the mean),
+the logistic loss (LS_LOGISTIC, two classes, one tree per round on
+the score of class 1, init[0] is the log-odds of class 1), or the
+multinomial loss (LS_MULTI, one tree per class and round on the
+softmax scores, stored in trees[round*clscnt +class], init[] are the
+log-priors of the classes; the leaf values are multiplied by (K-1)/K
+as proposed by Friedman). Since the training matrix and the bins or
+presorted lists (grow() restores their order) only depend on the
+attributes, they are created once and reused for all trees, so the
+fast histogram path is used if bincnt > 0. Each tree is grown with
+thcnt threads as in dt_grow(). The returned trees are
+regression trees with the same target attribute identifier, but the
+values of their nodes are score increments, not target values. The
+training error is the (weighted) mean squared error or the rate of
+misclassifications of the final scores.
+----------------------------------------------------------------------*/
+
 #endif  /* #ifdef DT_GROW */
 /*----------------------------------------------------------------------
   Error Estimation Functions
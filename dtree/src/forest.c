@@ -0,0 +1,199 @@
+/*----------------------------------------------------------------------
+  File    : forest.c
+  Contents: decision and regression forest management
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "forest.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define BLKSIZE     16          /* block size for the tree array */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+DTFOREST* df_create (ATTSET *attset, ATTID trgid)
+{                               /* --- create a forest */
+  VALID    k;                   /* size of the buffer */
+  DTFOREST *df;                 /* created forest */
+
+  assert(attset && (trgid >= 0) && (trgid < as_attcnt(attset)));
+  df = (DTFOREST*)malloc(sizeof(DTFOREST));
+  if (!df) return NULL;         /* create a forest body */
+  df->attset = attset;          /* note the attribute set, */
+  df->trgid  = trgid;           /* the target's id, */
+  df->target = as_att(attset, trgid);  /* the target attribute, */
+  df->type   = att_type(df->target);   /* the target's type, */
+  df->clscnt = (df->type == AT_NOM)    /* and the number of classes */
+             ? att_valcnt(df->target) : 0;
+  df->cnt    = df->size = 0;    /* there are no trees yet */
+  df->trees  = NULL;            /* and no tree array */
+  df->supp   = 0;               /* clear the support */
+  k = (df->clscnt > 2) ? df->clscnt : 2;
+  df->frqs   = (double*)malloc((size_t)k *sizeof(double));
+  if (!df->frqs) { free(df); return NULL; }
+  return df;                    /* create the frequency buffer */
+}  /* df_create() */            /* and return the created forest */
+
+/*--------------------------------------------------------------------*/
+
+void df_delete (DTFOREST *df, int delas)
+{                               /* --- delete a forest */
+  assert(df);                   /* check the function argument */
+  if (df->trees) {              /* if there are trees */
+    while (--df->cnt >= 0)      /* delete all trees */
+      dt_delete(df->trees[df->cnt], 0);
+    free(df->trees);            /* and the tree array */
+  }
+  if (delas) as_delete(df->attset);  /* delete attribute set */
+  free(df->frqs);               /* delete the frequency buffer */
+  free(df);                     /* and the forest body */
+}  /* df_delete() */
+
+/*--------------------------------------------------------------------*/
+
+int df_add (DTFOREST *df, DTREE *dt)
+{                               /* --- add a tree to a forest */
+  int   n;                      /* new size of the tree array */
+  DTREE **p;                    /* new tree array */
+
+  assert(df && dt);             /* check the function arguments */
+  if ((dt_attset(dt) != df->attset)
+  ||  (dt_trgid(dt)  != df->trgid))
+    return -1;                  /* check the target attribute */
+  if (df->cnt >= df->size) {    /* if the tree array is full */
+    n = df->size +((df->size > BLKSIZE) ? df->size : BLKSIZE);
+    p = (DTREE**)realloc(df->trees, (size_t)n *sizeof(DTREE*));
+    if (!p) return -1;          /* enlarge the tree array */
+    df->trees = p; df->size = n;/* and set the new array */
+  }
+  df->trees[df->cnt++] = dt;    /* add the tree to the forest */
+  return 0;                     /* return 'ok' */
+}  /* df_add() */
+
+/*----------------------------------------------------------------------
+  Execution Functions
+----------------------------------------------------------------------*/
+
+int df_exec (DTFOREST *df, TUPLE *tuple, double weight,
+             INST *res, double *supp, double *conf)
+{                               /* --- execute a forest */
+  int    i;                     /* loop variable for trees */
+  VALID  c, k;                  /* loop variable, class index */
+  DTREE  *dt;                   /* to traverse the trees */
+  INST   pred;                  /* prediction of a tree */
+  double *frq;                  /* to access the frequencies */
+  double s, n, t;               /* support sum, number of trees */
+
+  assert(df && res);            /* check the function arguments */
+  k   = (df->type == AT_NOM) ? df->clscnt : 2;
+  frq = memset(df->frqs, 0, (size_t)k *sizeof(double));
+  for (s = 0, i = 0; i < df->cnt; i++) {
+    dt = df->trees[i];          /* traverse the trees */
+    if (dt_exec(dt, tuple, weight, &pred, &t, NULL) != 0)
+      return -1;                /* execute the current tree */
+    s += t;                     /* sum the support */
+    if (df->type == AT_NOM) {   /* if the target is nominal, */
+      for (c = 0; c < k; c++)   /* sum the class probabilities */
+        frq[c] += dt_conf(dt, c); }
+    else {                      /* if the target is metric, */
+      frq[0] += t = (double)pred.f;    /* sum the predicted values */
+      frq[1] += t*t;            /* and their squares */
+    }
+  }
+  n = (df->cnt > 0) ? (double)df->cnt : 1.0;
+  df->supp = s /n;              /* compute the average support */
+  if (supp) *supp = df->supp;   /* and store it if requested */
+  if (df->type != AT_NOM) {     /* if the target is metric */
+    res->f = (DTFLT)(s = frq[0] /n);   /* average the predictions */
+    t = frq[1] /n -s*s;         /* compute the variance */
+    if (conf) *conf = (t > 0) ? sqrt(t) : 0; }
+  else {                        /* if the target is nominal */
+    for (c = 0; c < k; c++)     /* average the class probabilities */
+      frq[c] /= n;              /* (soft voting of the trees) */
+    for (k = 0, c = 1; c < df->clscnt; c++)
+      if (frq[c] > frq[k]) k = c;
+    res->n = k;                 /* find the most probable class */
+    if (conf) *conf = frq[k];   /* and note its probability */
+  }
+  return 0;                     /* return 'ok' */
+}  /* df_exec() */
+
+/*----------------------------------------------------------------------
+A forest predicts the class with the highest average probability over
+all trees (soft voting) or the average value predicted by the trees.
+The confidence is the probability of the predicted class or, for a
+metric target, the standard deviation of the predictions of the trees
+(a measure of the agreement of the trees). The support is the average
+support of the trees.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Description Functions
+----------------------------------------------------------------------*/
+
+int df_desc (DTFOREST *df, FILE *file, int mode, int maxlen)
+{                               /* --- describe a forest */
+  int i, len, l;                /* loop variables for comments */
+
+  assert(df && file);           /* check the function arguments */
+  len = (maxlen > 0) ? maxlen -2 : 70;
+  if (mode & DT_TITLE) {        /* if the title flag is set */
+    fputs("/*", file); for (l = len; --l >= 0; ) fputc('-', file);
+    fprintf(file, (df->type == AT_NOM)
+            ? "\n  decision forest (%d trees)\n"
+            : "\n  regression forest (%d trees)\n", df->cnt);
+    for (l = len; --l >= 0; ) fputc('-', file);
+    fputs("*/\n", file);        /* print a title header */
+  }                             /* (as a comment) */
+  for (i = 0; i < df->cnt; i++) {
+    if (i > 0) fputc('\n', file);   /* print the trees one by one */
+    if (dt_desc(df->trees[i], file, mode & ~DT_TITLE, maxlen) != 0)
+      return -1;                /* (the trees are separated */
+  }                             /* by empty lines) */
+  return ferror(file) ? -1 : 0; /* return the writing result */
+}  /* df_desc() */
+
+/*----------------------------------------------------------------------
+  Parse Function
+----------------------------------------------------------------------*/
+#ifdef DF_PARSE
+
+DTFOREST* df_parse (ATTSET *attset, SCANNER *scan)
+{                               /* --- parse a forest */
+  DTREE    *dt;                 /* parsed decision tree */
+  DTFOREST *df = NULL;          /* created forest */
+
+  assert(attset && scan);       /* check the function arguments */
+  do {                          /* tree read loop */
+    dt = dt_parse(attset, scan);/* parse the next tree */
+    if (!dt) { if (df) df_delete(df, 0); return NULL; }
+    if (!df)                    /* create a forest for the target */
+      df = df_create(attset, dt_trgid(dt));
+    if (!df || (df_add(df, dt) != 0)) {
+      dt_delete(dt, 0);         /* add the tree to the forest, */
+      if (df) df_delete(df, 0); /* on failure delete the tree */
+      return NULL;              /* and the forest and abort */
+    }
+  } while (!scn_eof(scan, 0));  /* while not at the end of the file */
+  return df;                    /* return the created forest */
+}  /* df_parse() */
+
+/*----------------------------------------------------------------------
+A forest is described by its trees, one after the other, so that a
+forest file can be read by reading trees until the end of the file
+(all trees must have the same target attribute).
+----------------------------------------------------------------------*/
+
+#endif  /* #ifdef DF_PARSE */
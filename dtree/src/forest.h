@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------
+  File    : forest.h
+  Contents: decision and regression forest management
+  Author  : Christian Borgelt
+  History : 2026.10.17 file created
+----------------------------------------------------------------------*/
+#ifndef __FOREST__
+#define __FOREST__
+#ifdef DF_PARSE
+#ifndef DT_PARSE
+#define DT_PARSE
+#endif
+#endif
+#include "dtree.h"
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- decision/regression forest --- */
+  ATTSET *attset;               /* attribute set */
+  ATTID  trgid;                 /* identifier of target attribute */
+  ATT    *target;               /* target attribute */
+  int    type;                  /* type of target attribute */
+  VALID  clscnt;                /* number of classes (nominal target) */
+  int    cnt;                   /* number of trees */
+  int    size;                  /* size of the tree array */
+  DTREE  **trees;               /* array of trees */
+  double supp;                  /* support of prediction */
+  double *frqs;                 /* buffer for exec. frequencies */
+} DTFOREST;                     /* (decision/regression forest) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern DTFOREST* df_create (ATTSET *attset, ATTID trgid);
+extern void      df_delete (DTFOREST *df, int delas);
+extern ATTSET*   df_attset (DTFOREST *df);
+extern ATT*      df_target (DTFOREST *df);
+extern ATTID     df_trgid  (DTFOREST *df);
+extern int       df_type   (DTFOREST *df);
+extern int       df_cnt    (DTFOREST *df);
+extern DTREE*    df_tree   (DTFOREST *df, int index);
+extern int       df_add    (DTFOREST *df, DTREE *dt);
+
+extern int       df_exec   (DTFOREST *df, TUPLE *tuple, double weight,
+                            INST *res, double *supp, double *conf);
+extern double    df_supp   (DTFOREST *df);
+extern double    df_conf   (DTFOREST *df, VALID clsid);
+
+extern int       df_desc   (DTFOREST *df, FILE *file, int mode,
+                            int maxlen);
+#ifdef DF_PARSE
+extern DTFOREST* df_parse  (ATTSET *attset, SCANNER *scan);
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define df_attset(f)     ((f)->attset)
+#define df_target(f)     ((f)->target)
+#define df_trgid(f)      ((f)->trgid)
+#define df_type(f)       ((f)->type)
+#define df_cnt(f)        ((f)->cnt)
+#define df_tree(f,i)     ((f)->trees[i])
+
+#define df_supp(f)       ((f)->supp)
+#define df_conf(f,i)     ((f)->frqs[i])
+
+#endif
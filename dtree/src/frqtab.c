@@ -35,6 +35,7 @@
             2013.03.07 adapted to direction param. of sorting functions
             2013.08.23 adapted to preprocessor definition of DIMID
             2013.08.26 indexing system for frq_xy made more consistent
+            2026.10.17 frq_xy made a pointer (frq_xy[-1] valid index)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -700,9 +701,10 @@ FRQTAB* ft_create (DIMID xsize, DIMID ysize)
   z += (size_t)xsize *(size_t)ysize +(size_t)xsize+(size_t)ysize;
   p  = (double*)malloc(z *sizeof(double));
   if (!p) { free(ftab->dsts-1); free(ftab); return NULL; }
+  ftab->frq_xy   = ftab->cols+1; /* (frq_xy[-1]: unknown x) */
   ftab->frq_x    = p += 1;      /* allocate table and buffer */
   ftab->frq_y    = p += xsize;  /* elements and organize them */
-  ftab->frq_z[0] = p += ysize;
+  ftab->cols[0]  = p += ysize;
   for (i = 0; i < xsize-1; i++)
     ftab->frq_xy[i] = p += ysize;
   ftab->buf_x  = p += ysize -1;
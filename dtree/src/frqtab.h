@@ -22,6 +22,7 @@
             2009.04.16 modified relevance measure added
             2013.08.23 preprocessor definition of type DIMID added
             2013.08.26 indexing system for frq_xy made more consistent
+            2026.10.17 frq_xy made a pointer (frq_xy[-1] valid index)
 ----------------------------------------------------------------------*/
 #ifndef __FRQTAB__
 #define __FRQTAB__
@@ -161,8 +162,8 @@ typedef struct {                /* --- frequency table --- */
   double known;                 /* number of cases with a known value */
   double *frq_x;                /* marginal x frequencies */
   double *frq_y;                /* marginal y frequencies */
-  double *frq_z[1];             /* freqs. for unknown x (frq_xy[-1]) */
-  double *frq_xy[1];            /* table of joint frequencies */
+  double **frq_xy;              /* table of joint frequencies */
+  double *cols[1];              /* column vectors (frq_xy[-1]: null) */
 } FRQTAB;                       /* (frequency table) */
 
 /*----------------------------------------------------------------------
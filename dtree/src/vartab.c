@@ -6,6 +6,10 @@
             2000.12.17 first version completed
             2013.08.23 adapted to preprocessor definition of DIMID
             2013.08.26 indexing system for data made more consistent
+            2026.10.17 function vt_mvsum() added (move aggregates)
+            2026.10.17 sums of squared errors clamped to be nonnegative
+            2026.10.17 combined columns skipped in evaluation functions
+            2026.10.17 data array accessed via pointer (data[-1] valid)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,6 +25,9 @@
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
 #define EPSILON     1e-12       /* to handle roundoff errors */
+#define SSE(q,m,s)  (((q) -(m)*(s) > 0) ? (q) -(m)*(s) : 0)
+                                /* sum of squared errors (roundoff */
+                                /* errors can make it negative) */
 
 /*----------------------------------------------------------------------
   Type Definitions
@@ -54,7 +61,8 @@ static double sse (VARTAB *vtab, int measure, double *params)
   if (vtab->known <= 0)         /* if there are too few cases, */
     return 0;                   /* abort the function */
   for (red = vtab->sse, i = 0; i < vtab->cnt; i++)
-    red -= vtab->data[i].sse;   /* subtract sums of squared errors */
+    if (vtab->dsts[i] < 0)      /* skip combined columns and */
+      red -= vtab->data[i].sse; /* subtract sums of squared errors */
   if (measure & VEF_WGTD) red *= vtab->known/vtab->frq;
   return red;                   /* return the (weighted) reduction */
 }  /* sse() */
@@ -70,7 +78,8 @@ static double mse (VARTAB *vtab, int measure, double *params)
   if (vtab->known <= 0)         /* if there are too few cases, */
     return 0;                   /* abort the function */
   for (red = 0, i = 0; i < vtab->cnt; i++)
-    red += vtab->data[i].sse;   /* sum the sums of the squared errors */
+    if (vtab->dsts[i] < 0)      /* skip combined columns and */
+      red += vtab->data[i].sse; /* sum the sums of squared errors */
   red = vtab->sse /vtab->frq    /* compute the reduction */
       - red /vtab->known;       /* of the mean squared error */
   if (measure & VEF_WGTD) red *= vtab->known/vtab->frq;
@@ -88,7 +97,8 @@ static double rmse (VARTAB *vtab, int measure, double *params)
   if (vtab->known <= 0)         /* if there are too few cases, */
     return 0;                   /* abort the function */
   for (red = 0, i = 0; i < vtab->cnt; i++)
-    red += sqrt(vtab->data[i].sse *vtab->data[i].frq);
+    if (vtab->dsts[i] < 0)      /* skip combined columns */
+      red += sqrt(vtab->data[i].sse *vtab->data[i].frq);
                                 /* red = \sum frq *\sqrt{sse/frq} */
   red = sqrt(vtab->sse /vtab->frq)
       - red /vtab->known;       /* compute the rmse reduction */
@@ -110,7 +120,9 @@ static double var (VARTAB *vtab, int measure, double *params)
   frq = vtab->frq -1;           /* compute the global variance */
   var = (frq > 0) ? vtab->sse /frq : 0;
   for (red = 0, i = 0; i < vtab->cnt; i++) {
-    frq  = vtab->data[i].frq-1; /* traverse the table columns */
+    if (vtab->dsts[i] >= 0)     /* traverse the table columns, */
+      continue;                 /* but skip combined columns */
+    frq  = vtab->data[i].frq-1;
     red += vtab->data[i].frq    /* weighted sum of the variances */
          * ((frq > 0) ? vtab->data[i].sse /frq : var);
   }
@@ -133,7 +145,9 @@ static double sdev (VARTAB *vtab, int measure, double *params)
   frq  = vtab->frq -1;          /* compute the global std. deviation */
   sdev = (frq > 0) ? sqrt(vtab->sse /frq) : 0;
   for (red = 0, i = 0; i < vtab->cnt; i++) {
-    frq  = vtab->data[i].frq-1; /* traverse the table columns */
+    if (vtab->dsts[i] >= 0)     /* traverse the table columns, */
+      continue;                 /* but skip combined columns */
+    frq  = vtab->data[i].frq-1;
     red += vtab->data[i].frq    /* weighted sum of the std. devs. */
          * ((frq > 0) ? sqrt(vtab->data[i].sse /frq) : sdev);
   }
@@ -165,8 +179,9 @@ VARTAB* vt_create (DIMID size)
 
   if (size < 1) size = 1;       /* check the function argument */
   vtab = (VARTAB*)malloc(sizeof(VARTAB)
-                       +(size_t)(size-1) *sizeof(VARDATA));
+                       +(size_t) size    *sizeof(VARDATA));
   if (!vtab) return NULL;       /* create a variance table and */
+  vtab->data = vtab->buf +1;    /* (data[-1] is for unknown values) */
   vtab->size = size;            /* set its size (number of columns) */
   vtab->cnt  = 0;
   vtab->dsts = (DIMID*)malloc((size_t)(size+1) *sizeof(DIMID));
@@ -247,11 +262,11 @@ void vt_calc (VARTAB *vtab)
   }
   vtab->known = vtab->frq - vtab->data[-1].frq;
   vtab->mean  = (vtab->frq > 0) ? vtab->sum /vtab->frq : 0;
-  vtab->sse   = vtab->ssv -vtab->mean *vtab->sum;
+  vtab->sse   = SSE(vtab->ssv, vtab->mean, vtab->sum);
   for (i = 0; i < vtab->cnt; i++) {
     p = vtab->data +i;          /* traverse the table columns again */
     p->mean = (p->frq > 0) ? p->sum /p->frq : vtab->mean;
-    p->sse  = p->ssv -p->mean *p->sum;
+    p->sse  = SSE(p->ssv, p->mean, p->sum);
   }                             /* compute the column aggregates */
 }  /* vt_calc() */
 
@@ -270,13 +285,34 @@ void vt_move (VARTAB *vtab, DIMID xsrc, DIMID xdst, double y,double frq)
   src->sum -= frq *= y; dst->sum += frq;  /* and its frequency */
   src->ssv -= frq *= y; dst->ssv += frq;
   src->mean = (src->frq > 0) ? src->sum /src->frq : vtab->mean;
-  src->sse  = src->ssv -src->mean *src->sum;
+  src->sse  = SSE(src->ssv, src->mean, src->sum);
   dst->mean = (dst->frq > 0) ? dst->sum /dst->frq : vtab->mean;
-  dst->sse  = dst->ssv -dst->mean *dst->sum;
+  dst->sse  = SSE(dst->ssv, dst->mean, dst->sum);
 }  /* vt_move() */              /* recompute column aggregates */
 
 /*--------------------------------------------------------------------*/
 
+void vt_mvsum (VARTAB *vtab, DIMID xsrc, DIMID xdst,
+               double frq, double sum, double ssv)
+{                               /* --- move aggregated values */
+  VARDATA *src, *dst;           /* source and destination column */
+
+  assert(vtab                   /* check the function arguments */
+  &&    (xsrc >= 0) && (xsrc < vtab->cnt)
+  &&    (xdst >= 0) && (xdst < vtab->cnt));
+  src = vtab->data +xsrc;       /* check the indices and */
+  dst = vtab->data +xdst;       /* get the column data */
+  src->frq -= frq; dst->frq += frq;  /* move the frequency, */
+  src->sum -= sum; dst->sum += sum;  /* the sum of the values, */
+  src->ssv -= ssv; dst->ssv += ssv;  /* and the sum of their squares */
+  src->mean = (src->frq > 0) ? src->sum /src->frq : vtab->mean;
+  src->sse  = SSE(src->ssv, src->mean, src->sum);
+  dst->mean = (dst->frq > 0) ? dst->sum /dst->frq : vtab->mean;
+  dst->sse  = SSE(dst->ssv, dst->mean, dst->sum);
+}  /* vt_mvsum() */             /* recompute column aggregates */
+
+/*--------------------------------------------------------------------*/
+
 void vt_comb (VARTAB *vtab, DIMID xsrc, DIMID xdst)
 {                               /* --- combine two columns */
   VARDATA *src, *dst;           /* source and destination column */
@@ -292,7 +328,7 @@ void vt_comb (VARTAB *vtab, DIMID xsrc, DIMID xdst)
   dst->sum += src->sum;         /* of the destination column */
   dst->ssv += src->ssv;         /* and recompute the aggregates */
   dst->mean = (dst->frq > 0) ? dst->sum /dst->frq : vtab->mean;
-  dst->sse  = dst->ssv -dst->mean *dst->sum;
+  dst->sse  = SSE(dst->ssv, dst->mean, dst->sum);
 }  /* vt_comb() */
 
 /*--------------------------------------------------------------------*/
@@ -314,7 +350,7 @@ void vt_uncomb (VARTAB *vtab, DIMID xsrc)
     dst->sum -= src->sum;       /* of the destination column, */
     dst->ssv -= src->ssv;       /* then recompute the aggregates */
     dst->mean = (dst->frq > 0) ? dst->sum /dst->frq : vtab->mean;
-    dst->sse  = dst->ssv -dst->mean *dst->sum;
+    dst->sse  = SSE(dst->ssv, dst->mean, dst->sum);
     xdst = vtab->dsts[xdst];    /* get the next destination column, */
   } while (xdst >= 0);          /* while there is another */
 }  /* vt_uncomb() */
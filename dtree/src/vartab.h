@@ -5,6 +5,8 @@
   History : 2000.09.12 file created
             2013.08.23 preprocessor definition of type DIMID added
             2013.08.26 indexing system for data made more consistent
+            2026.10.17 function vt_mvsum() added (move aggregates)
+            2026.10.17 data array accessed via pointer (data[-1] valid)
 ----------------------------------------------------------------------*/
 #ifndef __VARTAB__
 #define __VARTAB__
@@ -120,8 +122,8 @@ typedef struct {                /* --- variation table --- */
   double  ssv;                  /* sum of squared values */
   double  mean;                 /* mean value */
   double  sse;                  /* sum of squared errors */
-  VARDATA null[1];              /* variation data for unknown x */
-  VARDATA data[1];              /* variation data per column */
+  VARDATA *data;                /* variation data per column */
+  VARDATA buf[1];               /* data for unknown x and columns */
 } VARTAB;                       /* (variation table) */
 
 /*----------------------------------------------------------------------
@@ -136,6 +138,8 @@ extern void    vt_add     (VARTAB *vtab, DIMID x, double y, double frq);
 extern void    vt_calc    (VARTAB *vtab);
 extern void    vt_move    (VARTAB *vtab, DIMID xsrc, DIMID xdst,
                            double y, double frq);
+extern void    vt_mvsum   (VARTAB *vtab, DIMID xsrc, DIMID xdst,
+                           double frq, double sum, double ssv);
 
 extern void    vt_comb    (VARTAB *vtab, DIMID xsrc, DIMID xdst);
 extern void    vt_uncomb  (VARTAB *vtab, DIMID xsrc);
@@ -43,6 +43,7 @@
             2013.07.26 parameter 'dir' added to function tab_sort()
             2013.09.05 return values for tab_reduce() and tab_balance()
             2015.08.01 function tab_colperm() added (permute columns)
+            2026.10.17 identifier of first tuple set in tab_reduce()
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -549,6 +550,7 @@ TPLID tab_reduce (TABLE *tab)
   if (tab->cnt <= 0) return 0;  /* check whether table is empty */
   ptr_qsort(tab->tpls, (size_t)tab->cnt, +1, (CMPFN*)tpl_cmp, NULL);
   d = tab->tpls; s = d+1;       /* sort and traverse the tuple array */
+  (*d)->id = 0;                 /* (first tuple is always kept) */
   for (i = tab->cnt, tab->cnt = 1; --i > 0; s++) {
     if (tpl_cmp(*d, *s, NULL) != 0) {
       *++d = *s;                /* if the next tuple differs, keep it */
@@ -0,0 +1,231 @@
+/*----------------------------------------------------------------------
+  File    : hhsketch.c
+  Contents: heavy hitter sketch for items and item pairs (Space-Saving)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created (as part of patspec.c)
+            2026.10.17 moved to a module of its own, maximum size added
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "hhsketch.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static size_t hhhash (ITEM a, ITEM b)
+{                               /* --- hash function for item pairs */
+  size_t h;                     /* computed hash value */
+
+  h = (size_t)a *2654435761u +(size_t)(b+1) *40503u;
+  return h ^ (h >> 15);         /* combine the items and */
+}  /* hhhash() */               /* mix the higher bits down */
+
+/*--------------------------------------------------------------------*/
+
+static size_t hhfind (HHSKETCH *hhs, ITEM a, ITEM b)
+{                               /* --- find slot of an item pair */
+  size_t i;                     /* slot index */
+  HHCTR  *c;                    /* counter referred to by slot */
+
+  for (i = hhhash(a, b) & hhs->mask; hhs->htab[i];
+       i = (i+1) & hhs->mask) { /* linear probing */
+    c = hhs->ctrs +hhs->htab[i]-1;
+    if ((c->a == a) && (c->b == b)) break;
+  }                             /* return the slot of the pair */
+  return i;                     /* or the empty slot for it */
+}  /* hhfind() */
+
+/*--------------------------------------------------------------------*/
+
+static void hhremove (HHSKETCH *hhs, size_t i)
+{                               /* --- remove a slot from hash table */
+  size_t j, k;                  /* slot indices, home slot */
+  HHCTR  *c;                    /* counter referred to by slot */
+
+  hhs->htab[i] = 0;             /* clear the slot and */
+  for (j = i; 1; ) {            /* shift following entries back */
+    j = (j+1) & hhs->mask;      /* get the next slot */
+    if (!hhs->htab[j]) break;   /* until an empty slot is reached */
+    c = hhs->ctrs +hhs->htab[j]-1;
+    k = hhhash(c->a, c->b) & hhs->mask;
+    if ((j > i) ? ((k > i) && (k <= j)) : ((k > i) || (k <= j)))
+      continue;                 /* skip entries that are reachable */
+    hhs->htab[i] = hhs->htab[j];/* move the entry to the free slot */
+    hhs->htab[j] = 0; c->slot = i; i = j;
+  }                             /* (backward shift deletion, */
+}  /* hhremove() */             /* so that no tombstones are needed) */
+
+/*--------------------------------------------------------------------*/
+
+static void hhsift (HHSKETCH *hhs, size_t i)
+{                               /* --- let counter sift down in heap */
+  size_t k;                     /* index of child counter */
+  HHCTR  t = hhs->ctrs[i];      /* counter to sift down */
+
+  for (k = i+i+1; k < hhs->cnt; k = i+i+1) {
+    if ((k+1 < hhs->cnt) && (hhs->ctrs[k+1].frq < hhs->ctrs[k].frq))
+      k++;                      /* get the child with smaller freq. */
+    if (hhs->ctrs[k].frq >= t.frq) break;
+    hhs->ctrs[i] = hhs->ctrs[k];/* if the child is smaller, */
+    hhs->htab[hhs->ctrs[i].slot] = i+1; i = k;
+  }                             /* move the child up one level */
+  hhs->ctrs[i] = t;             /* store the counter to sift */
+  hhs->htab[t.slot] = i+1;      /* and note its new position */
+}  /* hhsift() */
+
+/*----------------------------------------------------------------------
+  Heavy Hitter Sketch Functions
+----------------------------------------------------------------------*/
+
+HHSKETCH* hh_create (size_t size)
+{                               /* --- create a heavy hitter sketch */
+  HHSKETCH *hhs;                /* created heavy hitter sketch */
+  size_t   n;                   /* size of the hash table */
+
+  if (size < 1) size = 1;       /* ensure at least one counter */
+  if (size > HH_MAXSIZE) return NULL;  /* and check the maximum */
+  for (n = 4; n < size+size; n += n);
+  hhs = (HHSKETCH*)malloc(sizeof(HHSKETCH));
+  if (!hhs) return NULL;        /* create the base structure */
+  hhs->ctrs = (HHCTR*) malloc(size *sizeof(HHCTR));
+  hhs->htab = (size_t*)calloc(n,     sizeof(size_t));
+  if (!hhs->ctrs || !hhs->htab) { hh_delete(hhs); return NULL; }
+  hhs->size  = size;            /* allocate counters and hash table */
+  hhs->mask  = n-1;             /* (hash table at most half full) */
+  hhs->cnt   = hhs->total = 0;  /* clear the counters */
+  return hhs;                   /* return created sketch */
+}  /* hh_create() */
+
+/*--------------------------------------------------------------------*/
+
+void hh_delete (HHSKETCH *hhs)
+{                               /* --- delete a heavy hitter sketch */
+  assert(hhs);                  /* check the function argument */
+  if (hhs->htab) free(hhs->htab);
+  if (hhs->ctrs) free(hhs->ctrs);
+  free(hhs);                    /* delete the arrays */
+}  /* hh_delete() */            /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+void hh_clear (HHSKETCH *hhs)
+{                               /* --- clear a heavy hitter sketch */
+  assert(hhs);                  /* check the function argument */
+  memset(hhs->htab, 0, (hhs->mask+1) *sizeof(size_t));
+  hhs->cnt = hhs->total = 0;    /* clear hash table and counters */
+}  /* hh_clear() */
+
+/*--------------------------------------------------------------------*/
+
+void hh_add (HHSKETCH *hhs, ITEM a, ITEM b, size_t frq)
+{                               /* --- add to an item (pair) frequency */
+  size_t i, k;                  /* slot in hash table, heap indices */
+  HHCTR  *c, t;                 /* counter to update, exchange buffer */
+
+  assert(hhs && (a >= 0));      /* check the function arguments */
+  if ((b >= 0) && (b < a)) { i = (size_t)a; a = b; b = (ITEM)i; }
+  if (b < 0) b = -1;            /* get a canonical pair/item */
+  hhs->total += frq;            /* sum the frequencies */
+  i = hhfind(hhs, a, b);        /* find the item pair */
+  if (hhs->htab[i]) {           /* if there is a counter for it, */
+    c = hhs->ctrs +hhs->htab[i]-1;    /* simply update it */
+    c->frq += frq; hhsift(hhs, (size_t)(c -hhs->ctrs)); return; }
+  if (hhs->cnt < hhs->size) {   /* if there is an unused counter */
+    c = hhs->ctrs +hhs->cnt++;  /* get the next counter and */
+    c->a = a; c->b = b;         /* initialize it for the pair */
+    c->frq = frq; c->err = 0; c->slot = i;
+    hhs->htab[i] = hhs->cnt;    /* enter the counter into the table */
+    for (i = hhs->cnt-1; i > 0; i = k) {
+      k = (i-1) >> 1;           /* traverse the parent counters */
+      if (hhs->ctrs[k].frq <= frq) break;
+      t = hhs->ctrs[k]; hhs->ctrs[k] = hhs->ctrs[i];
+      hhs->ctrs[i] = t;         /* if the parent is larger, */
+      hhs->htab[hhs->ctrs[i].slot] = i+1;  /* swap the counters */
+      hhs->htab[hhs->ctrs[k].slot] = k+1;  /* and update their */
+    }                           /* hash table entries */
+    return;                     /* the counter is in place */
+  }
+  c = hhs->ctrs;                /* replace the minimum counter */
+  hhremove(hhs, c->slot);       /* remove the old pair from the table */
+  c->slot = hhfind(hhs, a, b);  /* and enter the new pair */
+  hhs->htab[c->slot] = 1;       /* (the removal may have shifted */
+  c->a   = a; c->b = b;         /*  the slot of the new pair) */
+  c->err = c->frq;              /* the frequency of the replaced */
+  c->frq += frq;                /* pair bounds the overestimation */
+  hhsift(hhs, 0);               /* restore the heap condition */
+}  /* hh_add() */
+
+/*--------------------------------------------------------------------*/
+
+static int hhcmp (const void *p1, const void *p2)
+{                               /* --- compare two counters */
+  const HHCTR *a = (const HHCTR*)p1;  /* type the counters */
+  const HHCTR *b = (const HHCTR*)p2;
+
+  if (a->frq > b->frq) return -1;  /* sort by descending frequency */
+  if (a->frq < b->frq) return +1;
+  if (a->a   < b->a)   return -1;  /* and by ascending items */
+  if (a->a   > b->a)   return +1;  /* (for a deterministic order) */
+  if (a->b   < b->b)   return -1;
+  return (a->b > b->b) ? +1 : 0;
+}  /* hhcmp() */
+
+/*--------------------------------------------------------------------*/
+
+size_t hh_sort (HHSKETCH *hhs, HHCTR *ctrs)
+{                               /* --- get sorted counters */
+  assert(hhs && ctrs);          /* check the function arguments */
+  memcpy(ctrs, hhs->ctrs, hhs->cnt *sizeof(HHCTR));
+  qsort(ctrs, hhs->cnt, sizeof(HHCTR), hhcmp);
+  return hhs->cnt;              /* copy and sort the counters and */
+}  /* hh_sort() */              /* return the number of counters */
+
+/*--------------------------------------------------------------------*/
+#ifdef HH_REPORT
+
+int hh_report (HHSKETCH *hhs, TABWRITE *twr, ITEMBASE *base)
+{                               /* --- report heavy hitters */
+  size_t i;                     /* loop variable */
+  HHCTR  *ctrs;                 /* sorted counters */
+
+  assert(hhs && twr && base);   /* check the function arguments */
+  if (hhs->cnt <= 0) return 0;  /* check for at least one counter */
+  ctrs = (HHCTR*)malloc(hhs->cnt *sizeof(HHCTR));
+  if (!ctrs) return -1;         /* get and sort a counter copy */
+  hh_sort(hhs, ctrs);           /* (to keep the heap intact) */
+  for (i = 0; i < hhs->cnt; i++) {
+    twr_puts(twr, ib_name(base, ctrs[i].a));
+    if (ctrs[i].b >= 0) {       /* print the item (pair) */
+      twr_blank(twr); twr_puts(twr, ib_name(base, ctrs[i].b)); }
+    twr_fldsep(twr); twr_printf(twr, "%"SIZE_FMT, ctrs[i].frq);
+    twr_fldsep(twr); twr_printf(twr, "%"SIZE_FMT, ctrs[i].err);
+    twr_recsep(twr);            /* print the estimated frequency */
+  }                             /* and the maximum overestimation */
+  free(ctrs);                   /* delete the counter copy */
+  return twr_error(twr);        /* return a write error indicator */
+}  /* hh_report() */
+
+#endif  /* #ifdef HH_REPORT */
+/*----------------------------------------------------------------------
+A heavy hitter sketch implements the Space-Saving algorithm: it keeps
+at most size counters for items or item pairs. If an item (pair) is
+added that has no counter and all counters are in use, the counter
+with the smallest frequency is taken over: the new pair inherits this
+frequency (so the reported frequencies never underestimate) and notes
+it as the maximum overestimation (err). Any item (pair) with a true
+frequency above total/size is guaranteed to have a counter, and if at
+most size distinct items (pairs) are added, all counts are exact.
+The counters are organized as a binary min-heap (so the counter to
+take over is always at the root), and an open addressing hash table
+with linear probing maps item pairs to counters. The function
+hh_sort() copies the counters to a given array (with room for at
+least hh_cnt() counters) and sorts them by descending frequency.
+The number of counters is limited to HH_MAXSIZE, so that the sizes
+of the counter array and of the hash table cannot overflow; with a
+larger size hh_create() fails (returns NULL).
+----------------------------------------------------------------------*/
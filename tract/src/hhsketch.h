@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------
+  File    : hhsketch.h
+  Contents: heavy hitter sketch for items and item pairs (Space-Saving)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created (as part of patspec.h)
+            2026.10.17 moved to a module of its own, maximum size added
+----------------------------------------------------------------------*/
+#ifndef __HHSKETCH__
+#define __HHSKETCH__
+#include <stdint.h>
+#include "tract.h"
+#ifdef HH_REPORT
+#include "tabwrite.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define HH_MAXSIZE  (SIZE_MAX/4/sizeof(HHCTR))
+                                /* maximum number of counters */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- heavy hitter counter --- */
+  ITEM   a, b;                  /* item pair (b < 0: single item a) */
+  size_t frq;                   /* (over)estimated frequency */
+  size_t err;                   /* maximum overestimation */
+  size_t slot;                  /* slot in the hash table */
+} HHCTR;                        /* (heavy hitter counter) */
+
+typedef struct {                /* --- heavy hitter sketch --- */
+  size_t size;                  /* maximum number of counters */
+  size_t cnt;                   /* current number of counters */
+  size_t total;                 /* total of the added frequencies */
+  size_t mask;                  /* bit mask for hash table indices */
+  size_t *htab;                 /* hash table (counter indices +1) */
+  HHCTR  *ctrs;                 /* counters (heap, min. freq. first) */
+} HHSKETCH;                     /* (heavy hitter sketch) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern HHSKETCH* hh_create  (size_t size);
+extern void      hh_delete  (HHSKETCH *hhs);
+extern void      hh_clear   (HHSKETCH *hhs);
+extern size_t    hh_size    (HHSKETCH *hhs);
+extern size_t    hh_cnt     (HHSKETCH *hhs);
+extern size_t    hh_total   (HHSKETCH *hhs);
+extern void      hh_add     (HHSKETCH *hhs, ITEM a, ITEM b, size_t frq);
+extern size_t    hh_sort    (HHSKETCH *hhs, HHCTR *ctrs);
+#ifdef HH_REPORT
+extern int       hh_report  (HHSKETCH *hhs, TABWRITE *twr,
+                             ITEMBASE *base);
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define hh_size(h)          ((h)->size)
+#define hh_cnt(h)           ((h)->cnt)
+#define hh_total(h)         ((h)->total)
+
+#endif
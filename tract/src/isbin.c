@@ -0,0 +1,666 @@
+/*----------------------------------------------------------------------
+  File    : isbin.c
+  Contents: binary item set/association rule format and reader
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+            2026.10.16 reader for binary trans. id lists added
+            2026.10.17 readers split into create/open (error codes)
+            2026.10.17 usage message and options in main function
+            2026.10.17 round trip test of trans. id lists (ISB_TEST)
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "isbin.h"
+#ifdef ISB_TEST
+#include "report.h"
+#endif
+#if defined ISB_MAIN || defined ISB_TEST
+#include "error.h"
+#endif
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define BLKSIZE      32         /* block size for enlarging arrays */
+#define RDERR(f)     ((ferror(f)) ? E_FREAD : ISB_EFORMAT)
+
+#ifdef ISB_MAIN
+#define PRGNAME     "isb"
+#define DESCRIPTION "convert binary item sets/transaction id lists " \
+                    "to text"
+#define VERSION     "version 1.1 (2026.10.17)         " \
+                    "(c) 2026        Christian Borgelt"
+
+/* --- error codes --- */
+/* error codes   0 to  -5 defined in tract.h and isbin.h */
+#define E_FORMAT     ISB_EFORMAT /* invalid file format */
+#define E_OPTION     (-6)       /* unknown option */
+#define E_ARGCNT     (-7)       /* too few/many arguments */
+#endif
+
+#ifdef ISB_TEST
+/* --- error codes --- */
+/* error codes   0 to  -5 defined in tract.h and isbin.h */
+#define E_CHECK      (-6)       /* consistency check failed */
+
+#define FN_SETS     "isbtest.isb" /* name of the item set file */
+#define FN_TIDS     "isbtest.tid" /* name of the trans. id list file */
+#define ITEMCNT        8        /* number of items */
+#define TRACNT       100        /* number of transactions */
+#endif
+
+/*----------------------------------------------------------------------
+  Global Variables
+----------------------------------------------------------------------*/
+#ifdef ISB_MAIN
+static const char *errmsgs[] = {/* error messages */
+  /* E_NONE      0 */  "no error",
+  /* E_NOMEM    -1 */  "not enough memory",
+  /* E_FOPEN    -2 */  "cannot open file %s",
+  /* E_FREAD    -3 */  "read error on file %s",
+  /* E_FWRITE   -4 */  "write error on file %s",
+  /* E_FORMAT   -5 */  "invalid format in file %s",
+  /* E_OPTION   -6 */  "unknown option -%c",
+  /* E_ARGCNT   -7 */  "wrong number of arguments",
+  /*            -8 */  "unknown error"
+};
+
+static const char *prgname;     /* program name for error messages */
+static ISBIN      *isb = NULL;  /* binary item set reader */
+static ISBTID     *tid = NULL;  /* binary trans. id list reader */
+#endif
+
+#ifdef ISB_TEST
+static const char *errmsgs[] = {/* error messages */
+  /* E_NONE      0 */  "no error",
+  /* E_NOMEM    -1 */  "not enough memory",
+  /* E_FOPEN    -2 */  "cannot open file %s",
+  /* E_FREAD    -3 */  "read error on file %s",
+  /* E_FWRITE   -4 */  "write error on file %s",
+  /* E_FORMAT   -5 */  "invalid format in file %s",
+  /* E_CHECK    -6 */  "check failed: %s",
+  /*            -7 */  "unknown error"
+};
+
+static const char *prgname;     /* program name for error messages */
+static ITEMBASE   *ibase  = NULL; /* item base */
+static TABAG      *tabag  = NULL; /* transaction bag/multiset */
+static ISREPORT   *report = NULL; /* item set reporter */
+static ISBIN      *isb    = NULL; /* binary item set reader */
+static ISBTID     *tid    = NULL; /* binary trans. id list reader */
+#endif
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int getuint (FILE *file, size_t *num)
+{                               /* --- read a variable length number */
+  int    c;                     /* next byte of the number */
+  int    s = 0;                 /* shift for the next 7 bits */
+  size_t n = 0;                 /* number to read */
+
+  do {                          /* read the bytes of the number */
+    if ((c = getc(file)) == EOF)/* if at the end of the file, */
+      return (s > 0) ? ISB_EFORMAT : 1;   /* abort the function */
+    if (s >= (int)(8*sizeof(size_t))) return ISB_EFORMAT;
+    n |= (size_t)(c & 0x7f) << s;
+    s += 7;                     /* add the next 7 bits */
+  } while (c & 0x80);           /* while the continuation bit is set */
+  *num = n;                     /* store the read number */
+  return 0;                     /* return 'ok' */
+}  /* getuint() */
+
+/*--------------------------------------------------------------------*/
+
+static int getdbl (FILE *file, double *num)
+{                               /* --- read a floating point number */
+  int      i, c;                /* loop variable, next byte */
+  uint64_t b = 0;               /* bits of the number */
+
+  for (i = 0; i < 8; i++) {     /* read little endian byte order */
+    if ((c = getc(file)) == EOF) return ISB_EFORMAT;
+    b |= (uint64_t)c << (8*i);  /* collect the bytes */
+  }                             /* of the floating point number */
+  memcpy(num, &b, sizeof(double));
+  return 0;                     /* return 'ok' */
+}  /* getdbl() */
+
+/*--------------------------------------------------------------------*/
+
+static int getsupp (ISBIN *isb, double *supp)
+{                               /* --- read a support value */
+  size_t n;                     /* buffer for an integer support */
+
+  if (isb->flags & ISB_DBLSUPP) /* if supports are doubles, */
+    return getdbl(isb->file, supp);      /* read them directly */
+  if (getuint(isb->file, &n) != 0) return ISB_EFORMAT;
+  *supp = (double)n;            /* read an integer support */
+  return 0;                     /* and convert it to double */
+}  /* getsupp() */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+
+ISBIN* isb_create (void)
+{                               /* --- create a binary item set reader */
+  return (ISBIN*)calloc(1, sizeof(ISBIN));
+}  /* isb_create() */
+
+/*--------------------------------------------------------------------*/
+
+void isb_delete (ISBIN *isb)
+{                               /* --- delete a binary item set reader */
+  assert(isb);                  /* check the function argument */
+  isb_close(isb);               /* close the current file */
+  if (isb->items) free(isb->items);
+  free(isb);                    /* delete the item array */
+}  /* isb_delete() */           /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+static int readhdr (ISBIN *isb)
+{                               /* --- read the file header */
+  char   hdr[6];                /* buffer for the file header */
+  size_t i, n, k;               /* loop variable, number of items */
+
+  if (fread(hdr, 1, 6, isb->file) != 6) return RDERR(isb->file);
+  if ((memcmp(hdr, ISB_MAGIC, 4) != 0)
+  ||  (hdr[4] != ISB_VERSION))  /* read and check the file header */
+    return ISB_EFORMAT;         /* (magic string and version) */
+  isb->flags = (unsigned char)hdr[5];
+  if ((getuint(isb->file, &n) != 0) || (n > (size_t)ITEM_MAX))
+    return RDERR(isb->file);    /* read the number of items */
+  isb->names = (char**)calloc(n+1, sizeof(char*));
+  if (!isb->names) return E_NOMEM;  /* create the name array */
+  for (i = 0; i < n; i++) {     /* traverse the item dictionary */
+    if (getuint(isb->file, &k) != 0) return RDERR(isb->file);
+    isb->names[i] = (char*)malloc((k+1) *sizeof(char));
+    if (!isb->names[i]) return E_NOMEM;
+    isb->icnt = (ITEM)(i+1);    /* create a name buffer and */
+    if (fread(isb->names[i], 1, k, isb->file) != k)
+      return RDERR(isb->file);  /* read the name characters */
+    isb->names[i][k] = 0;       /* terminate the name */
+  }
+  return 0;                     /* return 'ok' */
+}  /* readhdr() */
+
+/*--------------------------------------------------------------------*/
+
+int isb_open (ISBIN *isb, FILE *file, const char *name)
+{                               /* --- open a binary item set file */
+  int r;                        /* result of header reading */
+
+  assert(isb);                  /* check the function arguments */
+  isb_close(isb);               /* close a previously opened file */
+  if (file) {                   /* if a file is given directly, */
+    if      (name)          isb->name = name; /* store the name */
+    else if (file == stdin) isb->name = "<stdin>";
+    else                    isb->name = "<unknown>"; }
+  else if (!name || !*name) {   /* if no file name is given */
+    file = stdin;           isb->name = "<stdin>"; }
+  else {                        /* if a proper file name is given */
+    file = fopen(isb->name = name, "rb");
+    if (!file) return E_FOPEN;  /* open file with given name */
+  }                             /* and check for an error */
+  isb->file   = file;           /* store the new input file */
+  isb->cnt    = 0;              /* there is no current record */
+  isb->reccnt = 0;              /* and no record has been read */
+  r = readhdr(isb);             /* read the file header */
+  if (r != 0) isb_close(isb);   /* on failure close the file */
+  return r;                     /* return the error status */
+}  /* isb_open() */
+
+/*--------------------------------------------------------------------*/
+
+int isb_close (ISBIN *isb)
+{                               /* --- close a binary item set file */
+  int  r;                       /* result of fclose() */
+  ITEM i;                       /* loop variable */
+
+  assert(isb);                  /* check the function argument */
+  if (isb->names) {             /* if there is an item dictionary */
+    for (i = 0; i < isb->icnt; i++)
+      free(isb->names[i]);      /* delete the item names */
+    free(isb->names);           /* and the name array */
+    isb->names = NULL; isb->icnt = 0;
+  }
+  if (!isb->file) return 0;     /* check whether there is a file */
+  r = ferror(isb->file);        /* check the error indicator */
+  if (isb->file != stdin) r |= fclose(isb->file);
+  isb->file = NULL;             /* close the current input file */
+  return r;                     /* return the result of fclose() */
+}  /* isb_close() */
+
+/*--------------------------------------------------------------------*/
+
+int isb_next (ISBIN *isb)
+{                               /* --- read the next record */
+  int    r;                     /* result of read function */
+  size_t n, k;                  /* number of items, item identifier */
+  ITEM   i;                     /* loop variable */
+  ITEM   *p;                    /* to enlarge the item array */
+
+  assert(isb);                  /* check the function argument */
+  r = getuint(isb->file, &n);   /* read the number of items */
+  if (r != 0) return (ferror(isb->file)) ? E_FREAD : r;
+  if (n > (size_t)ITEM_MAX) return ISB_EFORMAT;
+  if ((ITEM)n > isb->size) {    /* if the item array is too small */
+    i = isb->size +((isb->size > BLKSIZE) ? isb->size >> 1 : BLKSIZE);
+    if (i < (ITEM)n) i = (ITEM)n;
+    p = (ITEM*)realloc(isb->items, (size_t)i *sizeof(ITEM));
+    if (!p) return E_NOMEM;     /* enlarge the item array */
+    isb->items = p; isb->size = i;
+  }                             /* set the new array and its size */
+  for (i = 0; i < (ITEM)n; i++){/* read the items of the record */
+    if ((getuint(isb->file, &k) != 0)
+    ||  (k >= (size_t)isb->icnt)) return RDERR(isb->file);
+    isb->items[i] = (ITEM)k;    /* read and check an item identifier */
+  }
+  isb->cnt = (ITEM)n;           /* note the number of items */
+  if (getsupp(isb, &isb->supp) != 0) return RDERR(isb->file);
+  if ((isb->flags & ISB_RULES)  /* if association rules */
+  && ((getsupp(isb, &isb->body) != 0)
+  ||  (getsupp(isb, &isb->head) != 0))) return RDERR(isb->file);
+  if ((isb->flags & ISB_EVAL)   /* if records contain an evaluation */
+  &&  (getdbl(isb->file, &isb->eval) != 0)) return RDERR(isb->file);
+  isb->reccnt += 1;             /* count the read record */
+  return 0;                     /* return 'ok' */
+}  /* isb_next() */
+
+/*----------------------------------------------------------------------
+The binary item set format is written by an item set reporter with
+mode ISR_BINARY (see report.h). A file starts with a header, which
+consists of the magic string "ISRB", a version byte, a byte with the
+format flags (ISB_EVAL, ISB_RULES, ISB_DBLSUPP), the number of items
+and the item dictionary (for each item the length of its name and the
+name characters, without a terminating null). Each following record
+contains the number of items and the item identifiers (indices into
+the dictionary), then the support (and for association rules the body
+and head support), and finally, with flag ISB_EVAL, the additional
+evaluation. In association rules the first item is the rule head.
+All counts, item identifiers and (integer) supports are stored as
+variable length unsigned integers (7 bits per byte, least significant
+group first, high bit set in all bytes except the last); floating
+point numbers are stored as 8 byte IEEE 754 doubles in little endian
+byte order. A reader is created with isb_create() and may read
+several files in sequence. The function isb_open() returns 0 or an
+error code (E_FOPEN, E_FREAD, ISB_EFORMAT or E_NOMEM), in which case
+the file is closed again. The function isb_next() returns 0 if a
+record was read, 1 at the end of the file, and a negative error code
+(E_FREAD, ISB_EFORMAT or E_NOMEM) otherwise.
+----------------------------------------------------------------------*/
+
+ISBTID* isb_tidcreate (void)
+{                               /* --- create a trans. id list reader */
+  return (ISBTID*)calloc(1, sizeof(ISBTID));
+}  /* isb_tidcreate() */
+
+/*--------------------------------------------------------------------*/
+
+void isb_tiddelete (ISBTID *tid)
+{                               /* --- delete a trans. id list reader */
+  assert(tid);                  /* check the function argument */
+  isb_tidclose(tid);            /* close the current file */
+  if (tid->tids) free(tid->tids);
+  if (tid->occs) free(tid->occs);
+  free(tid);                    /* delete the id/counter arrays */
+}  /* isb_tiddelete() */        /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+int isb_tidopen (ISBTID *tid, FILE *file, const char *name)
+{                               /* --- open a binary trans. id file */
+  int  r;                       /* error code */
+  char hdr[5];                  /* buffer for the file header */
+
+  assert(tid);                  /* check the function arguments */
+  isb_tidclose(tid);            /* close a previously opened file */
+  if (file) {                   /* if a file is given directly, */
+    if      (name)          tid->name = name; /* store the name */
+    else if (file == stdin) tid->name = "<stdin>";
+    else                    tid->name = "<unknown>"; }
+  else if (!name || !*name) {   /* if no file name is given */
+    file = stdin;           tid->name = "<stdin>"; }
+  else {                        /* if a proper file name is given */
+    file = fopen(tid->name = name, "rb");
+    if (!file) return E_FOPEN;  /* open file with given name */
+  }                             /* and check for an error */
+  tid->file   = file;           /* store the new input file */
+  tid->cnt    = 0;              /* there is no current list */
+  tid->reccnt = 0;              /* and no list has been read */
+  if      (fread(hdr, 1, 5, file) != 5)
+    r = RDERR(file);            /* read the file header */
+  else if ((memcmp(hdr, ISB_TIDMAGIC, 4) != 0)
+  ||       (hdr[4] != ISB_TIDVERSION))
+    r = ISB_EFORMAT;            /* check magic string and version */
+  else return 0;                /* return 'ok' */
+  isb_tidclose(tid);            /* on failure close the file */
+  return r;                     /* return the error code */
+}  /* isb_tidopen() */
+
+/*--------------------------------------------------------------------*/
+
+int isb_tidclose (ISBTID *tid)
+{                               /* --- close a binary trans. id file */
+  int r;                        /* result of fclose() */
+
+  assert(tid);                  /* check the function argument */
+  if (!tid->file) return 0;     /* check whether there is a file */
+  r = ferror(tid->file);        /* check the error indicator */
+  if (tid->file != stdin) r |= fclose(tid->file);
+  tid->file = NULL;             /* close the current input file */
+  return r;                     /* return the result of fclose() */
+}  /* isb_tidclose() */
+
+/*--------------------------------------------------------------------*/
+
+int isb_tidnext (ISBTID *tid)
+{                               /* --- read the next trans. id list */
+  int    r;                     /* result of read function */
+  size_t n, k;                  /* number of ids, gap/item counter */
+  TID    i, z;                  /* loop variable, new array size */
+  TID    prv;                   /* previous transaction id */
+  TID    *t;                    /* to enlarge the id array */
+  ITEM   *o;                    /* to enlarge the counter array */
+
+  assert(tid);                  /* check the function argument */
+  r = getuint(tid->file, &n);   /* read the number of ids and */
+  if (r != 0) return (ferror(tid->file)) ? E_FREAD : r;
+  tid->hasocc = (int)(n & 1);   /* the item counter flag */
+  if ((n >>= 1) > (size_t)TID_MAX) return ISB_EFORMAT;
+  if ((TID)n > tid->size) {     /* if the id array is too small */
+    z = tid->size +((tid->size > BLKSIZE) ? tid->size >> 1 : BLKSIZE);
+    if (z < (TID)n) z = (TID)n;
+    t = (TID*)realloc(tid->tids, (size_t)z *sizeof(TID));
+    if (!t) return E_NOMEM;     /* enlarge the id array */
+    tid->tids = t;              /* and the item counter array */
+    o = (ITEM*)realloc(tid->occs, (size_t)z *sizeof(ITEM));
+    if (!o) return E_NOMEM;     /* (keep arrays in sync, so that */
+    tid->occs = o; tid->size = z;    /* size is valid for both) */
+  }                             /* set the new arrays and their size */
+  for (prv = -1, i = 0; i < (TID)n; i++) {
+    if ((getuint(tid->file, &k) != 0)
+    ||  (k >= (size_t)(TID_MAX -prv))) return RDERR(tid->file);
+    tid->tids[i] = prv = (TID)(prv +1 +(TID)k);
+    if (!tid->hasocc) continue; /* decode the next transaction id */
+    if ((getuint(tid->file, &k) != 0)
+    ||  (k > (size_t)ITEM_MAX)) return RDERR(tid->file);
+    tid->occs[i] = (ITEM)k;     /* read the number of items */
+  }                             /* contained in the transaction */
+  tid->cnt = (TID)n;            /* note the number of ids */
+  tid->reccnt += 1;             /* count the read list */
+  return 0;                     /* return 'ok' */
+}  /* isb_tidnext() */
+
+/*----------------------------------------------------------------------
+The binary transaction id list format is written by an item set
+reporter with mode ISR_TIDBIN (see report.h) to the file opened with
+isr_tidopen(). A file starts with the magic string "ISRT" and a version
+byte. Each following list belongs to the item set reported at the same
+position in the item set output and contains the number of ids times
+two (plus one if item counters are present), followed by the ids in
+ascending order, gap coded: the first (zero-based) id is stored as is,
+each following one as the difference to its predecessor minus one.
+With item counters each id is followed by the number of items of the
+set that are contained in the transaction. All numbers are variable
+length unsigned integers as in the item set format. The functions
+isb_tidcreate(), isb_tidopen() and isb_tidnext() work like their
+item set counterparts; isb_tidnext() returns 0 if a list was read,
+1 at the end of the file, and a negative error code otherwise.
+----------------------------------------------------------------------*/
+#ifdef ISB_MAIN
+
+#ifndef NDEBUG                  /* if debug version */
+  #undef  CLEANUP               /* clean up memory and close files */
+  #define CLEANUP \
+  if (isb) isb_delete(isb); \
+  if (tid) isb_tiddelete(tid);
+#endif
+
+GENERROR(error, exit)           /* generic error reporting function */
+
+/*--------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{                               /* --- convert binary to text */
+  int        i, k = 0;          /* loop variables, counter */
+  char       *s;                /* to traverse the options */
+  const char *fn_inp = NULL;    /* name of the input file */
+  int        tids   = 0;        /* flag for trans. id lists */
+  int        r;                 /* result of read function */
+  ITEM       m;                 /* loop variable for items */
+  TID        n;                 /* loop variable for trans. ids */
+
+  prgname = argv[0];            /* get program name for error msgs. */
+
+  /* --- print usage message --- */
+  if (argc > 1) {               /* if arguments are given */
+    fprintf(stderr, "%s - %s\n", argv[0], DESCRIPTION);
+    fprintf(stderr, VERSION); } /* print a startup message */
+  else {                        /* if no arguments given */
+    printf("usage: %s [options] infile\n", argv[0]);
+    printf("%s\n", DESCRIPTION);
+    printf("%s\n", VERSION);
+    printf("-t       read transaction id lists                "
+                    "(default: item sets)\n");
+    printf("infile   file to read binary records from         "
+                    "[required]\n");
+    printf("         (\"-\" for standard input)\n");
+    return 0;                   /* print a usage message */
+  }                             /* and abort the program */
+
+  /* --- evaluate arguments --- */
+  for (i = 1; i < argc; i++) {  /* traverse arguments */
+    s = argv[i];                /* get option argument */
+    if ((*s == '-') && *++s) {  /* -- if argument is an option */
+      while (*s) {              /* traverse options */
+        switch (*s++) {         /* evaluate switches */
+          case 't': tids = -1;             break;
+          default : error(E_OPTION, *--s); break;
+        }                       /* set option variables */
+      } }
+    else {                      /* -- if argument is no option */
+      switch (k++) {            /* evaluate non-options */
+        case  0: fn_inp = s;      break;
+        default: error(E_ARGCNT); break;
+      }                         /* note the file name */
+    }
+  }
+  if (k != 1) error(E_ARGCNT);  /* check the number of arguments */
+  fprintf(stderr, "\n");        /* terminate the startup message */
+
+  /* --- convert transaction id lists --- */
+  if (tids) {                   /* if to convert trans. id lists */
+    tid = isb_tidcreate();      /* create a trans. id list reader */
+    if (!tid) error(E_NOMEM);   /* and open the input file */
+    r = isb_tidopen(tid, NULL, fn_inp);
+    if (r != 0) error(r, isb_tidfname(tid));
+    while ((r = isb_tidnext(tid)) == 0) {
+      for (n = 0; n < isb_tidcnt(tid); n++) {
+        if (n > 0) fputc(' ', stdout);
+        printf("%ld", (long)isb_tid(tid, n)+1);
+        if (isb_hasocc(tid)) printf(":%ld", (long)isb_occ(tid, n));
+      }                         /* print the (one-based) trans. ids */
+      fputc('\n', stdout);      /* and the item counters */
+    }                           /* in the text format of the reporter */
+    if (r < 0) error(r, isb_tidfname(tid));
+    isb_tiddelete(tid); tid = NULL;
+    return 0;                   /* close the trans. id list file */
+  }                             /* and abort the program */
+
+  /* --- convert item sets/association rules --- */
+  isb = isb_create();           /* create an item set reader */
+  if (!isb) error(E_NOMEM);     /* and open the input file */
+  r = isb_open(isb, NULL, fn_inp);
+  if (r != 0) error(r, isb_fname(isb));
+  while ((r = isb_next(isb)) == 0) {
+    for (m = 0; m < isb_cnt(isb); m++) {
+      if (m > 0) fputs(((m == 1) && (isb_flags(isb) & ISB_RULES))
+                       ? " <- " : " ", stdout);
+      fputs(isb_name(isb, isb_item(isb, m)), stdout);
+    }                           /* print the items of the record */
+    printf(" (%.17g", isb_supp(isb));
+    if (isb_flags(isb) & ISB_RULES)
+      printf(", %.17g, %.17g", isb_body(isb), isb_head(isb));
+    if (isb_flags(isb) & ISB_EVAL)
+      printf(", %.17g", isb_eval(isb));
+    fputs(")\n", stdout);       /* print the record information */
+  }
+  if (r < 0) error(r, isb_fname(isb));
+  isb_delete(isb); isb = NULL;  /* close the binary item set file */
+  return 0;                     /* return 'ok' */
+}  /* main() */
+
+#endif
+
+/*--------------------------------------------------------------------*/
+#ifdef ISB_TEST
+
+#ifndef NDEBUG                  /* if debug version */
+  #undef  CLEANUP               /* clean up memory and close files */
+  #define CLEANUP \
+  if (isb)    isb_delete(isb); \
+  if (tid)    isb_tiddelete(tid); \
+  if (report) isr_delete(report, 0); \
+  if (tabag)  tbg_delete(tabag, 0); \
+  if (ibase)  ib_delete (ibase);
+#endif
+
+GENERROR(error, exit)           /* generic error reporting function */
+
+/*--------------------------------------------------------------------*/
+
+static TID cover (TABAG *bag, ITEM a, ITEM b, TID *tids)
+{                               /* --- collect ids of transactions */
+  TID        k, n;              /* loop variable, number of ids */
+  ITEM       c;                 /* number of contained items */
+  const ITEM *s;                /* to traverse the items */
+
+  assert(bag && tids);          /* check the function arguments */
+  for (n = k = 0; k < tbg_cnt(bag); k++) {
+    s = ta_items(tbg_tract(bag, k));
+    for (c = 0; *s > TA_END; s++)
+      c += (*s == a) || (*s == b);
+    if (c >= ((b < 0) ? 1 : 2)) tids[n++] = k;
+  }                             /* collect the transactions that */
+  return n;                     /* contain the item(s) a (and b) */
+}  /* cover() */
+
+/*--------------------------------------------------------------------*/
+
+static void check (ITEM a, ITEM b, TID *tids, TID n)
+{                               /* --- check a read set and id list */
+  TID k;                        /* loop variable, result */
+
+  assert(tids);                 /* check the function arguments */
+  k = isb_next(isb);            /* read the next item set */
+  if (k < 0) error((int)k, isb_fname(isb));
+  if (k > 0) error(E_CHECK, "missing item set");
+  if ((isb_cnt(isb) != ((b < 0) ? 1 : 2))
+  ||  (isb_item(isb, 0) != a) || ((b >= 0) && (isb_item(isb, 1) != b))
+  ||  (isb_supp(isb) != (double)n))
+    error(E_CHECK, "wrong item set");
+  k = isb_tidnext(tid);         /* read the next trans. id list */
+  if (k < 0) error((int)k, isb_tidfname(tid));
+  if (k > 0) error(E_CHECK, "missing transaction id list");
+  if (isb_hasocc(tid)) error(E_CHECK, "unexpected item counters");
+  if (isb_tidcnt(tid) != n) error(E_CHECK, "wrong number of ids");
+  for (k = 0; k < n; k++)       /* compare the transaction ids */
+    if (isb_tid(tid, k) != tids[k])
+      error(E_CHECK, "wrong transaction id");
+}  /* check() */
+
+/*--------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{                               /* --- main function for testing */
+  ITEM i, k;                    /* loop variables for items */
+  TID  n, m;                    /* loop variables for transactions */
+  TID  tids[TRACNT];            /* buffer for transaction ids */
+  TID  desc[TRACNT];            /* ids in descending order */
+  char name[2] = "a";           /* buffer for an item name */
+
+  prgname = argv[0];            /* get program name for error msgs. */
+  ibase = ib_create(0, 0);      /* create an item base */
+  if (!ibase) error(E_NOMEM);   /* and a transaction bag */
+  tabag = tbg_create(ibase);    /* to store the transactions */
+  if (!tabag) error(E_NOMEM);
+  for (k = 0; k < ITEMCNT; k++){/* add all items to the item base, */
+    name[0] = (char)('a'+k);    /* so that the item codes are fixed */
+    if (ib_add(ibase, name) < 0) error(E_NOMEM);
+  }
+  for (n = 0; n < TRACNT; n++){ /* create transactions with items */
+    ib_clear(ibase);            /* of different frequencies */
+    for (k = 0; k < ITEMCNT; k++) {
+      if ((n *(k+1) +k) % (k+3) >= 2) continue;
+      name[0] = (char)('a'+k);  /* draw whether the item occurs */
+      if (ib_add2ta(ibase, name) < 0) error(E_NOMEM);
+    }                           /* add the item to the transaction */
+    ib_finta(ibase, 1);         /* finalize the transaction */
+    if (tbg_addib(tabag) != 0) error(E_NOMEM);
+  }                             /* add it to the transaction bag */
+
+  /* --- write transaction id lists --- */
+  report = isr_create(ibase);   /* create an item set reporter */
+  if (!report) error(E_NOMEM);  /* and configure it */
+  isr_setsupp(report, 0, RSUPP_MAX);
+  if (isr_settarg(report, ISR_ALL,
+                  ISR_NOFILTER|ISR_BINARY|ISR_TIDBIN, -1) != 0)
+    error(E_NOMEM);             /* write binary sets and id lists */
+  if (isr_tidbag(report, tabag) != 0) error(E_NOMEM);
+  n = isr_open(report, NULL, FN_SETS);
+  if (n != 0) error((int)n, FN_SETS);
+  n = isr_tidopen(report, NULL, FN_TIDS);
+  if (n != 0) error((int)n, FN_TIDS);
+  if (isr_setup(report) < 0) error(E_NOMEM);
+  for (i = 0; i < ITEMCNT; i++) {
+    n = cover(tabag, i, -1, tids);
+    for (m = 0; m < n; m++)     /* get the transaction ids */
+      desc[m] = tids[n-1-m];    /* in descending order */
+    isr_add(report, i, (RSUPP)n);
+    isr_reportx(report, desc, -n);
+    for (k = i+1; k < ITEMCNT; k++) {
+      isr_add(report, k, (RSUPP)cover(tabag, i, k, tids));
+      isr_report(report);       /* report the pairs without ids, */
+      isr_remove(report, 1);    /* so that they are collected */
+    }                           /* from the transaction bag */
+    isr_remove(report, 1);      /* report the single items */
+  }                             /* with explicit transaction ids */
+  if (isr_close   (report) != 0) error(E_FWRITE, FN_SETS);
+  if (isr_tidclose(report) != 0) error(E_FWRITE, FN_TIDS);
+  isr_delete(report, 0); report = NULL;
+
+  /* --- read item sets and transaction id lists --- */
+  isb = isb_create();           /* create an item set reader */
+  if (!isb) error(E_NOMEM);     /* and open the written file */
+  n = isb_open(isb, NULL, FN_SETS);
+  if (n != 0) error((int)n, FN_SETS);
+  tid = isb_tidcreate();        /* create a trans. id list reader */
+  if (!tid) error(E_NOMEM);     /* and open the written file */
+  n = isb_tidopen(tid, NULL, FN_TIDS);
+  if (n != 0) error((int)n, FN_TIDS);
+  for (m = i = 0; i < ITEMCNT; i++) {
+    check(i, -1, tids, cover(tabag, i, -1, tids)); m++;
+    for (k = i+1; k < ITEMCNT; k++) {
+      check(i,  k, tids, cover(tabag, i,  k, tids)); m++; }
+  }                             /* compare the sets and lists */
+  if ((isb_next(isb) != 1) || (isb_tidnext(tid) != 1))
+    error(E_CHECK, "too many item sets or id lists");
+  isb_delete(isb);    isb = NULL;  /* delete the readers, */
+  isb_tiddelete(tid); tid = NULL;  /* which closes the files, */
+  remove(FN_SETS);              /* and delete the written files */
+  remove(FN_TIDS);
+  printf("isb: ok (%"TID_FMT" item sets with id lists)\n", m);
+  CLEANUP;                      /* clean up memory */
+  SHOWMEM;                      /* show (final) memory usage */
+  return 0;                     /* return 'ok' */
+}  /* main() */
+
+#endif
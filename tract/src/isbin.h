@@ -0,0 +1,121 @@
+/*----------------------------------------------------------------------
+  File    : isbin.h
+  Contents: binary item set/association rule format and reader
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+            2026.10.16 reader for binary trans. id lists added
+            2026.10.17 readers split into create/open (error codes)
+----------------------------------------------------------------------*/
+#ifndef __ISBIN__
+#define __ISBIN__
+#include <stdio.h>
+#include <limits.h>
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define ISB_MAGIC   "ISRB"      /* magic string at start of file */
+#define ISB_VERSION 1           /* version of the binary format */
+
+/* --- format flags (in file header) --- */
+#define ISB_EVAL    0x01        /* records contain an evaluation */
+#define ISB_RULES   0x02        /* records are association rules */
+#define ISB_DBLSUPP 0x04        /* supports are stored as doubles */
+
+/* --- transaction id lists --- */
+#define ISB_TIDMAGIC   "ISRT"   /* magic string at start of file */
+#define ISB_TIDVERSION 1        /* version of the binary format */
+
+/* --- error codes --- */
+#define ISB_EFORMAT (-5)        /* invalid file format */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- binary item set reader --- */
+  FILE       *file;             /* file to read from */
+  const char *name;             /* name of the file */
+  int        flags;             /* format flags (e.g. ISB_EVAL) */
+  ITEM       icnt;              /* number of items in dictionary */
+  char       **names;           /* names of the items */
+  ITEM       size;              /* size of the item array */
+  ITEM       cnt;               /* number of items in current record */
+  ITEM       *items;            /* items of current record */
+  double     supp;              /* support of the item set */
+  double     body;              /* support of the rule body */
+  double     head;              /* support of the rule head */
+  double     eval;              /* additional evaluation */
+  size_t     reccnt;            /* number of records read */
+} ISBIN;                        /* (binary item set reader) */
+
+typedef struct {                /* --- binary trans. id list reader --- */
+  FILE       *file;             /* file to read from */
+  const char *name;             /* name of the file */
+  TID        size;              /* size of the id/counter arrays */
+  TID        cnt;               /* number of ids in current list */
+  TID        *tids;             /* transaction ids (zero-based) */
+  ITEM       *occs;             /* numbers of contained items */
+  int        hasocc;            /* whether list has item counters */
+  size_t     reccnt;            /* number of lists read */
+} ISBTID;                       /* (binary trans. id list reader) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern ISBIN*      isb_create  (void);
+extern void        isb_delete  (ISBIN *isb);
+extern int         isb_open    (ISBIN *isb, FILE *file,
+                                const char *name);
+extern int         isb_close   (ISBIN *isb);
+extern const char* isb_fname   (ISBIN *isb);
+extern int         isb_next    (ISBIN *isb);
+extern int         isb_flags   (ISBIN *isb);
+extern ITEM        isb_icnt    (ISBIN *isb);
+extern const char* isb_name    (ISBIN *isb, ITEM item);
+extern ITEM        isb_cnt     (ISBIN *isb);
+extern const ITEM* isb_items   (ISBIN *isb);
+extern ITEM        isb_item    (ISBIN *isb, ITEM index);
+extern double      isb_supp    (ISBIN *isb);
+extern double      isb_body    (ISBIN *isb);
+extern double      isb_head    (ISBIN *isb);
+extern double      isb_eval    (ISBIN *isb);
+extern size_t      isb_reccnt  (ISBIN *isb);
+
+extern ISBTID*     isb_tidcreate (void);
+extern void        isb_tiddelete (ISBTID *tid);
+extern int         isb_tidopen (ISBTID *tid, FILE *file,
+                                const char *name);
+extern int         isb_tidclose(ISBTID *tid);
+extern const char* isb_tidfname(ISBTID *tid);
+extern int         isb_tidnext (ISBTID *tid);
+extern TID         isb_tidcnt  (ISBTID *tid);
+extern const TID*  isb_tids    (ISBTID *tid);
+extern TID         isb_tid     (ISBTID *tid, TID index);
+extern int         isb_hasocc  (ISBTID *tid);
+extern ITEM        isb_occ     (ISBTID *tid, TID index);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define isb_fname(b)      ((b)->name)
+#define isb_flags(b)      ((b)->flags)
+#define isb_icnt(b)       ((b)->icnt)
+#define isb_name(b,i)     ((const char*)(b)->names[i])
+#define isb_cnt(b)        ((b)->cnt)
+#define isb_items(b)      ((const ITEM*)(b)->items)
+#define isb_item(b,i)     ((b)->items[i])
+#define isb_supp(b)       ((b)->supp)
+#define isb_body(b)       ((b)->body)
+#define isb_head(b)       ((b)->head)
+#define isb_eval(b)       ((b)->eval)
+#define isb_reccnt(b)     ((b)->reccnt)
+
+#define isb_tidfname(t)   ((t)->name)
+#define isb_tidcnt(t)     ((t)->cnt)
+#define isb_tids(t)       ((const TID*)(t)->tids)
+#define isb_tid(t,i)      ((t)->tids[i])
+#define isb_hasocc(t)     ((t)->hasocc)
+#define isb_occ(t,i)      ((t)->occs[i])
+
+#endif
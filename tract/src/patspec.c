@@ -13,6 +13,14 @@
             2014.07.25 spectrum estimation for item sequences added
             2014.10.24 treatment of non-integer support type corrected
             2016.10.05 slot counting with and without duplicate check
+            2026.10.16 parallel estimation with per-task random streams
+            2026.10.16 functions psp_reserve() and psp_merge() added
+            2026.10.16 function psp_addpsp() adds whole row ranges
+            2026.10.16 bug in psp_delete()/psp_clear() fixed (last row)
+            2026.10.16 heavy hitter sketch (Space-Saving) added
+            2026.10.17 shard merging checked in test main function
+            2026.10.17 seeded estimation checked in test main function
+            2026.10.17 heavy hitter sketch moved to module hhsketch
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -32,6 +40,9 @@
 #include "gamma.h"
 #include "random.h"
 #endif
+#ifdef USE_THREADS
+#include "threads.h"
+#endif
 #ifdef PSP_MAIN
 #include "error.h"
 #endif
@@ -68,6 +79,12 @@
 
 /*--------------------------------------------------------------------*/
 #define BLKSIZE      32         /* block size for enlarging arrays */
+#define CHUNK       256         /* number of samples per task */
+#ifndef USE_THREADS             /* if not to use threads, */
+#define THR_MAX       1         /* only use the calling thread */
+#define WORKERDEF(n,p) void* n (void *p)
+#define THREAD_OK     NULL      /* return value of a worker */
+#endif
 
 #ifdef PSP_MAIN
 /* --- error codes --- */
@@ -76,6 +93,10 @@
 #define E_OPTION     (-6)       /* unknown option */
 #define E_OPTARG     (-7)       /* missing option argument */
 #define E_ARGCNT     (-8)       /* too few/many arguments */
+#define E_CHECK      (-9)       /* consistency check failed */
+
+#define SHARDS          4       /* number of pattern spectrum shards */
+#define SEED           42       /* seed for the estimation test */
 
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
@@ -104,6 +125,49 @@ typedef struct {                /* --- point process element */
 } PPELEM;                       /* (point process element) */
 
 #endif  /* #if defined PSP_TRAIN && defined PSP_ESTIM */
+#ifndef USE_THREADS
+typedef WORKERDEF(THRWORKER, arg);  /* worker function */
+#endif
+
+typedef struct {                /* --- merge worker --- */
+  PATSPEC      *dst;            /* destination pattern spectrum */
+  PATSPEC      **shards;        /* pattern spectrum shards to merge */
+  int          cnt;             /* number of shards */
+  int          id;              /* index of first row to process */
+  int          step;            /* step width between rows */
+  size_t       sigcnt;          /* number of new signatures */
+  size_t       total;           /* sum of added frequencies */
+} PSPMERGE;                     /* (merge worker) */
+
+#ifdef PSP_ESTIM
+
+typedef struct {                /* --- estimation data --- */
+  PATSPEC      *psp;            /* pattern spectrum to fill */
+  size_t       *cnts;           /* number of slots per size */
+  const double *probs;          /* item occurrence probabilities */
+  ITEM         n;               /* number of items */
+  RSUPP        smax;            /* maximum support (coincidences) */
+  size_t       equiv;           /* equivalent number of surrogates */
+  size_t       smpls;           /* number of samples per size */
+  int          seq;             /* flag for sequence estimation */
+  unsigned int seed;            /* seed for the random streams */
+  size_t       chcnt;           /* number of chunks per size */
+  double       **res;           /* distributions per task */
+  RSUPP        *lens;           /* lengths of the distributions */
+} PSPEST;                       /* (estimation data) */
+
+typedef struct {                /* --- estimation worker --- */
+  PSPEST       *est;            /* shared estimation data */
+  int          id;              /* index of first task to process */
+  int          step;            /* step width between tasks */
+  int          err;             /* error status */
+  RNG          *rng;            /* random number generator */
+  double       *probs;          /* item probabilities (work copy) */
+  double       *dist;           /* probability distribution */
+  PATSPEC      *psp;            /* partial pattern spectrum */
+} PSPWORK;                      /* (estimation worker) */
+
+#endif  /* #ifdef PSP_ESTIM */
 /*----------------------------------------------------------------------
   Global Variables
 ----------------------------------------------------------------------*/
@@ -121,7 +185,8 @@ static CCHAR *errmsgs[] = {     /* error messages */
   /* E_OPTION   -6 */  "unknown option -%c",
   /* E_OPTARG   -7 */  "missing option argument",
   /* E_ARGCNT   -8 */  "wrong number of arguments",
-  /*            -9 */  "unknown error"
+  /* E_CHECK    -9 */  "check failed: %s",
+  /*           -10 */  "unknown error"
 };
 #endif
 
@@ -131,7 +196,13 @@ static CCHAR *errmsgs[] = {     /* error messages */
 #ifdef PSP_MAIN
 static CCHAR    *prgname;       /* program name for error messages */
 static PATSPEC  *psp    = NULL; /* pattern spectrum */
+static PATSPEC  *mrg    = NULL; /* merged pattern spectrum */
+static PATSPEC  *shards[SHARDS] = { NULL }; /* spectrum shards */
 static TABWRITE *twrite = NULL; /* table writer */
+#ifdef PSP_ESTIM
+static TABAG    *tabag  = NULL; /* transaction bag for estimation */
+static PATSPEC  *ests[2] = { NULL, NULL }; /* estimated spectra */
+#endif
 #endif
 
 /*----------------------------------------------------------------------
@@ -168,7 +239,7 @@ void psp_delete (PATSPEC *psp)
   if (psp->rows) {              /* if there are pattern spectrum rows */
     #if INTSUPP                 /* if integer support type */
     ITEM size;                  /* loop variable */
-    for (size = psp->minsize; size < psp->max; size++)
+    for (size = psp->minsize; size <= psp->max; size++)
       if (psp->rows[size].frqs) free(psp->rows[size].frqs);
     #endif                      /* delete the counter arrays */
     free(psp->rows);            /* delete the row array */
@@ -184,7 +255,7 @@ void psp_clear (PATSPEC *psp)
 
   assert(psp);                  /* check the function argument */
   if (psp->rows) {              /* if there are pattern spectrum rows */
-    for (size = psp->minsize; size < psp->max; size++) {
+    for (size = psp->minsize; size <= psp->max; size++) {
       #if INTSUPP               /* if integer support type */
       if (psp->rows[size].frqs) free(psp->rows[size].frqs);
       #endif                    /* delete the counter arrays */
@@ -217,30 +288,77 @@ size_t psp_getfrq (PATSPEC *psp, ITEM size, RSUPP supp)
 
 /*--------------------------------------------------------------------*/
 
-static int resize (PATSPEC *psp, ITEM size, RSUPP supp)
+static int addrows (PATSPEC *psp, ITEM size)
 {                               /* --- resize the row array (sizes) */
   size_t n, i;                  /* new maximum size, loop variable */
-  PSPROW *row;                  /* to access/reallocate the rows */
+  PSPROW *row;                  /* to reallocate the rows */
+
+  assert(psp && (size <= psp->maxsize));
+  if (size <= psp->max) return 0;  /* check if rows exist */
+  n = (psp->max > 0) ? (size_t)psp->max : 0;
+  n += (n > BLKSIZE) ? n >> 1 : BLKSIZE;
+  if (n < (size_t)size)         n = (size_t)size;
+  if (n > (size_t)psp->maxsize) n = (size_t)psp->maxsize;
+  row = (PSPROW*)realloc(psp->rows, (n+1) *sizeof(PSPROW));
+  if (!row) return psp->err = -1;   /* enlarge the row array */
+  for (i = (size_t)psp->max; ++i <= n; )
+    row[i] = empty;             /* initialize the new elements */
+  psp->rows = row;              /* set the new array */
+  psp->max  = (ITEM)n;          /* and its size */
+  return 0;                     /* return 'ok' */
+}  /* addrows() */
+
+/*--------------------------------------------------------------------*/
+#if INTSUPP
+
+static int fitrow (PSPROW *row, RSUPP min, RSUPP max)
+{                               /* --- fit row to a support range */
+  size_t n, k;                  /* new and old number of counters */
+  size_t *p;                    /* to reallocate the counter array */
+
+  assert(row && (min <= max));  /* check the function arguments */
+  if (row->frqs) {              /* if the row has counters, */
+    if (min > row->min) min = row->min;  /* extend the range */
+    if (max < row->max) max = row->max;  /* to the old range */
+    if ((min == row->min) && (max == row->max))
+      return 0;                 /* if the range is unchanged, abort */
+  }
+  n = (size_t)max -(size_t)min +1; /* compute the new array size */
+  p = (size_t*)realloc(row->frqs, n *sizeof(size_t));
+  if (!p) return -1;            /* enlarge the counter array */
+  if (!row->frqs)               /* if new array created */
+    memset(p, 0, n *sizeof(size_t));
+  else {                        /* if an existing array was enlarged */
+    k = (size_t)row->max -(size_t)row->min +1;
+    if (min < row->min) {       /* if enlarged at the front */
+      memmove(p +(row->min -min), p, k *sizeof(size_t));
+      memset (p, 0, (size_t)(row->min -min) *sizeof(size_t));
+    }                           /* move the existing counters */
+    if (max > row->max)         /* if enlarged at the end */
+      memset(p +(row->max -min) +1, 0,
+             (size_t)(max -row->max) *sizeof(size_t));
+  }                             /* initialize the new elements */
+  row->frqs = p;                /* set the new array */
+  row->min  = min;              /* and its range */
+  row->max  = max;
+  return 0;                     /* return 'ok' */
+}  /* fitrow() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static int resize (PATSPEC *psp, ITEM size, RSUPP supp)
+{                               /* --- resize the row array (sizes) */
+  PSPROW *row;                  /* to access the rows */
   #if INTSUPP                   /* if integer support type */
   RSUPP  min, max;              /* new minimum and maximum support */
-  size_t *p;                    /* to reallocate the counter array */
   #endif
 
   assert(psp                    /* check the function arguments */
   &&    (size >= psp->minsize) && (size <= psp->maxsize)
   &&    (supp >= psp->minsupp) && (supp <= psp->maxsupp));
-  if (size > psp->max) {        /* if outside of size range */
-    n = (psp->max > 0) ? (size_t)psp->max : 0;
-    n += (n > BLKSIZE) ? n >> 1 : BLKSIZE;
-    if (n < (size_t)size)         n = (size_t)size;
-    if (n > (size_t)psp->maxsize) n = (size_t)psp->maxsize;
-    row = (PSPROW*)realloc(psp->rows, (n+1) *sizeof(PSPROW));
-    if (!row) return psp->err = -1;   /* enlarge the row array */
-    for (i = (size_t)psp->max; ++i <= n; )
-      row[i] = empty;           /* initialize the new elements */
-    psp->rows = row;            /* set the new array */
-    psp->max  = (ITEM)n;        /* and its size */
-  }
+  if (addrows(psp, size) != 0)  /* if outside of size range, */
+    return psp->err = -1;       /* enlarge the row array */
   row = psp->rows +size;        /* get the indexed row */
   #if INTSUPP                   /* if integer support type */
   if ((supp >= row->min) && (supp <= row->max))
@@ -256,22 +374,8 @@ static int resize (PATSPEC *psp, ITEM size, RSUPP supp)
   else                               max = supp;
   if (max > psp->maxsupp)            max = psp->maxsupp;
   if (size <= 0) min = max = supp; /* only one counter for size = 0 */
-  n = (size_t)max -(size_t)min +1; /* compute the new array size */
-  p = (size_t*)realloc(row->frqs, n *sizeof(size_t));
-  if (!p) return psp->err = -1; /* enlarge the counter array */
-  if      (!row->frqs)          /* if new array created */
-    memset(p, 0, n *sizeof(size_t));
-  else if (supp > row->max) {   /* if enlarged at the end */
-    n = (size_t)row->max -(size_t)row->min +1;
-    memset(p +n, 0, (size_t)(max -row->max) *sizeof(size_t)); }
-  else if (supp < row->min) {   /* if enlarged at the front */
-    n = (size_t)(row->max -row->min +1);
-    memmove(p +(row->min -min), p, n *sizeof(size_t));
-    memset (p, 0, (size_t)(row->min -min) *sizeof(size_t));
-  }                             /* move the existing counters, */
-  row->frqs = p;                /* initialize the new elements */
-  row->min  = min;              /* and set the new array */
-  row->max  = max;              /* and its range */
+  if (fitrow(row, min, max) != 0)  /* enlarge the counter array */
+    return psp->err = -1;
   #else                         /* if double support type */
   if (supp < row->min) row->min = supp;
   if (supp > row->max) row->max = supp;
@@ -281,6 +385,27 @@ static int resize (PATSPEC *psp, ITEM size, RSUPP supp)
 
 /*--------------------------------------------------------------------*/
 
+int psp_reserve (PATSPEC *psp, ITEM size, RSUPP supp)
+{                               /* --- preallocate a dense grid */
+  assert(psp);                  /* check the function arguments */
+  if (size > psp->maxsize) size = psp->maxsize;
+  if (supp > psp->maxsupp) supp = psp->maxsupp;
+  if ((size < psp->minsize) || (supp < psp->minsupp))
+    return 0;                   /* check for a non-empty grid */
+  if (addrows(psp, size) != 0)  /* create all rows up to size */
+    return psp->err = -1;       /* (sizes minsize to size) */
+  #if INTSUPP                   /* if integer support type */
+  { ITEM z;                     /* loop variable for sizes */
+    for (z = psp->minsize; z <= size; z++)
+      if (fitrow(psp->rows +z, psp->minsupp, supp) != 0)
+        return psp->err = -1;   /* create all counters */
+  }                             /* (supports minsupp to supp) */
+  #endif
+  return 0;                     /* return 'ok' */
+}  /* psp_reserve() */
+
+/*--------------------------------------------------------------------*/
+
 int psp_setfrq (PATSPEC *psp, ITEM size, RSUPP supp, size_t frq)
 {                               /* --- set a counter value */
   PSPROW *row;                  /* to access the table row */
@@ -340,23 +465,62 @@ int psp_incfrq (PATSPEC *psp, ITEM size, RSUPP supp, size_t frq)
 
 /*--------------------------------------------------------------------*/
 
+#if INTSUPP
+
+static size_t addrow (PSPROW *dst, PSPROW *src, RSUPP min, RSUPP max,
+                      size_t *sigcnt)
+{                               /* --- add a row range to another */
+  size_t *d;                    /* to traverse the destination */
+  size_t frq;                   /* (size,supp) signature frequency */
+  size_t sum = 0;               /* sum of added frequencies */
+  RSUPP  supp;                  /* loop variable for supports */
+
+  assert(dst && src             /* check the function arguments */
+  &&    (min >= dst->min) && (max <= dst->max));
+  if (!src->frqs) return 0;     /* if no counters exist, abort */
+  if (min < src->min) min = src->min;
+  if (max > src->cur) max = src->cur;
+  d = dst->frqs -dst->min;      /* get the destination counters */
+  for (supp = min; supp <= max; supp++) {
+    if ((frq = src->frqs[supp -src->min]) <= 0) continue;
+    if (d[supp] <= 0) *sigcnt += 1;  /* count new signatures */
+    d[supp] += frq; sum += frq; /* add the signature frequency */
+    if (supp > dst->cur) dst->cur = supp;
+  }                             /* update the maximum support */
+  dst->sum += sum;              /* update the sum for the size */
+  return sum;                   /* return the sum of frequencies */
+}  /* addrow() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
 int psp_addpsp (PATSPEC *dst, PATSPEC *src)
 {                               /* --- add a spectrum to another */
   PSPROW *row;                  /* to traverse the rows (sizes) */
   ITEM   size;                  /* loop variable for sizes */
   #if INTSUPP
-  SUPP   supp;                  /* loop variable for supports */
-  size_t frq;                   /* (size,supp) signature frequency */
+  RSUPP  min, max;              /* support range of a row */
+  size_t sum;                   /* sum of added frequencies */
   #endif
 
   assert(dst && src);           /* check the function arguments */
-  for (size = src->minsize; size <= src->max; size++) {
+  for (size = src->minsize; size <= src->cur; size++) {
+    if ((size < dst->minsize) || (size > dst->maxsize))
+      continue;                 /* skip sizes outside of range */
     row = src->rows +size;      /* traverse the rows (sizes) */
     #if INTSUPP                 /* if integer support type */
     if (!row->frqs) continue;   /* if no counters exist, skip row */
-    for (supp = row->min; supp <= row->max; supp++)
-      if ((frq = row->frqs[supp-row->min]) > 0)
-        psp_incfrq(dst, size, supp, frq);
+    min = (row->min > dst->minsupp) ? row->min : dst->minsupp;
+    max = (row->cur < dst->maxsupp) ? row->cur : dst->maxsupp;
+    while ((min <= max) && (row->frqs[min -row->min] <= 0)) min++;
+    while ((min <= max) && (row->frqs[max -row->min] <= 0)) max--;
+    if (min > max) continue;    /* get range of non-zero counters */
+    if ((addrows(dst, size) != 0)
+    ||  (fitrow(dst->rows +size, min, max) != 0))
+      return dst->err = -1;     /* enlarge table if necessary */
+    sum = addrow(dst->rows +size, row, min, max, &dst->sigcnt);
+    dst->total += sum;          /* add the row range and */
+    if (size > dst->cur) dst->cur = size;  /* update the totals */
     #else                       /* if double support type */
     if (row->max < row->min) continue;
     if (resize(dst, size, row->min) < 0)
@@ -367,6 +531,118 @@ int psp_addpsp (PATSPEC *dst, PATSPEC *src)
   return dst->err;              /* return the error status */
 }  /* psp_addpsp() */
 
+/*--------------------------------------------------------------------*/
+#if INTSUPP || defined PSP_ESTIM
+
+static int runall (THRWORKER *fn, void *args, size_t size, int cnt)
+{                               /* --- run workers (threads) */
+  #ifdef USE_THREADS            /* if to use threads */
+  return thr_run(fn, args, size, cnt);
+  #else                         /* if not to use threads, */
+  int i;                        /* loop variable */
+  for (i = 0; i < cnt; i++)     /* run the workers sequentially */
+    fn((char*)args +(size_t)i *size);
+  return 0;                     /* return 'ok' */
+  #endif
+}  /* runall() */
+
+#endif  /* #if INTSUPP || defined PSP_ESTIM */
+/*--------------------------------------------------------------------*/
+#if INTSUPP
+
+static WORKERDEF(merge, p)
+{                               /* --- merge rows of shards */
+  PSPMERGE *w = (PSPMERGE*)p;   /* type the worker data */
+  PATSPEC  *dst = w->dst;       /* destination pattern spectrum */
+  PSPROW   *row;                /* destination row */
+  ITEM     size;                /* loop variable for sizes */
+  int      i;                   /* loop variable for shards */
+
+  for (size = dst->minsize +w->id; size <= dst->max; size += w->step) {
+    row = dst->rows +size;      /* traverse the rows of the worker */
+    if (!row->frqs) continue;   /* (only rows with counters) */
+    for (i = 0; i < w->cnt; i++)/* add the rows of the shards */
+      if (size <= w->shards[i]->cur)
+        w->total += addrow(row, w->shards[i]->rows +size,
+                           row->min, row->max, &w->sigcnt);
+  }                             /* (each row is processed */
+  return THREAD_OK;             /* by exactly one worker) */
+}  /* merge() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+int psp_merge (PATSPEC *dst, PATSPEC **shards, int cnt, int thcnt)
+{                               /* --- merge pattern spectrum shards */
+  int      i;                   /* loop variable for shards */
+  #if INTSUPP                   /* if integer support type */
+  ITEM     size, z;             /* loop variable for sizes */
+  RSUPP    min, max;            /* support range of a row */
+  PSPROW   *row;                /* to traverse the shard rows */
+  PSPMERGE w[THR_MAX];          /* data of the merge workers */
+
+  assert(dst && (shards || (cnt <= 0)));
+  for (z = dst->minsize-1, i = 0; i < cnt; i++)
+    if (shards[i]->cur > z) z = shards[i]->cur;
+  if (z > dst->maxsize) z = dst->maxsize;
+  if (z < dst->minsize) return dst->err;
+  if (addrows(dst, z) != 0)     /* get the maximum size and */
+    return dst->err = -1;       /* create the needed rows */
+  for (size = dst->minsize; size <= z; size++) {
+    min = RSUPP_MAX; max = RSUPP_MIN;
+    for (i = 0; i < cnt; i++) { /* traverse the shards */
+      if (size > shards[i]->cur) continue;
+      row = shards[i]->rows +size;
+      if (!row->frqs) continue; /* skip shards without counters */
+      if (row->min < min) min = row->min;
+      if (row->cur > max) max = row->cur;
+    }                           /* get the union of the ranges */
+    if (min < dst->minsupp) min = dst->minsupp;
+    if (max > dst->maxsupp) max = dst->maxsupp;
+    if ((min <= max) && (fitrow(dst->rows +size, min, max) != 0))
+      return dst->err = -1;     /* enlarge the destination rows */
+  }                             /* (single-threaded, so that the */
+  #ifdef USE_THREADS            /*  workers need not allocate) */
+  if (thcnt <= 0) thcnt = thr_cnt();
+  #endif                        /* (use all processors by default) */
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  if (thcnt > (int)(z -dst->minsize +1)) thcnt = (int)(z -dst->minsize +1);
+  if (thcnt < 1)       thcnt = 1;  /* clamp the number of threads */
+  for (i = 0; i < thcnt; i++) { /* initialize the workers */
+    w[i].dst = dst; w[i].shards = shards; w[i].cnt = cnt;
+    w[i].id  = i;   w[i].step   = thcnt;
+    w[i].sigcnt = w[i].total = 0;
+  }                             /* merge the rows in parallel */
+  if (runall(merge, w, sizeof(PSPMERGE), thcnt) != 0)
+    return dst->err = -1;       /* (no locks needed, since each */
+  for (i = 0; i < thcnt; i++) { /*  row has exactly one writer) */
+    dst->sigcnt += w[i].sigcnt; /* sum the signature counters */
+    dst->total  += w[i].total;  /* and the total frequencies */
+  }                             /* of the workers */
+  for (size = z; size >= dst->minsize; size--)
+    if (dst->rows[size].sum > 0) break;
+  if (size > dst->cur) dst->cur = size;
+  #else                         /* if double support type */
+  assert(dst && (shards || (cnt <= 0)));
+  for (i = 0; i < cnt; i++)     /* simply add the shards */
+    if (psp_addpsp(dst, shards[i]) != 0) break;
+  #endif
+  return dst->err;              /* return the error status */
+}  /* psp_merge() */
+
+/*----------------------------------------------------------------------
+Pattern spectrum shards (e.g. one per thread, attached to per-thread
+item set reporters with isr_addpsp()) are filled without any locking
+and merged at the end of a run with psp_merge(). The merge first
+creates all needed rows and counters of the destination (the union of
+the support ranges of the shards), so that the rows can then be merged
+in parallel without locks: each row is processed by exactly one worker
+and the signature counters and totals are summed per worker. If the
+bounds of a spectrum are known in advance, psp_reserve() allocates
+the full grid of counters at once, so that no reallocation is needed
+while the spectrum is filled.
+----------------------------------------------------------------------*/
+
 /*--------------------------------------------------------------------*/
 #ifdef PSP_ESTIM                /* if estimation from a train set */
 
@@ -401,7 +677,26 @@ static double dchoose (ITEM n, ITEM k)
 
 /*--------------------------------------------------------------------*/
 
-static double samplelp (double *probs, ITEM n, ITEM k)
+static void dblsel (double *array, size_t n, size_t k, RNG *rng)
+{                               /* --- select random array entries */
+  size_t i;                     /* array index */
+  double t;                     /* exchange buffer */
+
+  assert(array && (n >= k));    /* check the function arguments */
+  k = (k < n) ? k+1 : n;        /* adapt the number of selections */
+  while (--k > 0) {             /* shuffle loop (k selections) */
+    i = (size_t)(rng_dbl(rng) *(double)n);  /* get a random index */
+    if (i > --n) i = n;         /* and exchange the array elements */
+    t = array[i]; array[i] = *array; *array++ = t;
+  }
+}  /* dblsel() */
+
+/*--------------------------------------------------------------------*/
+/* Same as dbl_select() from arrays.c, but with a generator object,   */
+/* so that each task can draw from its own random number stream.      */
+/*--------------------------------------------------------------------*/
+
+static double samplelp (double *probs, ITEM n, ITEM k, RNG *rng)
 {                               /* --- get log. prob. of item sample */
   int    i;                     /* loop variable */
   ITEM   l;                     /* loop variable */
@@ -411,7 +706,7 @@ static double samplelp (double *probs, ITEM n, ITEM k)
   assert(probs);                /* check the function arguments */
   if (k <= 0) return 0.0;       /* check for an empty sample */
   if (k >  n) k = n;            /* ensure that sampling is possible */
-  dbl_select(probs, (size_t)n, (size_t)k, drand);
+  dblsel(probs, (size_t)n, (size_t)k, rng);
   if (k <= 1) return log(probs[0]);
   if (k <= 2) {                 /* handle trivial cases directly */
     p1 = probs[0]; p2 = probs[1]; p = p1*p2;
@@ -445,7 +740,7 @@ static double samplelp (double *probs, ITEM n, ITEM k)
   p = 0.0;                      /* initialize average probability */
   for (i = 0; i < 8; i++) {     /* draw 8/16 samples (permutations) */
     if (i <= 0) dbl_qsort  (probs, (size_t)k, +1);
-    else        dbl_shuffle(probs, (size_t)k, drand);
+    else        dblsel(probs, (size_t)k, (size_t)k-1, rng);
     t = r = 1.0;                /* init. the probabilities */
     for (l = 0; l < k; l++) { t *= n *probs[l] /r; r -= probs[l]; }
     p += t;                     /* sum the permutation probability */
@@ -666,59 +961,206 @@ static int simpest (PATSPEC *psp, size_t *cnts, ITEM n,
 
 /*--------------------------------------------------------------------*/
 
-static int cplxest (PATSPEC *psp, size_t *cnts, double *probs, ITEM n,
-                    RSUPP smax, size_t equiv, size_t smpls, int seq)
-{                               /* --- complex est. (diff. probs.) */
-  ITEM   z;                     /* loop variable, number of items */
-  RSUPP  c, s;                  /* loop variables (coin./support) */
-  size_t i;                     /* loop variable (samples) */
-  size_t frq;                   /* frequency of a signature */
-  double *dist;                 /* probability distribution */
-  double t, l, x, y, q;         /* buffers for various purposes */
+static unsigned int mixseed (unsigned int seed, unsigned int i)
+{                               /* --- derive seed for a task */
+  seed += (i+1) *0x9e3779b9u;   /* add a multiple of golden ratio */
+  seed ^= seed >> 16; seed *= 0x85ebca6bu;
+  seed ^= seed >> 13; seed *= 0xc2b2ae35u;
+  seed ^= seed >> 16;           /* mix the bits (hash finalizer) */
+  return seed;                  /* return the derived seed */
+}  /* mixseed() */
 
-  assert(psp && cnts && probs   /* check the function arguments */
-  &&    (n > 0) && (smax > 0) && (equiv > 0) && (smpls > 0));
-  dist = probs +n;              /* get probability distribution */
-  s    = smax+1;                /* clear fully on first loop */
-  for (z = psp->minsize; z < n; z++) { /* traverse pattern sizes */
-    if (cnts[z] <= 0) continue; /* if there are no slots, skip size */
-    memset(dist, 0, (size_t)s *sizeof(double));
+/*--------------------------------------------------------------------*/
+
+static WORKERDEF(sample, p)
+{                               /* --- draw samples for some tasks */
+  PSPWORK *w = (PSPWORK*)p;     /* type the worker data */
+  PSPEST  *e = w->est;          /* get the estimation data */
+  ITEM    z;                    /* number of items (set size) */
+  RSUPP   c, s = e->smax+1;     /* loop variables (coin./support) */
+  size_t  t, i, k;              /* task index, loop variable, chunk */
+  size_t  m;                    /* number of samples of a chunk */
+  double  l, x, y, q, thr;      /* buffers for various purposes */
+
+  for (t = (size_t)w->id; t < (size_t)(e->n-e->psp->minsize) *e->chcnt;
+       t += (size_t)w->step) {  /* traverse the tasks of the worker */
+    z = e->psp->minsize +(ITEM)(t /e->chcnt);
+    if (e->cnts[z] <= 0) continue;    /* skip sizes without slots */
+    k = t % e->chcnt;           /* get the chunk index and */
+    m = e->smpls -k *CHUNK;     /* the number of samples in it */
+    if (m > CHUNK) m = CHUNK;
+    memcpy(w->probs, e->probs, (size_t)e->n *sizeof(double));
+    rng_seed(w->rng, mixseed(e->seed, (unsigned int)t));
+    memset(w->dist, 0, (size_t)s *sizeof(double));
     s = 0;                      /* clear distrib. and get threshold */
-    q = (seq) ? logGamma(z+1) : 0;
-    y = logGamma(n+1) -q -logGamma(n-z+1);
-    t = -log((double)equiv) -y -9;   /* compute threshold for dist. */
-    for (i = 0; i < smpls; i++){/* draw a certain number of samples */
-      l = log((double)cnts[z]) +samplelp(probs, n, z) -q;
-      x = -exp(l);              /* compute distribution parameter */
-      dist[0] += exp(x);        /* store for distribution value */
-      for (c = 1; c <= smax; c++) {
+    q = (e->seq) ? logGamma(z+1) : 0;
+    y = logGamma(e->n+1) -q -logGamma(e->n-z+1);
+    thr = -log((double)e->equiv) -y -9;  /* threshold for dist. */
+    for (i = 0; i < m; i++) {   /* draw the samples of the chunk */
+      l = log((double)e->cnts[z]) +samplelp(w->probs, e->n, z, w->rng)
+        -q;                     /* compute distribution parameter */
+      x = -exp(l);              /* and start of Poisson distribution */
+      w->dist[0] += exp(x);     /* store for distribution value */
+      for (c = 1; c <= e->smax; c++) {
         x += y = l -log((double)c);  /* traverse the coincidences */
-        if      (x >= t) dist[(size_t)c] += exp(x);
+        if      (x >= thr) w->dist[(size_t)c] += exp(x);
         else if (y <= 0) break; /* compute next distribution value */
       }                         /* update probability distribution */
       if (c > s) s = c;         /* update maximum coincidence count */
     }                           /* (for clearing the distribution) */
-    x = dchoose(n,z) /(double)smpls;
+    e->res[t] = (double*)malloc((size_t)s *sizeof(double));
+    if (!e->res[t]) { w->err = -1; break; }
+    memcpy(e->res[t], w->dist, (size_t)s *sizeof(double));
+    e->lens[t] = s;             /* store the chunk distribution */
+  }
+  return THREAD_OK;             /* return a dummy result */
+}  /* sample() */
+
+/*--------------------------------------------------------------------*/
+
+static WORKERDEF(collect, p)
+{                               /* --- combine chunk distributions */
+  PSPWORK *w = (PSPWORK*)p;     /* type the worker data */
+  PSPEST  *e = w->est;          /* get the estimation data */
+  ITEM    z;                    /* loop variable (set size) */
+  RSUPP   c, s;                 /* loop variables (coin./support) */
+  size_t  t, k;                 /* task index, loop variable */
+  size_t  frq;                  /* frequency of a signature */
+  double  x, y;                 /* buffers for various purposes */
+
+  for (z = e->psp->minsize +w->id; z < e->n; z += w->step) {
+    if (e->cnts[z] <= 0) continue;    /* skip sizes without slots */
+    t = (size_t)(z -e->psp->minsize) *e->chcnt;
+    memset(w->dist, 0, ((size_t)e->smax+1) *sizeof(double));
+    for (s = 0, k = 0; k < e->chcnt; k++) {
+      if (e->lens[t+k] > s) s = e->lens[t+k];
+      for (c = 0; c < e->lens[t+k]; c++)
+        w->dist[(size_t)c] += e->res[t+k][(size_t)c];
+    }                           /* sum the chunks in a fixed order */
+    x = dchoose(e->n,z) /(double)e->smpls;
     y = 0.0;                    /* compute the scaling factor */
     for (c = 0; c < s; c++) {   /* traverse the distribution */
-      dist[(size_t)c] *= x;     /* scale probability distribution */
-      y += (double)c *dist[(size_t)c]; /* sum the covered slots */
-    }                                  /* (for normalization) */
-    x = (y > 0) ? (double)cnts[z] /y : 1.0;
-    for (c = psp->minsupp; c < s; c++) {
-      dist[(size_t)c] *= x;     /* normalize the number of slots */
-      frq = (size_t)(dist[(size_t)c] *(double)equiv +0.5);
+      w->dist[(size_t)c] *= x;  /* scale probability distribution */
+      y += (double)c *w->dist[(size_t)c]; /* sum the covered slots */
+    }                                     /* (for normalization) */
+    x = (y > 0) ? (double)e->cnts[z] /y : 1.0;
+    for (c = e->psp->minsupp; c < s; c++) {
+      w->dist[(size_t)c] *= x;  /* normalize the number of slots */
+      frq = (size_t)(w->dist[(size_t)c] *(double)e->equiv +0.5);
       if (frq <= 0) continue;   /* compute equivalent frequency */
-      if (psp_incfrq(psp, z, c, frq) != 0) return -1;
+      if (psp_incfrq(w->psp, z, c, frq) != 0) {
+        w->err = -1; return THREAD_OK; }
     }                           /* add computed signature frequency */
-  }                             /* to the pattern spectrum */
+  }                             /* to the partial pattern spectrum */
+  return THREAD_OK;             /* return a dummy result */
+}  /* collect() */
+
+/*--------------------------------------------------------------------*/
+
+static int runchk (THRWORKER *fn, PSPWORK *w, int cnt)
+{                               /* --- run workers and check them */
+  int i;                        /* loop variable */
+
+  if (runall(fn, w, sizeof(PSPWORK), cnt) != 0) return -1;
+  for (i = 0; i < cnt; i++)     /* check the workers */
+    if (w[i].err) return -1;    /* for an error */
   return 0;                     /* return 'ok' */
+}  /* runchk() */
+
+/*--------------------------------------------------------------------*/
+
+static int cplxest (PATSPEC *psp, size_t *cnts, double *probs, ITEM n,
+                    RSUPP smax, size_t equiv, size_t smpls, int seq,
+                    unsigned int seed, int thcnt)
+{                               /* --- complex est. (diff. probs.) */
+  int     i, r = 0;             /* loop variable, error status */
+  size_t  t, k;                 /* number of tasks, loop variable */
+  PSPEST  e;                    /* estimation data */
+  PSPWORK w[THR_MAX];           /* data of the worker threads */
+  PATSPEC *shards[THR_MAX];     /* partial pattern spectra */
+
+  assert(psp && cnts && probs   /* check the function arguments */
+  &&    (n > 0) && (smax > 0) && (equiv > 0) && (smpls > 0));
+  if (psp->minsize >= n) return 0;  /* check for sizes to estimate */
+  e.psp   = psp;   e.cnts  = cnts;  e.probs = probs; e.n = n;
+  e.smax  = smax;  e.equiv = equiv; e.smpls = smpls; e.seq = seq;
+  e.seed  = seed;  e.chcnt = (smpls +CHUNK-1) /CHUNK;
+  t = (size_t)(n -psp->minsize) *e.chcnt;
+  e.res   = (double**)calloc(t, sizeof(double*));
+  e.lens  = (RSUPP*)  calloc(t, sizeof(RSUPP));
+  if (!e.res || !e.lens) {      /* allocate the task result arrays */
+    if (e.res) free(e.res);
+    return -1;                  /* on failure delete */
+  }                             /* the partial result arrays */
+  #ifdef USE_THREADS            /* if to use threads */
+  if (thcnt <= 0) thcnt = thr_cnt();
+  #endif                        /* (use all processors by default) */
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  if ((size_t)thcnt > t) thcnt = (int)t;
+  if (thcnt < 1)       thcnt = 1;  /* clamp the number of threads */
+  memset(w, 0, (size_t)thcnt *sizeof(PSPWORK));
+  for (i = 0; i < thcnt; i++) { /* initialize the workers */
+    w[i].est   = &e; w[i].id = i; w[i].step = thcnt;
+    w[i].rng   = rng_create(seed);
+    w[i].probs = (double*)malloc(((size_t)n +(size_t)smax +1)
+                                 *sizeof(double));
+    w[i].psp   = psp_create(psp->minsize, psp->maxsize,
+                            psp->minsupp, psp->maxsupp);
+    if (!w[i].rng || !w[i].probs || !w[i].psp) { r = -1; break; }
+    w[i].dist  = w[i].probs +n; /* create a random number generator, */
+  }                             /* work memory and partial spectrum */
+  if (r == 0) r = runchk(sample,  w, thcnt);  /* draw the samples */
+  if (r == 0) r = runchk(collect, w, thcnt);  /* and combine them */
+  if (r == 0) {                 /* if no error occurred, */
+    for (i = 0; i < thcnt; i++) /* merge the partial spectra */
+      shards[i] = w[i].psp;     /* (one shard per worker) */
+    if (psp_merge(psp, shards, thcnt, thcnt) != 0) r = -1;
+  }
+  for (i = 0; i < thcnt; i++) { /* traverse the workers */
+    if (w[i].psp)   psp_delete(w[i].psp);
+    if (w[i].probs) free(w[i].probs);
+    if (w[i].rng)   rng_delete(w[i].rng);
+  }
+  for (k = 0; k < t; k++)       /* delete the chunk distributions */
+    if (e.res[k]) free(e.res[k]);
+  free(e.lens); free(e.res);    /* delete the task result arrays */
+  return r;                     /* return the error status */
 }  /* cplxest() */
 
+/*----------------------------------------------------------------------
+The samples for each item set size are split into chunks of CHUNK
+samples, each of which is a task with its own random number stream
+(seeded from the seed and the task index only) and its own copy of the
+item probabilities. The tasks are distributed over the worker threads,
+the chunk distributions of each size are summed in a fixed order, and
+each worker adds the signature frequencies of its sizes to a partial
+pattern spectrum, which are finally merged with psp_merge(). Hence
+the result depends only on the seed, not on the number of threads.
+----------------------------------------------------------------------*/
+
 /*--------------------------------------------------------------------*/
 
 int psp_tbgest (TABAG *tabag, PATSPEC *psp, size_t equiv,
                 double alpha, size_t smpls)
+{                               /* --- estimate a pattern spectrum */
+  return psp_tbgestx(tabag, psp, equiv, alpha, smpls, urand(), 0);
+}  /* psp_tbgest() */           /* (derive seed from global stream) */
+
+/*----------------------------------------------------------------------
+psp_tbgest() and psp_tnsest() take the seed for the random streams
+from the global random number generator (urand(), see random.h), as
+the former single-threaded versions drew their samples from it. Hence
+their results are reproducible only if the caller seeds this generator
+with rseed() beforehand; otherwise, use psp_tbgestx()/psp_tnsestx()
+with an explicit seed. In either case the result does not depend on
+the number of threads.
+----------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+
+int psp_tbgestx (TABAG *tabag, PATSPEC *psp, size_t equiv,
+                 double alpha, size_t smpls,
+                 unsigned int seed, int thcnt)
 {                               /* --- estimate a pattern spectrum */
   int      r;                   /* result of function call */
   ITEM     z, n;                /* loop variable, number of items */
@@ -749,16 +1191,26 @@ int psp_tbgest (TABAG *tabag, PATSPEC *psp, size_t equiv,
     for (z = 0; z < n; z++)     /* and multiply deviation with alpha */
       probs[z] = (probs[z]-x) *alpha +x;
   }                             /* estimate the pattern spectrum */
-  r = cplxest(psp, cnts, probs, n, smax, equiv, smpls, 0);
+  r = cplxest(psp, cnts, probs, n, smax, equiv, smpls, 0, seed, thcnt);
   free(probs); free(cnts);      /* delete the working memory */
   return r;                     /* return the error status */
-}  /* psp_tbgest() */
+}  /* psp_tbgestx() */
 
 /*--------------------------------------------------------------------*/
 #ifdef PSP_TRAIN
 
 int psp_tnsest (TRAINSET *tns, PATSPEC *psp, size_t equiv,
                 double width, double alpha, size_t smpls, int target)
+{                               /* --- estimate a pattern spectrum */
+  return psp_tnsestx(tns, psp, equiv, width, alpha, smpls, target,
+                     urand(), 0);
+}  /* psp_tnsest() */           /* (derive seed from global stream) */
+
+/*--------------------------------------------------------------------*/
+
+int psp_tnsestx (TRAINSET *tns, PATSPEC *psp, size_t equiv,
+                 double width, double alpha, size_t smpls, int target,
+                 unsigned int seed, int thcnt)
 {                               /* --- estimate a pattern spectrum */
   int    r;                     /* result of function call */
   ITEM   z, n;                  /* loop variable, number of items */
@@ -789,10 +1241,10 @@ int psp_tnsest (TRAINSET *tns, PATSPEC *psp, size_t equiv,
       probs[z] = (probs[z]-x) *alpha +x;
   }                             /* estimate the pattern spectrum */
   r = cplxest(psp, cnts, probs, n, smax, equiv, smpls,
-              (target > PSP_ITEMSET));
+              (target > PSP_ITEMSET), seed, thcnt);
   free(probs); free(cnts);      /* delete the working memory */
   return r;                     /* return the error status */
-}  /* psp_tnsest() */
+}  /* psp_tnsestx() */
 
 #endif  /* #ifdef PSP_TRAIN */
 #endif  /* #ifdef PSP_ESTIM */
@@ -873,9 +1325,21 @@ void psp_show (PATSPEC *psp)
 #ifdef PSP_MAIN
 
 #ifndef NDEBUG                  /* if debug version */
+  #ifdef PSP_ESTIM              /* clean up estimation test data */
+  #define ESTCLEAN \
+  if (ests[0]) psp_delete(ests[0]); \
+  if (ests[1]) psp_delete(ests[1]); \
+  if (tabag)   tbg_delete(tabag, 1);
+  #else
+  #define ESTCLEAN
+  #endif
   #undef  CLEANUP               /* clean up memory and close files */
   #define CLEANUP \
   if (twrite) twr_delete(twrite, 1); \
+  { int k; for (k = 0; k < SHARDS; k++) \
+      if (shards[k]) psp_delete(shards[k]); } \
+  if (mrg)    psp_delete(mrg); \
+  ESTCLEAN \
   if (psp)    psp_delete(psp);
 #endif
 
@@ -883,15 +1347,44 @@ GENERROR(error, exit)           /* generic error reporting function */
 
 /*--------------------------------------------------------------------*/
 
+static int pspcmp (PATSPEC *a, PATSPEC *b)
+{                               /* --- compare two pattern spectra */
+  ITEM  size;                   /* loop variable for sizes */
+  RSUPP supp;                   /* loop variable for support values */
+
+  assert(a && b);               /* check the function arguments */
+  if ((psp_sigcnt(a) != psp_sigcnt(b))
+  ||  (psp_total (a) != psp_total (b))
+  ||  (psp_max   (a) != psp_max   (b)))
+    return -1;                  /* compare the global counters */
+  for (size = psp_minsize(a); size <= psp_maxsize(a); size++)
+    for (supp = psp_minsupp(a); supp <= psp_maxsupp(a); supp++)
+      if (psp_getfrq(a, size, supp) != psp_getfrq(b, size, supp))
+        return -1;              /* compare the signature frequencies */
+  return 0;                     /* return 'equal' */
+}  /* pspcmp() */
+
+/*--------------------------------------------------------------------*/
+
 int main (int argc, char *argv[])
 {                               /* --- main function for testing */
   int    i;                     /* loop variable */
   size_t equiv = 1;             /* equivalent number of surrogates */
   ITEM   size;                  /* size    of a signature */
   RSUPP  supp;                  /* support of a signature */
+  #ifdef PSP_ESTIM              /* if to test the estimation */
+  int      k;                   /* loop variable for items */
+  ITEMBASE *base;               /* underlying item base */
+  char     name[2] = "a";       /* buffer for an item name */
+  #endif
 
+  prgname = argv[0];            /* get program name for error msgs. */
   psp = psp_create(2, 12, 2, 12);
   if (!psp) error(E_NOMEM);     /* create a pattern spectrum */
+  for (i = 0; i < SHARDS; i++) {/* and the spectrum shards */
+    shards[i] = psp_create(2, 12, 2, 12);
+    if (!shards[i]) error(E_NOMEM);
+  }
   for (i = 0; i < 10000; i++) { /* create some random signatures */
     size = (ITEM) (16 *(double)rand()/((double)RAND_MAX +1));
     supp = (RSUPP)(16 *(double)rand()/((double)RAND_MAX +1));
@@ -899,6 +1392,7 @@ int main (int argc, char *argv[])
     printf("%d: (%"ITEM_FMT",%"RSUPP_FMT")\n", i, size, supp);
     #endif
     psp_incfrq(psp, size, supp, 1);
+    psp_incfrq(shards[i % SHARDS], size, supp, 1);
   }                             /* register each signature */
   twrite = twr_create();        /* create a table writer and */
   if (!twrite) error(E_NOMEM);  /* configure the characters */
@@ -910,6 +1404,55 @@ int main (int argc, char *argv[])
   twrite = NULL;                /* and delete the table writer */
   printf("sigcnt: %"SIZE_FMT"\n", psp_sigcnt(psp));
   printf("total:  %"SIZE_FMT"\n", psp_total(psp));
+
+  /* --- merge the shards --- */
+  mrg = psp_create(2, 12, 2, 12);
+  if (!mrg) error(E_NOMEM);     /* create a destination spectrum */
+  if (psp_reserve(mrg, 6, 6) != 0) error(E_NOMEM);
+  if (psp_merge(mrg, shards, SHARDS, 2) != 0) error(E_NOMEM);
+  if (pspcmp(mrg, psp) != 0)    /* merge the shards (partly into */
+    error(E_CHECK, "merged shards differ from single pass");
+  printf("merge:  ok\n");      /* preallocated counters) and */
+                                /* compare the result to the */
+  #ifdef PSP_ESTIM              /* single pass pattern spectrum */
+  /* --- estimate spectra --- */
+  base = ib_create(0, 0);       /* create an item base and */
+  if (!base) error(E_NOMEM);    /* a transaction bag for it */
+  tabag = tbg_create(base);     /* (the bag takes over the base) */
+  if (!tabag) { ib_delete(base); error(E_NOMEM); }
+  rseed(SEED);                  /* create random transactions */
+  for (i = 0; i < 1000; i++) {  /* with skewed item frequencies */
+    ib_clear(base);
+    for (k = 0; k < 16; k++) {  /* traverse the item candidates */
+      if (drand() >= 1.0/(double)(k+2)) continue;
+      name[0] = (char)('a'+k);  /* draw whether the item occurs */
+      if (ib_add2ta(base, name) < 0) error(E_NOMEM);
+    }                           /* add the item to the transaction */
+    ib_finta(base, 1);          /* finalize the transaction */
+    if (tbg_addib(tabag) != 0) error(E_NOMEM);
+  }                             /* add it to the transaction bag */
+  for (k = 0; k < 2; k++) {     /* create two pattern spectra */
+    ests[k] = psp_create(2, 16, 2, 1000);
+    if (!ests[k]) error(E_NOMEM);
+  }                             /* the result may depend only on */
+  if ((psp_tbgestx(tabag, ests[0], 100, 0.5, 2000, SEED, 1) != 0)
+  ||  (psp_tbgestx(tabag, ests[1], 100, 0.5, 2000, SEED, 3) != 0))
+    error(E_NOMEM);             /* the seed, not the thread count */
+  if (psp_sigcnt(ests[0]) <= 0) error(E_CHECK, "empty estimate");
+  if (pspcmp(ests[0], ests[1]) != 0)
+    error(E_CHECK, "estimate depends on the number of threads");
+  psp_clear(ests[1]);           /* psp_tbgest() draws its seed from */
+  rseed(SEED);                  /* the global random number stream, */
+  if (psp_tbgestx(tabag, ests[1], 100, 0.5, 2000, urand(), 0) != 0)
+    error(E_NOMEM);             /* so it is reproducible by seeding */
+  psp_clear(ests[0]);           /* this stream with rseed() */
+  rseed(SEED);
+  if (psp_tbgest (tabag, ests[0], 100, 0.5, 2000) != 0)
+    error(E_NOMEM);
+  if (pspcmp(ests[0], ests[1]) != 0)
+    error(E_CHECK, "estimate not reproducible with rseed()");
+  printf("estim:  ok (%"SIZE_FMT" signatures)\n", psp_sigcnt(ests[0]));
+  #endif
   return 0;                     /* return 'ok' */
 }  /* main() */
 
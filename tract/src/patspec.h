@@ -8,6 +8,10 @@
             2013.10.15 functions psp_error() and psp_clear() added
             2014.02.28 optional function psp_estim() added (PSP_ESTIM)
             2014.07.25 spectrum estimation for item sequences added
+            2026.10.16 functions psp_tbgestx() and psp_tnsestx() added
+            2026.10.16 functions psp_reserve() and psp_merge() added
+            2026.10.16 heavy hitter sketch for items and pairs added
+            2026.10.17 heavy hitter sketch moved to module hhsketch
 ----------------------------------------------------------------------*/
 #ifndef __PATSPEC__
 #define __PATSPEC__
@@ -159,14 +163,23 @@ extern int      psp_setfrq  (PATSPEC *psp, ITEM size, RSUPP supp,
                              size_t frq);
 extern int      psp_incfrq  (PATSPEC *psp, ITEM size, RSUPP supp,
                              size_t frq);
+extern int      psp_reserve (PATSPEC *psp, ITEM size, RSUPP supp);
 extern int      psp_addpsp  (PATSPEC *dst, PATSPEC *src);
+extern int      psp_merge   (PATSPEC *dst, PATSPEC **shards, int cnt,
+                             int thcnt);
 #ifdef PSP_ESTIM
 extern int      psp_tbgest  (TABAG *tabag, PATSPEC *psp, size_t eqsur,
                              double alpha, size_t smpls);
+extern int      psp_tbgestx (TABAG *tabag, PATSPEC *psp, size_t eqsur,
+                             double alpha, size_t smpls,
+                             unsigned int seed, int thcnt);
 #ifdef PSP_TRAIN
 extern int      psp_tnsest  (TRAINSET *tns, PATSPEC *psp, size_t eqsur,
                              double width, double alpha, size_t smpls,
                              int seq);
+extern int      psp_tnsestx (TRAINSET *tns, PATSPEC *psp, size_t eqsur,
+                             double width, double alpha, size_t smpls,
+                             int seq, unsigned int seed, int thcnt);
 #endif
 #endif
 #ifdef PSP_REPORT
@@ -74,6 +74,16 @@
             2016.10.14 function isr_size() added (item array size)
             2016.10.14 bugs in array/memory sizes for sequences fixed
             2017.05.30 optional compression with zlib library added
+            2026.10.16 binary output format added (mode ISR_BINARY)
+            2026.10.16 in-memory columnar item set store added
+            2026.10.16 asynchronous output writer thread added
+            2026.10.16 fast output extended to general info. formats
+            2026.10.16 heavy hitter sketches of items and pairs added
+            2026.10.16 delta/varint coded trans. id lists (ISR_TIDBIN)
+            2026.10.17 function isr_tidbag() added (collect trans. ids)
+            2026.10.16 rules of isr_rule() counted in pattern spectrum
+            2026.10.17 support of perfect ext. sets also for fast output
+            2026.10.17 trans. ids from a bag collected per prefix level
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -82,6 +92,7 @@
 #include <assert.h>
 #include <math.h>
 #include "report.h"
+#include "isbin.h"
 #ifndef ISR_NONAMES
 #include "scanner.h"
 #endif
@@ -105,6 +116,8 @@
 #define BS_WRITE    (64*1024)   /* size of internal write buffer */
 #define BS_INT         48       /* buffer size for integer output */
 #define BS_FLOAT       96       /* buffer size for float   output */
+#define BS_STORE     1024       /* block size for item set store */
+#define FO_MAXC     65536       /* max. number of cached supports */
 #define LN_2        0.69314718055994530942  /* ln(2) */
 
 /*----------------------------------------------------------------------
@@ -118,61 +131,138 @@ static const double pows[] = {  /* several powers of ten */
   1e+24, 1e+25, 1e+26, 1e+27, 1e+28, 1e+29, 1e+30, 1e+31,
   1e+32, 1e+33 };
 
+static const char digs[] =     /* pairs of decimal digits */
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
 /*----------------------------------------------------------------------
   Basic Output Functions
 ----------------------------------------------------------------------*/
 
+static int getsd (const char *s, const char **end)
+{                               /* --- get number of signif. digits */
+  int k = 6;                    /* number of significant digits */
+
+  assert(s && end);             /* check the function arguments */
+  if ((*s >= '0') && (*s <= '9')) {
+    k = *s++ -'0';              /* get the first digit */
+    if ((*s >= '0') && (*s <= '9'))
+      k = 10 *k +*s++ -'0';     /* get a possible second digit and */
+  }                             /* compute the number of digits */
+  if (k > 32) k = 32;           /* limit   the number of digits */
+  *end = s; return k;           /* return  the number of digits */
+}  /* getsd() */
+
+/*--------------------------------------------------------------------*/
+
 static void fastchk (ISREPORT *rep)
 {                               /* --- check for fast output mode */
+  int        n;                 /* size of a slot in the info. cache */
+  const char *s;                /* to traverse the info. format */
+
+  if (rep->focache) {           /* delete an existing info. cache */
+    free(rep->focache); rep->focache = NULL; }
+  rep->seplen = (int)strlen(rep->sep);   /* note separator length */
   if (rep->border               /* if there is a filtering border */
   ||  rep->repofn               /* or a report function */
   ||  rep->evalfn               /* or an evaluation function */
-  ||  rep->tidfile)             /* or trans ids. are to be written, */
+  ||  rep->tidfile              /* or trans ids. are to be written */
+  ||  rep->store)               /* or sets are to be stored, */
     rep->fast =  0;             /* standard output has to be used */
   else if (!rep->file)          /* if no output (and no filtering), */
     rep->fast = -1;             /* only count the item sets */
   else {                        /* if only an output file is written */
-    rep->fast = ((rep->zmin <= 1) && (rep->zmax >= ITEM_MAX)
-              && ((strcmp(rep->info, " (%a)") == 0)
-              ||  (strcmp(rep->info, " (%d)") == 0))
-              &&  (strcmp(rep->hdr,  "")      == 0)
-              &&  (strcmp(rep->sep,  " ")     == 0)) ? +1 : 0;
-  }                             /* check standard reporting settings */
+    rep->fast = 0;              /* check standard reporting settings */
+    if ((rep->zmin > 1) || (rep->zmax < ITEM_MAX)
+    ||  (rep->mode & ISR_BINARY))
+      return;                   /* all sizes and text output needed */
+    for (n = 2, s = rep->info; *s; ) {
+      if (*s++ != '%') { n += 1; continue; }
+      getsd(s, &s);             /* skip the number of signif. digits */
+      if (!*s || !strchr("adqQsSxX%", *s++))
+        return;                 /* the information must depend */
+      n += BS_INT;              /* only on the item set support */
+    }                           /* (so that it can be cached) */
+    if (n >= (int)sizeof(rep->fobuf))
+      return;                   /* check the size of a cache slot */
+    rep->foslot = n;            /* note the size of a cache slot */
+    rep->fomin  = rep->smin;    /* and the cached support range */
+    rep->fomax  = (rep->smax < rep->supps[0]) ? rep->smax : rep->supps[0];
+    #define int    1            /* (cache only for integer support) */
+    #define double 2
+    #if RSUPP==double
+    rep->fomax  = -1;           /* double support cannot be cached */
+    #else
+    if (rep->fomax -rep->fomin >= FO_MAXC)
+      rep->fomax = rep->fomin +FO_MAXC-1;
+    #endif                      /* limit the number of cached values */
+    #undef int
+    #undef double
+    rep->fast   = +1;           /* note that fast output is possible */
+  }
 }  /* fastchk() */
 
 /*--------------------------------------------------------------------*/
 
-static int getsd (const char *s, const char **end)
-{                               /* --- get number of signif. digits */
-  int k = 6;                    /* number of significant digits */
+static char* fmtdec (char *end, size_t num)
+{                               /* --- format a non-negative integer */
+  size_t k;                     /* index into digit pair table */
 
-  assert(s && end);             /* check the function arguments */
-  if ((*s >= '0') && (*s <= '9')) {
-    k = *s++ -'0';              /* get the first digit */
-    if ((*s >= '0') && (*s <= '9'))
-      k = 10 *k +*s++ -'0';     /* get a possible second digit and */
-  }                             /* compute the number of digits */
-  if (k > 32) k = 32;           /* limit   the number of digits */
-  *end = s; return k;           /* return  the number of digits */
-}  /* getsd() */
+  assert(end);                  /* check the function argument */
+  while (num >= 100) {          /* while there are 3 or more digits */
+    k = (num % 100) << 1; num /= 100;
+    *--end = digs[k+1]; *--end = digs[k];
+  }                             /* store two digits at a time */
+  if (num < 10) *--end = (char)(num +'0');
+  else { k = num << 1; *--end = digs[k+1]; *--end = digs[k]; }
+  return end;                   /* store the last digit(s) and */
+}  /* fmtdec() */               /* return the start of the number */
 
 /*--------------------------------------------------------------------*/
 
-#ifdef USE_ZLIB
-#define isr_flush(r)   isr_flushx(r, Z_NO_FLUSH)
-#define isr_finish(r)  isr_flushx(r, Z_FINISH)
-static void isr_flushx (ISREPORT *rep, int flush)
-#else
-#define isr_finish(r)  isr_flush(r)
-static void isr_flush (ISREPORT *rep)
+static void tidfree (ISREPORT *rep)
+{                               /* --- delete trans. id lists */
+  ITEM k;                       /* loop variable for prefix levels */
+
+  assert(rep);                  /* check the function argument */
+  if (rep->tidlst) {            /* if there are trans. id lists */
+    for (k = rep->size+1; --k >= 0; )
+      if (rep->tidlst[k]) free(rep->tidlst[k]);
+    free(rep->tidlst); rep->tidlst = NULL;
+  }                             /* delete the lists of all levels */
+  if (rep->tidlen) { free(rep->tidlen); rep->tidlen = NULL; }
+  if (rep->tiditm) { free(rep->tiditm); rep->tiditm = NULL; }
+  rep->tidvld = 0;              /* delete the list lengths and items */
+}  /* tidfree() */              /* and invalidate all levels */
+
+/*--------------------------------------------------------------------*/
+
+#ifdef USE_ZLIB                 /* if optional output compression */
+#define FL_CONT        Z_NO_FLUSH
+#define FL_FINISH      Z_FINISH
+#else                           /* if no output compression */
+#define FL_CONT        0        /* continue the output */
+#define FL_FINISH      1        /* finish the output */
 #endif
-{                               /* --- flush the output buffer */
+#define isr_flush(r)   isr_flushx(r, FL_CONT)
+#define isr_finish(r)  isr_flushx(r, FL_FINISH)
+
+static void isr_write (ISREPORT *rep, char *buf, size_t len, int flush)
+{                               /* --- write a buffer to the file */
   assert(rep);                  /* check the function arguments */
   #ifdef USE_ZLIB               /* if optional output compression */
   if (rep->mode & ISR_ZLIB) {   /* if to compress the output */
     size_t n;                   /* number of bytes to write */
-    rep->zsets.next_in  = (UCHAR*)rep->buf;
-    rep->zsets.avail_in = (unsigned)(rep->next -rep->buf);
+    rep->zsets.next_in  = (UCHAR*)buf;
+    rep->zsets.avail_in = (unsigned)len;
     do {                        /* compress and write output */
       rep->zsets.avail_out = BS_WRITE;
       rep->zsets.next_out  = rep->zbuf;
@@ -182,12 +272,115 @@ static void isr_flush (ISREPORT *rep)
     } while (rep->zsets.avail_out == 0);
   } else                        /* while output buffer becomes empty */
   #endif                        /* (i.e. more data can be compressed) */
-  fwrite(rep->buf, sizeof(char),(size_t)(rep->next-rep->buf),rep->file);
-  rep->next = rep->buf;         /* write the output buffer */
+  fwrite(buf, sizeof(char), len, rep->file);
   #ifndef NDEBUG                /* in debug mode */
   fflush(rep->file);            /* flush the output buffer */
   #endif                        /* after every flush operation */
-}  /* isr_flush() */
+}  /* isr_write() */
+
+/*--------------------------------------------------------------------*/
+#ifdef USE_THREADS
+
+static WORKERDEF(isr_writer, p)
+{                               /* --- output writer thread */
+  ISREPORT *rep = (ISREPORT*)p; /* type the item set reporter */
+  int      i;                   /* index of buffer to write */
+
+  thr_lock(&rep->rmutex);       /* lock the buffer ring */
+  while (1) {                   /* buffer write loop */
+    while ((rep->rfull <= 0) && !rep->rstop)
+      thr_wait(&rep->rcond, &rep->rmutex);
+    if (rep->rfull <= 0) break; /* wait for a filled buffer */
+    i = rep->rhead;             /* (or the stop flag) */
+    thr_unlock(&rep->rmutex);   /* write (and compress) the buffer */
+    isr_write(rep, rep->ring[i], rep->rlen[i], FL_CONT);
+    thr_lock(&rep->rmutex);     /* without holding the lock */
+    rep->rhead  = (i+1) % ISR_RING;
+    rep->rfull -= 1;            /* release the written buffer */
+    thr_signal(&rep->rcond);    /* and wake up a waiting miner */
+  }
+  thr_unlock(&rep->rmutex);     /* unlock the buffer ring */
+  return THREAD_OK;             /* and terminate the thread */
+}  /* isr_writer() */
+
+/*--------------------------------------------------------------------*/
+
+static int isr_start (ISREPORT *rep)
+{                               /* --- start the output writer */
+  int i;                        /* loop variable */
+
+  rep->ring[0] = rep->buf;      /* the write buffer is the first one */
+  for (i = 1; i < ISR_RING; i++) {
+    if (!rep->ring[i]) rep->ring[i] = (char*)malloc(BS_WRITE);
+    if (!rep->ring[i]) return -1;
+  }                             /* create the other ring buffers */
+  rep->rhead = rep->rtail = rep->rfull = rep->rstop = 0;
+  thr_mxinit(&rep->rmutex);     /* init. the ring and */
+  thr_cdinit(&rep->rcond);      /* the synchronization objects */
+  if (thr_start(&rep->writer, isr_writer, rep) == 0)
+    return 0;                   /* start the writer thread */
+  thr_cdfree(&rep->rcond);      /* on failure clean up */
+  thr_mxfree(&rep->rmutex);     /* the synchronization objects */
+  return -1;                    /* return an error indicator */
+}  /* isr_start() */
+
+/*--------------------------------------------------------------------*/
+
+static void isr_pass (ISREPORT *rep)
+{                               /* --- pass buffer to writer thread */
+  thr_lock(&rep->rmutex);       /* lock the buffer ring */
+  rep->rlen[rep->rtail] = (size_t)(rep->next -rep->buf);
+  rep->rtail  = (rep->rtail+1) % ISR_RING;
+  rep->rfull += 1;              /* queue the filled buffer */
+  thr_signal(&rep->rcond);      /* and wake up the writer */
+  while (rep->rfull >= ISR_RING)/* wait until the next buffer */
+    thr_wait(&rep->rcond, &rep->rmutex);   /* has been written */
+  thr_unlock(&rep->rmutex);     /* unlock the buffer ring */
+  rep->buf = rep->next = rep->ring[rep->rtail];
+  rep->end = rep->buf +BS_WRITE;/* continue with the next buffer */
+}  /* isr_pass() */
+
+/*--------------------------------------------------------------------*/
+
+static void isr_stop (ISREPORT *rep)
+{                               /* --- stop the output writer */
+  thr_lock(&rep->rmutex);       /* lock the buffer ring */
+  rep->rstop = 1;               /* set the stop flag */
+  thr_signal(&rep->rcond);      /* and wake up the writer */
+  thr_unlock(&rep->rmutex);     /* unlock the buffer ring */
+  thr_join(rep->writer);        /* wait for all buffers to be written */
+  thr_cdfree(&rep->rcond);      /* clean up */
+  thr_mxfree(&rep->rmutex);     /* the synchronization objects */
+  rep->buf = rep->next = rep->ring[0];
+  rep->end = rep->buf +BS_WRITE;/* restore the original buffer */
+}  /* isr_stop() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static void isr_flushx (ISREPORT *rep, int flush)
+{                               /* --- flush the output buffer */
+  assert(rep);                  /* check the function arguments */
+  #ifdef USE_THREADS            /* if to use an output thread */
+  if (rep->mode & ISR_ASYNC) {  /* if to write asynchronously, */
+    isr_pass(rep);              /* pass buffer to the writer thread */
+    if (flush == FL_CONT) return;
+    isr_stop(rep);              /* on finish wait for the writer */
+  }                             /* and finish in the calling thread */
+  #endif
+  isr_write(rep, rep->buf, (size_t)(rep->next -rep->buf), flush);
+  rep->next = rep->buf;         /* write the output buffer */
+}  /* isr_flushx() */
+
+/*----------------------------------------------------------------------
+With mode ISR_ASYNC the output buffer is one of a ring of ISR_RING
+buffers. A full buffer is passed to a writer thread, which writes
+(and, with ISR_ZLIB, compresses) it, while the miner continues with
+the next free buffer; the miner only waits if all buffers are full.
+Since the buffers are written in order, the output is identical to
+the one of synchronous writing. Only the item set/rule output uses
+the writer thread; the transaction identifier output is synchronous.
+----------------------------------------------------------------------*/
 
 /*--------------------------------------------------------------------*/
 
@@ -235,9 +428,84 @@ static void isr_putsn (ISREPORT *rep, const char *s, int n)
 
 /*--------------------------------------------------------------------*/
 
+static void isr_binint (ISREPORT *rep, size_t num)
+{                               /* --- write a variable length number */
+  while (num >= 0x80) {         /* while more than 7 bits are left */
+    isr_putc(rep, (int)(num & 0x7f) | 0x80);
+    num >>= 7;                  /* write the lowest 7 bits */
+  }                             /* with a continuation flag */
+  isr_putc(rep, (int)num);      /* write the last 7 bits */
+}  /* isr_binint() */
+
+/*--------------------------------------------------------------------*/
+
+static void isr_bindbl (ISREPORT *rep, double num)
+{                               /* --- write a floating point number */
+  int      i;                   /* loop variable */
+  uint64_t b;                   /* bits of the number */
+
+  memcpy(&b, &num, sizeof(double));
+  for (i = 0; i < 8; i++) {     /* write in little endian byte order */
+    isr_putc(rep, (int)(b & 0xff)); b >>= 8; }
+}  /* isr_bindbl() */
+
+/*--------------------------------------------------------------------*/
+
+static void isr_bininfo (ISREPORT *rep,
+                         RSUPP supp, RSUPP body, RSUPP head, double eval)
+{                               /* --- write binary record information */
+  if (rep->bin & ISB_DBLSUPP) { /* if double support values */
+    isr_bindbl(rep, (double)supp);
+    if (rep->bin & ISB_RULES) { /* write the item set support */
+      isr_bindbl(rep, (double)body);
+      isr_bindbl(rep, (double)head);
+    } }                         /* write body and head support */
+  else {                        /* if integer support values */
+    isr_binint(rep, (size_t)supp);
+    if (rep->bin & ISB_RULES) { /* write the item set support */
+      isr_binint(rep, (size_t)body);
+      isr_binint(rep, (size_t)head);
+    }                           /* write body and head support */
+  }
+  if (rep->bin & ISB_EVAL)      /* if to write an evaluation, */
+    isr_bindbl(rep, eval);      /* write it as a double */
+}  /* isr_bininfo() */
+
+/*--------------------------------------------------------------------*/
+
+static void isr_binhdr (ISREPORT *rep)
+{                               /* --- write binary file header */
+  ITEM       i, n;              /* loop variable, number of items */
+  const char *s;                /* to traverse the information format */
+  size_t     k;                 /* length of an item name */
+
+  assert(rep);                  /* check the function argument */
+  rep->bin = 0;                 /* determine the format flags */
+  if (rep->target & ISR_RULES) rep->bin |= ISB_RULES;
+  if ((RSUPP)0.5 > 0)          rep->bin |= ISB_DBLSUPP;
+  for (s = rep->info; *s; s++){ /* traverse the information format */
+    if (*s != '%') continue;    /* and search for an evaluation */
+    while ((*++s >= '0') && (*s <= '9'));
+    if ((*s == 'e') || (*s == 'E')) { rep->bin |= ISB_EVAL; break; }
+    if (!*s) break;             /* if an evaluation is printed, */
+  }                             /* it is also written in binary */
+  isr_puts(rep, ISB_MAGIC);     /* write the magic string, */
+  isr_putc(rep, ISB_VERSION);   /* the format version */
+  isr_putc(rep, rep->bin);      /* and the format flags */
+  isr_binint(rep, (size_t)(n = ib_cnt(rep->base)));
+  for (i = 0; i < n; i++) {     /* write the item dictionary */
+    s = ib_xname(rep->base, i); /* get the next item name */
+    isr_binint(rep, k = strlen(s));
+    isr_putsn (rep, s, (int)k); /* write the name length */
+  }                             /* and the name characters */
+}  /* isr_binhdr() */
+
+/*--------------------------------------------------------------------*/
+
 int isr_intout (ISREPORT *rep, ptrdiff_t num)
 {                               /* --- print an integer number */
-  int  i = BS_INT, n;           /* loop variable, character counter */
+  int  n;                       /* character counter */
+  char *s;                      /* start of the formatted number */
   char buf[BS_INT];             /* output buffer */
 
   assert(rep);                  /* check the function arguments */
@@ -257,12 +525,9 @@ int isr_intout (ISREPORT *rep, ptrdiff_t num)
   n = 0;                        /* default: no sign printed */
   if (num < 0) {                /* if the number is negative, */
     num = -num; isr_putc(rep, '-'); n = 1; }  /* print a sign */
-  do {                          /* digit output loop */
-    buf[--i] = (char)((num % 10) +'0');  /* store the next digit */
-    num /= 10;                  /* and remove it from the number */
-  } while (num > 0);            /* while there are more digits */
-  isr_putsn(rep, buf+i, BS_INT-i);
-  n += BS_INT-i;                /* print the generated digits and */
+  s = fmtdec(buf+BS_INT, (size_t)num);   /* format the number */
+  isr_putsn(rep, s, (int)(buf+BS_INT-s));
+  n += (int)(buf+BS_INT-s);     /* print the generated digits and */
   return n;                     /* return the number of characters */
 }  /* isr_intout() */
 
@@ -474,7 +739,7 @@ static void isr_tidputsn (ISREPORT *rep, const char *s, int n)
 
 static void isr_tidout (ISREPORT *rep, TID tid)
 {                               /* --- print a transaction id */
-  int  i;                       /* loop variable */
+  char *s;                      /* start of the formatted number */
   char buf[BS_INT];             /* output buffer */
 
   assert(rep && (tid >= 0));    /* check the function arguments */
@@ -482,19 +747,15 @@ static void isr_tidout (ISREPORT *rep, TID tid)
   && (tid >= rep->imin)         /* and transaction id is in range */
   && (tid <= rep->imax)) {
     isr_tidputs(rep, rep->ints[tid -rep->imin]); return; }
-  i = BS_INT;                   /* get end of output buffer */
-  do {                          /* digit output loop (back to front) */
-    buf[--i] = (char)((tid % 10) +'0');  /* store the next digit */
-    tid /= 10;                  /* and remove it from the number */
-  } while (tid > 0);            /* while there are more digits */
-  isr_tidputsn(rep, buf+i, BS_INT-i);      /* print the digits */
+  s = fmtdec(buf+BS_INT, (size_t)tid);     /* format the number */
+  isr_tidputsn(rep, s, (int)(buf+BS_INT-s));  /* print the digits */
 }  /* isr_tidout() */
 
 /*--------------------------------------------------------------------*/
 
 static void isr_occout (ISREPORT *rep, ITEM occ)
 {                               /* --- print an occurrence count */
-  int  i;                       /* loop variable */
+  char *s;                      /* start of the formatted number */
   char buf[BS_INT];             /* output buffer */
 
   assert(rep && (occ >= 0));    /* check the function arguments */
@@ -502,14 +763,68 @@ static void isr_occout (ISREPORT *rep, ITEM occ)
   && ((TID)occ <= rep->imin)    /* and occurrence counter is in range */
   && ((TID)occ <= rep->imax)) {
     isr_tidputs(rep, rep->ints[occ -rep->imin]); return; }
-  i = BS_INT;                   /* get end of output buffer */
-  do {                          /* digit output loop (back to front) */
-    buf[--i] = (char)((occ % 10) +'0');  /* store the next digit */
-    occ /= 10;                  /* and remove it from the number */
-  } while (occ > 0);            /* while there are more digits */
-  isr_tidputsn(rep, buf+i, BS_INT-i);      /* print the digits */
+  s = fmtdec(buf+BS_INT, (size_t)occ);     /* format the number */
+  isr_tidputsn(rep, s, (int)(buf+BS_INT-s));  /* print the digits */
 }  /* isr_occout() */
 
+/*--------------------------------------------------------------------*/
+
+static void isr_tidint (ISREPORT *rep, size_t num)
+{                               /* --- write a variable length number */
+  while (num >= 0x80) {         /* while more than 7 bits are left */
+    isr_tidputc(rep, (int)(num & 0x7f) | 0x80);
+    num >>= 7;                  /* write the lowest 7 bits */
+  }                             /* with a continuation flag */
+  isr_tidputc(rep, (int)num);   /* write the last 7 bits */
+}  /* isr_tidint() */
+
+/*--------------------------------------------------------------------*/
+
+static void isr_tidbin (ISREPORT *rep)
+{                               /* --- write a binary trans. id list */
+  TID  k, n;                    /* loop variable, number of tids */
+  TID  prv = -1;                /* previous transaction id */
+  ITEM min;                     /* minimum number of items */
+
+  assert(rep);                  /* check the function argument */
+  if      (rep->tidcnt > 0) {   /* if tids are in ascending order */
+    isr_tidint(rep, (size_t)rep->tidcnt << 1);
+    for (k = 0; k < rep->tidcnt; k++) {
+      isr_tidint(rep, (size_t)(rep->tids[k] -prv -1));
+      prv = rep->tids[k];       /* write the gaps between */
+    } }                         /* consecutive transaction ids */
+  else if (rep->tidcnt < 0) {   /* if tids are in descending order */
+    isr_tidint(rep, (size_t)-rep->tidcnt << 1);
+    for (k = -rep->tidcnt; k > 0; ) {
+      isr_tidint(rep, (size_t)(rep->tids[--k] -prv -1));
+      prv = rep->tids[k];       /* write the gaps between */
+    } }                         /* consecutive transaction ids */
+  else if (rep->tracnt > 0) {   /* if item occurrence counters */
+    min = (ITEM)(rep->cnt-rep->miscnt);
+    for (n = k = 0; k < rep->tracnt; k++)
+      if (rep->occs[k] >= min) n++;  /* count the transactions */
+    isr_tidint(rep, ((size_t)n << 1) | ((rep->miscnt > 0) ? 1 : 0));
+    for (k = 0; k < rep->tracnt; k++) {
+      if (rep->occs[k] < min)   /* skip all transactions that */
+        continue;               /* do not contain enough items */
+      isr_tidint(rep, (size_t)(k -prv -1)); prv = k;
+      if (rep->miscnt > 0)      /* write the gap to the previous id */
+        isr_tidint(rep, (size_t)rep->occs[k]);
+    } }                         /* and the number of contained items */
+  else                          /* if there are no transaction ids, */
+    isr_tidint(rep, 0);         /* write an empty list */
+}  /* isr_tidbin() */
+
+/* A binary transaction id list consists of the number n of ids,     */
+/* shifted left by one bit, with the lowest bit indicating whether   */
+/* occurrence counters are present, followed by the gaps between     */
+/* consecutive (zero-based, ascending) ids, i.e. the first id itself */
+/* and then id[i]-id[i-1]-1, each optionally followed by the number  */
+/* of items of the set contained in the transaction. All numbers are */
+/* written as variable length integers (7 bits per byte, see isbin). */
+/* For large supports the gaps are small, so that most ids need only */
+/* a single byte instead of several digits plus a separator.         */
+
 /*----------------------------------------------------------------------
   Generator Filtering Functions
 ----------------------------------------------------------------------*/
@@ -603,6 +918,120 @@ static int is_isgen (ISREPORT *rep, ITEM item, RSUPP supp)
 }  /* is_isgen() */
 
 #endif
+/*----------------------------------------------------------------------
+  Item Set Store Functions
+----------------------------------------------------------------------*/
+
+ISSTORE* iss_create (int mode)
+{                               /* --- create an item set store */
+  ISSTORE *iss;                 /* created item set store */
+
+  iss = (ISSTORE*)calloc(1, sizeof(ISSTORE));
+  if (!iss) return NULL;        /* create the base structure */
+  iss->mode   = mode;           /* note the storage mode */
+  iss->size   = iss->isize = BS_STORE;
+  iss->offs   = (size_t*)malloc((BS_STORE+1) *sizeof(size_t));
+  iss->supps  = (RSUPP*) malloc( BS_STORE    *sizeof(RSUPP));
+  iss->evals  = (double*)malloc( BS_STORE    *sizeof(double));
+  iss->items  = (ITEM*)  malloc( BS_STORE    *sizeof(ITEM));
+  if (mode & ISS_RULES) {       /* if to store association rules */
+    iss->bodies = (RSUPP*)malloc(BS_STORE *sizeof(RSUPP));
+    iss->heads  = (RSUPP*)malloc(BS_STORE *sizeof(RSUPP));
+    if (!iss->bodies || !iss->heads) { iss_delete(iss); return NULL; }
+  }                             /* create the rule support arrays */
+  if (!iss->offs || !iss->supps || !iss->evals || !iss->items) {
+    iss_delete(iss); return NULL; }
+  iss->offs[0] = 0;             /* init. the first record offset */
+  return iss;                   /* return the created store */
+}  /* iss_create() */
+
+/*--------------------------------------------------------------------*/
+
+void iss_delete (ISSTORE *iss)
+{                               /* --- delete an item set store */
+  assert(iss);                  /* check the function argument */
+  if (iss->items)  free(iss->items);
+  if (iss->heads)  free(iss->heads);
+  if (iss->bodies) free(iss->bodies);
+  if (iss->evals)  free(iss->evals);
+  if (iss->supps)  free(iss->supps);
+  if (iss->offs)   free(iss->offs);
+  free(iss);                    /* delete the arrays */
+}  /* iss_delete() */           /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+void iss_clear (ISSTORE *iss)
+{                               /* --- clear an item set store */
+  assert(iss);                  /* check the function argument */
+  iss->cnt = iss->icnt = 0;     /* clear the record and item counters */
+  iss->err = 0;                 /* and the error flag */
+}  /* iss_clear() */
+
+/*--------------------------------------------------------------------*/
+
+int iss_add (ISSTORE *iss, ITEM head, const ITEM *items, ITEM n,
+             RSUPP supp, RSUPP body, RSUPP hsupp, double eval)
+{                               /* --- add an item set/rule to store */
+  size_t k, z;                  /* number of items, new array size */
+  void   *p;                    /* to enlarge the arrays */
+
+  assert(iss && (items || (n <= 0)));
+  k = (size_t)n +((head >= 0) ? 1 : 0);
+  if (iss->icnt +k > iss->isize) {  /* if the item array is full */
+    z = iss->isize +((iss->isize > BS_STORE) ? iss->isize >> 1
+                                             : BS_STORE);
+    if (z < iss->icnt +k) z = iss->icnt +k;
+    p = realloc(iss->items, z *sizeof(ITEM));
+    if (!p) { iss->err = -1; return -1; }
+    iss->items = (ITEM*)p; iss->isize = z;
+  }                             /* enlarge the item array */
+  if (iss->cnt >= iss->size) {  /* if the record arrays are full */
+    z = iss->size +((iss->size > BS_STORE) ? iss->size >> 1
+                                           : BS_STORE);
+    p = realloc(iss->offs,  (z+1) *sizeof(size_t));
+    if (!p) { iss->err = -1; return -1; } iss->offs  = (size_t*)p;
+    p = realloc(iss->supps,  z    *sizeof(RSUPP));
+    if (!p) { iss->err = -1; return -1; } iss->supps = (RSUPP*) p;
+    p = realloc(iss->evals,  z    *sizeof(double));
+    if (!p) { iss->err = -1; return -1; } iss->evals = (double*)p;
+    if (iss->mode & ISS_RULES) {/* if to store association rules */
+      p = realloc(iss->bodies, z *sizeof(RSUPP));
+      if (!p) { iss->err = -1; return -1; } iss->bodies = (RSUPP*)p;
+      p = realloc(iss->heads,  z *sizeof(RSUPP));
+      if (!p) { iss->err = -1; return -1; } iss->heads  = (RSUPP*)p;
+    }                           /* enlarge the record arrays */
+    iss->size = z;              /* (only set the new size if all */
+  }                             /* arrays could be enlarged) */
+  if (head >= 0)                /* if a rule head is given, */
+    iss->items[iss->icnt++] = head;  /* store it as the first item */
+  if (n > 0) memcpy(iss->items +iss->icnt, items,
+                    (size_t)n *sizeof(ITEM));
+  iss->icnt += (size_t)n;       /* store the (other) items */
+  iss->supps[iss->cnt] = supp;  /* store support and evaluation */
+  iss->evals[iss->cnt] = eval;
+  if (iss->mode & ISS_RULES) {  /* if to store association rules, */
+    iss->bodies[iss->cnt] = body;  /* store body and head support */
+    iss->heads [iss->cnt] = hsupp;
+  }
+  iss->offs[++iss->cnt] = iss->icnt;
+  return 0;                     /* store the end offset of the record */
+}  /* iss_add() */              /* and return 'ok' */
+
+/*----------------------------------------------------------------------
+An item set store collects item sets or association rules in memory
+in a columnar layout: the items of all records are stored in one flat
+array, the records are delimited by an array of cnt+1 offsets, and the
+supports and evaluations (and, with mode ISS_RULES, the body and head
+supports of rules) are stored in separate arrays, one entry per record.
+The items of record i are items[offs[i]] to items[offs[i+1]-1]; in
+rules the first of these items is the rule head. The access functions
+iss_items() etc. and iss_itemarr() etc. return pointers into these
+arrays, so that the stored records can be processed without copying.
+(These pointers become invalid when further records are added.)
+A store is filled by an item set reporter if it is attached with
+isr_setstore(); it is neither cleared nor deleted by the reporter.
+----------------------------------------------------------------------*/
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
@@ -659,9 +1088,11 @@ ISREPORT* isr_createx (ITEMBASE *base, ITEM max)
   rep->nmax    = rep->nsum = 0; /* clear maximum/sum of name lengths */
   rep->repcnt  = 0;             /* init. the item set counter */
   rep->psp     = NULL;          /* clear pattern spectrum variable */
+  rep->hhs[0]  = rep->hhs[1] = NULL;  /* and heavy hitter sketches */
   rep->ints    = NULL;          /* clear pre-formatted integers */
   rep->imax    = -1;
   rep->file    = NULL;          /* clear the output file and its name */
+  rep->store   = NULL;          /* clear the in-memory item set store */
   rep->name    = NULL;          /* and the file write buffer */
   rep->buf     = rep->next   = rep->end    = NULL;
   rep->tidfile = NULL;          /* clear transaction id output file */
@@ -670,21 +1101,36 @@ ISREPORT* isr_createx (ITEMBASE *base, ITEM max)
   #ifdef USE_ZLIB               /* if to use optional compression */
   rep->zbuf    = NULL;          /* clear the compression buffer */
   #endif
+  #ifdef USE_THREADS            /* if to use an output thread */
+  memset(rep->ring, 0, sizeof(rep->ring));
+  #endif                        /* clear the output buffer ring */
   rep->occs    = NULL;
   rep->tids    = NULL;
   rep->tidcnt  = 0;
   rep->tracnt  = 0;
   rep->miscnt  = 0;
+  rep->tidbag  = NULL;          /* clear the bag for trans. ids */
+  rep->tidlst  = NULL;          /* and the trans. id lists */
+  rep->tidlen  = NULL;          /* of the prefix levels */
+  rep->tiditm  = NULL;
+  rep->tidvld  = 0;
   rep->fast    = -1;            /* default: only count the item sets */
-  rep->fosize  = 0;
+  rep->fosize  = rep->foslot = 0;
+  rep->foinfo  = rep->fobuf+1;  /* clear the fast output information */
+  rep->fomin   = 0;             /* and its cache */
+  rep->fomax   = -1;
+  rep->focache = NULL;
+  rep->seplen  = 1;             /* length of default item separator */
+  rep->bin     = 0;             /* clear the binary format flags */
   rep->out     = NULL;          /* there is no output buffer yet */
   rep->pxpp    = (ITEM*)  malloc((size_t)(k+k+k+2) *sizeof(ITEM));
   rep->iset    = (ITEM*)  malloc((size_t)(k+1)     *sizeof(ITEM));
   rep->supps   = (RSUPP*) malloc((size_t)(k+1)     *sizeof(RSUPP));
   rep->wgts    = (double*)calloc((size_t)(k+n+1),   sizeof(double));
   rep->stats   = (size_t*)calloc((size_t)(k+1),     sizeof(size_t));
+  rep->nlens   = (int*)   calloc((size_t)(n+1),     sizeof(int));
   if (!rep->pxpp || !rep->iset || !rep->supps || !rep->wgts
-  ||  !rep->stats) { isr_delete(rep, 0); return NULL; }
+  ||  !rep->stats || !rep->nlens) { isr_delete(rep, 0); return NULL; }
   memset(rep->pxpp, 0, (size_t)(n+1) *sizeof(ITEM));
   rep->pexs    = rep->pxpp +n+1;/* allocate memory for the arrays */
   rep->items   = rep->pexs += k;/* and organize and init. the arrays */
@@ -712,6 +1158,7 @@ ISREPORT* isr_createx (ITEMBASE *base, ITEM max)
     }                           /* and replace the original name */
     rep->nsum += m;             /* sum name size and find maximum */
     if (m > rep->nmax) rep->nmax = m;
+    rep->nlens [i] = (int)m;    /* note the length of the name and */
     rep->inames[i] = name;      /* store the (formatted) item name */
     if (!name) { isr_delete(rep, 0); return NULL; }
   }                             /* check for proper name copying */
@@ -733,6 +1180,8 @@ int isr_delete (ISREPORT *rep, int delis)
   #endif                        /* delete the closed/maximal filter */
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp)    psp_delete(rep->psp);
+  if (rep->hhs[0]) hh_delete(rep->hhs[0]);
+  if (rep->hhs[1]) hh_delete(rep->hhs[1]);
   #endif                        /* delete the pattern spectrum */
   if (rep->str)    free((void*)rep->str);
   if (rep->border) free(rep->border);
@@ -745,6 +1194,8 @@ int isr_delete (ISREPORT *rep, int delis)
   }                             /* delete all other arrays */
   #endif
   if (rep->ints)   free(rep->ints);
+  if (rep->focache) free(rep->focache);
+  if (rep->nlens)  free(rep->nlens);
   if (rep->stats)  free(rep->stats);
   if (rep->wgts)   free(rep->wgts);
   if (rep->supps)  free(rep->supps);
@@ -754,10 +1205,17 @@ int isr_delete (ISREPORT *rep, int delis)
   r = isr_close(rep);           /* close the output files */
   s = isr_tidclose(rep);        /* (if output files are open) */
   if (rep->tidbuf) free(rep->tidbuf);
+  tidfree(rep);                 /* delete the trans. id lists */
   if (rep->buf)    free(rep->buf); /* delete file write buffers */
   #ifdef USE_ZLIB               /* if to use optional compression */
   if (rep->zbuf)   free(rep->zbuf);
   #endif                        /* delete a compression buffer */
+  #ifdef USE_THREADS            /* if to use an output thread */
+  { int i;                      /* loop variable */
+    for (i = 1; i < ISR_RING; i++)
+      if (rep->ring[i]) free(rep->ring[i]);
+  }                             /* delete the output buffer ring */
+  #endif                        /* (first buffer is rep->buf) */
   free(rep);                    /* delete the base structure */
   return (r) ? r : s;           /* return file closing result */
 }  /* isr_delete() */
@@ -805,6 +1263,7 @@ void isr_setsupp (ISREPORT *rep, RSUPP smin, RSUPP smax)
   &&    (smin >= 0) && (smax >= smin));
   rep->smin = smin;             /* store the minimum and maximum */
   rep->smax = smax;             /* support of an item set to report */
+  fastchk(rep);                 /* check for fast output */
 }  /* isr_setsupp() */
 
 /*--------------------------------------------------------------------*/
@@ -919,6 +1378,15 @@ void isr_setrule (ISREPORT *rep, ISRULEFN rulefn, void *data)
 
 /*--------------------------------------------------------------------*/
 
+void isr_setstore (ISREPORT *rep, ISSTORE *store)
+{                               /* --- set in-memory item set store */
+  assert(rep);                  /* check the function argument */
+  rep->store = store;           /* store the item set store */
+  fastchk(rep);                 /* check for fast output */
+}  /* isr_setstore() */
+
+/*--------------------------------------------------------------------*/
+
 int isr_prefmt (ISREPORT *rep, TID min, TID max)
 {                               /* --- pre-format transaction ids */
   TID  t, z;                    /* to traverse the integers to format */
@@ -977,7 +1445,8 @@ int isr_open (ISREPORT *rep, FILE *file, const char *name)
   else if (!*name) {            /* if an empty name is given */
     file = stdout; rep->name = "<stdout>"; }
   else {                        /* if a proper name is given */
-    file = fopen(rep->name = name, "w");
+    file = fopen(rep->name = name,
+                 (rep->mode & ISR_BINARY) ? "wb" : "w");
     if (!file) return E_FOPEN;  /* open file with given name */
   }                             /* and check for an error */
   rep->file = file;             /* store the new output file */
@@ -994,6 +1463,12 @@ int isr_open (ISREPORT *rep, FILE *file, const char *name)
       return E_NOMEM;           /* initialize the compression */
   }                             /* (default method: deflate) */
   #endif
+  #ifdef USE_THREADS            /* if to use an output thread */
+  if (file && (rep->mode & ISR_ASYNC) && (isr_start(rep) != 0))
+    rep->mode &= ~ISR_ASYNC;    /* start the output writer thread */
+  #endif                        /* (on failure write synchronously) */
+  if (file && (rep->mode & ISR_BINARY))
+    isr_binhdr(rep);            /* write the binary file header */
   return 0;                     /* return 'ok' */
 }  /* isr_open() */
 
@@ -1038,7 +1513,8 @@ int isr_tidopen (ISREPORT *rep, FILE *file, const char *name)
   else if (!*name) {            /* if an empty name is given */
     file = stdout;           rep->tidname = "<stdout>"; }
   else {                        /* if a proper name is given */
-    file = fopen(rep->tidname = name, "w");
+    file = fopen(rep->tidname = name,
+                 (rep->mode & ISR_TIDBIN) ? "wb" : "w");
     if (!file) return E_FOPEN;  /* open file with given name */
   }                             /* and check for an error */
   rep->tidfile = file;          /* store the new output file */
@@ -1055,6 +1531,10 @@ int isr_tidopen (ISREPORT *rep, FILE *file, const char *name)
       return E_NOMEM;           /* initialize the compression */
   }                             /* (default method: deflate) */
   #endif
+  if (file && (rep->mode & ISR_TIDBIN)) {
+    isr_tidputs(rep, ISB_TIDMAGIC);   /* write the magic string */
+    isr_tidputc(rep, ISB_TIDVERSION); /* and the format version */
+  }                             /* of the binary trans. id format */
   return 0;                     /* return 'ok' */
 }  /* isr_tidopen() */
 
@@ -1088,6 +1568,45 @@ void isr_tidcfg (ISREPORT *rep, TID tracnt, ITEM miscnt)
 
 /*--------------------------------------------------------------------*/
 
+int isr_tidbag (ISREPORT *rep, TABAG *bag)
+{                               /* --- set bag to collect tids from */
+  TID  n;                       /* number of transactions */
+  ITEM k;                       /* number of prefix levels */
+
+  assert(rep);                  /* check the function arguments */
+  tidfree(rep);                 /* delete existing trans. id lists */
+  rep->tidbag = bag;            /* note the transaction bag */
+  if (!bag) return 0;           /* check for a transaction bag */
+  n = tbg_cnt(bag);             /* get the number of transactions */
+  k = rep->size+1;              /* and the number of prefix levels */
+  rep->tidlst = (TID**)calloc((size_t)k,   sizeof(TID*));
+  rep->tidlen = (TID*) calloc((size_t)k+(size_t)k, sizeof(TID));
+  rep->tiditm = (ITEM*)malloc((size_t)k   *sizeof(ITEM));
+  if (!rep->tidlst || !rep->tidlen || !rep->tiditm
+  || !(rep->tidlst[0] = (TID*)malloc((size_t)n *sizeof(TID)))) {
+    tidfree(rep); rep->tidbag = NULL; return E_NOMEM; }
+  rep->tidlen[0] = rep->tidlen[k] = n;
+  while (--n >= 0) rep->tidlst[0][n] = n;
+  rep->tracnt = 0;              /* the list of the empty set */
+  rep->miscnt = 0;              /* contains all transactions */
+  return 0;                     /* return 'ok' */
+}  /* isr_tidbag() */
+
+/* If a transaction bag is set, the transaction id list of an item */
+/* set that is reported without explicit transaction ids (that is, */
+/* with isr_report() or isr_reportv()) is collected from the bag.   */
+/* The lists are kept per prefix level: the list of a set is        */
+/* obtained by filtering the list of its prefix (the set without    */
+/* its last item), so only the levels after the prefix that the set */
+/* shares with the previously reported set have to be recomputed.   */
+/* The transaction ids are the indices of the transactions in the   */
+/* bag, so the bag must contain the items with the codes used by    */
+/* the reporter, but should not have been filtered, sorted or       */
+/* reduced. It is not copied and must be kept as long as the        */
+/* reporter is used. The settings of isr_tidcfg() are cleared.      */
+
+/*--------------------------------------------------------------------*/
+
 int isr_setup (ISREPORT *rep)
 {                               /* --- set up the item set reporter */
   size_t h, s, z;               /* lengths, size of output buffer */
@@ -1298,10 +1817,81 @@ double isr_wgtsupp (ISREPORT *rep, void *data)
 
 /*--------------------------------------------------------------------*/
 
+#ifdef ISR_PATSPEC
+
+static void hhcube (ISREPORT *rep, ITEM n,
+                    size_t base, size_t pex, size_t pair)
+{                               /* --- update heavy hitter sketches */
+  ITEM     i, k;                /* loop variables */
+  HHSKETCH *s = rep->hhs[0];    /* sketch for single items */
+  HHSKETCH *p = rep->hhs[1];    /* sketch for item pairs */
+
+  assert(rep && s && p);        /* check the function arguments */
+  for (i = 0; i < rep->cnt; i++) {
+    hh_add(s, rep->items[i], -1, base);
+    for (k = i+1; k < rep->cnt; k++)
+      hh_add(p, rep->items[i], rep->items[k], base);
+    if (pex <= 0) continue;     /* count the items and pairs */
+    for (k = 0; k < n; k++)     /* of the item set itself */
+      hh_add(p, rep->items[i], rep->pexs[k], pex);
+  }                             /* count mixed pairs with perf. exts. */
+  if (pex <= 0) return;         /* check for perfect extensions */
+  for (i = 0; i < n; i++) {     /* traverse the perfect extensions */
+    hh_add(s, rep->pexs[i], -1, pex);
+    if (pair <= 0) continue;    /* count the perfect extensions */
+    for (k = i+1; k < n; k++)   /* and pairs of them */
+      hh_add(p, rep->pexs[i], rep->pexs[k], pair);
+  }
+}  /* hhcube() */
+
+/* The frequencies base, pex and pair are the numbers of reported */
+/* item sets (in the hypercube of the n perfect extensions) that   */
+/* contain a given item of the set itself, a given perfect ext.    */
+/* and a given pair of perfect extensions, respectively.           */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static void fastinfo (ISREPORT *rep, RSUPP supp)
+{                               /* --- format info. for fast output */
+  char *slot = NULL;            /* slot in the information cache */
+  char *p;                      /* start of the formatted info. */
+  int  n;                       /* length of the formatted info. */
+
+  assert(rep && (rep->fast > 0));  /* check the function arguments */
+  if ((supp >= rep->fomin) && (supp <= rep->fomax)) {
+    if (!rep->focache) {        /* if there is no info. cache yet */
+      rep->focache = (char*)calloc((size_t)(rep->fomax-rep->fomin+1),
+                                   (size_t)rep->foslot);
+      if (!rep->focache) rep->fomax = rep->fomin-1;
+    }                           /* create an information cache */
+    if (rep->focache) {         /* if there is an information cache */
+      slot = rep->focache +(size_t)(supp-rep->fomin) *(size_t)rep->foslot;
+      if (*slot) {              /* if the info. is already formatted */
+        rep->fosize = (UCHAR)*slot -1;
+        rep->foinfo = slot+1; return;
+      }                         /* get the cached information */
+    }                           /* (length is stored in first byte) */
+  }
+  if (rep->end -rep->next < rep->foslot)
+    isr_flush(rep);             /* ensure space in the write buffer */
+  p = rep->next;                /* format the information directly */
+  isr_sinfo(rep, supp, 0, 0);   /* into the write buffer (no flush */
+  isr_putc (rep, '\n');         /* can happen due to the above check) */
+  n = (int)(rep->next -p);      /* and then take it back again */
+  rep->next = p;                /* (output order must be item set, */
+  if (!slot) slot = rep->fobuf; /* then information) */
+  *slot = (char)(n+1);          /* store the information size */
+  rep->foinfo = (CCHAR*)memcpy(slot+1, p, (size_t)n);
+  rep->fosize = n;              /* copy the formatted information */
+}  /* fastinfo() */
+
+/*--------------------------------------------------------------------*/
+
 static void fastout (ISREPORT *rep, ITEM n)
 {                               /* --- fast output of an item set */
-  char       *s;                /* to traverse the output buffer */
-  const char *name;             /* to traverse the item names */
+  ITEM i;                       /* item to print */
+  char *s;                      /* to traverse the output buffer */
 
   assert(rep);                  /* check the function argument */
   rep->stats[rep->cnt] += 1;    /* count the reported item set */
@@ -1309,16 +1899,19 @@ static void fastout (ISREPORT *rep, ITEM n)
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp)                 /* count item set in pattern spectrum */
     psp_incfrq(rep->psp, rep->cnt, rep->supps[rep->cnt], 1);
+  if (rep->hhs[0])              /* count items and pairs */
+    hhcube(rep, 0, 1, 0, 0);    /* in heavy hitter sketches */
   #endif
   s = rep->pos[rep->pfx];       /* get the position for appending */
   while (rep->pfx < rep->cnt) { /* traverse the additional items */
-    if (rep->pfx > 0)           /* if this is not the first item */
-      for (name = rep->sep; *name; )
-        *s++ = *name++;         /* copy the item separator */
-    for (name = rep->inames[rep->items[rep->pfx]]; *name; )
-      *s++ = *name++;           /* copy the item name to the buffer */
-    rep->pos[++rep->pfx] = s;   /* compute and record new position */
-  }                             /* for appending the next item */
+    if (rep->pfx > 0) {         /* if this is not the first item, */
+      memcpy(s, rep->sep, (size_t)rep->seplen);
+      s += rep->seplen;         /* copy the item separator */
+    }                           /* (block copy with known length) */
+    i = rep->items[rep->pfx];   /* copy the item name to the buffer */
+    memcpy(s, rep->inames[i], (size_t)rep->nlens[i]);
+    rep->pos[++rep->pfx] = s += rep->nlens[i];
+  }                             /* record the position for appending */
   while (n > 0) {               /* traverse the perfect extensions */
     rep->items[rep->cnt++] = rep->pexs[--n];
     fastout(rep, n);            /* add the next perfect extension, */
@@ -1330,12 +1923,80 @@ static void fastout (ISREPORT *rep, ITEM n)
 
 /*--------------------------------------------------------------------*/
 
+static int tidcoll (ISREPORT *rep)
+{                               /* --- collect trans. ids from bag */
+  ITEM       d, i;              /* prefix level, item of the level */
+  TID        k, n, m;           /* loop variable, number of tids */
+  TID        *src, *dst;        /* parent list and list to fill */
+  const ITEM *s;                /* to traverse the transaction items */
+
+  assert(rep && rep->tidbag);   /* check the function argument */
+  for (d = 0; (d < rep->tidvld) && (d < rep->cnt); d++)
+    if (rep->tiditm[d] != rep->items[d]) break;
+  for ( ; d < rep->cnt; d++) {  /* find first level that has changed */
+    n = rep->tidlen[d];         /* get the length of the parent list */
+    m = rep->tidlen[rep->size+1+d+1];
+    if (n > m) {                /* if the level's list is too small */
+      dst = (TID*)realloc(rep->tidlst[d+1], (size_t)n *sizeof(TID));
+      if (!dst) { rep->tidvld = -1; return -1; }
+      rep->tidlst[d+1] = dst; rep->tidlen[rep->size+1+d+1] = n;
+    }                           /* enlarge the list of the level */
+    src = rep->tidlst[d]; dst = rep->tidlst[d+1];
+    rep->tiditm[d] = i = rep->items[d];
+    for (m = k = 0; k < n; k++){/* traverse the parent list */
+      s = ta_items(tbg_tract(rep->tidbag, src[k]));
+      while ((*s > TA_END) && (*s != i)) s++;
+      if (*s == i) dst[m++] = src[k];
+    }                           /* keep the transactions that */
+    rep->tidlen[d+1] = m;       /* contain the item of the level */
+  }
+  rep->tidvld = rep->cnt;       /* all levels up to the set are valid */
+  rep->tids   = rep->tidlst[rep->cnt];
+  rep->tidcnt = rep->tidlen[rep->cnt];
+  return 0;                     /* set the trans. ids of the set */
+}  /* tidcoll() */
+
+/*--------------------------------------------------------------------*/
+
+static void tidwrite (ISREPORT *rep)
+{                               /* --- write a trans. id list */
+  TID  k, n;                    /* loop variable, number of tids */
+  ITEM min;                     /* minimum number of items */
+
+  assert(rep);                  /* check the function argument */
+  if (rep->mode & ISR_TIDBIN) { /* if to write binary format, */
+    isr_tidbin(rep); return; }  /* write a compressed id list */
+  if      (rep->tidcnt > 0) {   /* if tids are in ascending order */
+    for (k = 0; k < rep->tidcnt; k++) {
+      if (k > 0) isr_tidputs(rep, rep->sep);
+      isr_tidout(rep, rep->tids[k]+1);
+    } }                         /* report the transaction ids */
+  else if (rep->tidcnt < 0) {   /* if tids are in descending order */
+    for (k = -rep->tidcnt; k > 0; ) {
+      isr_tidout(rep, rep->tids[--k]+1);
+      if (k > 0) isr_tidputs(rep, rep->sep);
+    } }                         /* report the transaction ids */
+  else if (rep->tracnt > 0) {   /* if item occurrence counters */
+    min = (ITEM)(rep->cnt-rep->miscnt); /* traverse all trans. ids */
+    for (n = k = 0; k < rep->tracnt; k++) {
+      if (rep->occs[k] < min)   /* skip all transactions that */
+        continue;               /* do not contain enough items */
+      if (n++ > 0) isr_tidputs(rep, rep->sep);
+      isr_tidout(rep, k+1);     /* print the transaction identifier */
+      if (rep->miscnt <= 0) continue;
+      isr_tidputc(rep, ':');    /* print an item counter separator */
+      isr_occout(rep, rep->occs[k]);
+    }                           /* print number of contained items */
+  }
+  isr_tidputc(rep, '\n');       /* terminate the transaction id list */
+}  /* tidwrite() */
+
+/*--------------------------------------------------------------------*/
+
 static void output (ISREPORT *rep)
 {                               /* --- output an item set */
-  TID        k;                 /* loop variable */
-  ITEM       min;               /* minimum number of items */
+  ITEM       i, k;              /* item to print, loop variable */
   char       *s;                /* to traverse the output buffer */
-  const char *name;             /* to traverse the item names */
 
   assert(rep                    /* check the function arguments */
   &&    (rep->cnt >= rep->zmin)
@@ -1354,51 +2015,48 @@ static void output (ISREPORT *rep)
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp)                 /* count item set in pattern spectrum */
     psp_incfrq(rep->psp, rep->cnt, rep->supps[rep->cnt], 1);
+  if (rep->hhs[0])              /* count items and pairs */
+    hhcube(rep, 0, 1, 0, 0);    /* in heavy hitter sketches */
   #endif
   if (rep->repofn)              /* call reporting function if given */
     rep->repofn(rep, rep->repodat);
+  if (rep->store)               /* add item set to store if given */
+    iss_add(rep->store, -1, rep->items, rep->cnt,
+            rep->supps[rep->cnt], 0, 0, rep->eval);
   if (!rep->file) return;       /* check for an output file */
-  s = rep->pos[rep->pfx];       /* get the position for appending */
-  while (rep->pfx < rep->cnt) { /* traverse the additional items */
-    if (rep->pfx > 0)           /* if this is not the first item */
-      for (name = rep->sep; *name; )
-        *s++ = *name++;         /* copy the item separator */
-    for (name = rep->inames[rep->items[rep->pfx]]; *name; )
-      *s++ = *name++;           /* copy the item name to the buffer */
-    rep->pos[++rep->pfx] = s;   /* compute and record new position */
-  }                             /* for appending the next item */
-  isr_putsn(rep, rep->out, (int)(s-rep->out));
-  isr_sinfo(rep, rep->supps[rep->cnt], rep->wgts[rep->cnt], rep->eval);
-  isr_putc (rep, '\n');         /* print the item set information */
-  if (!rep->tidfile || !rep->tids) /* check whether to report */
-    return;                        /* a list of transaction ids */
-  if      (rep->tidcnt > 0) {   /* if tids are in ascending order */
-    for (k = 0; k < rep->tidcnt; k++) {
-      if (k > 0) isr_tidputs(rep, rep->sep);
-      isr_tidout(rep, rep->tids[k]+1);
-    } }                         /* report the transaction ids */
-  else if (rep->tidcnt < 0) {   /* if tids are in descending order */
-    for (k = -rep->tidcnt; k > 0; ) {
-      isr_tidout(rep, rep->tids[--k]+1);
-      if (k > 0) isr_tidputs(rep, rep->sep);
-    } }                         /* report the transaction ids */
-  else if (rep->tracnt > 0) {   /* if item occurrence counters */
-    min = (ITEM)(rep->cnt-rep->miscnt); /* traverse all trans. ids */
-    for (k = 0; k < rep->tracnt; k++) {
-      if (rep->occs[k] < min)   /* skip all transactions that */
-        continue;               /* do not contain enough items */
-      if (k > 0) isr_tidputs(rep, rep->sep);
-      isr_tidout(rep, k+1);     /* print the transaction identifier */
-      if (rep->miscnt <= 0) continue;
-      isr_tidputc(rep, ':');    /* print an item counter separator */
-      isr_occout(rep, rep->occs[k]);
-    }                           /* print number of contained items */
+  if (rep->mode & ISR_BINARY) { /* if to write binary format */
+    isr_binint(rep, (size_t)rep->cnt);
+    for (k = 0; k < rep->cnt; k++)
+      isr_binint(rep, (size_t)rep->items[k]);
+    isr_bininfo(rep, rep->supps[rep->cnt], 0, 0, rep->eval); }
+  else {                        /* if to write text format */
+    s = rep->pos[rep->pfx];     /* get the position for appending */
+    while (rep->pfx < rep->cnt){/* traverse the additional items */
+      if (rep->pfx > 0) {       /* if this is not the first item, */
+        memcpy(s, rep->sep, (size_t)rep->seplen);
+        s += rep->seplen;       /* copy the item separator */
+      }                         /* (block copy with known length) */
+      i = rep->items[rep->pfx]; /* copy the item name to the buffer */
+      memcpy(s, rep->inames[i], (size_t)rep->nlens[i]);
+      rep->pos[++rep->pfx] = s += rep->nlens[i];
+    }                           /* record the position for appending */
+    isr_putsn(rep, rep->out, (int)(s-rep->out));
+    isr_sinfo(rep, rep->supps[rep->cnt], rep->wgts[rep->cnt],rep->eval);
+    isr_putc (rep, '\n');       /* print the item set information */
   }
-  isr_tidputc(rep, '\n');       /* terminate the transaction id list */
+  if (!rep->tidfile) return;    /* check for a trans. id file */
+  if (rep->tids) {              /* if trans. ids are given, */
+    tidwrite(rep); return; }    /* write them directly */
+  if (!rep->tidbag) return;     /* check for a transaction bag */
+  if (tidcoll(rep) < 0) return; /* collect the transaction ids */
+  tidwrite(rep);                /* write the collected trans. ids */
+  rep->tids = NULL; rep->tidcnt = 0;
 }  /* output() */
 
 /*--------------------------------------------------------------------*/
 
+/*--------------------------------------------------------------------*/
+
 static void report (ISREPORT *rep, ITEM n)
 {                               /* --- recursively report item sets */
   assert(rep && (n >= 0));      /* check the function arguments */
@@ -1421,6 +2079,7 @@ int isr_report (ISREPORT *rep)
   ITEM   n, k;                  /* number of perfect extensions */
   ITEM   z;                     /* item set size */
   size_t m, c;                  /* buffers for item set counting */
+  size_t c1, c2, p1, p2;        /* counters for sketch updates */
   double w;                     /* buffer for an item set weight */
   RSUPP  s;                     /* support buffer */
   #ifdef ISR_CLOMAX             /* if closed/maximal filtering */
@@ -1465,7 +2124,9 @@ int isr_report (ISREPORT *rep)
       #ifdef ISR_PATSPEC        /* if pattern spectrum functions */
       if (rep->psp && (psp_incfrq(rep->psp, z, s, 1) < 0))
         return -1;              /* if a pattern spectrum exists, */
-      #endif                    /* count item set in pattern spectrum */
+      if (rep->hhs[0])          /* count item set in pattern spectrum */
+        hhcube(rep, n, 1, 1, 1);/* and all its items and pairs */
+      #endif                    /* in the heavy hitter sketches */
       return 0;                 /* return 'ok' */
     }
     m = 0; z = rep->cnt;        /* and init. the item set counter */
@@ -1477,10 +2138,15 @@ int isr_report (ISREPORT *rep)
         return -1;              /* if a pattern spectrum exists, */
       #endif                    /* count item set in pattern spectrum */
     }
+    p1 = p2 = 0;                /* init. the counters of the sets */
+    c1 = c2 = 1;                /* with given perfect extension(s) */
     for (c = 1, k = 1; (k <= n) && (++z <= rep->zmax); k++) {
       c = (c *(size_t)(n-k+1))  /* compute n choose k */
         / (size_t)k;            /* for 1 <= k <= n */
-      if (z >= rep->zmin) {     /* count the current item set */
+      if (k > 1) c1 = (c1 *(size_t)(n-k+1)) /(size_t)(k-1);
+      if (k > 2) c2 = (c2 *(size_t)(n-k+1)) /(size_t)(k-2);
+      if (z >= rep->zmin) {     /* (n-1 choose k-1, n-2 choose k-2) */
+        p1 += c1; if (k > 1) p2 += c2;
         rep->stats[z] += c; m += c; /* (for its size and overall) */
         #ifdef ISR_PATSPEC      /* if pattern spectrum functions */
         if (rep->psp && (psp_incfrq(rep->psp, z, s, c) < 0))
@@ -1489,14 +2155,17 @@ int isr_report (ISREPORT *rep)
       }
     }                           /* (n choose k is the number of */
     rep->repcnt += m;           /* item sets of size rep->cnt +k) */
+    #ifdef ISR_PATSPEC          /* if pattern spectrum functions */
+    if (rep->hhs[0])            /* count items and pairs */
+      hhcube(rep, n, m, p1, p2);/* in heavy hitter sketches */
+    #endif
     return 0;                   /* return 'ok' */
   }
   /* It is debatable whether this way of handling perfect extensions  */
   /* in case no output is produced is acceptable for fair benchmarks, */
   /* because the sets in the hypercube are not explicitly generated.  */
-  if (rep->fast)                /* format support for fast output */
-    rep->fosize = sprintf(rep->foinfo, " (%"RSUPP_FMT")\n",
-                          rep->supps[rep->cnt]);
+  if (rep->fast)                /* format info. for fast output */
+    fastinfo(rep, rep->supps[rep->cnt]);
   if (rep->mode & ISR_NOEXPAND){/* if not to expand perfect exts. */
     k = rep->cnt +n;            /* if all perfext extensions make */
     if (k > rep->zmax) return 0;/* the item set too large, abort */
@@ -1512,19 +2181,18 @@ int isr_report (ISREPORT *rep)
     #endif                      /* after every item set */
     return 0;                   /* abort the function */
   }                             /* (all reporting has been done) */
-  if (rep->fast)                /* if fast output is possible, */
-    fastout(rep, n);            /* report item sets recursively */
-  else {                        /* if fast output is not possible */
-    s = rep->supps[rep->cnt];   /* set support and weights */
-    w = rep->wgts [rep->cnt];   /* for perfect extension hypercube */
-    for (k = 0; ++k <= n; ) { rep->supps[rep->cnt+k] = s;
-                              rep->wgts [rep->cnt+k] = w; }
-    report(rep, n);             /* recursively add perfect exts. and */
-  }                             /* report the resulting item sets */
+  s = rep->supps[rep->cnt];     /* set support and weights */
+  w = rep->wgts [rep->cnt];     /* for perfect extension hypercube */
+  for (k = 0; ++k <= n; ) { rep->supps[rep->cnt+k] = s;
+                            rep->wgts [rep->cnt+k] = w; }
+  if (rep->fast) fastout(rep, n);   /* recursively add perfect */
+  else           report (rep, n);   /* extensions and report sets */
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp && psp_error(rep->psp))
     return -1;                  /* check whether updating the */
   #endif                        /* pattern spectrum failed */
+  if (rep->tidvld < 0) {        /* check whether collecting */
+    rep->tidvld = 0; return -1; }  /* trans. ids failed */
   #ifndef NDEBUG                /* in debug mode */
   isr_flush(rep);               /* flush the output buffer */
   #endif                        /* after every item set */
@@ -1595,7 +2263,25 @@ int isr_reprule (ISREPORT *rep, ITEM item,
     rep->eval = eval;           /* note the evaluation */
     rep->rulefn(rep, rep->ruledat, item, body, head);
   }                             /* call the reporting function */
+  if (rep->store) {             /* if there is an item set store */
+    for (i = s = 0; i < n; i++) {  /* collect the body items */
+      if (!s && (rep->items[i] == item)) { s = 1; continue; }
+      rep->iset[i-s] = rep->items[i];
+    }                           /* (skip the head item once) */
+    if (iss_add(rep->store, item, rep->iset, n-1,
+                supp, body, head, eval) < 0)
+      return -1;                /* add the rule to the store */
+  }                             /* (with the head as first item) */
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->mode & ISR_BINARY) { /* if to write binary format */
+    isr_binint(rep, (size_t)n); /* write the number of items */
+    isr_binint(rep, (size_t)item);       /* and the rule head */
+    for (i = s = 0; i < n; i++) /* traverse the items in the body */
+      if ((rep->items[i] != item) || s++)
+        isr_binint(rep, (size_t)rep->items[i]);
+    isr_bininfo(rep, supp, body, head, eval);
+    return 0;                   /* write the rule information */
+  }                             /* and abort the function */
   isr_puts(rep, rep->hdr);      /* print the record header */
   isr_puts(rep, rep->inames[item]);
   isr_puts(rep, rep->imp);      /* print rule head and impl. sign */
@@ -1637,7 +2323,17 @@ int isr_iset (ISREPORT *rep, const ITEM *items, ITEM n,
       isr_addwgt(rep, items[i], supp, wgt);
     rep->repofn(rep, rep->repodat);
   }                             /* call the reporter function */
+  if (rep->store                /* add item set to store if given */
+  && (iss_add(rep->store, -1, items, n, supp, 0, 0, eval) < 0))
+    return -1;
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->mode & ISR_BINARY) { /* if to write binary format */
+    isr_binint(rep, (size_t)n); /* write the number of items */
+    for (i = 0; i < n; i++)     /* and the items */
+      isr_binint(rep, (size_t)items[i]);
+    isr_bininfo(rep, supp, 0, 0, eval);
+    return 0;                   /* write the item set information */
+  }                             /* and abort the function */
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (n > 0)                    /* print the first item */
@@ -1675,7 +2371,17 @@ int isr_isetx (ISREPORT *rep, const ITEM *items, ITEM n,
   if (rep->psp && (psp_incfrq(rep->psp, n, supp, 1) < 0))
     return -1;                  /* if a pattern spectrum exists, */
   #endif                        /* count item set in pattern spectrum */
+  if (rep->store                /* add item set to store if given */
+  && (iss_add(rep->store, -1, items, n, supp, 0, 0, eval) < 0))
+    return -1;                  /* (item weights are not stored) */
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->mode & ISR_BINARY) { /* if to write binary format */
+    isr_binint(rep, (size_t)n); /* write the number of items */
+    for (i = 0; i < n; i++)     /* and the items */
+      isr_binint(rep, (size_t)items[i]);
+    isr_bininfo(rep, supp, 0, 0, eval);
+    return 0;                   /* write the item set information */
+  }                             /* (item weights are not written) */
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (n > 0) {                  /* if at least one item */
@@ -1708,11 +2414,26 @@ int isr_rule (ISREPORT *rep, const ITEM *items, ITEM n,
     return 0;                   /* check the item set size */
   rep->stats[n] += 1;           /* count the reported rule */
   rep->repcnt   += 1;           /* (for its size and overall) */
+  #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
+  if (rep->psp && (psp_incfrq(rep->psp, n, supp, 1) < 0))
+    return -1;                  /* if a pattern spectrum exists, */
+  #endif                        /* count item set in pattern spectrum */
   if (rep->rulefn) {            /* if a reporting function is given */
     rep->eval = eval;           /* note the evaluation */
     rep->rulefn(rep, rep->ruledat, items[0], body, head);
   }                             /* call the reporting function */
+  if (rep->store                /* add the rule to store if given */
+  && (iss_add(rep->store, items[0], items+1, n-1,
+              supp, body, head, eval) < 0))
+    return -1;
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->mode & ISR_BINARY) { /* if to write binary format */
+    isr_binint(rep, (size_t)n); /* write the number of items */
+    for (i = 0; i < n; i++)     /* and the items (head first) */
+      isr_binint(rep, (size_t)items[i]);
+    isr_bininfo(rep, supp, body, head, eval);
+    return 0;                   /* write the rule information */
+  }                             /* and abort the function */
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   isr_puts(rep, rep->inames[*items++]);
@@ -1768,7 +2489,18 @@ int isr_sxrule (ISREPORT *rep, const ITEM *ante, ITEM n, ITEM cons,
     rep->eval = eval;           /* note the evaluation */
     rep->rulefn(rep, rep->ruledat, cons, body, head);
   }                             /* call the reporting function */
+  if (rep->store                /* add the rule to store if given */
+  && (iss_add(rep->store, cons, ante, n, supp, body, head, eval) < 0))
+    return -1;
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->mode & ISR_BINARY) { /* if to write binary format */
+    isr_binint(rep, (size_t)n+1);        /* write the number of items, */
+    isr_binint(rep, (size_t)cons);       /* the rule head */
+    for (i = 0; i < n; i++)     /* and the items in the body */
+      isr_binint(rep, (size_t)ante[i]);
+    isr_bininfo(rep, supp, body, head, eval);
+    return 0;                   /* write the rule information */
+  }                             /* and abort the function */
   i = rep->cnt; rep->cnt = n+1; /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (--n >= 0)                 /* print the first item in body */
@@ -1806,7 +2538,9 @@ int isr_extrule (ISREPORT *rep, const ITEM *items, ITEM n,
     return 0;                   /* check the item set size */
   rep->stats[n+1] += 1;         /* count the reported rule */
   rep->repcnt     += 1;         /* (for its size and overall) */
-  if (!rep->file) return 0;     /* check for an output file */
+  if (!rep->file              /* check for an output file */
+  || (rep->mode & ISR_BINARY))  /* (extended rules have no */
+    return 0;                   /* binary format, only counted) */
   i = rep->cnt; rep->cnt = n+1; /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (--n >= 0)                 /* print the first item in body */
@@ -1836,7 +2570,9 @@ void isr_reset (ISREPORT *rep)
   n = ib_cnt(rep->base);        /* clear the statistics array */
   memset(rep->stats, 0, (size_t)(n+1) *sizeof(size_t));
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
-  if (rep->psp) psp_clear(rep->psp);
+  if (rep->psp)    psp_clear(rep->psp);
+  if (rep->hhs[0]) hh_clear(rep->hhs[0]);
+  if (rep->hhs[1]) hh_clear(rep->hhs[1]);
   #endif                        /* clear the pattern spectrum */
 }  /* isr_reset() */
 
@@ -1883,6 +2619,31 @@ PATSPEC* isr_rempsp (ISREPORT *rep, int delpsp)
   return NULL;                  /* return that there is none anymore */
 }  /* isr_rempsp() */
 
+/*--------------------------------------------------------------------*/
+
+int isr_addhhs (ISREPORT *rep, size_t size)
+{                               /* --- add heavy hitter sketches */
+  assert(rep);                  /* check the function arguments */
+  if (rep->hhs[0]) return 1;    /* if sketches exist, abort */
+  rep->hhs[0] = hh_create((size_t)ib_cnt(rep->base));
+  rep->hhs[1] = hh_create(size);/* create the sketches for items */
+  if (rep->hhs[0] && rep->hhs[1]) return 0;          /* and pairs */
+  if (rep->hhs[0]) { hh_delete(rep->hhs[0]); rep->hhs[0] = NULL; }
+  if (rep->hhs[1]) { hh_delete(rep->hhs[1]); rep->hhs[1] = NULL; }
+  return -1;                    /* on failure delete the sketches */
+}  /* isr_addhhs() */
+
+/*----------------------------------------------------------------------
+The heavy hitter sketches count how many reported item sets contain
+each item and each pair of items. The item sketch has one counter per
+item and is therefore exact; the pair sketch has size counters and
+keeps the most frequent pairs (Space-Saving, see hhsketch.c). Together
+with a pattern spectrum they allow for exploratory runs without any
+item set output (no output file): the item sets in the hypercube of
+perfect extensions are then not generated explicitly, but the number
+of sets containing an item or a pair is computed combinatorially.
+----------------------------------------------------------------------*/
+
 #endif
 /*--------------------------------------------------------------------*/
 
@@ -1911,10 +2672,12 @@ int isr_sinfo (ISREPORT *rep, RSUPP supp, double wgt, double eval)
       #define double 2
       #if RSUPP==double
       case 'a': n += isr_numout(rep,      sdbl,       k); break;
+      case 'd': n += isr_numout(rep,      sdbl,       k); break;
       case 'q': n += isr_numout(rep,      smax,       k); break;
       case 'Q': n += isr_numout(rep,      smax,       k); break;
       #else
       case 'a': n += isr_intout(rep, (ptrdiff_t)supp);    break;
+      case 'd': n += isr_intout(rep, (ptrdiff_t)supp);    break;
       case 'q': n += isr_intout(rep, (ptrdiff_t)smax);    break;
       case 'Q': n += isr_intout(rep, (ptrdiff_t)smax);    break;
       #endif
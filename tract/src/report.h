@@ -44,6 +44,16 @@
             2016.09.29 function isr_sxrule() added (explicit head item)
             2016.10.14 function isr_size() added (item array size)
             2017.05.30 optional compression with zlib library added
+            2026.10.16 binary output format added (ISR_BINARY)
+            2026.10.16 in-memory columnar item set store added (ISSTORE)
+            2026.10.16 asynchronous output writer thread added (ISR_ASYNC)
+            2026.10.16 fast output info. cache and name lengths added
+            2026.10.16 heavy hitter sketches of items and pairs added
+            2026.10.16 compressed binary trans. id lists added (ISR_TIDBIN)
+            2026.10.17 function isr_tidbag() added (collect trans. ids)
+            2026.10.17 heavy hitter sketches from module hhsketch
+            2026.10.17 trans. ids from a bag collected per prefix level
+            2026.10.17 placeholders for the output writer fields
 ----------------------------------------------------------------------*/
 #ifndef __REPORT__
 #define __REPORT__
@@ -52,8 +62,12 @@
 #ifdef USE_ZLIB
 #include <zlib.h>
 #endif
+#ifdef USE_THREADS
+#include "threads.h"
+#endif
 #ifdef ISR_PATSPEC
 #include "patspec.h"
+#include "hhsketch.h"
 #endif
 #ifdef ISR_CLOMAX
 #include "clomax.h"
@@ -175,10 +189,35 @@
 #ifdef USE_ZLIB                 /* if to use optional compression */
 #define ISR_ZLIB      0x1000    /* compress output with zlib */
 #endif
+#define ISR_BINARY    0x2000    /* write binary format (see isbin.h) */
+#ifdef USE_THREADS              /* if to use an output thread */
+#define ISR_ASYNC     0x4000    /* write output in a separate thread */
+#endif
+#define ISR_RING      4         /* number of buffers in output ring */
+#define ISR_TIDBIN    0x8000    /* write binary trans. id lists */
+
+/* --- item set store modes (for iss_create()) --- */
+#define ISS_SETS      0x0000    /* store item sets */
+#define ISS_RULES     0x0001    /* store association rules */
 
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
+typedef struct {                /* --- item set store (columnar) --- */
+  int        mode;              /* storage mode (e.g. ISS_RULES) */
+  int        err;               /* error flag (memory allocation) */
+  size_t     cnt;               /* number of stored item sets/rules */
+  size_t     size;              /* size of the per record arrays */
+  size_t     *offs;             /* start offsets of records in items */
+  RSUPP      *supps;            /* supports of the item sets/rules */
+  RSUPP      *bodies;           /* supports of the rule bodies */
+  RSUPP      *heads;            /* supports of the rule heads */
+  double     *evals;            /* additional evaluations */
+  size_t     icnt;              /* number of stored items */
+  size_t     isize;             /* size of the item array */
+  ITEM       *items;            /* items of all records (flat) */
+} ISSTORE;                      /* (item set store) */
+
 struct isreport;                /* --- an item set eval. function --- */
 typedef double ISEVALFN (struct isreport *rep, void *data);
 typedef void   ISREPOFN (struct isreport *rep, void *data);
@@ -239,13 +278,16 @@ typedef struct isreport {       /* --- an item set reporter --- */
   size_t     *stats;            /* reported item sets per set size */
   #ifdef ISR_PATSPEC            /* if pattern spectrum support */
   PATSPEC    *psp;              /* an (optional) pattern spectrum */
+  HHSKETCH   *hhs[2];           /* heavy hitters (items and pairs) */
   #else                         /* if no pattern spectrum support */
   void       *psp;              /* placeholder (for fixed offsets) */
+  void       *hhs[2];           /* dito */
   #endif
   char       **ints;            /* preformatted integer numbers */
   TID        imin;              /* smallest pre-formatted integer */
   TID        imax;              /* largest  pre-formatted integer */
   FILE       *file;             /* output file to write to */
+  ISSTORE    *store;            /* in-memory item set store */
   CCHAR      *name;             /* name of item set output file */
   char       *buf;              /* write buffer for output */
   char       *next;             /* next character position to write */
@@ -260,20 +302,77 @@ typedef struct isreport {       /* --- an item set reporter --- */
   z_stream   ztids;             /* stream for compressing trans. ids */
   UCHAR      *zbuf;             /* output buffer for compression */
   #endif
+  #ifdef USE_THREADS            /* if to write in a separate thread */
+  char       *ring[ISR_RING];   /* ring of output buffers */
+  size_t     rlen[ISR_RING];    /* number of bytes in each buffer */
+  int        rhead;             /* next buffer to write (writer) */
+  int        rtail;             /* current buffer to fill (miner) */
+  int        rfull;             /* number of filled buffers */
+  int        rstop;             /* flag for stopping the writer */
+  THREAD     writer;            /* output writer thread */
+  THRMUTEX   rmutex;            /* mutex for the buffer ring */
+  THRCOND    rcond;             /* condition variable for the ring */
+  #else                         /* if no output writer thread */
+  void       *ring[ISR_RING];   /* placeholder (for fixed offsets) */
+  void       *rlen[ISR_RING];   /* dito */
+  void       *rhead;            /* dito */
+  void       *rtail;            /* dito */
+  void       *rfull;            /* dito */
+  void       *rstop;            /* dito */
+  void       *writer;           /* dito */
+  void       *rmutex;           /* dito */
+  void       *rcond;            /* dito */
+  #endif
   ITEM       *occs;             /* array  of item occurrences */
   TID        *tids;             /* array  of transaction ids */
   TID        tidcnt;            /* number of transaction ids */
   TID        tracnt;            /* total number of transactions */
+  TABAG      *tidbag;           /* bag to collect trans. ids from */
+  TID        **tidlst;          /* trans. id lists per prefix level */
+  TID        *tidlen;           /* lengths and sizes of these lists */
+  ITEM       *tiditm;           /* items of the prefix levels */
+  ITEM       tidvld;            /* number of valid prefix levels */
   ITEM       miscnt;            /* accepted number of missing items */
   int        fast;              /* whether fast output is possible */
   int        fosize;            /* size of set info. for fastout() */
-  char       foinfo[64];        /* item set info.    for fastout() */
+  CCHAR      *foinfo;           /* item set info.    for fastout() */
+  char       fobuf[256];        /* buffer for uncached set info. */
+  int        foslot;            /* size of a slot in the info. cache */
+  RSUPP      fomin;             /* minimum support in the info. cache */
+  RSUPP      fomax;             /* maximum support in the info. cache */
+  char       *focache;          /* cache of formatted set infos. */
+  int        seplen;            /* length of the item separator */
+  int        *nlens;            /* lengths of the (formatted) names */
+  int        bin;               /* flags for binary output format */
   char       *out;              /* output buffer for sets/rules */
   char       *pos[1];           /* append positions in output buffer */
 } ISREPORT;                     /* (item set reporter) */
 
 /*----------------------------------------------------------------------
-  Functions
+  Item Set Store Functions
+----------------------------------------------------------------------*/
+extern ISSTORE*  iss_create   (int mode);
+extern void      iss_delete   (ISSTORE *iss);
+extern void      iss_clear    (ISSTORE *iss);
+extern int       iss_add      (ISSTORE *iss, ITEM head,
+                               const ITEM *items, ITEM n, RSUPP supp,
+                               RSUPP body, RSUPP hsupp, double eval);
+extern int       iss_mode     (ISSTORE *iss);
+extern int       iss_error    (ISSTORE *iss);
+extern size_t    iss_cnt      (ISSTORE *iss);
+extern ITEM      iss_size     (ISSTORE *iss, size_t index);
+extern const ITEM* iss_items  (ISSTORE *iss, size_t index);
+extern RSUPP     iss_supp     (ISSTORE *iss, size_t index);
+extern RSUPP     iss_body     (ISSTORE *iss, size_t index);
+extern RSUPP     iss_head     (ISSTORE *iss, size_t index);
+extern double    iss_eval     (ISSTORE *iss, size_t index);
+extern const ITEM*   iss_itemarr (ISSTORE *iss);
+extern const size_t* iss_offsarr (ISSTORE *iss);
+extern const RSUPP*  iss_supparr (ISSTORE *iss);
+extern const double* iss_evalarr (ISSTORE *iss);
+
+/*----------------------------------------------------------------------
+  Item Set Reporter Functions
 ----------------------------------------------------------------------*/
 extern ISREPORT* isr_create   (ITEMBASE *base);
 extern ISREPORT* isr_createx  (ITEMBASE *base, ITEM max);
@@ -323,10 +422,13 @@ extern int       isr_open     (ISREPORT *rep, FILE *file, CCHAR *name);
 extern int       isr_close    (ISREPORT *rep);
 extern FILE*     isr_file     (ISREPORT *rep);
 extern CCHAR*    isr_name     (ISREPORT *rep);
+extern void      isr_setstore (ISREPORT *rep, ISSTORE *store);
+extern ISSTORE*  isr_store    (ISREPORT *rep);
 
 extern int       isr_tidopen  (ISREPORT *rep, FILE *file, CCHAR *name);
 extern int       isr_tidclose (ISREPORT *rep);
 extern void      isr_tidcfg   (ISREPORT *rep, TID tracnt, ITEM miscnt);
+extern int       isr_tidbag   (ISREPORT *rep, TABAG *bag);
 extern FILE*     isr_tidfile  (ISREPORT *rep);
 extern CCHAR*    isr_tidname  (ISREPORT *rep);
 
@@ -399,6 +501,8 @@ extern void      isr_prstats  (ISREPORT *rep, FILE *out, ITEM min);
 extern int       isr_addpsp   (ISREPORT *rep, PATSPEC *psp);
 extern PATSPEC*  isr_rempsp   (ISREPORT *rep, int delpsp);
 extern PATSPEC*  isr_getpsp   (ISREPORT *rep);
+extern int       isr_addhhs   (ISREPORT *rep, size_t size);
+extern HHSKETCH* isr_gethhs   (ISREPORT *rep, int pairs);
 #endif
 extern int       isr_intout   (ISREPORT *rep, diff_t num);
 extern int       isr_numout   (ISREPORT *rep, double num, int digits);
@@ -419,6 +523,20 @@ extern int       isr_tail     (ISREPORT *rep, const ITEM *items,ITEM n);
 /*----------------------------------------------------------------------
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
+#define iss_mode(s)       ((s)->mode)
+#define iss_error(s)      ((s)->err)
+#define iss_cnt(s)        ((s)->cnt)
+#define iss_size(s,i)     ((ITEM)((s)->offs[(i)+1] -(s)->offs[i]))
+#define iss_items(s,i)    ((const ITEM*)(s)->items +(s)->offs[i])
+#define iss_supp(s,i)     ((s)->supps[i])
+#define iss_body(s,i)     ((s)->bodies[i])
+#define iss_head(s,i)     ((s)->heads[i])
+#define iss_eval(s,i)     ((s)->evals[i])
+#define iss_itemarr(s)    ((const ITEM*)  (s)->items)
+#define iss_offsarr(s)    ((const size_t*)(s)->offs)
+#define iss_supparr(s)    ((const RSUPP*) (s)->supps)
+#define iss_evalarr(s)    ((const double*)(s)->evals)
+
 #define isr_create(b)     isr_createx(b,0)
 #define isr_base(r)       ((r)->base)
 #define isr_size(r)       ((r)->size)
@@ -444,6 +562,7 @@ extern int       isr_tail     (ISREPORT *rep, const ITEM *items,ITEM n);
 
 #define isr_file(r)       ((r)->file)
 #define isr_name(r)       ((r)->name)
+#define isr_store(r)      ((r)->store)
 #define isr_tidfile(r)    ((r)->tidfile)
 #define isr_tidname(r)    ((r)->tidname)
 
@@ -474,6 +593,7 @@ extern int       isr_tail     (ISREPORT *rep, const ITEM *items,ITEM n);
 #define isr_stats(r)      ((const size_t*)(r)->stats)
 #ifdef ISR_PATSPEC
 #define isr_getpsp(r)     ((r)->psp)
+#define isr_gethhs(r,p)   ((r)->hhs[(p) ? 1 : 0])
 #endif
 #ifdef ISR_CLOMAX
 #define isr_buf(r)        ((r)->iset)
@@ -0,0 +1,335 @@
+/*----------------------------------------------------------------------
+  File    : tasrc.c
+  Contents: transaction source management (multi-pass streaming)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "arrays.h"
+#include "tasrc.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#ifdef TA_READ                  /* if transaction reading capability */
+#define READ(s)     (((s)->type == TSRC_FUNC) \
+                    ? (s)->fn((s)->base, (s)->data, 0) \
+                    : ib_read((s)->base, (s)->trd, (s)->mode))
+#else                           /* if no transaction reading */
+#define READ(s)     ((s)->fn((s)->base, (s)->data, 0))
+#endif
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int snapshot (TASRC *src)
+{                               /* --- note item base statistics */
+  ITEM     i;                   /* loop variable for items */
+  ITEMBASE *base;               /* underlying item base */
+  SUPP     *p;                  /* to traverse the frequencies */
+
+  assert(src);                  /* check the function argument */
+  base = src->base;             /* get the underlying item base */
+  src->icnt = ib_cnt(base);     /* get the number of items */
+  p = (SUPP*)realloc(src->frqs, (size_t)(src->icnt+1)
+                               *(2*sizeof(SUPP)));
+  if (!p) return src->err = E_NOMEM;
+  src->frqs = p;                /* (re)allocate a frequency buffer */
+  for (i = 0; i < src->icnt; i++) {
+    *p++ = ib_getfrq(base, i);  /* traverse the items and */
+    *p++ = ib_getxfq(base, i);  /* note the standard and */
+  }                             /* the extended item frequencies */
+  src->wgt  = ib_getwgt(base);  /* note the total transaction weight */
+  src->imax = ib_maxfrq(base);  /* and the maximum item support */
+  return 0;                     /* return 'ok' */
+}  /* snapshot() */
+
+/*--------------------------------------------------------------------*/
+
+static void restore (TASRC *src)
+{                               /* --- restore item base statistics */
+  ITEM     i;                   /* loop variable for items */
+  ITEMBASE *base;               /* underlying item base */
+  SUPP     *p;                  /* to traverse the frequencies */
+
+  assert(src);                  /* check the function argument */
+  base = src->base;             /* get the underlying item base */
+  if (ib_cnt(base) > src->icnt) /* remove items that were added */
+    ib_trunc(base, src->icnt);  /* during a re-scan of the source */
+  for (p = src->frqs, i = 0; i < src->icnt; i++) {
+    ib_setfrq(base, i, *p++);   /* traverse the items and */
+    ib_setxfq(base, i, *p++);   /* restore the item frequencies */
+  }                             /* to those of the first pass */
+  ib_setwgt(base, src->wgt);    /* restore the total weight */
+  base->max = src->imax;        /* and the maximum item support */
+}  /* restore() */
+
+/*--------------------------------------------------------------------*/
+
+static int endscan (TASRC *src)
+{                               /* --- finish the first pass */
+  assert(src);                  /* check the function argument */
+  if (src->cache) {             /* if a binary cache is written */
+    if (fflush(src->cache) != 0) return src->err = E_FWRITE;
+    src->buf = (TRACT*)malloc(sizeof(TRACT)
+                             +(size_t)(src->max+1) *sizeof(ITEM));
+    if (!src->buf) return src->err = E_NOMEM;
+    src->size = src->max;       /* create a buffer for transactions */
+  }                             /* that are read from the cache */
+  if (snapshot(src) != 0) return src->err;
+  src->pass = 1;                /* note the item base statistics */
+  return 1;                     /* and the completed first pass */
+}  /* endscan() */
+
+/*--------------------------------------------------------------------*/
+
+static int rdcache (TASRC *src)
+{                               /* --- read a cached transaction */
+  ITEM  k;                      /* number of items */
+  TRACT *t;                     /* transaction buffer */
+
+  assert(src && src->cache);    /* check the function argument */
+  t = src->buf;                 /* get the transaction buffer */
+  if (fread(&t->wgt, sizeof(SUPP), 1, src->cache) != 1)
+    return (ferror(src->cache)) ? (src->err = E_FREAD) : 1;
+  if ((fread(&k, sizeof(ITEM), 1, src->cache) != 1)
+  ||  (k < 0) || (k > src->size)
+  ||  (fread(t->items, sizeof(ITEM), (size_t)k, src->cache)
+       != (size_t)k))           /* read the transaction size */
+    return src->err = E_FREAD;  /* and the transaction items */
+  t->size = k;                  /* store the transaction size */
+  t->items[k] = TA_END;         /* and a sentinel after the items */
+  return 0;                     /* return 'ok' */
+}  /* rdcache() */
+
+/*--------------------------------------------------------------------*/
+
+static int wrcache (TASRC *src, const TRACT *t)
+{                               /* --- write a transaction to cache */
+  assert(src && src->cache && t);  /* check the function arguments */
+  if ((fwrite(&t->wgt,  sizeof(SUPP), 1, src->cache) != 1)
+  ||  (fwrite(&t->size, sizeof(ITEM), 1, src->cache) != 1)
+  ||  (fwrite(t->items, sizeof(ITEM), (size_t)t->size, src->cache)
+       != (size_t)t->size))     /* write the transaction weight, */
+    return src->err = E_FWRITE; /* the transaction size and */
+  return 0;                     /* the transaction items */
+}  /* wrcache() */
+
+/*----------------------------------------------------------------------
+  Transaction Source Functions
+----------------------------------------------------------------------*/
+
+TASRC* tsrc_create (ITEMBASE *base, int mode)
+{                               /* --- create a transaction source */
+  TASRC *src;                   /* created transaction source */
+
+  assert(base                   /* check the function arguments */
+  &&   !(ib_mode(base) & IB_WEIGHTS));
+  src = (TASRC*)malloc(sizeof(TASRC));
+  if (!src) return NULL;        /* create a transaction source */
+  src->base  = base;            /* and initialize the fields */
+  src->type  = TSRC_NONE;
+  src->mode  = mode;
+  src->pass  = 0;
+  src->app   = ib_getapp(base, -1);
+  src->trd   = NULL; src->name  = NULL;
+  src->cache = NULL; src->cname = NULL;
+  src->fn    = 0;    src->data  = NULL;
+  src->map   = NULL; src->icnt  = 0;
+  src->marks = NULL; src->min   = 0;
+  src->cnt   = 0;    src->wgt   = 0;
+  src->max   = 0;    src->imax  = 0;
+  src->frqs  = NULL;
+  src->size  = 0;    src->buf   = NULL;
+  src->err   = 0;
+  return src;                   /* return created transaction source */
+}  /* tsrc_create() */
+
+/*--------------------------------------------------------------------*/
+
+void tsrc_delete (TASRC *src, int deltrd)
+{                               /* --- delete a transaction source */
+  assert(src);                  /* check the function argument */
+  #ifdef TA_READ                /* if transaction reading capability */
+  if (src->trd && deltrd) trd_delete(src->trd, 1);
+  #endif                        /* delete the table reader */
+  if (src->cache) fclose(src->cache);
+  if (src->buf)   free(src->buf);
+  if (src->frqs)  free(src->frqs);
+  if (src->map)   free(src->map);
+  free(src);                    /* delete the buffers and */
+}  /* tsrc_delete() */          /* the base structure */
+
+/*--------------------------------------------------------------------*/
+#ifdef TA_READ
+
+int tsrc_file (TASRC *src, TABREAD *trd, const char *cache)
+{                               /* --- set a file as the source */
+  assert(src && trd             /* check the function arguments */
+  &&    (src->type == TSRC_NONE) && trd_file(trd));
+  if (!cache                    /* standard input cannot be */
+  &&  (trd_file(trd) == stdin)) /* re-read without a cache */
+    return src->err = E_FOPEN;
+  src->trd  = trd;              /* note the table reader */
+  src->name = trd_name(trd);    /* and the name of the file */
+  src->type = TSRC_FILE;        /* (needed to reopen the file) */
+  if (!cache) return 0;         /* if no cache file is requested, */
+  src->cname = cache;           /* abort the function */
+  src->cache = fopen(cache, "w+b");
+  if (!src->cache) return src->err = E_FOPEN;
+  src->type = TSRC_CACHE;       /* open the binary cache file */
+  return 0;                     /* return 'ok' */
+}  /* tsrc_file() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+int tsrc_func (TASRC *src, TSRCFN *fn, void *data)
+{                               /* --- set a callback as the source */
+  assert(src && fn              /* check the function arguments */
+  &&    (src->type == TSRC_NONE));
+  src->fn   = fn;               /* note the callback function */
+  src->data = data;             /* and the user data */
+  src->type = TSRC_FUNC;        /* set the source type */
+  return 0;                     /* return 'ok' */
+}  /* tsrc_func() */
+
+/*--------------------------------------------------------------------*/
+
+TID tsrc_scan (TASRC *src)
+{                               /* --- execute the first pass */
+  int   r;                      /* result of tsrc_next() */
+  TRACT *t;                     /* to traverse the transactions */
+
+  assert(src && (src->type != TSRC_NONE));
+  if (src->pass > 0)            /* if the first pass is done, */
+    return src->cnt;            /* simply return the trans. count */
+  while ((r = tsrc_next(src, &t)) == 0)
+    ;                           /* read all transactions */
+  return (r < 0) ? (TID)r : src->cnt;
+}  /* tsrc_scan() */            /* return the number of transactions */
+
+/*--------------------------------------------------------------------*/
+
+ITEM tsrc_recode (TASRC *src, SUPP min, SUPP max, ITEM cnt, int dir)
+{                               /* --- recode items w.r.t. frequency */
+  ITEM *map;                    /* identifier map for recoding */
+
+  assert(src);                  /* check the function arguments */
+  if (tsrc_scan(src) < 0)       /* execute the first pass */
+    return -1;                  /* (to determine item frequencies) */
+  map = (ITEM*)realloc(src->map, (size_t)ib_cnt(src->base)
+                                *sizeof(ITEM));
+  if (!map) { src->err = E_NOMEM; return -1; }
+  src->map = map;               /* create an item identifier map */
+  cnt = ib_recode(src->base, min, max, cnt, dir, map);
+  if (snapshot(src) != 0) return -1;
+  return cnt;                   /* recode the items and note the */
+}  /* tsrc_recode() */          /* new item base statistics */
+
+/*--------------------------------------------------------------------*/
+
+int tsrc_rewind (TASRC *src)
+{                               /* --- restart a transaction source */
+  assert(src && (src->type != TSRC_NONE)
+  &&    (src->pass > 0));       /* check the function argument */
+  if      (src->type == TSRC_CACHE) {
+    rewind(src->cache); }       /* restart reading the cache */
+  #ifdef TA_READ                /* if transaction reading capability */
+  else if (src->type == TSRC_FILE) {
+    trd_close(src->trd);        /* close and reopen the file */
+    if (trd_open(src->trd, NULL, src->name) != 0)
+      return src->err = E_FOPEN; }
+  #endif
+  else {                        /* if the source is a function, */
+    if (src->fn(src->base, src->data, 1) != 0)
+      return src->err = E_FREAD;/* let the function restart */
+  }
+  return 0;                     /* return 'ok' */
+}  /* tsrc_rewind() */
+
+/*--------------------------------------------------------------------*/
+
+int tsrc_next (TASRC *src, TRACT **tract)
+{                               /* --- get the next transaction */
+  int   r;                      /* result of read function */
+  ITEM  i, n;                   /* item buffer, number of items */
+  ITEM  *s, *d;                 /* to traverse the items */
+  TRACT *t;                     /* to access the transaction */
+
+  assert(src && tract && (src->type != TSRC_NONE));
+
+  /* --- first pass: read and note the transactions --- */
+  if (src->pass <= 0) {         /* if in the first pass */
+    r = READ(src);              /* read the next transaction */
+    if (r < 0) return src->err = r;
+    if (r > 0) return endscan(src);
+    *tract = t = ib_tract(src->base);
+    src->cnt += 1;              /* count the transaction and */
+    if (t->size > src->max)     /* update the maximum size */
+      src->max = t->size;       /* and write to the cache file */
+    return (src->cache) ? wrcache(src, t) : 0;
+  }
+
+  /* --- later passes: recode and filter the transactions --- */
+  do {                          /* read until a trans. qualifies */
+    if (src->type == TSRC_CACHE) {
+      r = rdcache(src);         /* read a transaction from the cache */
+      t = src->buf; }           /* (original item identifiers) */
+    else {                      /* if to re-read the source */
+      ib_setapp(src->base, -1, APP_NONE);
+      r = READ(src);            /* ignore unknown items and read */
+      ib_setapp(src->base, -1, src->app);  /* the next transaction */
+      t = ib_tract(src->base);  /* (current item identifiers) */
+    }
+    if (r < 0) return src->err = r;
+    if (r > 0) {                /* if at the end of the source */
+      if (src->type != TSRC_CACHE) restore(src);
+      src->pass += 1; return 1; /* restore item base statistics */
+    }                           /* and count the completed pass */
+    n = src->icnt;              /* get the number of items */
+    for (s = d = t->items; *s > TA_END; s++) {
+      i = *s;                   /* traverse the transaction items */
+      if ((src->type == TSRC_CACHE) && src->map)
+        i = src->map[i];        /* map cached items to new codes */
+      if ((i < 0) || (i >= n)   /* skip removed/new items */
+      ||  (src->marks && !src->marks[i]))
+        continue;               /* and items that are not used */
+      *d++ = i;                 /* store the (recoded) item */
+    }
+    t->size = (ITEM)(d -t->items);
+    t->items[t->size] = TA_END; /* store a sentinel after the items */
+  } while (t->size < src->min); /* skip transactions that are short */
+  ia_qsort(t->items, (size_t)t->size, +1);
+  *tract = t;                   /* sort the items in the transaction */
+  return 0;                     /* and return 'ok' */
+}  /* tsrc_next() */
+
+/*----------------------------------------------------------------------
+A transaction source delivers transactions one by one (pull model),
+so that the transactions need not be kept in memory. The first pass
+through a source determines the item frequencies and the transaction
+statistics (standard item base mechanism). Afterwards the items can
+be recoded with tsrc_recode() and any number of further passes can be
+executed, each started with tsrc_rewind(). In these passes the items
+are delivered with their new codes and sorted ascendingly; removed
+items are dropped, as are items that are not marked with the filter
+set with tsrc_filter(). Transactions smaller than the minimum size
+given to tsrc_filter() are skipped.
+  A file source re-parses the transaction file in every pass, which
+requires that it can be reopened (it must not be standard input).
+With a binary cache file the transactions are written to the cache
+in the first pass and read from there (with item identifiers mapped
+to the new codes) in all later passes, which avoids the (often more
+expensive) parsing of the transaction file. Since re-parsing updates
+the item frequencies in the item base, these are restored at the end
+of every later pass, so that they always reflect the first pass.
+----------------------------------------------------------------------*/
@@ -0,0 +1,95 @@
+/*----------------------------------------------------------------------
+  File    : tasrc.h
+  Contents: transaction source management (multi-pass streaming)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+----------------------------------------------------------------------*/
+#ifndef __TASRC__
+#define __TASRC__
+#include <stdio.h>
+#include "tract.h"
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+/* --- transaction source types --- */
+#define TSRC_NONE   0           /* no source set yet */
+#define TSRC_FILE   1           /* table/transaction file (re-parsed) */
+#define TSRC_CACHE  2           /* file with binary cache for passes */
+#define TSRC_FUNC   3           /* user-defined callback function */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef int TSRCFN (ITEMBASE *base, void *data, int rewind);
+/* The callback function has to fill the transaction buffer of the */
+/* item base (ib_clear(), ib_add2ta(), ib_finta()) and to return 0 */
+/* if a transaction was delivered, > 0 at the end of the data and  */
+/* < 0 on an error. With rewind != 0 it only has to restart.       */
+
+typedef struct {                /* --- transaction source --- */
+  ITEMBASE *base;               /* underlying item base */
+  int      type;                /* source type (e.g. TSRC_FILE) */
+  int      mode;                /* read mode (e.g. TA_WEIGHT) */
+  int      pass;                /* number of completed passes */
+  int      app;                 /* default appearance of item base */
+  #ifdef TA_READ                /* if transaction reading capability */
+  TABREAD  *trd;                /* table/transaction reader */
+  #else                         /* if no transaction reading */
+  void     *trd;                /* placeholder (for fixed size) */
+  #endif
+  const char *name;             /* name of the transaction file */
+  FILE     *cache;              /* binary cache file (if any) */
+  const char *cname;            /* name of the binary cache file */
+  TSRCFN   *fn;                 /* callback function for transactions */
+  void     *data;               /* user data for callback function */
+  ITEM     *map;                /* item map for cached transactions */
+  ITEM     icnt;                /* number of items after recoding */
+  const int *marks;             /* item markers for filtering */
+  ITEM     min;                 /* minimum size of a transaction */
+  TID      cnt;                 /* number of transactions */
+  SUPP     wgt;                 /* total weight of transactions */
+  ITEM     max;                 /* number of items in largest trans. */
+  SUPP     imax;                /* maximum support of an item */
+  SUPP     *frqs;               /* item frequencies after first pass */
+  ITEM     size;                /* size of the transaction buffer */
+  TRACT    *buf;                /* buffer for a cached transaction */
+  int      err;                 /* error code */
+} TASRC;                        /* (transaction source) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern TASRC*    tsrc_create  (ITEMBASE *base, int mode);
+extern void      tsrc_delete  (TASRC *src, int deltrd);
+#ifdef TA_READ
+extern int       tsrc_file    (TASRC *src, TABREAD *trd,
+                               const char *cache);
+#endif
+extern int       tsrc_func    (TASRC *src, TSRCFN *fn, void *data);
+extern ITEMBASE* tsrc_base    (TASRC *src);
+extern int       tsrc_type    (TASRC *src);
+extern TID       tsrc_cnt     (TASRC *src);
+extern SUPP      tsrc_wgt     (TASRC *src);
+extern ITEM      tsrc_max     (TASRC *src);
+extern int       tsrc_error   (TASRC *src);
+
+extern TID       tsrc_scan    (TASRC *src);
+extern ITEM      tsrc_recode  (TASRC *src, SUPP min, SUPP max,
+                               ITEM cnt, int dir);
+extern void      tsrc_filter  (TASRC *src, ITEM min, const int *marks);
+extern int       tsrc_rewind  (TASRC *src);
+extern int       tsrc_next    (TASRC *src, TRACT **tract);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define tsrc_base(s)      ((s)->base)
+#define tsrc_type(s)      ((s)->type)
+#define tsrc_cnt(s)       ((s)->cnt)
+#define tsrc_wgt(s)       ((s)->wgt)
+#define tsrc_max(s)       ((s)->max)
+#define tsrc_error(s)     ((s)->err)
+#define tsrc_filter(s,n,m) ((s)->min = (n), (s)->marks = (m))
+
+#endif
@@ -90,6 +90,13 @@
             2014.10.17 function ib_clear() made a proper function
             2014.10.24 changed from LGPL license to MIT license
             2015.02.27 more item appearance indicator strings added
+            2026.10.16 function tbg_reclus() added (co-occurrence order)
+            2026.10.16 parallel surrogate batch functions added (tbs_...)
+            2026.10.16 bit-represented transactions added (ta_bits())
+            2026.10.16 function tbs_setpin() added (pin surrogate workers)
+            2026.10.17 serial version of tbs_next() (without USE_THREADS)
+            2026.10.17 test main function for surrogate batches (TBS_MAIN)
+            2026.10.17 comment on memory placement of pinned workers
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -101,7 +108,10 @@
 #include <time.h>
 #include <assert.h>
 #include "tract.h"
-#ifdef TA_MAIN
+#if defined TA_SURR && defined USE_THREADS
+#include "threads.h"
+#endif
+#if defined TA_MAIN || defined TBS_MAIN
 #include "error.h"
 #endif
 #ifdef STORAGE
@@ -139,12 +149,26 @@
 #define E_OPTARG     (-7)       /* missing option argument */
 #define E_ARGCNT     (-8)       /* too few/many arguments */
 #define E_ITEMCNT    (-9)       /* invalid number of items */
+#define E_CHECK     (-10)       /* consistency check failed */
 /* error codes -15 to -25 defined in tract.h */
 
 #define BLKSIZE      1024       /* block size for enlarging arrays */
 #define TH_INSERT       8       /* threshold for insertion sort */
+#define CL_WINDOW      16       /* window for co-occurrence order */
 #define TS_PRIMES    (sizeof(primes)/sizeof(*primes))
 
+#if defined TA_SURR && !defined USE_THREADS
+#define THR_MAX       1         /* if not to use threads, */
+#define THR_NOPIN     (-1)      /* only use the calling thread */
+#define WORKERDEF(n,p) void* n (void *p)
+#define THREAD_OK     NULL      /* return value of a worker */
+#endif
+
+#ifdef TBS_MAIN
+#define SEED         4711       /* seed for the surrogate test */
+#define SLOTS           5       /* number of surrogates per batch */
+#endif
+
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
 #define CLOCK(t)    ((t) = clock())
@@ -220,7 +244,8 @@ static CCHAR *errmsgs[] = {     /* error messages */
   /* E_OPTARG   -7 */  "missing option argument",
   /* E_ARGCNT   -8 */  "wrong number of arguments",
   /* E_ITEMCNT  -9 */  "invalid number of items (must be <= 16)",
-  /*    -10 to -14 */  NULL, NULL, NULL, NULL, NULL,
+  /* E_CHECK   -10 */  "check failed: %s",
+  /*    -11 to -14 */  NULL, NULL, NULL, NULL,
   /* E_NOITEMS -15 */  "no (frequent) items found",
   /* E_ITEMEXP -16 */  "#item expected",
   /* E_ITEMWGT -17 */  "#invalid item weight %s",
@@ -248,6 +273,13 @@ static TABREAD  *tread = NULL;  /* table/transaction reader */
 static ITEMBASE *ibase = NULL;  /* item base */
 static TABAG    *tabag = NULL;  /* transaction bag/multiset */
 #endif
+#ifdef TBS_MAIN
+static CCHAR    *prgname;       /* program name for error messages */
+static ITEMBASE *ibase = NULL;  /* item base */
+static TABAG    *tabag = NULL;  /* transaction bag/multiset */
+static RNG      *rng   = NULL;  /* random number generator */
+static TBGSURR  *sbs[2] = { NULL, NULL };  /* surrogate batches */
+#endif
 
 #ifdef TA_READ                  /* if transaction reading capability */
 static char msgbuf[2*TRD_MAXLEN+64];
@@ -855,16 +887,41 @@ int ib_write (ITEMBASE *base, TABWRITE *twr, const char *wgtfmt, ...)
 #endif
 /*--------------------------------------------------------------------*/
 
+static void ib_remap (ITEMBASE *base, const ITEM *map)
+{                               /* --- recode buffered transaction */
+  ITEM   i;                     /* item buffer */
+  TRACT  *t;                    /* to access the standard transaction */
+  ITEM   *s, *d;                /* to traverse the items */
+  WTRACT *x;                    /* to access the extended transaction */
+  WITEM  *a, *b;                /* to traverse the items */
+
+  assert(base && map);          /* check the function arguments */
+  if (base->mode & IB_WEIGHTS){ /* if the items carry weights */
+    x = (WTRACT*)base->tract;   /* traverse the buffered transaction */
+    for (a = b = x->items; a->item >= 0; a++) {
+      i = map[a->item];         /* recode all items and remove */
+      if (i >= 0) (b++)->item = i;      /* all items to ignore */
+    }                           /* from the buffered transaction */
+    x->size = (ITEM)(b -x->items); /* compute the new number of items */
+    x->items[x->size] = WTA_END; } /* store sentinel after the items */
+  else {                        /* if the items do not carry weights */
+    t = (TRACT*)base->tract;    /* traverse the buffered transaction */
+    for (s = d = t->items; *s > TA_END; s++) {
+      i = map[*s];              /* recode all items and */
+      if (i >= 0) *d++ = i;     /* remove all items to ignore */
+    }                           /* from the buffered transaction */
+    t->size = (ITEM)(d -t->items);
+    t->items[t->size] = TA_END; /* compute the new number of items */
+  }                             /* store a sentinel after the items */
+}  /* ib_remap() */
+
+/*--------------------------------------------------------------------*/
+
 ITEM ib_recode (ITEMBASE *base, SUPP min, SUPP max,
                 ITEM cnt, int dir, ITEM *map)
 {                               /* --- recode items w.r.t. frequency */
   ITEM     k, n;                /* loop variables */
-  ITEM     i;                   /* item buffer */
   ITEMDATA *itd;                /* to traverse the items */
-  TRACT    *t;                  /* to access the standard transaction */
-  ITEM     *s, *d;              /* to traverse the items */
-  WTRACT   *x;                  /* to access the extended transaction */
-  WITEM    *a, *b;              /* to traverse the items */
   CMPFN    *cmp;                /* comparison function */
 
   assert(base);                 /* check the function arguments */
@@ -889,23 +946,7 @@ ITEM ib_recode (ITEMBASE *base, SUPP min, SUPP max,
   if (!map) return n;           /* if no map is provided, abort */
   while (k > 0)                 /* mark all removed items */
     if (map[--k] >= n) map[k] = -1;
-  if (base->mode & IB_WEIGHTS){ /* if the items carry weights */
-    x = (WTRACT*)base->tract;   /* traverse the buffered transaction */
-    for (a = b = x->items; a->item >= 0; a++) {
-      i = map[a->item];         /* recode all items and remove */
-      if (i >= 0) (b++)->item = i;      /* all items to ignore */
-    }                           /* from the buffered transaction */
-    x->size = (ITEM)(b -x->items); /* compute the new number of items */
-    x->items[x->size] = WTA_END; } /* store sentinel after the items */
-  else {                        /* if the items do not carry weights */
-    t = (TRACT*)base->tract;    /* traverse the buffered transaction */
-    for (s = d = t->items; *s > TA_END; s++) {
-      i = map[*s];              /* recode all items and */
-      if (i >= 0) *d++ = i;     /* remove all items to ignore */
-    }                           /* from the buffered transaction */
-    t->size = (ITEM)(d -t->items);
-    t->items[t->size] = TA_END; /* compute the new number of items */
-  }                             /* store a sentinel after the items */
+  ib_remap(base, map);          /* recode the buffered transaction */
   return n;                     /* return number of frequent items */
 }  /* ib_recode() */
 
@@ -1009,6 +1050,34 @@ int ta_bitmark (TRACT *t)
 
 /*--------------------------------------------------------------------*/
 
+BITTA ta_bits (const TRACT *t)
+{                               /* --- get items as a bit mask */
+  BITTA bits;                   /* bits representing items 0 to 63 */
+  const ITEM *s;                /* to traverse the items */
+
+  assert(t);                    /* check the function argument */
+  for (bits = 0, s = t->items; *s > TA_END; s++) {
+    if      (*s <  0)         bits |= (BITTA)(*s & ~TA_END);
+    else if (*s < BT_MAXCNT)  bits |= (BITTA)1 << *s;
+  }                             /* set bits for items 0 to 63 */
+  return bits;                  /* return the item bits */
+}  /* ta_bits() */
+
+/*--------------------------------------------------------------------*/
+#ifndef bt_popcnt
+
+int bt_popcnt (BITTA bits)
+{                               /* --- count the set bits */
+  bits -=  (bits >> 1) & 0x5555555555555555ULL;
+  bits  = ((bits >> 2) & 0x3333333333333333ULL)
+        +  (bits       & 0x3333333333333333ULL);
+  bits  = ((bits >> 4) +bits) & 0x0f0f0f0f0f0f0f0fULL;
+  return (int)((bits *0x0101010101010101ULL) >> 56);
+}  /* bt_popcnt() */            /* sum the bit counts of the bytes */
+
+#endif
+/*--------------------------------------------------------------------*/
+
 void ta_sort (TRACT *t, int dir)
 {                               /* --- sort items in transaction */
   ITEM n;                       /* number of items */
@@ -1643,6 +1712,7 @@ TABAG* tbg_create (ITEMBASE *base)
   bag->icnts  = NULL;
   bag->ifrqs  = NULL;
   bag->buf    = NULL;
+  bag->bits   = NULL;
   return bag;                   /* return the created t.a. bag */
 }  /* tbg_create() */
 
@@ -1658,6 +1728,7 @@ void tbg_delete (TABAG *bag, int delib)
     free(bag->tracts);          /* delete all transactions */
   }                             /* and the transaction array */
   if (bag->icnts) free(bag->icnts);
+  if (bag->bits)  free(bag->bits);
   if (delib) ib_delete(bag->base);
   free(bag);                    /* delete the item base and */
 }  /* tbg_delete() */           /* the transaction bag body */
@@ -1990,6 +2061,101 @@ ITEM tbg_recode (TABAG *bag, SUPP min, SUPP max, ITEM cnt, int dir)
 
 /*--------------------------------------------------------------------*/
 
+static int rnkcmp (const void *p1, const void *p2, void *data)
+{                               /* --- compare item ranks */
+  ITEM a = ((const ITEM*)data)[((const ITEMDATA*)p1)->id];
+  ITEM b = ((const ITEM*)data)[((const ITEMDATA*)p2)->id];
+
+  if (a > b) return +1;         /* get the new ranks of the items */
+  if (a < b) return -1;         /* from the rank map and */
+  return 0;                     /* return sign of rank difference */
+}  /* rnkcmp() */
+
+/*--------------------------------------------------------------------*/
+
+ITEM tbg_reclus (TABAG *bag, SUPP min, SUPP max, ITEM cnt, int dir,
+                 TID smpl)
+{                               /* --- recode w.r.t. co-occurrence */
+  ITEM   i, k, n, x, y;         /* loop variables, number of items */
+  ITEM   last, best;            /* last placed and best next item */
+  TID    t, step;               /* loop variable, sampling step */
+  SUPP   c, b;                  /* co-occurrence counters */
+  SUPP   *occ;                  /* banded co-occurrence matrix */
+  ITEM   *map;                  /* rank map for recoding */
+  ITEM   *buf;                  /* buffer for transaction items */
+  TRACT  *p;                    /* to traverse the transactions */
+  WTRACT *w;                    /* to traverse the transactions */
+
+  assert(bag);                  /* check the function arguments */
+  n = tbg_recode(bag, min, max, cnt, dir);
+  if (n <= 2) return n;         /* recode w.r.t. frequency first */
+  occ = (SUPP*)calloc((size_t)n *CL_WINDOW, sizeof(SUPP));
+  if (!occ) return -1;          /* create co-occurrence matrix */
+  map = (ITEM*)malloc((size_t)(n +bag->max +1) *sizeof(ITEM));
+  if (!map) { free(occ); return -1; }
+  buf = map +n;                 /* create rank map and item buffer */
+
+  /* --- count co-occurrences of nearby items --- */
+  step = ((smpl > 0) && (bag->cnt > smpl)) ? bag->cnt /smpl : 1;
+  for (t = 0; t < bag->cnt; t += step) {
+    if (bag->mode & IB_WEIGHTS){/* if the items carry weights */
+      w = (WTRACT*)bag->tracts[t];
+      for (k = 0; k < w->size; k++) buf[k] = w->items[k].item;
+      c = w->wgt; }             /* copy the items of the transaction */
+    else {                      /* if the items do not carry weights */
+      p = (TRACT*)bag->tracts[t];
+      memcpy(buf, p->items, (size_t)(k = p->size) *sizeof(ITEM));
+      c = p->wgt;               /* copy the items of the transaction */
+    }                           /* and get the transaction weight */
+    ia_qsort(buf, (size_t)k, +1);
+    for (i = 0; i < k; i++) {   /* traverse the items and count */
+      for (x = i; ++x < k; ) {  /* pairs within the order window */
+        y = buf[x] -buf[i];     /* (only a band of the matrix) */
+        if (y > CL_WINDOW) break;
+        if (y > 0) occ[(size_t)buf[i] *CL_WINDOW +(size_t)(y-1)] += c;
+      }
+    }
+  }
+
+  /* --- greedily chain co-occurring items --- */
+  for (i = 0; i < n; i++) map[i] = -1;
+  map[last = 0] = 0;            /* keep the first item in place */
+  for (i = k = 1; k < n; k++) { /* traverse the ranks to assign */
+    while (map[i] >= 0) i++;    /* find the first unplaced item */
+    b = -1; best = i;           /* init. the best candidate */
+    for (x = i, y = 0; (x < n) && (y < CL_WINDOW); x++) {
+      if (map[x] >= 0) continue;/* traverse the unplaced items */
+      y++;                      /* within the order window */
+      if      ((x > last) && (x -last <= CL_WINDOW))
+        c = occ[(size_t)last *CL_WINDOW +(size_t)(x-last-1)];
+      else if ((x < last) && (last -x <= CL_WINDOW))
+        c = occ[(size_t)x    *CL_WINDOW +(size_t)(last-x-1)];
+      else c = 0;               /* get the co-occurrence counter */
+      if (c > b) { b = c; best = x; }
+    }                           /* find the strongest co-occurrence */
+    map[last = best] = k;       /* (ties are resolved by frequency) */
+  }                             /* and place the found item next */
+  free(occ);                    /* delete the co-occurrence matrix */
+
+  /* --- recode items and transactions --- */
+  idm_sort(bag->base->idmap, rnkcmp, map, NULL, 0);
+  ib_remap(bag->base, map);     /* reorder the item base */
+  recode(bag, map);             /* and recode the transactions */
+  free(map);                    /* delete the rank map */
+  return n;                     /* return the number of items */
+}  /* tbg_reclus() */
+
+/* The items are first sorted w.r.t. their frequency. Then, starting  */
+/* with the first item, the next item is chosen greedily among the    */
+/* next CL_WINDOW unplaced items as the one that co-occurs most often */
+/* with the item placed last. Hence the frequency order is preserved  */
+/* roughly, but items that tend to appear in the same transactions    */
+/* receive close codes, so that the counters of an item set tree node */
+/* that are updated for a transaction lie closer together in memory. */
+/* Co-occurrences are counted on (at most) smpl transactions.         */
+
+/*--------------------------------------------------------------------*/
+
 void tbg_filter (TABAG *bag, ITEM min, const int *marks, double wgt)
 {                               /* --- filter (items in) transactions */
   TID    n;                     /* loop variable for transactions */
@@ -2371,6 +2537,35 @@ void tbg_bitmark (TABAG *bag)
 
 /*--------------------------------------------------------------------*/
 
+const BITTA* tbg_bits (TABAG *bag)
+{                               /* --- get bit-represented trans. */
+  TID   i;                      /* loop variable */
+  BITTA *bits;                  /* bit-represented transactions */
+
+  assert(bag                    /* check the function arguments */
+  &&   !(bag->mode & IB_WEIGHTS));
+  if (ib_cnt(bag->base) > BT_MAXCNT)
+    return NULL;                /* check the number of items */
+  bits = (BITTA*)realloc(bag->bits, (size_t)(bag->cnt+1) *sizeof(BITTA));
+  if (!bits) return NULL;       /* (re)allocate the bit array */
+  bag->bits = bits;             /* and store it in the bag */
+  for (i = 0; i < bag->cnt; i++)/* represent transactions as bits */
+    bits[i] = ta_bits((TRACT*)bag->tracts[i]);
+  return bits;                  /* return the bit representations */
+}  /* tbg_bits() */
+
+/*----------------------------------------------------------------------
+If the item base contains at most 64 items, each transaction can be
+represented by a single 64 bit integer, in which bit i is set if item
+i is contained in the transaction. The function tbg_bits() computes
+these bit masks for the current state of the transaction bag. The
+masks are not updated automatically, so they have to be recomputed
+(by calling this function again) whenever the transaction bag has
+been modified (e.g. by tbg_filter() or tbg_reduce()).
+----------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+
 void tbg_pack (TABAG *bag, int n)
 {                               /* --- pack all transactions */
   TID i;                        /* loop variable */
@@ -2790,6 +2985,136 @@ TABAG* tbg_shuffle (TABAG *src, RNG *rng, TABAG *dst)
   return dst;                   /* return the created surrogate */
 }  /* tbg_shuffle() */
 
+/*--------------------------------------------------------------------*/
+
+typedef struct {                /* --- surrogate batch worker --- */
+  TBGSURR *sb;                  /* surrogate batch to generate */
+  int     id;                   /* index of first slot to process */
+  int     step;                 /* step width between slots */
+  int     err;                  /* number of failed slots */
+} TBSWORK;                      /* (surrogate batch worker) */
+
+/*--------------------------------------------------------------------*/
+
+static unsigned int mixseed (unsigned int seed, unsigned int i)
+{                               /* --- derive seed for a slot */
+  seed += (i+1) *0x9e3779b9u;   /* add a multiple of golden ratio */
+  seed ^= seed >> 16; seed *= 0x85ebca6bu;
+  seed ^= seed >> 13; seed *= 0xc2b2ae35u;
+  seed ^= seed >> 16;           /* mix the bits (hash finalizer) */
+  return seed;                  /* return the derived seed */
+}  /* mixseed() */
+
+/*--------------------------------------------------------------------*/
+
+static WORKERDEF(tbs_work, p)
+{                               /* --- generate surrogates of a batch */
+  int     i;                    /* loop variable for slots */
+  TABAG   *bag;                 /* created/updated surrogate */
+  TBSWORK *w = (TBSWORK*)p;     /* type the worker data */
+  TBGSURR *sb = w->sb;          /* get the surrogate batch */
+
+  for (i = w->id; i < sb->cnt; i += w->step) {
+    bag = sb->fn(sb->src, sb->rngs[i], sb->bags[i]);
+    if (!bag) { w->err++; continue; }
+    sb->bags[i] = bag;          /* generate the next surrogate */
+  }                             /* and store it for reuse */
+  return THREAD_OK;             /* return a dummy result */
+}  /* tbs_work() */
+
+/*--------------------------------------------------------------------*/
+
+TBGSURR* tbs_create (TABAG *src, TBGSURRFN *fn, int cnt,
+                     unsigned int seed, int thcnt)
+{                               /* --- create a surrogate batch */
+  int     i;                    /* loop variable */
+  TBGSURR *sb;                  /* created surrogate batch */
+
+  assert(src && fn && (cnt > 0));  /* check the function arguments */
+  sb = (TBGSURR*)malloc(sizeof(TBGSURR));
+  if (!sb) return NULL;         /* create the base structure */
+  sb->rngs = (RNG**)  calloc((size_t)cnt, sizeof(RNG*));
+  sb->bags = (TABAG**)calloc((size_t)cnt, sizeof(TABAG*));
+  if (!sb->rngs || !sb->bags) { /* create the slot arrays */
+    if (sb->rngs) free(sb->rngs);
+    free(sb); return NULL;      /* on failure delete */
+  }                             /* the partial structure */
+  sb->src  = src; sb->fn = fn;  /* store the parameters */
+  sb->cnt  = cnt; sb->seed = seed; sb->err = 0;
+  #ifdef USE_THREADS            /* if to use threads */
+  if (thcnt <= 0) thcnt = thr_cnt();
+  #endif                        /* (use all processors by default) */
+  if (thcnt > cnt)     thcnt = cnt;
+  if (thcnt > THR_MAX) thcnt = THR_MAX;
+  if (thcnt < 1)       thcnt = 1;
+  sb->thcnt = thcnt;            /* clamp the number of threads */
+  sb->pin   = THR_NOPIN;        /* and do not pin them by default */
+  for (i = 0; i < cnt; i++) {   /* create one generator per slot */
+    sb->rngs[i] = rng_create(mixseed(seed, (unsigned int)i));
+    if (!sb->rngs[i]) { tbs_delete(sb); return NULL; }
+  }                             /* (independent streams per slot) */
+  return sb;                    /* return the created batch */
+}  /* tbs_create() */
+
+/*--------------------------------------------------------------------*/
+
+void tbs_delete (TBGSURR *sb)
+{                               /* --- delete a surrogate batch */
+  int i;                        /* loop variable */
+
+  assert(sb);                   /* check the function argument */
+  for (i = 0; i < sb->cnt; i++) {
+    if (sb->bags[i]) tbg_delete(sb->bags[i], 0);
+    if (sb->rngs[i]) rng_delete(sb->rngs[i]);
+  }                             /* delete surrogates and generators */
+  free(sb->bags); free(sb->rngs);
+  free(sb);                     /* delete the slot arrays */
+}  /* tbs_delete() */           /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+int tbs_next (TBGSURR *sb)
+{                               /* --- generate next surrogate batch */
+  int     i;                    /* loop variable */
+  TBSWORK w[THR_MAX];           /* data of the worker threads */
+
+  assert(sb);                   /* check the function argument */
+  for (i = 0; i < sb->thcnt; i++) {
+    w[i].sb = sb; w[i].id = i; w[i].step = sb->thcnt; w[i].err = 0; }
+  #ifdef USE_THREADS            /* if to use threads */
+  if (thr_runp(tbs_work, w, sizeof(TBSWORK), sb->thcnt, sb->pin) != 0) {
+    sb->err = -1; return -1; }  /* if not all threads could be */
+  #else                         /* started, abort with an error */
+  for (i = 0; i < sb->thcnt; i++)
+    tbs_work(w+i);              /* run the workers sequentially */
+  #endif                        /* in the calling thread */
+  for (sb->err = 0, i = 0; i < sb->thcnt; i++)
+    sb->err += w[i].err;        /* sum the failed slots */
+  return (sb->err > 0) ? -1 : 0;/* return an error indicator */
+}  /* tbs_next() */
+
+/*----------------------------------------------------------------------
+A surrogate batch holds cnt slots, each with its own random number
+generator and its own surrogate transaction bag. The generators are
+seeded from the master seed and the slot index only, so that the
+generated surrogates do not depend on the number of threads that is
+used. The surrogate bags (together with their internal buffers) are
+created on the first call of tbs_next() and reused in all later calls,
+so that no memory is allocated after the first batch. Note that for
+tbg_swap() the surrogates of a slot form a chain (each surrogate is
+derived from the previous one by further swaps), as with the single
+surrogate function. All slots share the (read-only) source bag and
+its item base, so the surrogate functions must not modify them.
+With tbs_setpin() the worker threads can be pinned to processors
+(worker i to processor cpu+i). A worker always processes the same
+slots and allocates and initializes their surrogate bags itself, but
+no NUMA node is selected explicitly: where the bags are placed is left
+to the memory policy of the operating system. If the module is compiled
+without USE_THREADS, all slots are processed by the calling thread
+(the number of threads and the pinning processor are ignored), which
+yields the same surrogates.
+----------------------------------------------------------------------*/
+
 #endif
 /*----------------------------------------------------------------------
   Transaction Array Functions
@@ -3486,3 +3811,82 @@ int main (int argc, char *argv[])
 }  /* main() */
 
 #endif
+/*----------------------------------------------------------------------
+  Surrogate Batch Test
+----------------------------------------------------------------------*/
+#ifdef TBS_MAIN
+
+#ifndef NDEBUG                  /* if debug version */
+  #undef  CLEANUP               /* clean up memory and close files */
+  #define CLEANUP \
+  if (sbs[0]) tbs_delete(sbs[0]); \
+  if (sbs[1]) tbs_delete(sbs[1]); \
+  if (rng)    rng_delete(rng); \
+  if (tabag)  tbg_delete(tabag, 0); \
+  if (ibase)  ib_delete (ibase);
+#endif
+
+GENERROR(error, exit)           /* generic error reporting function */
+
+/*--------------------------------------------------------------------*/
+
+static int bagcmp (TABAG *a, TABAG *b)
+{                               /* --- compare two transaction bags */
+  TID k;                        /* loop variable for transactions */
+
+  assert(a && b);               /* check the function arguments */
+  if (tbg_cnt(a) != tbg_cnt(b)) return -1;
+  for (k = 0; k < tbg_cnt(a); k++)
+    if (ta_cmp(tbg_tract(a, k), tbg_tract(b, k), NULL) != 0)
+      return -1;                /* compare the transactions */
+  return 0;                     /* return 'equal' */
+}  /* bagcmp() */
+
+/*--------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{                               /* --- main function for testing */
+  int  i, k;                    /* loop variables */
+  TID  n;                       /* loop variable for transactions */
+  char name[2] = "a";           /* buffer for an item name */
+
+  prgname = argv[0];            /* get program name for error msgs. */
+  ibase = ib_create(0, 0);      /* create an item base */
+  if (!ibase) error(E_NOMEM);   /* and a transaction bag */
+  tabag = tbg_create(ibase);    /* to store the transactions */
+  if (!tabag) error(E_NOMEM);
+  rng = rng_create(SEED);       /* create a random number generator */
+  if (!rng) error(E_NOMEM);     /* for the source transactions */
+  for (n = 0; n < 200; n++) {   /* create random transactions */
+    ib_clear(ibase);            /* with skewed item frequencies */
+    for (k = 0; k < 16; k++) {  /* traverse the item candidates */
+      if (rng_dbl(rng) >= 1.0/(double)(k+2)) continue;
+      name[0] = (char)('a'+k);  /* draw whether the item occurs */
+      if (ib_add2ta(ibase, name) < 0) error(E_NOMEM);
+    }                           /* add the item to the transaction */
+    ib_finta(ibase, 1);         /* finalize the transaction */
+    if (tbg_addib(tabag) != 0) error(E_NOMEM);
+  }                             /* add it to the transaction bag */
+  for (k = 0; k < 2; k++) {     /* create two surrogate batches */
+    sbs[k] = tbs_create(tabag, tbg_swap, SLOTS, SEED, (k) ? 3 : 1);
+    if (!sbs[k]) error(E_NOMEM);/* with the same seed, but with */
+  }                             /* different numbers of threads */
+  for (i = 0; i < 3; i++) {     /* generate some batches */
+    for (k = 0; k < 2; k++)     /* (later batches reuse the bags) */
+      if (tbs_next(sbs[k]) != 0) error(E_NOMEM);
+    for (k = 0; k < SLOTS; k++) {
+      if (tbg_extent(tbs_bag(sbs[0], k)) != tbg_extent(tabag))
+        error(E_CHECK, "surrogate differs in size from source");
+      if (bagcmp(tbs_bag(sbs[0], k), tbs_bag(sbs[1], k)) != 0)
+        error(E_CHECK, "surrogates depend on the number of threads");
+    }                           /* the surrogates may depend only */
+  }                             /* on the seed and the slot index */
+  if (bagcmp(tbs_bag(sbs[0], 0), tbs_bag(sbs[0], 1)) == 0)
+    error(E_CHECK, "slots do not have independent streams");
+  printf("tbs: ok (%d batches of %d surrogates)\n", i, SLOTS);
+  CLEANUP;                      /* clean up memory */
+  SHOWMEM;                      /* show (final) memory usage */
+  return 0;                     /* return 'ok' */
+}  /* main() */
+
+#endif
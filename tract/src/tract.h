@@ -53,10 +53,15 @@
             2014.09.08 transaction marker functions added (ta_..mark())
             2014.09.09 function ib_frqcnt() added (num. of freq. items)
             2014.10.17 function ib_clear() made a proper function
+            2026.10.16 function tbg_reclus() added (co-occurrence order)
+            2026.10.16 parallel surrogate batch functions added (tbs_...)
+            2026.10.16 bit-represented transactions added (ta_bits())
+            2026.10.16 function tbs_setpin() added (pin surrogate workers)
 ----------------------------------------------------------------------*/
 #ifndef __TRACT__
 #define __TRACT__
 #include <math.h>
+#include <stdint.h>
 #include "arrays.h"
 #ifdef TA_SURR
 #include "random.h"
@@ -429,6 +434,9 @@
 /* --- transaction sentinel --- */
 #define TA_END      ITEM_MIN    /* sentinel for item instance arrays */
 
+/* --- bit-represented transactions --- */
+#define BT_MAXCNT   64          /* maximum number of items */
+
 /* --- transaction modes --- */
 #define TA_PACKED   0x1f        /* transactions have been packed */
 #define TA_EQPACK   0x20        /* treat packed items all the same */
@@ -472,6 +480,8 @@
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
+typedef uint64_t BITTA;         /* bit-represented transaction */
+
 typedef struct {                /* --- item data --- */
   ITEM     id;                  /* item identifier */
   int      app;                 /* appearance indicator */
@@ -530,6 +540,7 @@ typedef struct {                /* --- transaction bag/multiset --- */
   TID      *icnts;              /* number of transactions per item */
   SUPP     *ifrqs;              /* frequency of the items (weight) */
   void     *buf;                /* buffer for surrogate generation */
+  BITTA    *bits;               /* bit-represented transactions */
 } TABAG;                        /* (transaction bag/multiset) */
 
 #ifdef TATREEFN
@@ -568,6 +579,18 @@ typedef struct {                /* --- transaction tree --- */
 
 #ifdef TA_SURR
 typedef TABAG* TBGSURRFN (TABAG *src, RNG *rng, TABAG *dst);
+
+typedef struct {                /* --- batch of surrogate data sets --- */
+  TABAG     *src;               /* source transaction bag */
+  TBGSURRFN *fn;                /* surrogate generation function */
+  int       cnt;                /* number of surrogates per batch */
+  int       thcnt;              /* number of threads to use */
+  int       pin;                /* first processor for pinning */
+  unsigned int seed;            /* master seed for random streams */
+  int       err;                /* error indicator (failed slots) */
+  RNG       **rngs;             /* random number generators per slot */
+  TABAG     **bags;             /* surrogate transaction bags */
+} TBGSURR;                      /* (batch of surrogate data sets) */
 #endif
 /*----------------------------------------------------------------------
   Item Base Functions
@@ -640,6 +663,8 @@ extern SUPP         ta_wgt      (const TRACT *t);
 extern int          ta_setmark  (TRACT *t, int mark);
 extern int          ta_getmark  (const TRACT *t);
 extern int          ta_bitmark  (TRACT *t);
+extern BITTA        ta_bits     (const TRACT *t);
+extern int          bt_popcnt   (BITTA bits);
 
 extern void         ta_sort     (TRACT *t, int dir);
 extern void         ta_reverse  (TRACT *t);
@@ -752,6 +777,8 @@ extern int          tbg_write   (TABAG *bag, TABWRITE *twr,
 extern int          tbg_istab   (TABAG *bag);
 extern ITEM         tbg_recode  (TABAG *bag, SUPP min, SUPP max,
                                  ITEM cnt, int dir);
+extern ITEM         tbg_reclus  (TABAG *bag, SUPP min, SUPP max,
+                                 ITEM cnt, int dir, TID smpl);
 extern void         tbg_filter  (TABAG *bag, ITEM min,
                                  const int *marks, double wgt);
 extern void         tbg_trim    (TABAG *bag, ITEM min,
@@ -764,6 +791,7 @@ extern void         tbg_reverse (TABAG *bag);
 extern TID          tbg_reduce  (TABAG *bag, int keep0);
 extern void         tbg_setmark (TABAG *bag, int mark);
 extern void         tbg_bitmark (TABAG *bag);
+extern const BITTA* tbg_bits    (TABAG *bag);
 extern void         tbg_pack    (TABAG *bag, int n);
 extern void         tbg_unpack  (TABAG *bag, int dir);
 extern int          tbg_packcnt (TABAG *bag);
@@ -782,6 +810,14 @@ extern TABAG*       tbg_ident  (TABAG *src, RNG *rng, TABAG *dst);
 extern TABAG*       tbg_random (TABAG *src, RNG *rng, TABAG *dst);
 extern TABAG*       tbg_swap   (TABAG *src, RNG *rng, TABAG *dst);
 extern TABAG*       tbg_shuffle(TABAG *src, RNG *rng, TABAG *dst);
+
+extern TBGSURR*     tbs_create (TABAG *src, TBGSURRFN *fn, int cnt,
+                                unsigned int seed, int thcnt);
+extern void         tbs_delete (TBGSURR *sb);
+extern void         tbs_setpin (TBGSURR *sb, int cpu);
+extern int          tbs_next   (TBGSURR *sb);
+extern int          tbs_cnt    (TBGSURR *sb);
+extern TABAG*       tbs_bag    (TBGSURR *sb, int i);
 #endif
 /*----------------------------------------------------------------------
   Transaction Array Functions
@@ -901,6 +937,19 @@ extern void         tat_show    (TATREE *tree);
 
 /*--------------------------------------------------------------------*/
 
+#ifdef __GNUC__                 /* if GNU C compiler (or compatible) */
+#define bt_popcnt(x)      __builtin_popcountll(x)
+#endif                          /* use the builtin population count */
+
+/*--------------------------------------------------------------------*/
+#ifdef TA_SURR
+#define tbs_cnt(s)        ((s)->cnt)
+#define tbs_setpin(s,c)   ((s)->pin = (c))
+#define tbs_bag(s,i)      ((s)->bags[i])
+#endif
+
+/*--------------------------------------------------------------------*/
+
 #define taa_dstsize(n,x)  ((size_t)(n)*sizeof(TRACT) +(x)*sizeof(ITEM))
 
 /*--------------------------------------------------------------------*/
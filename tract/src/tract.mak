@@ -9,6 +9,14 @@
 #           2013.04.04 added external modules and tract/train main prgs.
 #           2016.04.20 completed dependencies on header files
 #           2016.10.21 modules cm4seqs and cmfilter added (from coconad)
+#           2026.10.16 module tasrc added (transaction sources)
+#           2026.10.16 parallel surrogate batches in tars.obj (threads)
+#           2026.10.16 module isbin and main program isb added
+#           2026.10.16 optional output writer thread in report.obj
+#           2026.10.16 optional parallel estimation in pspest/pspetr.obj
+#           2026.10.16 optional parallel shard merging in patspec.obj
+#           2026.10.17 module hhsketch added (heavy hitter sketch)
+#           2026.10.17 surrogate functions added to tatree.obj
 #-----------------------------------------------------------------------
 THISDIR  = ..\..\tract\src
 UTILDIR  = ..\..\util\src
@@ -30,7 +38,7 @@ OBJS     = $(UTILDIR)\arrays.obj   $(UTILDIR)\memsys.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\escape.obj   \
            $(UTILDIR)\tabread.obj  $(UTILDIR)\tabwrite.obj \
            $(UTILDIR)\scform.obj \
-           taread.obj patspec.obj clomax.obj repcm.obj
+           taread.obj patspec.obj hhsketch.obj clomax.obj repcm.obj
 
 PSPOBJS  = $(UTILDIR)\arrays.obj   $(UTILDIR)\escape.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\tabread.obj  \
@@ -40,9 +48,10 @@ RGTOBJS  = $(UTILDIR)\arrays.obj   $(UTILDIR)\escape.obj   \
            $(UTILDIR)\idmap.obj    $(UTILDIR)\tabread.obj  \
            $(UTILDIR)\memsys.obj   $(UTILDIR)\scform.obj   \
            $(MATHDIR)\ruleval.obj  $(MATHDIR)\gamma.obj    \
-           $(MATHDIR)\chi2.obj     taread.obj report.obj patspec.obj
+           $(MATHDIR)\chi2.obj     taread.obj report.obj patspec.obj \
+           hhsketch.obj
 
-PRGS     = fim16.exe tract.exe train.exe psp.exe rgt.exe
+PRGS     = fim16.exe tract.exe train.exe psp.exe rgt.exe isb.exe
 
 #-----------------------------------------------------------------------
 # Build Programs
@@ -65,6 +74,9 @@ psp.exe:      $(PSPOBJS) pspmain.obj tract.mak
 rgt.exe:      $(RGTOBJS) rgmain.obj makefile
 	$(LD) $(LDFLAGS) $(RGTOBJS) rgmain.obj $(LIBS) /Fo$@
 
+isb.exe:      isbmain.obj tract.mak
+	$(LD) $(LDFLAGS) isbmain.obj $(LIBS) /out:$@
+
 #-----------------------------------------------------------------------
 # Main Programs
 #-----------------------------------------------------------------------
@@ -88,6 +100,10 @@ rgmain.obj:   $(HDRS) $(UTILDIR)\memsys.h $(MATHDIR)\ruleval.h report.h
 rgmain.obj:   rulegen.c makefile
 	$(CC) $(CFLAGS) $(INCS) /D RG_MAIN rulegen.c /Fo$@
 
+isbmain.obj:  $(HDRS)
+isbmain.obj:  isbin.h isbin.c tract.mak
+	$(CC) $(CFLAGS) $(INCS) /D ISB_MAIN isbin.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Item and Transaction Management
 #-----------------------------------------------------------------------
@@ -97,7 +113,8 @@ tract.obj:    tract.h tract.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) tract.c /Fo$@
 
 tasurr.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
-              $(UTILDIR)\symtab.h   $(UTILDIR)\random.h
+              $(UTILDIR)\symtab.h   $(UTILDIR)\random.h \
+              $(UTILDIR)\threads.h
 tasurr.obj:   tract.h tract.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D TA_SURR tract.c /Fo$@
 
@@ -114,7 +131,7 @@ tarw.obj:     tract.h tract.c tract.mak
 
 tars.obj:     $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
               $(UTILDIR)\symtab.h   $(UTILDIR)\random.h \
-              $(UTILDIR)\tabread.h
+              $(UTILDIR)\tabread.h  $(UTILDIR)\threads.h
 tars.obj:     tract.h tract.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D TA_READ /D TA_SURR tract.c /Fo$@
 
@@ -124,9 +141,19 @@ tard.obj:     tract.h tract.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D TA_READ /D SUPP=double tract.c /Fo$@
 
 tatree.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
-              $(UTILDIR)\symtab.h   $(UTILDIR)\tabread.h
+              $(UTILDIR)\symtab.h   $(UTILDIR)\tabread.h \
+              $(UTILDIR)\random.h   $(UTILDIR)\threads.h
 tatree.obj:   tract.h tract.c tract.mak
-	$(CC) $(CFLAGS) $(INCS) /D TA_READ /D TATREEFN tract.c /Fo$@
+	$(CC) $(CFLAGS) $(INCS) /D TA_READ /D TATREEFN /D TA_SURR \
+              tract.c /Fo$@
+
+#-----------------------------------------------------------------------
+# Transaction Source Management
+#-----------------------------------------------------------------------
+tasrc.obj:    $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
+              $(UTILDIR)\symtab.h   $(UTILDIR)\tabread.h tract.h
+tasrc.obj:    tasrc.h tasrc.c tract.mak
+	$(CC) $(CFLAGS) $(INCS) /D TA_READ tasrc.c /Fo$@
 
 #-----------------------------------------------------------------------
 # Train Management
@@ -175,10 +202,16 @@ fim16.obj:    fim16.c tract.mak
 # Pattern Statistics Management
 #-----------------------------------------------------------------------
 patspec.obj:  $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
-              $(UTILDIR)\symtab.h   $(UTILDIR)\tabwrite.h
+              $(UTILDIR)\symtab.h   $(UTILDIR)\tabwrite.h \
+              $(UTILDIR)\threads.h
 patspec.obj:  patspec.h patspec.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D PSP_REPORT patspec.c /Fo$@
 
+hhsketch.obj: $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
+              $(UTILDIR)\symtab.h   $(UTILDIR)\tabwrite.h tract.h
+hhsketch.obj: hhsketch.h hhsketch.c tract.mak
+	$(CC) $(CFLAGS) $(INCS) /D HH_REPORT hhsketch.c /Fo$@
+
 pspdbl.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
               $(UTILDIR)\symtab.h   $(UTILDIR)\tabwrite.h
 pspdbl.obj:   patspec.h patspec.c tract.mak
@@ -187,14 +220,15 @@ pspdbl.obj:   patspec.h patspec.c tract.mak
 
 pspest.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
               $(UTILDIR)\symtab.h   $(UTILDIR)\random.h \
-              $(UTILDIR)\tabwrite.h
+              $(UTILDIR)\tabwrite.h $(UTILDIR)\threads.h
 pspest.obj:   patspec.h patspec.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D PSP_REPORT /D PSP_ESTIM \
 	      patspec.c /Fo$@
 
 pspetr.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
               $(UTILDIR)\symtab.h   $(UTILDIR)\random.h \
-              $(UTILDIR)\tabwrite.h $(MATHDIR)\gamma.h
+              $(UTILDIR)\tabwrite.h $(UTILDIR)\threads.h \
+              $(MATHDIR)\gamma.h
 pspetr.obj:   patspec.h patspec.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D PSP_REPORT /D PSP_ESTIM /D PSP_TRAIN \
               patspec.c /Fo$@
@@ -239,31 +273,39 @@ cmfdbl.obj:   cmfilter.c makefile
 #-----------------------------------------------------------------------
 report.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h  \
               $(UTILDIR)\symtab.h   $(UTILDIR)\scanner.h \
-              tract.h patspec.h
+              $(UTILDIR)\threads.h  tract.h patspec.h hhsketch.h isbin.h
 report.obj:   report.h report.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D ISR_PATSPEC report.c /Fo$@
 
 repdbl.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h  \
               $(UTILDIR)\symtab.h   $(UTILDIR)\scanner.h \
-              tract.h patspec.h
+              tract.h patspec.h hhsketch.h isbin.h
 repdbl.obj:   report.h report.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D RSUPP=double /D ISR_PATSPEC \
               report.c /Fo$@
 
 repcm.obj:    $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h  \
               $(UTILDIR)\symtab.h   $(UTILDIR)\scanner.h \
-              tract.h patspec.h clomax.h
+              tract.h patspec.h hhsketch.h clomax.h isbin.h
 repcm.obj:    report.h report.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D ISR_PATSPEC /D ISR_CLOMAX \
               report.c /Fo$@
 
 repcmd.obj:   $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h  \
               $(UTILDIR)\symtab.h   $(UTILDIR)\scanner.h \
-              tract.h patspec.h clomax.h
+              tract.h patspec.h hhsketch.h clomax.h isbin.h
 repcmd.obj:   report.h report.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D RSUPP=double /D ISR_PATSPEC \
               /D ISR_CLOMAX report.c /Fo$@
 
+#-----------------------------------------------------------------------
+# Binary Item Set Reader Management
+#-----------------------------------------------------------------------
+isbin.obj:    $(UTILDIR)\fntypes.h  $(UTILDIR)\arrays.h \
+              $(UTILDIR)\symtab.h   tract.h
+isbin.obj:    isbin.h isbin.c tract.mak
+	$(CC) $(CFLAGS) $(INCS) isbin.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Rule Generation Tree Management
 #-----------------------------------------------------------------------
@@ -27,6 +27,7 @@
             2013.07.24 bug in move functions fixed (forward move)
             2015.07.29 bug in move functions fixed (memory allocation)
             2015.07.30 object functions added (up to maximum size)
+            2026.10.17 bug in index quicksort with comparison fixed
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -1281,20 +1282,20 @@ static void name##_qrec (tidx *index, size_t n,                        \
                          tin##_CMPFN *cmp, void *data)                 \
 {                               /* --- recursive part of quicksort */  \
   tidx   *l, *r;                /* pointers to exchange positions */   \
-  tidx   t;                     /* pivot element and exchange buffer */\
+  tidx   x, t;                  /* pivot element and exchange buffer */\
   size_t m;                     /* number of elements in 2nd section */\
                                                                        \
   do {                          /* sections sort loop */               \
     l = index; r = l +n -1;     /* start at left and right boundary */ \
     if (cmp(*l, *r, data) > 0){ /* bring the first and last */         \
       t = *l; *l = *r; *r = t;} /* element into proper order */        \
-    t = index[n /2];            /* get the middle element as pivot */  \
-    if      (cmp(t, *l, data) < 0) t = *l;  /* try to find a */        \
-    else if (cmp(t, *r, data) > 0) t = *r;  /* better pivot */         \
+    x = index[n /2];            /* get the middle element as pivot */  \
+    if      (cmp(x, *l, data) < 0) x = *l;  /* try to find a */        \
+    else if (cmp(x, *r, data) > 0) x = *r;  /* better pivot */         \
     while (1) {                 /* split and exchange loop */          \
-      while (cmp(*++l, t, data) < 0)  /* skip left  elements that */   \
+      while (cmp(*++l, x, data) < 0)  /* skip left  elements that */   \
         ;                       /* are smaller than pivot element */   \
-      while (cmp(*--r, t, data) > 0)  /* skip right elements that */   \
+      while (cmp(*--r, x, data) > 0)  /* skip right elements that */   \
         ;                       /* are greater than pivot element */   \
       if (l >= r) {             /* if at most one element left, */     \
         if (l <= r) { l++; r--; } break; }    /* abort the loop */     \
@@ -0,0 +1,170 @@
+/*----------------------------------------------------------------------
+  File    : threads.c
+  Contents: simple portable thread management (fork and join)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+            2026.10.16 thread pinning added (thr_pin(), thr_runp())
+            2026.10.16 functions thr_start() and thr_join() added
+            2026.10.17 functions thr_alloc() and thr_free() removed
+            2026.10.17 comment on memory placement corrected
+----------------------------------------------------------------------*/
+#ifdef __linux__                /* if Linux system */
+#define _GNU_SOURCE             /* needed for sysconf() and */
+#include <sched.h>              /* pthread_setaffinity_np() */
+#include <unistd.h>
+#elif !defined _WIN32           /* if other Unix system */
+#define _POSIX_C_SOURCE 200112L /* needed for sysconf() */
+#include <unistd.h>
+#endif
+#include <stdlib.h>
+#include <assert.h>
+#include "threads.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- pinned worker --- */
+  THRWORKER *fn;                /* worker function to execute */
+  void      *arg;               /* argument of the worker function */
+  int       cpu;                /* processor to pin the thread to */
+} PINNED;                       /* (pinned worker) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static WORKERDEF(pinned, p)
+{                               /* --- execute a pinned worker */
+  PINNED *w = (PINNED*)p;       /* type the worker data */
+  thr_pin(w->cpu);              /* pin the thread to a processor */
+  return w->fn(w->arg);         /* and execute the worker function */
+}  /* pinned() */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+
+int thr_cnt (void)
+{                               /* --- get number of processors */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  SYSTEM_INFO info;             /* system information */
+  GetSystemInfo(&info);         /* get the system information */
+  return (int)info.dwNumberOfProcessors;
+  #else                         /* if Linux/Unix system */
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n < 1) ? 1 : (n > THR_MAX) ? THR_MAX : (int)n;
+  #endif                        /* get the number of online cores */
+}  /* thr_cnt() */
+
+/*--------------------------------------------------------------------*/
+
+int thr_pin (int cpu)
+{                               /* --- pin thread to a processor */
+  #if defined _WIN32            /* if Microsoft Windows system */
+  cpu %= thr_cnt();             /* get a valid processor index */
+  if (cpu >= (int)(8*sizeof(DWORD_PTR))) return -1;
+  return (SetThreadAffinityMask(GetCurrentThread(),
+                                (DWORD_PTR)1 << cpu) != 0) ? 0 : -1;
+  #elif defined __linux__       /* if Linux system */
+  cpu_set_t set;                /* set of processors */
+  cpu %= thr_cnt();             /* get a valid processor index */
+  CPU_ZERO(&set); CPU_SET((size_t)cpu, &set);
+  return (pthread_setaffinity_np(pthread_self(), sizeof(set), &set)
+          == 0) ? 0 : -1;       /* pin the thread to the processor */
+  #else                         /* if other Unix system */
+  return -1;                    /* pinning is not supported */
+  #endif
+}  /* thr_pin() */
+
+/*--------------------------------------------------------------------*/
+
+int thr_start (THREAD *thread, THRWORKER *fn, void *arg)
+{                               /* --- start a single thread */
+  assert(thread && fn);         /* check the function arguments */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+  return (*thread) ? 0 : -1;    /* create a thread for the worker */
+  #else                         /* if Linux/Unix system */
+  return (pthread_create(thread, NULL, fn, arg) == 0) ? 0 : -1;
+  #endif                        /* create a thread for the worker */
+}  /* thr_start() */
+
+/*--------------------------------------------------------------------*/
+
+void thr_join (THREAD thread)
+{                               /* --- wait for a thread to finish */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);          /* wait for the thread to finish */
+  #else                         /* if Linux/Unix system */
+  pthread_join(thread, NULL);   /* wait for the thread to finish */
+  #endif
+}  /* thr_join() */
+
+/*--------------------------------------------------------------------*/
+
+int thr_runp (THRWORKER *fn, void *args, size_t size, int cnt, int pin)
+{                               /* --- run workers and wait for them */
+  int    i, k;                  /* loop variables, number of threads */
+  int    r = 0;                 /* result of thread creation */
+  THREAD threads[THR_MAX];      /* created threads */
+  PINNED pins[THR_MAX];         /* data of pinned workers */
+  char   *p;                    /* to traverse the worker arguments */
+
+  assert(fn && (args || (size <= 0)) && (cnt <= THR_MAX));
+  if (cnt <= 0) return 0;       /* check for at least one worker */
+  p = (char*)args;              /* get the worker arguments */
+  if (pin >= 0) {               /* if to pin the threads, */
+    for (i = 0; i < cnt; i++) { /* wrap the worker function */
+      pins[i].fn  = fn; pins[i].arg = p +(size_t)i *size;
+      pins[i].cpu = pin +i;     /* (worker i is pinned to */
+    }                           /* processor pin+i modulo the */
+    fn = pinned; p = (char*)pins; size = sizeof(PINNED);
+  }                             /* number of processors) */
+  for (k = (pin >= 0) ? 0 : 1; k < cnt; k++) {
+    #ifdef _WIN32               /* if Microsoft Windows system */
+    threads[k] = CreateThread(NULL, 0, fn, p +(size_t)k *size, 0, NULL);
+    if (!threads[k]) { r = -1; break; }
+    #else                       /* if Linux/Unix system */
+    if (pthread_create(threads+k, NULL, fn, p +(size_t)k *size) != 0) {
+      r = -1; break; }          /* create a thread for the worker */
+    #endif
+  }                             /* (on failure, wait for the others) */
+  i = 0;                        /* first worker may run directly */
+  if (pin < 0) { fn(p); i = 1; }/* (only if the caller is not pinned) */
+  for ( ; i < k; i++) {         /* traverse the created threads */
+    #ifdef _WIN32               /* if Microsoft Windows system */
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);    /* wait for the thread to finish */
+    #else                       /* if Linux/Unix system */
+    pthread_join(threads[i], NULL);
+    #endif                      /* wait for the thread to finish */
+  }
+  return r;                     /* return an error indicator */
+}  /* thr_runp() */
+
+/*----------------------------------------------------------------------
+The function thr_runp() executes a worker function for each of the
+cnt argument blocks (each of size bytes) in the array args, using one
+thread per block. It returns only after all workers have finished
+(fork and join). If pin < 0, the first block is processed by the
+calling thread. Otherwise all blocks are processed by new threads,
+and the thread for block i is pinned to processor (pin+i) modulo the
+number of processors. Memory placement is left to the operating
+system: no NUMA node is selected explicitly, but with a first touch
+policy the memory that a pinned worker initializes is local to its
+processor. If a thread cannot be created, the remaining blocks are
+not processed, all started workers are waited for, and -1 is
+returned. The macro thr_run() runs unpinned threads.
+
+The functions thr_start() and thr_join() start a single thread that
+runs in parallel with the calling thread (e.g. a writer thread that
+consumes buffers produced by the caller) and wait for it to finish.
+The data exchange is to be synchronized with a mutex and a condition
+variable (thr_cdinit(), thr_wait(), thr_signal(), thr_bcast()); note
+that, as usual, thr_wait() must be called in a loop that rechecks the
+waited-for condition, because of possible spurious wakeups.
+----------------------------------------------------------------------*/
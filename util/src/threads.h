@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------
+  File    : threads.h
+  Contents: simple portable thread management (fork and join)
+  Author  : Christian Borgelt
+  History : 2026.10.16 file created
+            2026.10.16 thread pinning added (thr_pin(), thr_runp())
+            2026.10.16 condition variables, thr_start(), thr_join() added
+            2026.10.17 functions thr_alloc() and thr_free() removed
+            2026.10.17 prototypes of macro functions removed
+----------------------------------------------------------------------*/
+#ifndef __THREADS__
+#define __THREADS__
+#include <stddef.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define THR_MAX       256       /* maximum number of threads */
+#define THR_NOPIN     (-1)      /* do not pin threads to processors */
+
+#ifdef _WIN32                   /* if Microsoft Windows system */
+#define THREAD        HANDLE    /* thread handle */
+#define THRMUTEX      CRITICAL_SECTION  /* mutual exclusion object */
+#define THRCOND       CONDITION_VARIABLE /* condition variable */
+#define WORKERDEF(n,p) DWORD WINAPI n (LPVOID p)
+#define THREAD_OK     0         /* return value of a worker */
+#else                           /* if Linux/Unix system */
+#define THREAD        pthread_t /* thread handle */
+#define THRMUTEX      pthread_mutex_t   /* mutual exclusion object */
+#define THRCOND       pthread_cond_t    /* condition variable */
+#define WORKERDEF(n,p) void* n (void *p)
+#define THREAD_OK     NULL      /* return value of a worker */
+#endif
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef WORKERDEF(THRWORKER, arg);  /* worker function of a thread */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern int  thr_cnt     (void);
+extern int  thr_runp    (THRWORKER *fn, void *args, size_t size,
+                         int cnt, int pin);
+extern int  thr_pin     (int cpu);
+extern int  thr_start   (THREAD *thread, THRWORKER *fn, void *arg);
+extern void thr_join    (THREAD thread);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define thr_run(f,a,s,n)  thr_runp(f,a,s,n,THR_NOPIN)
+
+#ifdef _WIN32                   /* if Microsoft Windows system */
+#define thr_mxinit(m)   InitializeCriticalSection(m)
+#define thr_mxfree(m)   DeleteCriticalSection(m)
+#define thr_lock(m)     EnterCriticalSection(m)
+#define thr_unlock(m)   LeaveCriticalSection(m)
+#define thr_cdinit(c)   InitializeConditionVariable(c)
+#define thr_cdfree(c)   ((void)(c))
+#define thr_wait(c,m)   SleepConditionVariableCS(c, m, INFINITE)
+#define thr_signal(c)   WakeConditionVariable(c)
+#define thr_bcast(c)    WakeAllConditionVariable(c)
+#else                           /* if Linux/Unix system */
+#define thr_mxinit(m)   pthread_mutex_init(m, NULL)
+#define thr_mxfree(m)   pthread_mutex_destroy(m)
+#define thr_lock(m)     pthread_mutex_lock(m)
+#define thr_unlock(m)   pthread_mutex_unlock(m)
+#define thr_cdinit(c)   pthread_cond_init(c, NULL)
+#define thr_cdfree(c)   pthread_cond_destroy(c)
+#define thr_wait(c,m)   pthread_cond_wait(c, m)
+#define thr_signal(c)   pthread_cond_signal(c)
+#define thr_bcast(c)    pthread_cond_broadcast(c)
+#endif
+
+#endif
@@ -11,6 +11,7 @@
 #           2008.08.18 adapted to main functions of arrays and lists
 #           2008.08.22 module escape added, test program tsctest added
 #           2016.04.20 completed dependencies on header files
+#           2026.10.16 module threads added (fork and join)
 #-----------------------------------------------------------------------
 THISDIR = ../../util/src
 
@@ -86,6 +87,12 @@ idmap.obj:    fntypes.h symtab.h arrays.h symtab.c util.mak
 random.obj:   random.h random.c util.mak
 	$(CC) $(CFLAGS) random.c /Fo$@
 
+#-----------------------------------------------------------------------
+# Thread Management
+#-----------------------------------------------------------------------
+threads.obj:  threads.h threads.c util.mak
+	$(CC) $(CFLAGS) threads.c /Fo$@
+
 #-----------------------------------------------------------------------
 # Numerical Statistics
 #-----------------------------------------------------------------------